@@ -123,6 +123,51 @@
      da_free(a1); // make sure not to leak memory!
      da_free(a2);
  }
+
+ // Example for a custom allocator: a simple arena for arrays that are only
+ // needed during one frame. All its memory is released at once by resetting it
+ // at the end of the frame, so the arrays don't need to be da_free()d.
+ typedef struct { unsigned char* mem; size_t used, size; } FrameArena;
+
+ static void* arenaAlloc(void* ctx, size_t numBytes)
+ {
+     FrameArena* arena = (FrameArena*)ctx;
+     size_t start = (arena->used + 15) & ~(size_t)15; // keep 16 byte alignment
+     if(numBytes > arena->size - start)  return NULL;
+     arena->used = start + numBytes;
+     return arena->mem + start;
+ }
+
+ static void* arenaRealloc(void* ctx, void* ptr, size_t oldNumBytes, size_t newNumBytes)
+ {
+     FrameArena* arena = (FrameArena*)ctx;
+     unsigned char* p = (unsigned char*)ptr;
+     // if it's the last allocation, it can just be resized in place
+     if(p + oldNumBytes == arena->mem + arena->used && newNumBytes <= arena->size - (p - arena->mem))
+     {
+         arena->used = (p - arena->mem) + newNumBytes;
+         return ptr;
+     }
+     void* ret = arenaAlloc(ctx, newNumBytes);
+     if(ret != NULL)  memcpy(ret, ptr, (oldNumBytes < newNumBytes) ? oldNumBytes : newNumBytes);
+     return ret;
+ }
+
+ static void arenaFree(void* ctx, void* ptr, size_t numBytes)
+ {
+     // freed at once at the end of the frame
+ }
+
+ void frame(FrameArena* arena)
+ {
+     dg_dynarr_allocator arenaAllocator = { arenaAlloc, arenaRealloc, arenaFree, NULL, arena };
+     MyIntArrType visible;
+     da_init_allocator(visible, &arenaAllocator);
+     for(int i=0; i<numObjects; ++i)
+         if(isVisible(i))  da_push(visible, i);
+     // ... use visible ...
+     arena->used = 0; // end of frame, visible must not be used anymore
+ }
 #endif // 0 (usage example)
 
 #ifndef DG__DYNARR_H
@@ -177,6 +222,55 @@
  #define DG_DYNARR_FREE(ptr)  free(ptr)
 */
 
+// When an array needs more memory, its capacity is multiplied by
+// DG_DYNARR_GROWTH_NUM / DG_DYNARR_GROWTH_DEN (2/1 by default; 3/2 grows by
+// factor 1.5, which wastes less memory but reallocates more often - the factor
+// should be > 1 and <= 2; define both or neither), but it's at least
+// DG_DYNARR_MIN_CAPACITY (8) elements.
+// Once an array uses DG_DYNARR_LINEAR_GROWTH_BYTES bytes or more, it only grows by
+// that many bytes each time - 0 (the default) disables that, it makes sense for huge
+// arrays if the allocator can grow them without copying (like glibc's realloc() for
+// big allocations, which uses mremap()), otherwise growing them gets expensive.
+// If you #define DG_DYNARR_ROUND_TO_SIZE_CLASSES (or your own DG_DYNARR_GOOD_SIZE()),
+// allocation sizes are rounded up as well and the capacity is set to the number of
+// elements that actually fit (by default they're not rounded, so the capacity is
+// exactly what the growth policy says):
+// Allocations of 16*DG_DYNARR_HUGEPAGE_SIZE bytes or more are rounded up to multiples
+// of DG_DYNARR_HUGEPAGE_SIZE (2MB by default), so they can be backed by huge pages.
+// Smaller sizes are rounded up with DG_DYNARR_GOOD_SIZE(numBytes) to the size the
+// allocator would reserve anyway (its size class). DG_DYNARR_GOOD_SIZE() defaults to
+// malloc_good_size() on macOS, on glibc it's based on how its malloc() rounds sizes
+// (for sizes below its mmap threshold, bigger ones aren't rounded) and elsewhere it
+// rounds up to 16 bytes; if you #define your own DG_DYNARR_MALLOC, it defaults to
+// not rounding at all.
+// Arrays with their own allocator (see below) always use its good_size() instead.
+// These are needed only before the #define DG_DYNARR_IMPLEMENTATION #include of
+// this header, so the following is here only for reference and commented out
+/*
+ #define DG_DYNARR_GROWTH_NUM  3
+ #define DG_DYNARR_GROWTH_DEN  2
+ #define DG_DYNARR_MIN_CAPACITY  8
+ #define DG_DYNARR_LINEAR_GROWTH_BYTES  (64*1024*1024)
+ #define DG_DYNARR_ROUND_TO_SIZE_CLASSES
+ #define DG_DYNARR_HUGEPAGE_SIZE  (2*1024*1024)
+ #define DG_DYNARR_GOOD_SIZE(numBytes)  (numBytes)
+*/
+
+// Arrays initialized with da_init_vm() reserve this much address space up front
+// (except on Linux, where mremap() is used instead), see da_init_vm() below.
+// Define it before the #define DG_DYNARR_IMPLEMENTATION #include of this header.
+// Default: 16GB on 64bit systems, 32MB on 32bit systems (their address space is small,
+// a reservation that's too small is just replaced with one twice as big when it's full)
+/*
+ #define DG_DYNARR_VM_RESERVE_BYTES  ((size_t)1 << 34)
+*/
+
+// Alternatively (or additionally), single arrays can be bound to their own allocator
+// at runtime with da_init_allocator(), for example to put all arrays that are only needed
+// for one frame into an arena that is reset at the end of the frame, or to use a
+// thread-local pool. See dg_dynarr_allocator below and the arena example after the
+// usage example at the top of this file.
+
 // if you want to prepend something to the non inline (DG_DYNARR_INLINE) functions,
 // like "__declspec(dllexport)" or whatever, #define DG_DYNARR_DEF
 #ifndef DG_DYNARR_DEF
@@ -225,6 +319,32 @@
 #define da_init_external(a, buf, buf_cap) \
 	dg_dynarr_init_external(a, buf, buf_cap)
 
+// initializes the array like da_init(), but binds it to the given allocator,
+// which is used for all its memory (instead of DG_DYNARR_MALLOC etc) until da_init()
+// is called again. alloc is a (const) dg_dynarr_allocator* that must remain valid
+// as long as the array is used (including da_free()).
+#define da_init_allocator(a, alloc) \
+	dg_dynarr_init_allocator(a, alloc)
+
+// combines da_init_external() and da_init_allocator(): buf is used as long as
+// it's big enough, after that the memory comes from alloc
+#define da_init_external_allocator(a, buf, buf_cap, alloc) \
+	dg_dynarr_init_external_allocator(a, buf, buf_cap, alloc)
+
+// initializes the array like da_init(), but for huge arrays: its memory is allocated
+// directly from the OS (with mmap() or VirtualAlloc()), so growing it never copies
+// the elements: on Linux it's grown with mremap() (if _GNU_SOURCE is #defined before
+// #including any headers in the implementation file, else it works like elsewhere),
+// elsewhere DG_DYNARR_VM_RESERVE_BYTES of address space are reserved up front and
+// only committed when needed. Shrinking (da_shrink_to_fit()) gives the memory at
+// the end back to the OS. On Linux, arrays of DG_DYNARR_HUGEPAGE_SIZE or more
+// bytes are madvise()d to use transparent huge pages (MADV_HUGEPAGE), unless
+// DG_DYNARR_VM_NO_HUGEPAGES is #defined.
+// The capacity is always a multiple of the page size, so only use it for arrays that
+// can get really big.
+#define da_init_vm(a) \
+	dg_dynarr_init_vm(a)
+
 // use this to free the memory allocated by dg_dynarr once you don't need the array anymore
 // Note: it is safe to add new elements to the array after da_free()
 //       it will allocate new memory, just like it would directly after da_init()
@@ -247,15 +367,29 @@
 	dg_dynarr_addn(a, vals, n)
 
 // add n elements to the end of the array and zeroes them with memset()
-// returns pointer to first added element, NULL if out of memory (array is empty then)
+// returns pointer to first added element, NULL if out of memory (array is unchanged then)
 #define da_addn_zeroed(a, n) \
 	dg_dynarr_addn_zeroed(a, n)
 
 // add n elements to the end of the array, will remain uninitialized
-// returns pointer to first added element, NULL if out of memory (array is empty then)
+// returns pointer to first added element, NULL if out of memory (array is unchanged then)
 #define da_addn_uninit(a, n) \
 	dg_dynarr_addn_uninit(a, n)
 
+// reserve room for at least k elements after the end of the array *without* adding them,
+// so they can be written in place (e.g. by read() or recv()); afterwards use da_commit()
+// to add the number of elements actually written. There's space for
+// da_capacity(a) - da_count(a) elements, which can be more than k (k = 0 is treated like 1).
+// returns pointer to where the next element would go, NULL if out of memory (array is unchanged then)
+// ! any other operation that adds elements or changes the capacity invalidates that pointer !
+#define da_append_reserve(a, k) \
+	dg_dynarr_append_reserve(a, k)
+
+// add n elements that were written to the space returned by da_append_reserve()
+// to the array; n must be <= da_capacity(a) - da_count(a)
+#define da_commit(a, n) \
+	dg_dynarr_commit(a, n)
+
 
 // insert a single value v at index idx
 #define da_insert(a, idx, v) \
@@ -377,14 +511,20 @@
 #define da_empty(a) \
 	dg_dynarr_empty(a)
 
-// returns 1 if the last (re)allocation when inserting failed (Out Of Memory)
-//   or if the array has never allocated any memory yet, else 0
-// deleting the contents when growing fails instead of keeping old may seem
-// a bit uncool, but it's simple and OOM should rarely happen on modern systems
-// anyway - after all you need to deplete both RAM and swap/pagefile.sys
+// returns 1 if a (re)allocation when inserting failed (Out Of Memory) since the
+//   last da_oom_clear() (or da_init() or da_free()), or if the array has never
+//   allocated any memory yet, else 0.
+// When growing the array fails, its contents and capacity are kept (only the
+// operation that needed more memory isn't done), so you can free some memory
+// (drop caches or whatever) and try again. The OOM flag is sticky (like ferror()),
+// so you can do lots of da_push() etc and only check da_oom() afterwards.
 #define da_oom(a) \
 	dg_dynarr_oom(a)
 
+// resets the sticky OOM flag checked by da_oom(), e.g. before retrying
+#define da_oom_clear(a) \
+	dg_dynarr_oom_clear(a)
+
 
 // sort a using the given qsort()-comparator cmp
 // (just a slim wrapper around qsort())
@@ -403,18 +543,31 @@
 // makes sure the array is initialized and can be used.
 // either do YourArray arr = {0}; or YourArray arr; dg_dynarr_init(arr);
 #define dg_dynarr_init(a) \
-	dg__dynarr_init((void**)&(a).p, &(a).md, NULL, 0)
+	dg__dynarr_init((void**)&(a).p, &(a).md, NULL, 0, NULL)
 
 // this allows you to provide an external buffer that'll be used as long as it's big enough
 // once you add more elements than buf can hold, fresh memory will be allocated on the heap
 #define dg_dynarr_init_external(a, buf, buf_cap) \
-	dg__dynarr_init((void**)&(a).p, &(a).md, (buf), (buf_cap))
+	dg__dynarr_init((void**)&(a).p, &(a).md, (buf), (buf_cap), NULL)
+
+// like dg_dynarr_init(), but the array uses the given dg_dynarr_allocator* for its memory
+#define dg_dynarr_init_allocator(a, alloc) \
+	dg__dynarr_init((void**)&(a).p, &(a).md, NULL, 0, (alloc))
+
+// like dg_dynarr_init_external(), but once buf is full the given dg_dynarr_allocator* is used
+#define dg_dynarr_init_external_allocator(a, buf, buf_cap, alloc) \
+	dg__dynarr_init((void**)&(a).p, &(a).md, (buf), (buf_cap), (alloc))
+
+// like dg_dynarr_init(), but the array memory is directly allocated from the OS
+// as virtual memory, see da_init_vm()
+#define dg_dynarr_init_vm(a) \
+	dg_dynarr_init_allocator(a, dg_dynarr_vm_allocator())
 
 // use this to free the memory allocated by dg_dynarr
 // Note: it is safe to add new elements to the array after dg_dynarr_free()
 //       it will allocate new memory, just like it would directly after dg_dynarr_init()
 #define dg_dynarr_free(a) \
-	dg__dynarr_free((void**)&(a).p, &(a).md)
+	dg__dynarr_free(dg__dynarr_unp(a))
 
 
 // add an element to the array (appended at the end)
@@ -436,20 +589,31 @@
 	} } DG__DYNARR_WHILE0
 
 // add n elements to the end of the array and zeroe them with memset()
-// returns pointer to first added element, NULL if out of memory (array is empty then)
+// returns pointer to first added element, NULL if out of memory (array is unchanged then)
 #define dg_dynarr_addn_zeroed(a, n) \
 	(dg__dynarr_add(dg__dynarr_unp(a), (n), 1) ? &(a).p[(a).md.cnt-(size_t)(n)] : NULL)
 
 // add n elements to the end of the array, which are uninitialized
-// returns pointer to first added element, NULL if out of memory (array is empty then)
+// returns pointer to first added element, NULL if out of memory (array is unchanged then)
 #define dg_dynarr_addn_uninit(a, n) \
 	(dg__dynarr_add(dg__dynarr_unp(a), (n), 0) ? &(a).p[(a).md.cnt-(size_t)(n)] : NULL)
 
+// make sure there's space for at least k more elements, without adding them
+// (k = 0 is treated like 1, so the array has memory and the result is only NULL on OOM)
+// returns pointer to where the next element would go, NULL if out of memory (array is unchanged then)
+#define dg_dynarr_append_reserve(a, k) \
+	(dg__dynarr_maybegrowadd(dg__dynarr_unp(a), dg__dynarr_atleast1(k)) ? (a).p + (a).md.cnt : NULL)
+
+// add n elements that were written after the end of the array (see dg_dynarr_append_reserve())
+#define dg_dynarr_commit(a, n) \
+	dg__dynarr_commit(&(a).md, (n))
+
 // insert a single value v at index idx
+// (if that fails because of OOM, v isn't evaluated and the array remains unchanged)
 #define dg_dynarr_insert(a, idx, v) \
 	(dg__dynarr_checkidxle((a),(idx)), \
-	 dg__dynarr_insert(dg__dynarr_unp(a), (idx), 1, 0), \
-	 (a).p[dg__dynarr_idx((a).md, (idx))] = (v))
+	 dg__dynarr_insert(dg__dynarr_unp(a), (idx), 1, 0) \
+	  ? (((a).p[dg__dynarr_idx((a).md, (idx))] = (v)),0) : 0)
 
 // insert n elements into a at idx, initialize them from array vals
 // doesn't return anything
@@ -608,15 +772,17 @@
 #define dg_dynarr_empty(a) \
 	((a).md.cnt == 0)
 
-// returns 1 if the last (re)allocation when inserting failed (Out Of Memory)
-//   or if the array has never allocated any memory yet, else 0
-// deleting the contents when growing fails instead of keeping old may seem
-// a bit uncool, but it's simple and OOM should rarely happen on modern systems
-// anyway - after all you need to deplete both RAM and swap/pagefile.sys
-// or deplete the address space, which /might/ happen with 32bit applications
-// but probably not with 64bit (at least in the foreseeable future)
+// returns 1 if a (re)allocation when inserting failed (Out Of Memory) since the
+//   last dg_dynarr_oom_clear() (or init or free), or if the array has never
+//   allocated any memory yet, else 0.
+// Growing the array keeps its contents and capacity if it fails, the flag is sticky
+// so it can be checked after a batch of operations (see da_oom() for more details).
 #define dg_dynarr_oom(a) \
-	((a).md.cap == 0)
+	(((a).md.alloc & DG__DYNARR_OOM_FLAG) || (a).md.cap == 0)
+
+// resets the sticky OOM flag checked by dg_dynarr_oom()
+#define dg_dynarr_oom_clear(a) \
+	((a).md.alloc &= ~DG__DYNARR_OOM_FLAG)
 
 
 // sort a using the given qsort()-comparator cmp
@@ -634,6 +800,32 @@
 extern "C" {
 #endif
 
+// an allocator that arrays can be bound to with dg_dynarr_init_allocator()
+// all sizes are in bytes, ctx is passed to all functions
+typedef struct dg_dynarr_allocator {
+	// returns new memory of (at least) numBytes bytes (aligned for the element type),
+	// or NULL if that fails
+	void* (*alloc)(void* ctx, size_t numBytes);
+	// like realloc(): returns memory of (at least) newNumBytes bytes that contains the
+	// first min(oldNumBytes, newNumBytes) bytes of ptr (can be ptr itself, if it could be
+	// resized in place) and frees ptr if it's not returned, or returns NULL and leaves ptr
+	// alone if it fails. newNumBytes is smaller than oldNumBytes when shrinking the array
+	// (da_shrink_to_fit()), so don't copy oldNumBytes bytes then!
+	// Only called with ptr != NULL, which was returned by this allocator
+	void* (*realloc)(void* ctx, void* ptr, size_t oldNumBytes, size_t newNumBytes);
+	// frees ptr, which has numBytes bytes (can be a no-op, e.g. for arenas)
+	void (*free)(void* ctx, void* ptr, size_t numBytes);
+	// optional (can be NULL): returns how many bytes the allocator would really reserve
+	// if numBytes were requested, the array capacity is increased accordingly
+	size_t (*good_size)(void* ctx, size_t numBytes);
+	void* ctx;
+} dg_dynarr_allocator;
+
+// returns the allocator used by dg_dynarr_init_vm(), or NULL if this platform
+// doesn't have it (then those arrays just use the default allocator)
+DG_DYNARR_DEF const dg_dynarr_allocator*
+dg_dynarr_vm_allocator(void);
+
 typedef struct {
 	size_t cnt; // logical number of elements
 	size_t cap; // cap & DG__DYNARR_SIZE_T_ALL_BUT_MSB is actual capacity (in elements, *not* bytes!)
@@ -642,11 +834,16 @@ typedef struct {
 		// that's handy to give an array a base-element storage on the stack, for example
 		// TODO: alternatively, we could introduce a flag field to this struct and use that,
 		//       so we don't have to calculate & everytime cap is needed
+	size_t alloc; // (size_t)dg_dynarr_allocator*, if not 0 it's used instead of DG_DYNARR_MALLOC etc
+		// alloc & DG__DYNARR_OOM_FLAG is set if growing the array failed, until dg_dynarr_oom_clear()
+		// (the allocator struct is at least pointer-aligned, so its address doesn't use that bit)
+		// use dg__dynarr_get_alloc() to get the allocator
 } dg__dynarr_md;
 
 // I used to have the following in an enum, but MSVC assumes enums are always 32bit ints
 static const size_t DG__DYNARR_SIZE_T_MSB = ((size_t)1) << (sizeof(size_t)*8 - 1);
 static const size_t DG__DYNARR_SIZE_T_ALL_BUT_MSB = (((size_t)1) << (sizeof(size_t)*8 - 1))-1;
+static const size_t DG__DYNARR_OOM_FLAG = 1;
 
 // "unpack" the elements of an array struct for use with helper functions
 // (to void** arr, dg__dynarr_md* md, size_t itemsize)
@@ -726,13 +923,13 @@ static const size_t DG__DYNARR_SIZE_T_ALL_BUT_MSB = (((size_t)1) << (sizeof(size
 // (instead of inline functions compiled into everything) should ensure that.
 
 DG_DYNARR_DEF void
-dg__dynarr_free(void** p, dg__dynarr_md* md);
+dg__dynarr_free(void** p, dg__dynarr_md* md, size_t itemsize);
 
 DG_DYNARR_DEF void
 dg__dynarr_shrink_to_fit(void** arr, dg__dynarr_md* md, size_t itemsize);
 
 // grow array to have enough space for at least min_needed elements
-// if it fails (OOM), the array will be deleted, a.p will be NULL, a.md.cap and a.md.cnt will be 0
+// if it fails (OOM), the array keeps its old memory and contents, the OOM flag is set
 // and the functions returns 0; else (on success) it returns 1
 DG_DYNARR_DEF int
 dg__dynarr_grow(void** arr, dg__dynarr_md* md, size_t itemsize, size_t min_needed);
@@ -742,14 +939,21 @@ dg__dynarr_grow(void** arr, dg__dynarr_md* md, size_t itemsize, size_t min_neede
 // and mosty implemented in functions so the macros don't get too ugly
 
 DG_DYNARR_INLINE void
-dg__dynarr_init(void** p, dg__dynarr_md* md, void* buf, size_t buf_cap)
+dg__dynarr_init(void** p, dg__dynarr_md* md, void* buf, size_t buf_cap, const dg_dynarr_allocator* alloc)
 {
 	*p = buf;
 	md->cnt = 0;
+	md->alloc = (size_t)alloc; // also clears the OOM flag
 	if(buf == NULL)  md->cap = 0;
 	else md->cap = (DG__DYNARR_SIZE_T_MSB | buf_cap);
 }
 
+DG_DYNARR_INLINE const dg_dynarr_allocator*
+dg__dynarr_get_alloc(const dg__dynarr_md* md)
+{
+	return (const dg_dynarr_allocator*)(md->alloc & ~DG__DYNARR_OOM_FLAG);
+}
+
 DG_DYNARR_INLINE int
 dg__dynarr_maybegrow(void** arr, dg__dynarr_md* md, size_t itemsize, size_t min_needed)
 {
@@ -802,6 +1006,21 @@ dg__dynarr_add(void** arr, dg__dynarr_md* md, size_t itemsize, size_t n, int ini
 	return 0;
 }
 
+DG_DYNARR_INLINE size_t
+dg__dynarr_atleast1(size_t n)
+{
+	return (n != 0) ? n : 1;
+}
+
+DG_DYNARR_INLINE void
+dg__dynarr_commit(dg__dynarr_md* md, size_t n)
+{
+	size_t avail = (md->cap & DG__DYNARR_SIZE_T_ALL_BUT_MSB) - md->cnt;
+	DG_DYNARR_ASSERT(n <= avail, "Can't commit more elements than there's space for, use dg_dynarr_append_reserve() first!");
+	// never let count exceed capacity, even if assertions are disabled
+	md->cnt += (n <= avail) ? n : avail;
+}
+
 DG_DYNARR_INLINE void
 dg__dynarr_delete(void** arr, dg__dynarr_md* md, size_t itemsize, size_t idx, size_t n)
 {
@@ -854,6 +1073,11 @@ dg__dynarr_deletefast(void** arr, dg__dynarr_md* md, size_t itemsize, size_t idx
 // you can #define DG_DYNARR_MALLOC, DG_DYNARR_REALLOC and DG_DYNARR_FREE
 // to provide alternative implementations like Win32 Heap(Re)Alloc/HeapFree
 // 
+// defining your own DG_DYNARR_GOOD_SIZE() means you want sizes to be rounded
+#if defined(DG_DYNARR_GOOD_SIZE) && !defined(DG_DYNARR_ROUND_TO_SIZE_CLASSES)
+	#define DG_DYNARR_ROUND_TO_SIZE_CLASSES
+#endif
+
 #ifndef DG_DYNARR_MALLOC
 	#define DG_DYNARR_MALLOC(elemSize, numElems)  malloc(elemSize*numElems)
 
@@ -863,6 +1087,56 @@ dg__dynarr_deletefast(void** arr, dg__dynarr_md* md, size_t itemsize, size_t idx
 		realloc(ptr, elemSize*newCapacity);
 
 	#define DG_DYNARR_FREE(ptr)  free(ptr)
+
+	#if !defined(DG_DYNARR_GOOD_SIZE) && defined(DG_DYNARR_ROUND_TO_SIZE_CLASSES)
+		#if defined(__APPLE__)
+			#include <malloc/malloc.h>
+			#define DG_DYNARR_GOOD_SIZE(numBytes)  malloc_good_size(numBytes)
+		#elif defined(__GLIBC__)
+			// glibc's malloc() adds a size_t for its chunk header, rounds that up to
+			// multiples of 16 and can use the header of the following chunk,
+			// so the rounded size minus one size_t is usable.
+			// That's only true for chunks from the heap: allocations from its (default)
+			// mmap threshold of 128KB on *may* get their own mmap()ed chunk, which has a
+			// different header and is rounded to pages, so those sizes are left alone
+			#define DG__DYNARR_GLIBC_MMAP_THRESHOLD  (128*1024)
+			#define DG_DYNARR_GOOD_SIZE(numBytes) \
+				(((numBytes) < DG__DYNARR_GLIBC_MMAP_THRESHOLD) \
+				  ? ((((numBytes) + sizeof(size_t) + 15) & ~(size_t)15) - sizeof(size_t)) \
+				  : (numBytes))
+		#else
+			// most allocators at least align (and thus round) sizes to 16 bytes
+			#define DG_DYNARR_GOOD_SIZE(numBytes)  (((numBytes) + 15) & ~(size_t)15)
+		#endif
+	#endif
+#endif
+
+// see the CONFIGURATION section at the top for the growth policy
+#if defined(DG_DYNARR_GROWTH_NUM) != defined(DG_DYNARR_GROWTH_DEN)
+	#error Define both DG_DYNARR_GROWTH_NUM and DG_DYNARR_GROWTH_DEN (or neither) !
+#elif !defined(DG_DYNARR_GROWTH_NUM)
+	#define DG_DYNARR_GROWTH_NUM  2
+	#define DG_DYNARR_GROWTH_DEN  1
+#endif
+
+#ifndef DG_DYNARR_MIN_CAPACITY
+	#define DG_DYNARR_MIN_CAPACITY  8
+#endif
+
+#ifndef DG_DYNARR_LINEAR_GROWTH_BYTES
+	#define DG_DYNARR_LINEAR_GROWTH_BYTES  0
+#endif
+
+#ifndef DG_DYNARR_HUGEPAGE_SIZE
+	#define DG_DYNARR_HUGEPAGE_SIZE  (2*1024*1024)
+#endif
+
+#ifndef DG_DYNARR_GOOD_SIZE
+	#define DG_DYNARR_GOOD_SIZE(numBytes)  (numBytes)
+#endif
+
+#ifndef DG_DYNARR_VM_RESERVE_BYTES
+	#define DG_DYNARR_VM_RESERVE_BYTES  ((size_t)1 << ((sizeof(void*) >= 8) ? 34 : 25))
 #endif
 
 // you can #define DG_DYNARR_OUT_OF_MEMORY to some code that will be executed
@@ -876,63 +1150,160 @@ dg__dynarr_deletefast(void** arr, dg__dynarr_md* md, size_t itemsize, size_t idx
 extern "C" {
 #endif
 
+// the following wrap DG_DYNARR_MALLOC etc, or the array's allocator if it has one
+
+static void*
+dg__dynarr_malloc(const dg__dynarr_md* md, size_t itemsize, size_t numElems)
+{
+	const dg_dynarr_allocator* alloc = dg__dynarr_get_alloc(md);
+	if(alloc != NULL)  return alloc->alloc(alloc->ctx, itemsize*numElems);
+	return DG_DYNARR_MALLOC(itemsize, numElems);
+}
+
+static void*
+dg__dynarr_realloc(const dg__dynarr_md* md, void* ptr, size_t itemsize, size_t newcap)
+{
+	const dg_dynarr_allocator* alloc = dg__dynarr_get_alloc(md);
+	if(alloc != NULL)
+	{
+		// the realloc() of the allocator gets the old capacity, not just the used part
+		size_t oldBytes = itemsize * (md->cap & DG__DYNARR_SIZE_T_ALL_BUT_MSB);
+		if(ptr == NULL)  return alloc->alloc(alloc->ctx, itemsize*newcap);
+		return alloc->realloc(alloc->ctx, ptr, oldBytes, itemsize*newcap);
+	}
+	return DG_DYNARR_REALLOC(ptr, itemsize, md->cnt, newcap);
+}
+
+static void
+dg__dynarr_freemem(const dg__dynarr_md* md, void* ptr, size_t itemsize)
+{
+	const dg_dynarr_allocator* alloc = dg__dynarr_get_alloc(md);
+	if(alloc != NULL)
+	{
+		if(ptr != NULL)
+			alloc->free(alloc->ctx, ptr, itemsize * (md->cap & DG__DYNARR_SIZE_T_ALL_BUT_MSB));
+	}
+	else
+	{
+		DG_DYNARR_FREE(ptr);
+	}
+}
+
 DG_DYNARR_DEF void
-dg__dynarr_free(void** p, dg__dynarr_md* md)
+dg__dynarr_free(void** p, dg__dynarr_md* md, size_t itemsize)
 {
 	// only free memory if it doesn't point to external memory
 	if(!(md->cap & DG__DYNARR_SIZE_T_MSB))
 	{
-		DG_DYNARR_FREE(*p);
+		dg__dynarr_freemem(md, *p, itemsize);
 		*p = NULL;
 		md->cap = 0;
 	}
 	md->cnt = 0;
+	md->alloc &= ~DG__DYNARR_OOM_FLAG;
 }
 
 
+// the new capacity for an array that has cap elements and needs at least
+// min_needed (<= maxcap) elements, according to the growth policy
+// (see DG_DYNARR_GROWTH_NUM etc in the CONFIGURATION section at the top)
+static size_t
+dg__dynarr_newcap(const dg__dynarr_md* md, size_t itemsize, size_t min_needed, size_t maxcap)
+{
+	size_t cap = md->cap & DG__DYNARR_SIZE_T_ALL_BUT_MSB;
+	size_t newcap, numBytes;
+	const dg_dynarr_allocator* alloc;
+
+#if DG_DYNARR_LINEAR_GROWTH_BYTES > 0
+	if(cap*itemsize >= (size_t)DG_DYNARR_LINEAR_GROWTH_BYTES)
+	{
+		newcap = cap + ((size_t)DG_DYNARR_LINEAR_GROWTH_BYTES + itemsize - 1) / itemsize;
+	}
+	else
+#endif
+	{
+		// cap * NUM / DEN, without overflowing in the multiplication
+		size_t num = DG_DYNARR_GROWTH_NUM, den = DG_DYNARR_GROWTH_DEN;
+		newcap = cap + (cap / den) * (num - den) + ((cap % den) * (num - den)) / den;
+	}
+	if(newcap < cap || newcap > maxcap)  newcap = maxcap; // overflow or too big
+	if(newcap < DG_DYNARR_MIN_CAPACITY)  newcap = DG_DYNARR_MIN_CAPACITY;
+	if(newcap < min_needed)  newcap = min_needed;
+	if(newcap > maxcap)  newcap = maxcap; // if DG_DYNARR_MIN_CAPACITY is too big
+
+	numBytes = newcap * itemsize;
+	alloc = dg__dynarr_get_alloc(md);
+	if(alloc != NULL)
+	{
+		// custom allocators know best how to round their sizes (if at all)
+		if(alloc->good_size != NULL)  numBytes = alloc->good_size(alloc->ctx, numBytes);
+	}
+#ifdef DG_DYNARR_ROUND_TO_SIZE_CLASSES
+	else
+	{
+		if(numBytes >= 16*(size_t)DG_DYNARR_HUGEPAGE_SIZE)
+		{
+			// DG_DYNARR_HUGEPAGE_SIZE must be a power of two.
+			// DG_DYNARR_GOOD_SIZE() isn't applied on top of this, it could add a
+			// few bytes and so break the multiple of DG_DYNARR_HUGEPAGE_SIZE
+			numBytes = (numBytes + DG_DYNARR_HUGEPAGE_SIZE - 1) & ~((size_t)DG_DYNARR_HUGEPAGE_SIZE - 1);
+		}
+		else numBytes = DG_DYNARR_GOOD_SIZE(numBytes);
+	}
+#endif // DG_DYNARR_ROUND_TO_SIZE_CLASSES
+
+	// use all the memory the allocator will give us anyway
+	// (if rounding overflowed, numBytes is smaller and that's just ignored)
+	if(numBytes / itemsize > newcap)
+	{
+		newcap = numBytes / itemsize;
+		if(newcap > maxcap)  newcap = maxcap;
+	}
+	return newcap;
+}
+
 DG_DYNARR_DEF int
 dg__dynarr_grow(void** arr, dg__dynarr_md* md, size_t itemsize, size_t min_needed)
 {
 	size_t cap = md->cap & DG__DYNARR_SIZE_T_ALL_BUT_MSB;
+	// make sure not to set DG__DYNARR_SIZE_T_MSB and that the size in bytes fits into a size_t
+	size_t maxcap = (DG__DYNARR_SIZE_T_MSB-1) / itemsize;
 
 	DG_DYNARR_ASSERT(min_needed > cap, "dg__dynarr_grow() should only be called if storage actually needs to grow!");
 
-	if(min_needed < DG__DYNARR_SIZE_T_MSB)
+	if(min_needed <= maxcap)
 	{
-		size_t newcap = (cap > 4) ? (2*cap) : 8; // allocate for at least 8 elements
-		// make sure not to set DG__DYNARR_SIZE_T_MSB (unlikely anyway)
-		if(newcap >= DG__DYNARR_SIZE_T_MSB)  newcap = DG__DYNARR_SIZE_T_MSB-1;
-		if(min_needed > newcap)  newcap = min_needed;
+		size_t newcap = dg__dynarr_newcap(md, itemsize, min_needed, maxcap);
 
+		void* p;
 		// the memory was allocated externally, don't free it, just copy contents
 		if(md->cap & DG__DYNARR_SIZE_T_MSB)
 		{
-			void* p = DG_DYNARR_MALLOC(itemsize, newcap);
+			p = dg__dynarr_malloc(md, itemsize, newcap);
 			if(p != NULL)  memcpy(p, *arr, itemsize*md->cnt);
-			*arr = p;
 		}
 		else
 		{
-			void* p = DG_DYNARR_REALLOC(*arr, itemsize, md->cnt, newcap);
-			if(p == NULL)  DG_DYNARR_FREE(*arr); // realloc failed, at least don't leak memory
-			*arr = p;
+			p = dg__dynarr_realloc(md, *arr, itemsize, newcap);
 		}
 
-		// TODO: handle OOM by setting highest bit of count and keeping old data?
-
-		if(*arr)  md->cap = newcap;
-		else
+		if(p != NULL)
 		{
-			md->cap = 0;
-			md->cnt = 0;
-			
-			DG_DYNARR_OUT_OF_MEMORY ;
-			
-			return 0;
+			*arr = p;
+			md->cap = newcap;
+			return 1;
 		}
-		return 1;
+
+		// realloc() leaves the old memory alone if it fails, so just keep using it
+		// (and the capacity and count) - the caller can free some memory and retry
+		md->alloc |= DG__DYNARR_OOM_FLAG;
+
+		DG_DYNARR_OUT_OF_MEMORY ;
+
+		return 0;
 	}
-	DG_DYNARR_ASSERT(min_needed < DG__DYNARR_SIZE_T_MSB, "Arrays must stay below SIZE_T_MAX/2 elements!");
+	DG_DYNARR_ASSERT(min_needed <= maxcap, "Arrays must stay below SIZE_T_MAX/2 bytes!");
+	md->alloc |= DG__DYNARR_OOM_FLAG;
 	return 0;
 }
 
@@ -943,15 +1314,27 @@ dg__dynarr_shrink_to_fit(void** arr, dg__dynarr_md* md, size_t itemsize)
 	if(!(md->cap & DG__DYNARR_SIZE_T_MSB))
 	{
 		size_t cnt = md->cnt;
-		if(cnt == 0)  dg__dynarr_free(arr, md);
+		const dg_dynarr_allocator* alloc = dg__dynarr_get_alloc(md);
+		if(cnt == 0)  dg__dynarr_free(arr, md, itemsize);
+		else if(alloc != NULL && (md->cap & DG__DYNARR_SIZE_T_ALL_BUT_MSB) > cnt)
+		{
+			// custom allocators can shrink in place (dg_dynarr_vm_allocator() releases the
+			// pages at the end, an arena can shrink its last allocation), so use realloc
+			void* p = alloc->realloc(alloc->ctx, *arr, itemsize*md->cap, itemsize*cnt);
+			if(p != NULL)
+			{
+				md->cap = cnt;
+				*arr = p;
+			}
+		}
 		else if((md->cap & DG__DYNARR_SIZE_T_ALL_BUT_MSB) > cnt)
 		{
-			void* p = DG_DYNARR_MALLOC(itemsize, cnt);
+			void* p = dg__dynarr_malloc(md, itemsize, cnt);
 			if(p != NULL)
 			{
 				memcpy(p, *arr, cnt*itemsize);
+				dg__dynarr_freemem(md, *arr, itemsize); // needs the old md->cap
 				md->cap = cnt;
-				DG_DYNARR_FREE(*arr);
 				*arr = p;
 			}
 		}
@@ -962,4 +1345,300 @@ dg__dynarr_shrink_to_fit(void** arr, dg__dynarr_md* md, size_t itemsize)
 } // extern "C"
 #endif
 
+// ########## dg_dynarr_vm_allocator() ##########
+
+#if defined(_WIN32)
+	// only VirtualAlloc() and VirtualFree() are needed, so don't pull in all of
+	// windows.h (and its min() and max() macros) if the user didn't already
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+		#define DG__DYNARR_DEFINED_WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+		#define DG__DYNARR_DEFINED_NOMINMAX
+	#endif
+	#include <windows.h>
+	#ifdef DG__DYNARR_DEFINED_WIN32_LEAN_AND_MEAN
+		#undef WIN32_LEAN_AND_MEAN
+		#undef DG__DYNARR_DEFINED_WIN32_LEAN_AND_MEAN
+	#endif
+	#ifdef DG__DYNARR_DEFINED_NOMINMAX
+		#undef NOMINMAX
+		#undef DG__DYNARR_DEFINED_NOMINMAX
+	#endif
+	#define DG__DYNARR_HAVE_VM
+#elif defined(__unix__) || defined(__unix) || defined(__APPLE__)
+	#include <sys/mman.h>
+	#include <unistd.h>
+	#if defined(MAP_ANONYMOUS)
+		#define DG__DYNARR_MAP_ANONYMOUS  MAP_ANONYMOUS
+	#elif defined(MAP_ANON) // older BSDs and macOS
+		#define DG__DYNARR_MAP_ANONYMOUS  MAP_ANON
+	#endif
+	#ifdef DG__DYNARR_MAP_ANONYMOUS
+		#define DG__DYNARR_HAVE_VM
+	#endif
+	// mremap() is only declared with _GNU_SOURCE
+	#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+		#define DG__DYNARR_VM_MREMAP
+	#endif
+#endif
+
+#ifdef DG__DYNARR_HAVE_VM
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static size_t
+dg__dynarr_vm_pagesize(void)
+{
+	// not cached in a static: that would be a data race if several threads create
+	// their first VM arrays at the same time, and this is cheap compared to mmap() etc
+#ifdef _WIN32
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	return sysInfo.dwPageSize;
+#else
+	long ps = sysconf(_SC_PAGESIZE);
+	return (ps > 0) ? (size_t)ps : 4096;
+#endif
+}
+
+// rounds numBytes up to a multiple of to (which must be a power of two)
+static size_t
+dg__dynarr_vm_round(size_t numBytes, size_t to)
+{
+	return (numBytes + to - 1) & ~(to - 1);
+}
+
+#ifdef DG__DYNARR_VM_MREMAP
+
+// On Linux, mremap() can grow (and shrink) a mapping without copying anything:
+// if it can't be extended in place, its pages are just mapped to another address.
+
+static void
+dg__dynarr_vm_advise(void* p, size_t size)
+{
+#if defined(MADV_HUGEPAGE) && !defined(DG_DYNARR_VM_NO_HUGEPAGES)
+	if(size >= (size_t)DG_DYNARR_HUGEPAGE_SIZE)  madvise(p, size, MADV_HUGEPAGE);
+#else
+	(void)p; (void)size;
+#endif
+}
+
+static void*
+dg__dynarr_vm_alloc(void* ctx, size_t numBytes)
+{
+	size_t size = dg__dynarr_vm_round(numBytes, dg__dynarr_vm_pagesize());
+	void* p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | DG__DYNARR_MAP_ANONYMOUS, -1, 0);
+	(void)ctx;
+	if(p == MAP_FAILED)  return NULL;
+	dg__dynarr_vm_advise(p, size);
+	return p;
+}
+
+static void*
+dg__dynarr_vm_realloc(void* ctx, void* ptr, size_t oldNumBytes, size_t newNumBytes)
+{
+	size_t oldSize = dg__dynarr_vm_round(oldNumBytes, dg__dynarr_vm_pagesize());
+	size_t newSize = dg__dynarr_vm_round(newNumBytes, dg__dynarr_vm_pagesize());
+	void* p;
+	(void)ctx;
+	if(newSize == oldSize)  return ptr;
+	// when shrinking, this releases the pages at the end (like MADV_DONTNEED, but they're unmapped)
+	p = mremap(ptr, oldSize, newSize, MREMAP_MAYMOVE);
+	if(p == MAP_FAILED)  return NULL;
+	if(newSize > oldSize)  dg__dynarr_vm_advise(p, newSize);
+	return p;
+}
+
+static void
+dg__dynarr_vm_free(void* ctx, void* ptr, size_t numBytes)
+{
+	(void)ctx;
+	munmap(ptr, dg__dynarr_vm_round(numBytes, dg__dynarr_vm_pagesize()));
+}
+
+static size_t
+dg__dynarr_vm_good_size(void* ctx, size_t numBytes)
+{
+	(void)ctx;
+	// whole pages are mapped anyway, and big arrays get whole huge pages
+	if(numBytes >= 16*(size_t)DG_DYNARR_HUGEPAGE_SIZE)
+		return dg__dynarr_vm_round(numBytes, DG_DYNARR_HUGEPAGE_SIZE);
+	return dg__dynarr_vm_round(numBytes, dg__dynarr_vm_pagesize());
+}
+
+#else // no mremap()
+
+// Elsewhere, address space for (at least) DG_DYNARR_VM_RESERVE_BYTES is reserved up front
+// and pages are only committed when the array grows into them, so growing doesn't copy
+// until the reservation is exhausted (then a new one twice as big is made).
+// The first bytes of the reservation store its size, the array starts behind them.
+#define DG__DYNARR_VM_HEADER  64
+
+// reserves address space, but no memory
+static unsigned char*
+dg__dynarr_vm_reserve(size_t size)
+{
+#ifdef _WIN32
+	return (unsigned char*)VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+	int flags = MAP_PRIVATE | DG__DYNARR_MAP_ANONYMOUS;
+  #ifdef MAP_NORESERVE
+	flags |= MAP_NORESERVE;
+  #endif
+	void* p = mmap(NULL, size, PROT_NONE, flags, -1, 0);
+	return (p == MAP_FAILED) ? NULL : (unsigned char*)p;
+#endif
+}
+
+// makes the reserved pages in [p, p+size) usable, returns 0 on failure
+static int
+dg__dynarr_vm_commit(unsigned char* p, size_t size)
+{
+#ifdef _WIN32
+	return VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+	return mprotect(p, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+// gives the memory of the pages in [p, p+size) back to the OS, but keeps them reserved
+static void
+dg__dynarr_vm_decommit(unsigned char* p, size_t size)
+{
+#ifdef _WIN32
+	VirtualFree(p, size, MEM_DECOMMIT);
+#else
+  #ifdef MADV_DONTNEED
+	madvise(p, size, MADV_DONTNEED);
+  #endif
+	mprotect(p, size, PROT_NONE);
+#endif
+}
+
+// releases the whole reservation of size bytes at base
+static void
+dg__dynarr_vm_release(unsigned char* base, size_t size)
+{
+#ifdef _WIN32
+	(void)size;
+	VirtualFree(base, 0, MEM_RELEASE);
+#else
+	munmap(base, size);
+#endif
+}
+
+static void*
+dg__dynarr_vm_alloc_reserve(size_t numBytes, size_t minReserve)
+{
+	size_t pageSize = dg__dynarr_vm_pagesize();
+	size_t used = dg__dynarr_vm_round(DG__DYNARR_VM_HEADER + numBytes, pageSize);
+	size_t reserve = dg__dynarr_vm_round(minReserve, pageSize);
+	unsigned char* base;
+	if(reserve < used)  reserve = used;
+	base = dg__dynarr_vm_reserve(reserve);
+	if(base == NULL)  return NULL;
+	if(!dg__dynarr_vm_commit(base, used))
+	{
+		dg__dynarr_vm_release(base, reserve);
+		return NULL;
+	}
+	*(size_t*)base = reserve;
+	return base + DG__DYNARR_VM_HEADER;
+}
+
+static void*
+dg__dynarr_vm_alloc(void* ctx, size_t numBytes)
+{
+	(void)ctx;
+	return dg__dynarr_vm_alloc_reserve(numBytes, DG_DYNARR_VM_RESERVE_BYTES);
+}
+
+static void*
+dg__dynarr_vm_realloc(void* ctx, void* ptr, size_t oldNumBytes, size_t newNumBytes)
+{
+	size_t pageSize = dg__dynarr_vm_pagesize();
+	unsigned char* base = (unsigned char*)ptr - DG__DYNARR_VM_HEADER;
+	size_t reserve = *(size_t*)base;
+	size_t oldUsed = dg__dynarr_vm_round(DG__DYNARR_VM_HEADER + oldNumBytes, pageSize);
+	size_t newUsed = dg__dynarr_vm_round(DG__DYNARR_VM_HEADER + newNumBytes, pageSize);
+	void* ret;
+	(void)ctx;
+
+	if(newUsed <= reserve)
+	{
+		if(newUsed > oldUsed)
+		{
+			if(!dg__dynarr_vm_commit(base + oldUsed, newUsed - oldUsed))  return NULL;
+		}
+		else if(newUsed < oldUsed)
+		{
+			dg__dynarr_vm_decommit(base + newUsed, oldUsed - newUsed);
+		}
+		return ptr;
+	}
+
+	// the reservation is exhausted, move to a new one that's twice as big
+	ret = dg__dynarr_vm_alloc_reserve(newNumBytes, (reserve < DG__DYNARR_SIZE_T_MSB) ? 2*reserve : reserve);
+	if(ret != NULL)
+	{
+		memcpy(ret, ptr, oldNumBytes);
+		dg__dynarr_vm_release(base, reserve);
+	}
+	return ret;
+}
+
+static void
+dg__dynarr_vm_free(void* ctx, void* ptr, size_t numBytes)
+{
+	unsigned char* base = (unsigned char*)ptr - DG__DYNARR_VM_HEADER;
+	(void)ctx; (void)numBytes;
+	dg__dynarr_vm_release(base, *(size_t*)base);
+}
+
+static size_t
+dg__dynarr_vm_good_size(void* ctx, size_t numBytes)
+{
+	(void)ctx;
+	// the committed pages can be used completely
+	return dg__dynarr_vm_round(DG__DYNARR_VM_HEADER + numBytes, dg__dynarr_vm_pagesize()) - DG__DYNARR_VM_HEADER;
+}
+
+#endif // DG__DYNARR_VM_MREMAP
+
+DG_DYNARR_DEF const dg_dynarr_allocator*
+dg_dynarr_vm_allocator(void)
+{
+	static const dg_dynarr_allocator vmAllocator = {
+		dg__dynarr_vm_alloc, dg__dynarr_vm_realloc, dg__dynarr_vm_free, dg__dynarr_vm_good_size, NULL
+	};
+	return &vmAllocator;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#else // DG__DYNARR_HAVE_VM
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+DG_DYNARR_DEF const dg_dynarr_allocator*
+dg_dynarr_vm_allocator(void)
+{
+	return NULL; // no mmap() or VirtualAlloc() => arrays use the default allocator
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // DG__DYNARR_HAVE_VM
+
 #endif // DG_DYNARR_IMPLEMENTATION
@@ -20,6 +20,15 @@
  * function signatures (like "static", "inline", "__declspec(dllexport)", ...)
  * Example: #define DG_MISC_DEF static inline
  *
+ * On x86/x86_64 some functions use SSE2 (and AVX2, if the compiler is told to
+ * generate it). #define DG_MISC_NO_SIMD to only use plain C code, or
+ * #define DG_MISC_RUNTIME_DISPATCH to let them check at runtime if the CPU
+ * supports AVX2 (so binaries built for baseline x86_64 can still use it).
+ * #define DG_MISC_STRLEN_SIMD to also use SSE2/AVX2 for DG_strnlen() and DG_strlen()
+ * (when they don't just call the libc versions). That's faster for longer strings,
+ * but reads whole aligned 16/32 byte blocks, so it can read a bit behind the end
+ * of the string (never crossing a page boundary, so that's safe in practice).
+ *
  * Supported Microsoft Visual C++ Versions:
  *  Tested MSVC 2013 and 2010 (it just works for them), and MSVC 6.0, which works
  *  with little changes: you need to "typedef unsigned int uintptr_t;" before
@@ -73,6 +82,28 @@ DG_MISC_DEF const char* DG_GetExecutableDir(void);
 // returns empty string on error
 DG_MISC_DEF const char* DG_GetExecutableFilename(void);
 
+// NOTE: the path is determined only once, at the first call of any of the
+//   DG_GetExecutable*() functions (with a single syscall), later calls just return
+//   the stored strings. That's thread-safe, even if the first calls happen concurrently.
+//   This also means that if determining the path fails, it's not retried: all later
+//   calls return empty strings as well (retrying could change the strings while other
+//   threads use them).
+
+// the path of the executable and its parts, for DG_GetExecutableInfo()
+typedef struct DG_ExecutableInfo {
+	const char* path;     // same as DG_GetExecutablePath()
+	const char* dir;      // same as DG_GetExecutableDir()
+	const char* filename; // same as DG_GetExecutableFilename()
+	size_t pathLen;       // the lengths of those strings
+	size_t dirLen;
+	size_t filenameLen;
+} DG_ExecutableInfo;
+
+// fills info with the path, directory and filename of your executable (and their lengths),
+// so you don't need three calls and strlen()s. the strings stay valid until the program ends.
+// returns 1 on success, 0 on error (then all strings are empty)
+DG_MISC_DEF int DG_GetExecutableInfo(DG_ExecutableInfo* info);
+
 // copy up to n chars of str into a new string which is guaranteed to be
 // '\0'-terminated.
 // Needs to be free'd with free(), returns NULL if allocation failed
@@ -116,11 +147,163 @@ DG_MISC_DEF void* DG_memrchr(const void* buf, unsigned char c, size_t buflen);
 // returns the address of the last match, or NULL if it wasn't found
 DG_MISC_DEF char* DG_strrstr(const char* haystack, const char* needle);
 
+// like DG_memmem(), but ASCII letters are compared case-insensitively ('a' matches 'A').
+// this doesn't depend on the locale, all bytes >= 128 must match exactly
+// returns the address of the first match, or NULL if it wasn't found
+DG_MISC_DEF void* DG_memimem(const void* haystack, size_t haystacklen,
+                             const void* needle, size_t needlelen);
+
+// like DG_memrmem(), but ASCII letters are compared case-insensitively, like in DG_memimem()
+// returns the address of the last match, or NULL if it wasn't found
+DG_MISC_DEF void* DG_memrimem(const void* haystack, size_t haystacklen,
+                              const void* needle, size_t needlelen);
+
+// like strstr(), but ASCII letters are compared case-insensitively (like DG_memimem()).
+// unlike the strcasestr() some libcs have, this is portable and doesn't depend on the locale
+// returns the address of the first match, or NULL if it wasn't found
+DG_MISC_DEF char* DG_strcasestr(const char* haystack, const char* needle);
+
+// like DG_strrstr(), but ASCII letters are compared case-insensitively (like DG_memimem())
+// returns the address of the last match, or NULL if it wasn't found
+DG_MISC_DEF char* DG_strrcasestr(const char* haystack, const char* needle);
+
+// compares up to n chars of s1 and s2 case-insensitively, stops at the first '\0'.
+// like strncasecmp() (or _strnicmp() on Windows) in the "C" locale, i.e. only ASCII
+// letters are folded. returns a value < 0, 0 or > 0 if s1 is less than, equal to or
+// greater than s2 (comparing the lowercase chars as unsigned char)
+DG_MISC_DEF int DG_strncasecmp(const char* s1, const char* s2, size_t n);
+
+// a set of needles compiled for searching all of them at once with DG_memmem_multi()
+// (an Aho-Corasick automaton), so the haystack only needs to be scanned once
+typedef struct DG_MultiNeedle DG_MultiNeedle;
+
+// create a DG_MultiNeedle from numNeedles needles; needles[i] has length needleLens[i],
+// which must not be 0. i is the ID of that needle in the results of DG_memmem_multi*().
+// like with DG_memmem(), the needles are compared as binary data (unsigned char),
+// they don't need to be '\0'-terminated. they can be free'd after this returns.
+// returns NULL if allocation failed, free with DG_MultiNeedle_Free()
+DG_MISC_DEF DG_MultiNeedle* DG_MultiNeedle_Create(const char* const* needles,
+                                                  const size_t* needleLens, size_t numNeedles);
+
+DG_MISC_DEF void DG_MultiNeedle_Free(DG_MultiNeedle* mn);
+
+// search for the first occurence of any of the needles in mn in haystack.
+// returns the address of the match that starts first (if several needles start at
+// that address, the one with the lowest ID wins) or NULL if none was found.
+// if matchedNeedle is not NULL, the ID of the needle is written to it.
+DG_MISC_DEF void* DG_memmem_multi(const void* haystack, size_t haystacklen,
+                                  const DG_MultiNeedle* mn, size_t* matchedNeedle);
+
+// called by DG_memmem_multi_all() for each match of needle needleID at haystack+offset.
+// return 0 to stop the search, anything else to continue.
+typedef int (*DG_MultiNeedle_MatchFn)(void* userData, size_t needleID, size_t offset);
+
+// find all (also overlapping) occurences of all needles in mn in haystack
+// and call onMatch for each of them, in the order of the positions they *end* at
+// (for matches ending at the same position, longer needles first).
+// returns the number of matches passed to onMatch
+DG_MISC_DEF size_t DG_memmem_multi_all(const void* haystack, size_t haystacklen,
+                                       const DG_MultiNeedle* mn,
+                                       DG_MultiNeedle_MatchFn onMatch, void* userData);
+
+// for searching a needle in data that arrives in chunks (e.g. read from a file or socket)
+// with DG_MemmemStream_Feed(). Matches that span several chunks are found as well,
+// for that only the last needlelen-1 bytes are kept - the chunks aren't copied.
+typedef struct DG_MemmemStream DG_MemmemStream;
+
+// called by DG_MemmemStream_Feed() for each match, offset is relative to the start
+// of the stream (the first byte passed to DG_MemmemStream_Feed() after creating or
+// resetting it). return 0 to stop searching, anything else to continue.
+typedef int (*DG_MemmemStream_MatchFn)(void* userData, unsigned long long offset);
+
+// create a DG_MemmemStream that searches for needle (which is copied).
+// needlelen must not be 0. returns NULL if allocation failed, free with DG_MemmemStream_Free()
+DG_MISC_DEF DG_MemmemStream* DG_MemmemStream_Create(const void* needle, size_t needlelen);
+
+// search the next chunk of the stream and call onMatch for each (also overlapping) match,
+// in order. returns the number of matches passed to onMatch.
+// once onMatch returned 0, this doesn't search anymore until DG_MemmemStream_Reset()
+DG_MISC_DEF size_t DG_MemmemStream_Feed(DG_MemmemStream* ms, const void* chunk, size_t chunklen,
+                                        DG_MemmemStream_MatchFn onMatch, void* userData);
+
+// start over with a new stream (for the same needle), offsets start at 0 again
+DG_MISC_DEF void DG_MemmemStream_Reset(DG_MemmemStream* ms);
+
+DG_MISC_DEF void DG_MemmemStream_Free(DG_MemmemStream* ms);
+
+// search for needle in the file at path, without reading it into a buffer: it's mapped
+// into memory (in windows of up to 1GB, 64MB on 32bit) that are searched with DG_memmem().
+// returns 1 if the needle was found and sets *offset to the offset of the first match
+// in the file, returns 0 if it wasn't found, or -1 on error (couldn't open or map the file)
+DG_MISC_DEF int DG_FileFind(const char* path, const void* needle, size_t needlelen,
+                            unsigned long long* offset);
+
+// like DG_FileFind(), but sets *offset to the last match, using DG_memrmem().
+// starts at the end of the file with small windows, so finding something (like a trailer)
+// close to the end of a huge file only needs to read a small part of it
+DG_MISC_DEF int DG_FileFindLast(const char* path, const void* needle, size_t needlelen,
+                                unsigned long long* offset);
+
+// for DG_memmem_parallel_jobs(): a function that must be called numJobs times
+typedef void (*DG_MemmemJobFn)(void* jobData);
+// for DG_memmem_parallel_jobs(): runs job(jobData) numJobs times in parallel (e.g. in your
+// thread pool) and only returns when all of them are done. the jobs take their work
+// from a shared queue, so it's fine if some of the calls only happen after others are done
+typedef void (*DG_MemmemRunJobsFn)(void* userData, DG_MemmemJobFn job, void* jobData, int numJobs);
+
+// like DG_memmem(), but for huge haystacks: splits the haystack into segments that
+// are searched in parallel by numJobs jobs run with runJobs(userData, ...).
+// once a match is found, segments behind it aren't searched anymore.
+// returns the address of the first match or NULL, like DG_memmem()
+DG_MISC_DEF void* DG_memmem_parallel_jobs(const void* haystack, size_t haystacklen,
+                                          const void* needle, size_t needlelen,
+                                          DG_MemmemRunJobsFn runJobs, void* userData, int numJobs);
+
+#ifdef DG_MISC_WITH_THREADS
+// like DG_memmem_parallel_jobs(), but creates numThreads-1 threads to run the jobs on
+// (and uses the calling thread). if numThreads <= 0, the number of CPUs is used.
+// only available if DG_MISC_WITH_THREADS is #defined (needs pthreads on non-Windows)
+DG_MISC_DEF void* DG_memmem_parallel(const void* haystack, size_t haystacklen,
+                                     const void* needle, size_t needlelen, int numThreads);
+#endif
+
 // like strtok, but threadsafe - saves the context in context.
 // so do char* ctx; foo = DG_strtok_r(bar, " \t", &ctx);
 // See http://linux.die.net/man/3/strtok_r for more details
 DG_MISC_DEF char* DG_strtok_r(char* str, const char* delim, char** context);
 
+// splits a string into tokens separated by delimiter chars, like DG_strtok_r(), but
+// doesn't modify the string (so it also works on read-only data like memory-mapped files)
+// and the string doesn't need to be '\0'-terminated. Tokens are returned as pointer+length:
+//   DG_StrSplitIter it;
+//   const char* tok;
+//   size_t tokLen;
+//   DG_StrSplitIter_Init(&it, str, strLen, " \t\n", 0);
+//   while(DG_StrSplitIter_Next(&it, &tok, &tokLen)) { ... }
+// the members are internal, only use the DG_StrSplitIter_* functions
+typedef struct DG_StrSplitIter {
+	const char* cur; // where the next token starts (or its leading delimiters), NULL when done
+	const char* end; // end of the string
+	unsigned int delimSet[8]; // bit (c%32) of delimSet[c/32] is set if c is a delimiter
+	unsigned char delims[8]; // the delimiters for the SIMD scan (if numDelims <= 8)
+	int numDelims; // number of different delimiters
+	int flags;
+} DG_StrSplitIter;
+
+// flag for DG_StrSplitIter_Init(): by default, consecutive delimiters (and ones at the
+// start or end of the string) are skipped like in strtok(). With this flag, each delimiter
+// ends a token, so there are empty tokens between them, like with strsep()
+#define DG_STRSPLIT_KEEP_EMPTY 1
+
+// initializes it for splitting the len chars at str (which must stay valid while it is used)
+// at any of the chars in the '\0'-terminated string delims. flags: 0 or DG_STRSPLIT_KEEP_EMPTY
+DG_MISC_DEF void DG_StrSplitIter_Init(DG_StrSplitIter* it, const char* str, size_t len,
+                                      const char* delims, int flags);
+
+// gets the next token: sets *token to its start in the string and *tokenLen to its length.
+// returns 1 if there was another token, 0 if the end of the string has been reached
+DG_MISC_DEF int DG_StrSplitIter_Next(DG_StrSplitIter* it, const char** token, size_t* tokenLen);
+
 // on many platforms (incl. windows and freebsd) this implementation is faster
 // than the libc's strnlen(). on others (linux/glibc, OSX) it just calls the
 // ASM-optimized strnlen() provided by the libc.
@@ -186,6 +369,257 @@ DG_MISC_DEF size_t DG_strlen(const char* s);
 
 #endif // _WIN32 and either not Visual Studio or a version < 2015
 
+// a growable '\0'-terminated string that keeps track of its length, so appending to it
+// is fast (unlike with DG_strlcat(), which has to find the end of dst on every call).
+// All DG_StrBuf_Append*() functions return 1 on success, or 0 if allocation failed
+// (in that case the string is unchanged).
+//   DG_StrBuf sb;
+//   char stackBuf[256];
+//   DG_StrBuf_InitExternal(&sb, stackBuf, sizeof(stackBuf)); // or DG_StrBuf_Init(&sb);
+//   DG_StrBuf_Append(&sb, "Hello ");
+//   DG_StrBuf_AppendF(&sb, "%d World%c", 42, '!');
+//   puts(sb.str);
+//   DG_StrBuf_Free(&sb);
+typedef struct DG_StrBuf {
+	char* str;   // the string; NULL after DG_StrBuf_Init() until something is appended
+	size_t len;  // length of str (without terminating '\0')
+	size_t cap;  // size of the buffer str points to
+	int external; // str points to the buffer passed to DG_StrBuf_InitExternal(), don't free it
+} DG_StrBuf;
+
+// initializes sb as empty string, memory will be allocated when needed
+DG_MISC_DEF void DG_StrBuf_Init(DG_StrBuf* sb);
+
+// like DG_StrBuf_Init(), but buf (e.g. an array on the stack) is used as long as it's big enough.
+// when more space is needed, the contents are copied to heap memory. buf isn't freed.
+DG_MISC_DEF void DG_StrBuf_InitExternal(DG_StrBuf* sb, char* buf, size_t bufSize);
+
+// frees the memory (unless it's the external buffer) and makes sb an empty string again
+DG_MISC_DEF void DG_StrBuf_Free(DG_StrBuf* sb);
+
+// sets the length to 0, but keeps the memory for reuse
+DG_MISC_DEF void DG_StrBuf_Clear(DG_StrBuf* sb);
+
+// makes sure that at least extraLen more chars (+ terminating '\0') fit into sb without
+// allocating. returns 1 on success, 0 if allocation failed
+DG_MISC_DEF int DG_StrBuf_Reserve(DG_StrBuf* sb, size_t extraLen);
+
+// appends the '\0'-terminated string str
+DG_MISC_DEF int DG_StrBuf_Append(DG_StrBuf* sb, const char* str);
+
+// appends the first len chars of str (which must not contain '\0' in them)
+DG_MISC_DEF int DG_StrBuf_AppendN(DG_StrBuf* sb, const char* str, size_t len);
+
+DG_MISC_DEF int DG_StrBuf_AppendChar(DG_StrBuf* sb, char c);
+
+// appends the printf()-style formatted string, formatted directly into sb's memory.
+// returns 1 on success, 0 if allocation failed or there was an encoding error
+#if defined(__GNUC__)
+DG_MISC_DEF int DG_StrBuf_AppendF(DG_StrBuf* sb, const char* format, ...) __attribute__ ((format (printf, 2, 3)));
+#else
+DG_MISC_DEF int DG_StrBuf_AppendF(DG_StrBuf* sb, const char* format, ...);
+#endif
+
+#ifdef va_start // it's a macro and defined if the user #included stdarg.h
+// like DG_StrBuf_AppendF(), but with a va_list
+DG_MISC_DEF int DG_StrBuf_AppendVF(DG_StrBuf* sb, const char* format, va_list ap);
+#endif // va_start
+
+// returns the string as a buffer that must be free()d by the caller (a copy, if it's the
+// external buffer) and makes sb an empty string again. if len is not NULL, the length
+// is written to it. returns NULL if allocation failed (then sb is unchanged)
+DG_MISC_DEF char* DG_StrBuf_Detach(DG_StrBuf* sb, size_t* len);
+
+// a pool of unique ("interned") strings: interning equal strings always returns the
+// same pointer (and the same 32-bit ID), so they're only stored once and can be
+// compared with == instead of strcmp().
+// The strings are stored in big blocks that never move, so the returned pointers
+// stay valid until DG_StrPool_Free(). IDs are assigned in the order the strings were
+// first interned, starting at 0, so they can be used as indices in your own arrays.
+// All DG_StrPool_Intern*() functions return NULL (or DG_STRPOOL_INVALID_ID) if
+// allocation failed (then the pool is unchanged).
+//   DG_StrPool pool;
+//   DG_StrPool_Init(&pool);
+//   const char* a = DG_StrPool_Intern(&pool, "foo");
+//   const char* b = DG_StrPool_InternN(&pool, "foobar", 3);
+//   // now a == b
+//   unsigned int id = DG_StrPool_GetID(&pool, a); // 0, DG_StrPool_Get(&pool, id) == a
+//   DG_StrPool_Free(&pool);
+typedef struct DG_StrPool {
+	struct DG__StrPoolBlock* blocks;  // the memory the strings are stored in (linked list)
+	char* blockPos;                   // where the next string is stored in the newest block
+	size_t blockRest;                 // free bytes at blockPos
+	struct DG__StrPoolEntry* entries; // entries[id] is the string with that ID
+	unsigned int* index;     // hash table (open addressing) with ID+1 of the strings, 0 = unused
+	unsigned int numStrings; // number of interned strings, their IDs are 0 .. numStrings-1
+	unsigned int entriesCap; // number of elements entries has space for
+	unsigned int indexSize;  // number of slots in index, a power of two (or 0)
+} DG_StrPool;
+
+// returned by DG_StrPool_InternID() if allocation failed, or DG_StrPool_Find()
+// if the string isn't in the pool
+#define DG_STRPOOL_INVALID_ID 0xFFFFFFFFu
+
+// initializes pool as empty pool, memory will be allocated when needed
+DG_MISC_DEF void DG_StrPool_Init(DG_StrPool* pool);
+
+// frees all memory of the pool (so all its strings become invalid) and makes it empty again
+DG_MISC_DEF void DG_StrPool_Free(DG_StrPool* pool);
+
+// returns the interned copy of the '\0'-terminated string str, adds it to the pool
+// if it's not in there yet. returns NULL if allocation failed
+DG_MISC_DEF const char* DG_StrPool_Intern(DG_StrPool* pool, const char* str);
+
+// like DG_StrPool_Intern(), but for the first len chars of str (which doesn't need to be
+// '\0'-terminated, and may even contain '\0'); the interned copy is '\0'-terminated
+DG_MISC_DEF const char* DG_StrPool_InternN(DG_StrPool* pool, const char* str, size_t len);
+
+// like DG_StrPool_InternN(), but returns the ID of the interned string
+// (or DG_STRPOOL_INVALID_ID if allocation failed)
+DG_MISC_DEF unsigned int DG_StrPool_InternID(DG_StrPool* pool, const char* str, size_t len);
+
+// returns the ID of the first len chars of str if they're in the pool, else
+// DG_STRPOOL_INVALID_ID. doesn't add anything to the pool
+DG_MISC_DEF unsigned int DG_StrPool_Find(const DG_StrPool* pool, const char* str, size_t len);
+
+// returns the interned string with the given ID (which must be valid)
+DG_MISC_DEF const char* DG_StrPool_Get(const DG_StrPool* pool, unsigned int id);
+
+// returns the length of the interned string with the given ID (which must be valid)
+DG_MISC_DEF size_t DG_StrPool_Len(const DG_StrPool* pool, unsigned int id);
+
+// returns the ID of interned, which must have been returned by DG_StrPool_Intern*()
+// or DG_StrPool_Get() of the same pool. doesn't need to hash or compare anything
+DG_MISC_DEF unsigned int DG_StrPool_GetID(const DG_StrPool* pool, const char* interned);
+
+// fast number to string conversion, much faster than DG_snprintf() and independent
+// of the locale (the decimal point is always '.')
+
+// the minimum size of the buffer passed to DG_u64toa() and DG_i64toa()
+#define DG_I64TOA_BUFSIZE 21
+
+// writes the decimal representation of v and a terminating '\0' to buf, which must
+// be at least DG_I64TOA_BUFSIZE bytes big. returns the length (without '\0')
+DG_MISC_DEF size_t DG_u64toa(char* buf, unsigned long long v);
+
+// like DG_u64toa(), but signed (with leading '-' for negative numbers)
+DG_MISC_DEF size_t DG_i64toa(char* buf, long long v);
+
+// the minimum size of the buffer passed to DG_dtoa() and DG_ftoa()
+#define DG_DTOA_BUFSIZE 32
+
+// writes the shortest decimal representation of v that reads back (e.g. with strtod())
+// as exactly v, and a terminating '\0' to buf, which must be at least DG_DTOA_BUFSIZE
+// bytes big. returns the length (without '\0').
+// The format is like in JavaScript: "123.45", "0.001", "100000", "1e+21", "1.5e-7",
+// "0", "-0", "inf", "-inf" or "nan"
+DG_MISC_DEF size_t DG_dtoa(char* buf, double v);
+
+// like DG_dtoa(), but for float: the shortest representation that reads back
+// (e.g. with strtof()) as exactly v
+DG_MISC_DEF size_t DG_ftoa(char* buf, float v);
+
+// fast string to number conversion, like C++17's std::from_chars(): independent of
+// the locale (the decimal point is always '.'), the string doesn't need to be
+// '\0'-terminated (only the first len chars are used) and there's no leading
+// whitespace or '+' allowed. Returns a pointer to the first char after the number.
+// If error is not NULL, one of the following is written to it:
+
+// the number was parsed successfully
+#define DG_PARSE_OK       0
+// there's no number at the start of str, *value is unchanged and str is returned
+#define DG_PARSE_INVALID  1
+// the number is too big (or small) for the type. For integers *value is unchanged, for
+// floating point numbers it's set to +/-inf or +/-0. Returns the end of the number
+#define DG_PARSE_RANGE    2
+
+// parses an unsigned integer in the given base (2 to 36, letters can be upper- or lowercase),
+// without prefix like "0x"
+DG_MISC_DEF const char* DG_strtou64(const char* str, size_t len, unsigned long long* value,
+                                    int base, int* error);
+
+// like DG_strtou64(), but for signed integers (with a leading '-' for negative numbers)
+DG_MISC_DEF const char* DG_strtoi64(const char* str, size_t len, long long* value,
+                                    int base, int* error);
+
+// parses a decimal floating point number like "-123.456e-7", ".5", "1." or "42"
+// (or "inf", "infinity", "nan" or "nan(...)", case insensitive), correctly rounded to
+// the nearest double. Much faster than strtod() (uses the Eisel-Lemire algorithm)
+DG_MISC_DEF const char* DG_strtod(const char* str, size_t len, double* value, int* error);
+
+// like DG_strtod(), but for float
+DG_MISC_DEF const char* DG_strtof(const char* str, size_t len, float* value, int* error);
+
+// UTF-8 validation and conversion between UTF-8 and UTF-16 (in native byte order, so on
+// Windows you can cast wchar_t* to unsigned short*).
+// Invalid UTF-8 means bytes that aren't part of a valid sequence, truncated sequences,
+// overlong encodings, surrogates (U+D800 - U+DFFF) and code points above U+10FFFF.
+// Invalid UTF-16 means unpaired surrogates.
+
+// returned by DG_utf8_to_utf16() and DG_utf16_to_utf8() if the input is invalid
+#define DG_UTF_INVALID ((size_t)-1)
+
+// returns len if the len bytes in str are valid UTF-8, otherwise the offset of the first
+// invalid sequence (i.e. the length of the valid part)
+DG_MISC_DEF size_t DG_utf8_validate(const char* str, size_t len);
+
+// converts srcLen bytes of UTF-8 in src to UTF-16, writes at most dstLen units to dst
+// (dst can be NULL if dstLen is 0). Like snprintf(), returns the number of UTF-16 units
+// needed for the whole string - if that's > dstLen, the output was cut off (between two
+// code points). Doesn't '\0'-terminate dst, unless src contains a '\0' (so you can pass
+// strlen(src)+1 as srcLen to get a terminated string).
+// If src is invalid UTF-8, returns DG_UTF_INVALID without writing anything to dst and,
+// if errorOffset isn't NULL, sets *errorOffset to the offset of the first invalid sequence in src
+DG_MISC_DEF size_t DG_utf8_to_utf16(unsigned short* dst, size_t dstLen,
+                                    const char* src, size_t srcLen, size_t* errorOffset);
+
+// like DG_utf8_to_utf16(), but the other way around: dstLen is in bytes, srcLen is in
+// UTF-16 units and *errorOffset is set to the index of the first unpaired surrogate.
+// Like there, nothing is written to dst if src is invalid.
+DG_MISC_DEF size_t DG_utf16_to_utf8(char* dst, size_t dstLen,
+                                    const unsigned short* src, size_t srcLen, size_t* errorOffset);
+
+// fast non-cryptographic hash functions, for hash tables, checksums of file contents etc.
+// (NOT for anything security related, like storing passwords or signing data!)
+
+// returns a 64-bit hash of the len bytes at data, different seeds give independent hashes.
+// This is XXH3 (the 64-bit variant) from https://github.com/Cyan4973/xxHash, so the
+// result is the same as XXH3_64bits_withSeed(data, len, seed), on all platforms
+DG_MISC_DEF unsigned long long DG_hash64(const void* data, size_t len, unsigned long long seed);
+
+// for calculating DG_hash64() of data that arrives in chunks:
+//   DG_Hash64State st;
+//   DG_Hash64_Init(&st, seed);
+//   DG_Hash64_Update(&st, chunk1, chunk1len);
+//   DG_Hash64_Update(&st, chunk2, chunk2len);
+//   unsigned long long hash = DG_Hash64_Final(&st); // == DG_hash64(chunk1 + chunk2, ...)
+// the members are internal, only use the DG_Hash64_* functions
+typedef struct DG_Hash64State {
+	unsigned long long acc[8];   // the accumulators for inputs longer than 240 bytes
+	unsigned long long totalLen; // the number of bytes passed to DG_Hash64_Update()
+	unsigned long long seed;
+	unsigned int bufferedSize;   // the number of bytes in buffer that haven't been processed yet
+	unsigned int stripesInBlock; // how many 64 byte stripes of the current block have been processed
+	unsigned char secret[192];   // derived from the seed
+	unsigned char buffer[256];
+} DG_Hash64State;
+
+// initializes st for hashing data with the given seed
+DG_MISC_DEF void DG_Hash64_Init(DG_Hash64State* st, unsigned long long seed);
+
+// adds the next len bytes at data to the hash
+DG_MISC_DEF void DG_Hash64_Update(DG_Hash64State* st, const void* data, size_t len);
+
+// returns the hash of all data added so far. doesn't change st, so you can continue
+// adding data with DG_Hash64_Update() afterwards
+DG_MISC_DEF unsigned long long DG_Hash64_Final(const DG_Hash64State* st);
+
+// returns the CRC-32C (Castagnoli, like used by iSCSI, ext4, Btrfs, ...) of the len bytes
+// at data. Uses the crc32 instruction of SSE4.2 if available.
+// crc is the CRC of the preceding data, so for a single buffer pass 0, and for data
+// in chunks: crc = DG_crc32c(0, chunk1, len1); crc = DG_crc32c(crc, chunk2, len2); ...
+DG_MISC_DEF unsigned int DG_crc32c(unsigned int crc, const void* data, size_t len);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -239,6 +673,7 @@ extern "C" {
 #include <stdarg.h>
 #include <stdio.h>
 #include <limits.h> // INT_MAX, maybe PATH_MAX
+#include <float.h> // FLT_EVAL_METHOD
 
 // for uintptr_t:
 #ifndef _MSC_VER
@@ -253,8 +688,20 @@ extern "C" {
 #include <sys/sysctl.h> // for sysctl() to get path to executable
 #endif
 
+#ifndef _WIN32
+#include <fcntl.h> // open()
+#include <unistd.h> // close(), sysconf()
+#include <sys/stat.h> // fstat()
+#include <sys/mman.h> // mmap(), madvise() - for DG_FileFind()
+#include <sched.h> // sched_yield()
+#endif
+
+#if defined(DG_MISC_WITH_THREADS) && !defined(_WIN32)
+#include <pthread.h> // for DG_memmem_parallel()
+#endif
+
 #ifdef _WIN32
-#include <windows.h> // GetModuleFileNameA()
+#include <windows.h> // GetModuleFileNameA(), SwitchToThread()
 #endif
 
 #ifdef __APPLE__
@@ -282,6 +729,216 @@ extern "C" {
   #error "can't determine if compiling for a 32bit or 64bit platform"
 #endif
 
+// SSE2 is always available on x86_64 (and on 32bit x86 if enabled with -msse2 or /arch:SSE2)
+// and is used for some of the string search functions.
+// #define DG_MISC_NO_SIMD to only use the plain C implementations
+#if !defined(DG_MISC_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) \
+                                  || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #include <emmintrin.h>
+  #define DG__MISC_HAVE_SSE2
+#endif
+
+// AVX2 is only used if the compiler is told to generate code for it (-mavx2, /arch:AVX2)
+// or if DG_MISC_RUNTIME_DISPATCH is #defined (see below)
+#if !defined(DG_MISC_NO_SIMD) && defined(__AVX2__)
+  #include <immintrin.h>
+  #define DG__MISC_HAVE_AVX2
+  #define DG__MISC_ALWAYS_AVX2 // AVX2 kernels can be called without checking the CPU
+#endif
+
+// #define DG_MISC_RUNTIME_DISPATCH to make DG_strnlen(), DG_strlen(), DG_memmem(),
+// DG_memrmem(), DG_memrchr(), the DG_utf*() functions, DG_hash64(), DG_crc32c(),
+// DG_strlcpy() and DG_strlcat() (and the other functions based on them) check once
+// (at their first call) which SIMD instructions the CPU supports and use the fastest
+// implementation for it.
+// That way a binary built for baseline x86_64 (SSE2) can still use AVX2.
+// Only supported on x86 and x86_64 with GCC, clang and MSVC, ignored elsewhere.
+#if defined(DG_MISC_RUNTIME_DISPATCH) && !defined(DG_MISC_NO_SIMD) \
+    && defined(DG__MISC_HAVE_SSE2) && !defined(DG__MISC_ALWAYS_AVX2) \
+    && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+  #include <immintrin.h>
+  #define DG__MISC_HAVE_AVX2
+  #define DG__MISC_DISPATCH
+  #if defined(__GNUC__) || defined(__clang__)
+    // allows using AVX2 intrinsics in functions marked with this, even if the
+    // rest of the code is compiled without -mavx2. (MSVC always allows that.)
+    #define DG__MISC_TARGET_AVX2  __attribute__((target("avx2")))
+  #endif
+#endif
+
+#ifndef DG__MISC_TARGET_AVX2
+  #define DG__MISC_TARGET_AVX2
+#endif
+
+// DG_crc32c() can use the crc32 instruction from SSE4.2 (and PCLMULQDQ to combine the CRCs
+// of interleaved blocks) on x86_64. That's always done when compiling for SSE4.2 and
+// PCLMULQDQ (-msse4.2 -mpclmul). When compiling for AVX2 or with DG_MISC_RUNTIME_DISPATCH,
+// it's done if CPUID says that the CPU supports both (checked once, at the first call).
+#if defined(DG_MISC_IS_64BIT) && defined(DG__MISC_HAVE_SSE2) \
+    && (defined(DG__MISC_HAVE_AVX2) || (defined(__SSE4_2__) && defined(__PCLMUL__)))
+  #include <immintrin.h>
+  #define DG__MISC_HAVE_CRC32C
+  #if defined(__SSE4_2__) && defined(__PCLMUL__)
+    #define DG__MISC_ALWAYS_CRC32C
+  #endif
+  #if defined(__GNUC__) || defined(__clang__)
+    #define DG__MISC_TARGET_CRC32C  __attribute__((target("sse4.2,pclmul")))
+  #else
+    #define DG__MISC_TARGET_CRC32C
+  #endif
+#endif
+
+// for functions that deliberately read a bit outside of buffers, in a way that is safe
+// (like aligned reads that don't cross page boundaries), so AddressSanitizer doesn't complain
+#if defined(__GNUC__) || defined(__clang__)
+  #define DG__MISC_NO_ASAN  __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER) && _MSC_VER >= 1929 // VS2019 16.10
+  #define DG__MISC_NO_ASAN  __declspec(no_sanitize_address)
+#else
+  #define DG__MISC_NO_ASAN
+#endif
+
+// some of the implementations aren't used in all configurations (e.g. when
+// the libc version is used instead), this avoids "unused function" warnings
+#if defined(__GNUC__) || defined(__clang__)
+  #define DG__MISC_MAYBE_UNUSED  __attribute__((unused))
+#else
+  #define DG__MISC_MAYBE_UNUSED
+#endif
+
+// SIMD levels of the different implementations of functions
+#define DG__MISC_SIMD_NONE 0
+#define DG__MISC_SIMD_SSE2 1
+#define DG__MISC_SIMD_AVX2 2
+
+// the best SIMD level that can be used without checking the CPU
+#if defined(DG__MISC_ALWAYS_AVX2)
+  #define DG__MISC_SIMD_DEFAULT DG__MISC_SIMD_AVX2
+#elif defined(DG__MISC_HAVE_SSE2)
+  #define DG__MISC_SIMD_DEFAULT DG__MISC_SIMD_SSE2
+#else
+  #define DG__MISC_SIMD_DEFAULT DG__MISC_SIMD_NONE
+#endif
+
+#ifdef DG__MISC_DISPATCH
+// table of functions for a given SIMD level,
+// DG__MiscGetKernels() returns the best one for the CPU (see end of file)
+typedef struct {
+	size_t (*strnlen)(const char* s, size_t n);
+  #ifndef DG_strlen // if it's not just a #define for regular strlen
+	size_t (*strlen)(const char* s);
+  #endif
+	void* (*memmem)(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl);
+	void* (*memrmem)(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl);
+	void* (*memrchr)(const unsigned char* b, unsigned char c, size_t len);
+	// for functions that take the SIMD level as argument instead of having one kernel per level
+	int simdLevel;
+} DG__MiscKernels;
+
+static const DG__MiscKernels* DG__MiscGetKernels(void);
+
+  #define DG__MISC_SIMD_LEVEL  (DG__MiscGetKernels()->simdLevel)
+#else
+  #define DG__MISC_SIMD_LEVEL  DG__MISC_SIMD_DEFAULT
+#endif // DG__MISC_DISPATCH
+
+#ifdef _MSC_VER
+  #include <intrin.h> // _BitScanForward(), _BitScanReverse()
+#endif
+
+// magic numbers used for the trick from https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord
+// to check if any of the bytes in a uintptr_t is 0 (see DG_strnlen() for details)
+#ifdef DG_MISC_IS_32BIT
+  #define DG__MISC_MAGIC1 ((uintptr_t)0x01010101uL)
+  #define DG__MISC_MAGIC2 ((uintptr_t)0x80808080uL)
+#elif defined(DG_MISC_IS_64BIT)
+  #define DG__MISC_MAGIC1 ((uintptr_t)0x0101010101010101uLL)
+  #define DG__MISC_MAGIC2 ((uintptr_t)0x8080808080808080uLL)
+#else
+  #error "no 32 or 64bit platform?!"
+#endif
+
+// nonzero if any of the bytes in the uintptr_t w is 0
+#define DG__MISC_HAS_ZERO_BYTE(w) \
+	(((w) - DG__MISC_MAGIC1) & ~(w) & DG__MISC_MAGIC2)
+
+// minimal atomic operations on size_t, for the code that can be used from several threads.
+// loads have acquire and stores have release semantics, the other operations are sequentially consistent
+#if defined(__GNUC__) || defined(__clang__)
+DG__MISC_MAYBE_UNUSED
+static size_t DG__AtomicLoad(volatile size_t* p)
+{
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+DG__MISC_MAYBE_UNUSED
+static void DG__AtomicStore(volatile size_t* p, size_t val)
+{
+	__atomic_store_n(p, val, __ATOMIC_RELEASE);
+}
+// returns the old value
+DG__MISC_MAYBE_UNUSED
+static size_t DG__AtomicFetchAdd(volatile size_t* p, size_t val)
+{
+	return __atomic_fetch_add(p, val, __ATOMIC_SEQ_CST);
+}
+// sets *p to desired if it's expected, returns the old value of *p
+DG__MISC_MAYBE_UNUSED
+static size_t DG__AtomicCompareExchange(volatile size_t* p, size_t expected, size_t desired)
+{
+	__atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return expected; // if it failed, __atomic_compare_exchange_n() wrote the actual value to it
+}
+
+#elif defined(_MSC_VER)
+// the Interlocked*() functions are full memory barriers
+  #ifdef _WIN64
+    #define DG__MISC_INTERLOCKED(name, p, ...)  name ## 64((volatile __int64*)(p), __VA_ARGS__)
+    #define DG__MISC_INTERLOCKED_T __int64
+  #else
+    #define DG__MISC_INTERLOCKED(name, p, ...)  name((volatile long*)(p), __VA_ARGS__)
+    #define DG__MISC_INTERLOCKED_T long
+  #endif
+
+static size_t DG__AtomicLoad(volatile size_t* p)
+{
+	return (size_t)DG__MISC_INTERLOCKED(InterlockedCompareExchange, p, 0, 0);
+}
+static void DG__AtomicStore(volatile size_t* p, size_t val)
+{
+	DG__MISC_INTERLOCKED(InterlockedExchange, p, (DG__MISC_INTERLOCKED_T)val);
+}
+static size_t DG__AtomicFetchAdd(volatile size_t* p, size_t val)
+{
+	return (size_t)DG__MISC_INTERLOCKED(InterlockedExchangeAdd, p, (DG__MISC_INTERLOCKED_T)val);
+}
+static size_t DG__AtomicCompareExchange(volatile size_t* p, size_t expected, size_t desired)
+{
+	return (size_t)DG__MISC_INTERLOCKED(InterlockedCompareExchange, p,
+	                                    (DG__MISC_INTERLOCKED_T)desired, (DG__MISC_INTERLOCKED_T)expected);
+}
+
+#else // unknown compiler: no atomics, things only work single-threaded
+
+  #ifdef DG_MISC_WITH_THREADS
+    #error "DG_MISC_WITH_THREADS needs atomic operations, which are only implemented for GCC, clang and MSVC"
+  #endif
+static size_t DG__AtomicLoad(volatile size_t* p) { return *p; }
+static void DG__AtomicStore(volatile size_t* p, size_t val) { *p = val; }
+static size_t DG__AtomicFetchAdd(volatile size_t* p, size_t val)
+{
+	size_t ret = *p;
+	*p = ret + val;
+	return ret;
+}
+static size_t DG__AtomicCompareExchange(volatile size_t* p, size_t expected, size_t desired)
+{
+	size_t ret = *p;
+	if(ret == expected)  *p = desired;
+	return ret;
+}
+
+#endif // atomics
+
 #ifndef PATH_MAX
 // this is mostly for windows. windows has a MAX_PATH = 260 #define, but allows
 // longer paths anyway.. this might not be the maximum allowed length, but is
@@ -290,9 +947,18 @@ extern "C" {
 #define _DG__DEFINED_PATH_MAX
 #endif
 
-static void DG__SetExecutablePath(char* exePath)
+// the path of the executable and its directory, determined once by DG__GetExePaths()
+typedef struct {
+	char path[PATH_MAX];
+	char dir[PATH_MAX];
+	size_t pathLen;
+	size_t dirLen;
+} DG__ExePaths;
+
+// sets paths->path (or makes it empty on error) and paths->pathLen
+static void DG__SetExecutablePath(DG__ExePaths* paths)
 {
-	// !!! this assumes that exePath can hold PATH_MAX chars !!!
+	char* exePath = paths->path;
 
 #ifdef _WIN32
 
@@ -307,15 +973,16 @@ static void DG__SetExecutablePath(char* exePath)
 
 	// all the platforms that have /proc/$pid/exe or similar that symlink the
 	// real executable - basiscally Linux and the BSDs except for FreeBSD which
-	// doesn't enable proc by default and has a sysctl() for this
-	char buf[PATH_MAX] = {0};
+	// doesn't enable proc by default and has a sysctl() for this.
+	// "self" and "curproc" link to the /proc/$pid/ of the calling process, so
+	// there's no need to format the PID into the path
 #ifdef __linux
-	snprintf(buf, sizeof(buf), "/proc/%d/exe", getpid());
+	const char* link = "/proc/self/exe";
 #else // the BSDs
-	snprintf(buf, sizeof(buf), "/proc/%d/file", getpid());
+	const char* link = "/proc/curproc/file";
 #endif
 	// readlink() doesn't null-terminate!
-	int len = readlink(buf, exePath, PATH_MAX-1);
+	ssize_t len = readlink(link, exePath, PATH_MAX-1);
 	if (len <= 0)
 	{
 		// an error occured, clear exe path
@@ -357,69 +1024,91 @@ static void DG__SetExecutablePath(char* exePath)
 #error "Unsupported Platform!" // feel free to add implementation for your platform and send me a patch
 
 #endif
-}
-
-DG_MISC_DEF const char* DG_GetExecutablePath(void)
-{
-	static char exePath[PATH_MAX] = {0};
-
-	if(exePath[0] != '\0') return exePath;
-
-	// the following code should only be executed at the first call of this function
-	DG__SetExecutablePath(exePath);
 
-	return exePath;
+	paths->pathLen = strlen(exePath);
 }
 
-DG_MISC_DEF const char* DG_GetExecutableDir(void)
+// fills paths with the path of the executable and its directory
+static void DG__InitExePaths(DG__ExePaths* paths)
 {
-	static char exeDir[PATH_MAX] = {0};
-
-	if(exeDir[0] != '\0') return exeDir;
-
-	// the following code should only be executed at the first call of this function
-	const char* exePath = DG_GetExecutablePath();
-
-	if(exePath == NULL || exePath[0] == '\0') return exeDir;
+	DG__SetExecutablePath(paths);
 
-	DG_strlcpy(exeDir, exePath, PATH_MAX);
-
-	// cut off executable name
-	char* lastSlash = strrchr(exeDir, '/');
+	// the directory is the path up to (and including) the last (back)slash
+	const char* lastSlash = strrchr(paths->path, '/');
 #ifdef _WIN32
-	char* lastBackSlash = strrchr(exeDir, '\\');
+	const char* lastBackSlash = strrchr(paths->path, '\\');
 	if(lastSlash == NULL || lastBackSlash > lastSlash) lastSlash = lastBackSlash;
 #endif // _WIN32
 
-	if(lastSlash != NULL) lastSlash[1] = '\0'; // cut off after last (back)slash
-
-	return exeDir;
+	paths->dirLen = (lastSlash != NULL) ? (size_t)(lastSlash + 1 - paths->path) : paths->pathLen;
+	memcpy(paths->dir, paths->path, paths->dirLen);
+	paths->dir[paths->dirLen] = '\0';
 }
 
-DG_MISC_DEF const char* DG_GetExecutableFilename(void)
+// returns the paths, they're determined at the first call (if that fails, they stay
+// empty). thread-safe: if several threads call this at the same time, only one of
+// them initializes the paths and the others wait for that to finish
+static const DG__ExePaths* DG__GetExePaths(void)
 {
-	static const char* exeName = "";
-	if(exeName[0] != '\0') return exeName;
+	// 0: not initialized yet, 1: a thread is initializing paths, 2: done
+	static volatile size_t state = 0;
+	static DG__ExePaths paths;
 
-	// the following code should only be executed at the first call of this function
-	const char* exePath = DG_GetExecutablePath();
+	size_t s = DG__AtomicLoad(&state);
+	if(s != 2)
+	{
+		if(s == 0 && DG__AtomicCompareExchange(&state, 0, 1) == 0)
+		{
+			DG__InitExePaths(&paths);
+			DG__AtomicStore(&state, 2);
+		}
+		else
+		{
+			// another thread is initializing it, that's just one syscall so it won't take long,
+			// but let it (or others) run instead of burning the CPU while waiting
+			while(DG__AtomicLoad(&state) != 2)
+			{
+#ifdef _WIN32
+				SwitchToThread();
+#else
+				sched_yield();
+#endif
+			}
+		}
+	}
+	return &paths;
+}
 
-	if(exePath == NULL || exePath[0] == '\0') return exeName;
+DG_MISC_DEF const char* DG_GetExecutablePath(void)
+{
+	return DG__GetExePaths()->path;
+}
 
-	// cut off executable name
-	const char* lastSlash = strrchr(exePath, '/');
-#ifdef _WIN32
-	const char* lastBackSlash = strrchr(exePath, '\\');
-	if(lastSlash == NULL || lastBackSlash > lastSlash) lastSlash = lastBackSlash;
-#endif // _WIN32
+DG_MISC_DEF const char* DG_GetExecutableDir(void)
+{
+	return DG__GetExePaths()->dir;
+}
 
-	if(lastSlash != NULL && lastSlash[1] != '\0')
-	{
-		// the filename starts after the last (back)slash
-		exeName = lastSlash+1;
-	}
+DG_MISC_DEF const char* DG_GetExecutableFilename(void)
+{
+	const DG__ExePaths* paths = DG__GetExePaths();
+	// if the path is empty or ends with a (back)slash, dirLen == pathLen and this is ""
+	// (that's also the case if the path has no (back)slash at all, but that shouldn't happen)
+	return paths->path + paths->dirLen;
+}
 
-	return exeName;
+DG_MISC_DEF int DG_GetExecutableInfo(DG_ExecutableInfo* info)
+{
+	DG_MISC_ASSERT(info != NULL, "Don't pass NULL into DG_GetExecutableInfo()!");
+
+	const DG__ExePaths* paths = DG__GetExePaths();
+	info->path = paths->path;
+	info->dir = paths->dir;
+	info->filename = paths->path + paths->dirLen;
+	info->pathLen = paths->pathLen;
+	info->dirLen = paths->dirLen;
+	info->filenameLen = paths->pathLen - paths->dirLen;
+	return paths->pathLen != 0;
 }
 
 DG_MISC_DEF char* DG_strndup(const char* str, size_t n)
@@ -436,615 +1125,6206 @@ DG_MISC_DEF char* DG_strndup(const char* str, size_t n)
 	return ret;
 }
 
+// returns the index of the lowest set bit in x - x must not be 0!
+DG__MISC_MAYBE_UNUSED
+static int DG__LowestBitIdx(unsigned int x)
+{
+	DG_MISC_ASSERT(x != 0, "DG__LowestBitIdx() must not be called with 0!");
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+	unsigned long idx;
+	_BitScanForward(&idx, x);
+	return (int)idx;
+#else
+	int ret = 0;
+	while((x & 1) == 0) { x >>= 1; ++ret; }
+	return ret;
+#endif
+}
+
+// returns the index of the highest set bit in x - x must not be 0!
+DG__MISC_MAYBE_UNUSED
+static int DG__HighestBitIdx(unsigned int x)
+{
+	DG_MISC_ASSERT(x != 0, "DG__HighestBitIdx() must not be called with 0!");
+#if defined(__GNUC__) || defined(__clang__)
+	return 31 - __builtin_clz(x);
+#elif defined(_MSC_VER)
+	unsigned long idx;
+	_BitScanReverse(&idx, x);
+	return (int)idx;
+#else
+	int ret = 31;
+	while((x & 0x80000000u) == 0) { x <<= 1; --ret; }
+	return ret;
+#endif
+}
+
 // Notes on DG_strlcat() and DG_strlcpy():
-// My implementations use (DG_)strlen(), (DG_)strnlen() and memcpy(), which are
-// usually heavily optimized. Thus they're faster than the BSD strl*
-// implementations in most cases (those iterate the strings bytewise themselves)
-// - unless the function call overhead is higher than iterating the bytes,
-//   which only happens for very short strings and is negligible.
-//  Furthermore the speedup depends on how well optimized your libc is.)
+// My implementations find the end of src and copy it in one pass, with
+// DG__StrCopy_*(), which copy one machine word or 16/32 bytes at once until they
+// find the '\0' or reach the size limit. Thus they're faster than the BSD strl*
+// implementations (those iterate the strings bytewise) and than doing
+// strlen() + memcpy(), which reads src twice (and the function call overhead of
+// that is noticeable with the short strings these functions are usually used for).
+// Only if src doesn't fit into dst, the rest of it is counted with DG_strlen()
+// (strlcpy() must return the length of src to let the caller detect truncation).
 // Note that strlcat() is *not* the same as strncat(), which takes the max
 //  number of bytes that should be appended, which is mostly useless.
 // And that strlcpy() is *not* the same as strncpy(), which fills up the unused
 //  part of the buffer with '\0', but doesn't guarantee '\0'-termination if the
 //  buffer isn't big enough.. and thus is pretty useless.
 
-DG_MISC_DEF size_t DG_strlcpy(char* dst, const char* src, size_t dstsize)
+// Like in DG_strncasecmp(), the SSE2/AVX2 copy kernels use unaligned loads that may
+// read past the end of src, but never cross a page boundary (when a block would,
+// it's loaded from further back so it ends at the boundary, and the bytes before
+// it are copied again). Only the bytes of src up to the '\0' are written to dst.
+#define DG__STRCOPY_PAGESIZE 4096
+
+// copies len bytes from src to dst, for the rest after the last full block of a copy
+// kernel, with (overlapping) moves of up to 8 bytes instead of a memcpy() call.
+// len must be < 16. (Only general purpose registers are used, mixing SSE instructions
+// into the AVX2 kernel would cause expensive transitions between SSE and AVX state)
+DG__MISC_MAYBE_UNUSED
+static void DG__StrCopyTail(char* dst, const char* src, size_t len)
 {
-	DG_MISC_ASSERT(src && dst, "Don't call strlcpy with NULL arguments!");
-	size_t srclen = DG_strlen(src);
-
-	if(dstsize != 0)
+	if(len >= 8)
 	{
-		size_t numchars = dstsize-1;
-
-		if(srclen < numchars) numchars = srclen;
-
-		memcpy(dst, src, numchars);
-		dst[numchars] = '\0';
+		memcpy(dst, src, 8);
+		memcpy(dst + len - 8, src + len - 8, 8);
+	}
+	else if(len >= 4)
+	{
+		memcpy(dst, src, 4);
+		memcpy(dst + len - 4, src + len - 4, 4);
+	}
+	else if(len > 0)
+	{
+		dst[0] = src[0];
+		dst[len/2] = src[len/2];
+		dst[len-1] = src[len-1];
 	}
-	return srclen;
 }
 
-DG_MISC_DEF size_t DG_strlcat(char* dst, const char* src, size_t dstsize)
+// copies src to dst until the terminating '\0' (which is *not* copied) or until n
+// bytes have been copied, returns the number of copied bytes.
+// Plain C version: copies bytewise until src is aligned, then whole uintptr_t words;
+// aligned words never cross a page boundary, but may contain bytes behind the '\0'
+DG__MISC_NO_ASAN DG__MISC_MAYBE_UNUSED
+static size_t DG__StrCopy_swar(char* dst, const char* src, size_t n)
 {
-	DG_MISC_ASSERT(src && dst, "Don't call strlcat with NULL arguments!");
-
-	size_t dstlen = DG_strnlen(dst, dstsize);
-	size_t srclen = DG_strlen(src);
-
-	DG_MISC_ASSERT(dstlen != dstsize, "dst must contain null-terminated data with strlen < dstsize!");
-
-	// TODO: dst[dstsize-1] = '\0' to ensure null-termination and make wrong dstsize more obvious?
+	static const size_t WordSize = sizeof(uintptr_t);
+	size_t i = 0;
 
-	if(dstsize > 1 && dstlen < dstsize-1)
+	for( ; i < n && ((uintptr_t)(src+i) & (WordSize-1)) != 0; ++i)
 	{
-		size_t numchars = dstsize-dstlen-1;
-
-		if(srclen < numchars) numchars = srclen;
+		if(src[i] == '\0')  return i;
+		dst[i] = src[i];
+	}
 
-		memcpy(dst+dstlen, src, numchars);
-		dst[dstlen+numchars] = '\0';
+	for( ; n - i >= WordSize; i += WordSize)
+	{
+		uintptr_t w = *(const uintptr_t*)(src+i);
+		if(DG__MISC_HAS_ZERO_BYTE(w))  break; // the rest is copied bytewise below
+		memcpy(dst+i, &w, WordSize);
 	}
 
-	return dstlen + srclen;
+	for( ; i < n; ++i)
+	{
+		if(src[i] == '\0')  return i;
+		dst[i] = src[i];
+	}
+	return n;
 }
 
-DG_MISC_DEF void* DG_memmem(const void* haystack, size_t haystacklen,
-                            const void* needle, size_t needlelen)
+// number of bytes from p to the next page boundary
+DG__MISC_MAYBE_UNUSED
+static size_t DG__StrCopyPageRest(const char* p)
 {
-	DG_MISC_ASSERT((haystack != NULL || haystacklen == 0)
-			&& (needle != NULL || needlelen == 0),
-			"Don't pass NULL into DG_memmem(), unless the corresponding len is 0!");
-
-#if defined(_GNU_SOURCE) && !defined(DG_MISC_NO_GNU_SOURCE)
-	// glibc has a very optimized version of this, use that instead
-	return memmem(haystack, haystacklen, needle, needlelen);
-#else
-	unsigned char* h = (unsigned char*)haystack;
-	unsigned char* n = (unsigned char*)needle;
-
-	if(needlelen == 0) return (void*)haystack; // this is what glibc does..
-	if(haystacklen < needlelen) return NULL; // also handles haystacklen == 0
-
-	if(needlelen == 1) return (void*)memchr(haystack, n[0], haystacklen);
-
-	// TODO: knuth-morris-pratt or boyer-moore or something like that might be a lot faster.
-
-	// the byte after the last byte needle could start at so it'd still fit into haystack
-	unsigned char* afterlast = h + haystacklen - needlelen + 1;
-	// haystack length up to afterlast
-	size_t hlen_for_needle_start = afterlast - h;
-	int n0 = n[0];
-	unsigned char* n0candidate = (unsigned char*)memchr(h, n0, hlen_for_needle_start);
+	return DG__STRCOPY_PAGESIZE - ((uintptr_t)p & (DG__STRCOPY_PAGESIZE-1));
+}
 
-	while(n0candidate != NULL)
+#ifdef DG__MISC_HAVE_SSE2
+// like DG__StrCopy_swar(), but copies 16 bytes at once with SSE2
+DG__MISC_NO_ASAN DG__MISC_MAYBE_UNUSED
+static size_t DG__StrCopy_sse2(char* dst, const char* src, size_t n)
+{
+	size_t i = 0;
+	while(i < n)
 	{
-		if(memcmp(n0candidate+1, n+1, needlelen-1) == 0)
+		// the last block to copy before the next page boundary of src
+		size_t lastBlock = i;
+		size_t pageRest = DG__StrCopyPageRest(src + i);
+		if(pageRest >= 16)
+		{
+			lastBlock = i + pageRest - 16;
+		}
+		else if(i >= 16 - pageRest)
+		{
+			// load the block from further back, so it ends at the page boundary
+			i -= 16 - pageRest;
+			lastBlock = i;
+		}
+		else
 		{
-			return (void*)n0candidate;
+			if(src[i] == '\0')  return i;
+			dst[i] = src[i];
+			++i;
+			continue;
 		}
 
-		++n0candidate; // go on searching one byte after the last n0candidate
-		hlen_for_needle_start = afterlast - n0candidate;
-		n0candidate = (unsigned char*)memchr(n0candidate, n0, hlen_for_needle_start);
+		// two blocks at once while neither contains the '\0' or the limit
+		const __m128i zero = _mm_setzero_si128();
+		for( ; i + 16 <= lastBlock && n - i >= 32; i += 32)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i*)(src+i));
+			__m128i b = _mm_loadu_si128((const __m128i*)(src+i+16));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(a, b), zero)) != 0)  break;
+			_mm_storeu_si128((__m128i*)(dst+i), a);
+			_mm_storeu_si128((__m128i*)(dst+i+16), b);
+		}
+		for( ; i <= lastBlock; i += 16)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i*)(src+i));
+			unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+			size_t rem = n - i;
+			if(rem < 16)  mask |= 1u << rem; // stop at n, like at a '\0'
+			if(mask != 0)
+			{
+				size_t len = (size_t)DG__LowestBitIdx(mask);
+				DG__StrCopyTail(dst+i, src+i, len);
+				return i + len;
+			}
+			_mm_storeu_si128((__m128i*)(dst+i), v);
+		}
 	}
+	return n;
+}
+#endif // DG__MISC_HAVE_SSE2
 
-	return NULL; // not found
+#ifdef DG__MISC_HAVE_AVX2
+// like DG__StrCopy_sse2(), but copies 32 bytes at once
+DG__MISC_TARGET_AVX2 DG__MISC_NO_ASAN DG__MISC_MAYBE_UNUSED
+static size_t DG__StrCopy_avx2(char* dst, const char* src, size_t n)
+{
+	size_t i = 0;
+	while(i < n)
+	{
+		size_t lastBlock = i;
+		size_t pageRest = DG__StrCopyPageRest(src + i);
+		if(pageRest >= 32)
+		{
+			lastBlock = i + pageRest - 32;
+		}
+		else if(i >= 32 - pageRest)
+		{
+			i -= 32 - pageRest;
+			lastBlock = i;
+		}
+		else
+		{
+			if(src[i] == '\0')  return i;
+			dst[i] = src[i];
+			++i;
+			continue;
+		}
 
-#endif // _GNU_SOURCE
+		// two blocks at once while neither contains the '\0' or the limit
+		const __m256i zero = _mm256_setzero_si256();
+		for( ; i + 32 <= lastBlock && n - i >= 64; i += 64)
+		{
+			__m256i a = _mm256_loadu_si256((const __m256i*)(src+i));
+			__m256i b = _mm256_loadu_si256((const __m256i*)(src+i+32));
+			if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(a, b), zero)) != 0)  break;
+			_mm256_storeu_si256((__m256i*)(dst+i), a);
+			_mm256_storeu_si256((__m256i*)(dst+i+32), b);
+		}
+		for( ; i <= lastBlock; i += 32)
+		{
+			__m256i v = _mm256_loadu_si256((const __m256i*)(src+i));
+			unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+			size_t rem = n - i;
+			if(rem < 32)  mask |= 1u << rem;
+			if(mask != 0)
+			{
+				size_t len = (size_t)DG__LowestBitIdx(mask);
+				if(len >= 16)
+				{
+					// the first 16 bytes and the (overlapping) last 16 bytes
+					_mm_storeu_si128((__m128i*)(dst+i), _mm256_castsi256_si128(v));
+					_mm_storeu_si128((__m128i*)(dst+i+len-16), _mm_loadu_si128((const __m128i*)(src+i+len-16)));
+				}
+				else
+				{
+					DG__StrCopyTail(dst+i, src+i, len);
+				}
+				return i + len;
+			}
+			_mm256_storeu_si256((__m256i*)(dst+i), v);
+		}
+	}
+	return n;
 }
+#endif // DG__MISC_HAVE_AVX2
 
+#undef DG__STRCOPY_PAGESIZE
 
-DG_MISC_DEF void* DG_memrchr(const void* buf, unsigned char c, size_t buflen)
+// DG__StrCopy_*() for the given DG__MISC_SIMD_* level
+static size_t DG__StrCopy_level(char* dst, const char* src, size_t n, int simdLevel)
 {
-	DG_MISC_ASSERT(buf != NULL, "Don't pass NULL into DG_memrchr()!");
-#if defined(_GNU_SOURCE) && !defined(DG_MISC_NO_GNU_SOURCE)
-	// glibc has a very optimized version of this, use that instead
-	return (void*)memrchr(buf, c, buflen);
-#else
+	(void)simdLevel; // unused if DG_MISC_NO_SIMD is #defined
+  #ifdef DG__MISC_HAVE_AVX2
+	if(simdLevel >= DG__MISC_SIMD_AVX2)  return DG__StrCopy_avx2(dst, src, n);
+  #endif
+  #ifdef DG__MISC_HAVE_SSE2
+	if(simdLevel >= DG__MISC_SIMD_SSE2)  return DG__StrCopy_sse2(dst, src, n);
+  #endif
+	return DG__StrCopy_swar(dst, src, n);
+}
 
-	// TODO: this could use a variation of the trick used in DG_strnlen(), as described
-	//       on https://graphics.stanford.edu/~seander/bithacks.html#ValueInWord
+// DG_strlcpy() without the argument checks
+static size_t DG__strlcpy_level(char* dst, const char* src, size_t dstsize, int simdLevel)
+{
+	if(dstsize == 0)  return DG_strlen(src);
 
-	unsigned char* cur = (unsigned char*)buf + buflen;
-	const unsigned char* b = (const unsigned char*)buf;
-	while(cur > b) // aborts immediately if buflen == 0
-	{
-		--cur;
-		if(*cur == c) return cur;
-	}
+	size_t len = DG__StrCopy_level(dst, src, dstsize-1, simdLevel);
+	dst[len] = '\0';
+	// if dst is full, src might be longer - the return value is its whole length
+	if(len == dstsize-1)  len += DG_strlen(src + len);
+	return len;
+}
 
-	return NULL;
-#endif // _GNU_SOURCE
+DG_MISC_DEF size_t DG_strlcpy(char* dst, const char* src, size_t dstsize)
+{
+	DG_MISC_ASSERT(src && dst, "Don't call strlcpy with NULL arguments!");
+	return DG__strlcpy_level(dst, src, dstsize, DG__MISC_SIMD_LEVEL);
 }
 
-DG_MISC_DEF void* DG_memrmem(const void* haystack, size_t haystacklen,
-                             const void* needle, size_t needlelen)
+DG_MISC_DEF size_t DG_strlcat(char* dst, const char* src, size_t dstsize)
 {
-	DG_MISC_ASSERT((haystack != NULL || haystacklen == 0)
-			&& (needle != NULL || needlelen == 0),
-			"Don't pass NULL into DG_memrmem(), unless the corresponding len is 0!");
+	DG_MISC_ASSERT(src && dst, "Don't call strlcat with NULL arguments!");
 
-	unsigned char* h = (unsigned char*)haystack;
-	unsigned char* n = (unsigned char*)needle;
+	size_t dstlen = DG_strnlen(dst, dstsize);
+
+	DG_MISC_ASSERT(dstlen != dstsize, "dst must contain null-terminated data with strlen < dstsize!");
 
-	if(needlelen == 0) return (void*)(h+haystacklen); // this is kinda analog to DG_memmem()'s behavior
-	if(haystacklen < needlelen) return NULL; // also handles haystacklen == 0
+	// TODO: dst[dstsize-1] = '\0' to ensure null-termination and make wrong dstsize more obvious?
 
-	if(needlelen == 1) return (void*)DG_memrchr(haystack, n[0], haystacklen);
+	if(dstlen == dstsize)  return dstlen + DG_strlen(src);
 
-	// TODO: knuth-morris-pratt or boyer-moore or something like that might be a lot faster.
+	return dstlen + DG__strlcpy_level(dst+dstlen, src, dstsize-dstlen, DG__MISC_SIMD_LEVEL);
+}
 
-	// the byte after the last byte needle could start at so it'd still fit into haystack
-	unsigned char* afterlast = h + haystacklen - needlelen + 1;
-	// haystack length up to afterlast
-	size_t hlen_for_needle_start = afterlast - h;
-	int n0 = n[0];
-	unsigned char* n0candidate = (unsigned char*)DG_memrchr(h, n0, hlen_for_needle_start);
+// the search engine used by DG_memmem() (when not using glibc's memmem()) depends on the
+// length of the needle:
+// - needles of up to DG__MEMMEM_SHORT_MAXLEN bytes are searched with SSE2 by comparing
+//   16 possible start positions at once with the first and the last byte of the needle
+//   and only memcmp()ing the positions where both match
+// - needles of up to DG__MEMMEM_BMH_MAXLEN bytes (or short ones without SSE2) use
+//   Boyer-Moore-Horspool, which is usually very fast, but can degrade to O(n*m)
+// - long needles use the Two-Way algorithm, which is worst-case linear
+// To keep the whole thing worst-case linear, the first two engines keep track of how
+// many bytes they compared and continue with Two-Way if that gets out of hand
+// (e.g. when searching "aaaaaaab" in "aaaaaaaaaaaaaa...")
+// All engines take an icase argument for DG_memimem() and friends: if it's != 0, haystack
+// bytes are converted to lowercase (ASCII only) before comparing them (SIMD engines do that
+// in the registers), and the needle must already be lowercase (except for Two-Way)
+#define DG__MEMMEM_SHORT_MAXLEN 16
+#define DG__MEMMEM_BMH_MAXLEN   256
+
+// the "out of hand" check mentioned above: too many compared bytes for how far we got
+#define DG__MEMMEM_TOO_MUCH_WORK(work, progress) \
+	((work) > 4*(size_t)(progress) + 1024)
+
+// returns c converted to lowercase if icase != 0 and c is an ASCII letter, otherwise c
+static unsigned char DG__FoldCase(unsigned char c, int icase)
+{
+	// only 'A'..'Z' are < 26 after subtracting 'A' (the others wrap around),
+	// and 'a' - 'A' == 32
+	return (unsigned char)(c + ((icase && (unsigned char)(c - 'A') < 26) ? 32 : 0));
+}
 
-	while(n0candidate != NULL)
+// like memcmp(a, b, len) == 0, but if icase != 0, a is compared as if it was converted
+// with DG__FoldCase() (b must be lowercase then)
+static int DG__MemEqFold(const unsigned char* a, const unsigned char* b, size_t len, int icase)
+{
+	if(!icase)  return memcmp(a, b, len) == 0;
+	for(size_t i=0; i<len; ++i)
 	{
-		if(memcmp(n0candidate+1, n+1, needlelen-1) == 0)
-		{
-			return (void*)n0candidate;
-		}
-
-		// now n0candidate is the char *after* the end of the part of
-		// the string we still care about
-		hlen_for_needle_start = n0candidate - h;
-		n0candidate = (unsigned char*)DG_memrchr(h, n0, hlen_for_needle_start);
+		if(DG__FoldCase(a[i], 1) != b[i])  return 0;
 	}
-
-	return NULL; // not found
+	return 1;
 }
 
-DG_MISC_DEF char* DG_strrstr(const char* haystack, const char* needle)
+#ifdef DG__MISC_HAVE_SSE2
+// converts the ASCII letters in v to lowercase
+static __m128i DG__ToLower_sse2(__m128i v)
 {
-	size_t hLen = DG_strlen(haystack);
-	size_t nLen = DG_strlen(needle);
-	return (char*)DG_memrmem(haystack, hLen, needle, nLen);
+	// adding 128 - 'A' moves 'A'..'Z' to -128..-103 (as signed char), all other
+	// bytes end up greater than that - so one signed compare finds the uppercase letters
+	__m128i moved = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A')));
+	__m128i isUpper = _mm_cmplt_epi8(moved, _mm_set1_epi8((char)(0x80 + 26)));
+	return _mm_or_si128(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
 }
+#endif // DG__MISC_HAVE_SSE2
 
-/* 
- * public domain strtok_r() by Charlie Gordon
- * see http://groups.google.com/group/comp.lang.c/msg/2ab1ecbb86646684
- * and http://groups.google.com/group/comp.lang.c/msg/7c7b39328fefab9c
- * with a fix from Fletcher T. Penney, also in public domain,
- * see https://github.com/fletcher/MultiMarkdown-4/blob/master/strtok.c
- */
-DG_MISC_DEF char* DG_strtok_r(char* str, const char* delim, char** context)
+#ifdef DG__MISC_HAVE_AVX2
+// like DG__ToLower_sse2(), but for 32 bytes
+DG__MISC_TARGET_AVX2
+static __m256i DG__ToLower_avx2(__m256i v)
 {
-	DG_MISC_ASSERT(context && delim, "Don't call DG_strtok_r() with delim or context set to NULL!");
-	DG_MISC_ASSERT(str || *context, "Don't call DG_strtok_r() with *context and str both set to NULL!");
-
-#if !defined(DG_MISC_NO_GNU_SOURCE) && !defined(_WIN32)
-
-	// I think every interesting platform except for Windows supports strtok_r
-	// (if not, add it above with "&& !defined(_OTHER_CRAPPY_PLATFORM)")
-	return strtok_r(str, delim, context);
-
-#else // Windows
-
-	// I don't wanna use MSVC's strtok_s(), because C11 defines a function with
-	// that name but a totally different signature.. and it's not supported
-	// by old MSVC versions.
-	char* ret;
+	__m256i moved = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'A')));
+	__m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), moved);
+	return _mm256_or_si256(v, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+}
+#endif // DG__MISC_HAVE_AVX2
+
+// precomputed data for the Two-Way search (Crochemore and Perrin, 1991), combined
+// with a Boyer-Moore-Horspool-like shift table, similar to musl's memmem()
+typedef struct {
+	size_t ms;   // critical position: the needle is split into n[0..ms] and n[ms+1..nl-1]
+	size_t per;  // shift after the needle matched, or after a mismatch in the left half
+	size_t mem0; // number of needle bytes known to match after a shift by per (periodic needles)
+	size_t shift[256]; // shift[c] = 1 + index of last occurence of c in needle, 0 if not in needle
+} DG__TwoWay;
+
+// computes the maximal suffix of n (using reversed byte order if invert != 0),
+// returns the position before it and sets *period to its period
+// if rev != 0, the needle is read backwards (for DG_memrmem()),
+// if icase != 0, it's read as if it was converted to lowercase
+static size_t DG__TwoWayMaxSuffix(const unsigned char* n, size_t nl, int rev, int invert, int icase, size_t* period)
+{
+	size_t ip = (size_t)-1; // the "-1" is intended, only ip+k is used, which wraps around to k-1
+	size_t jp = 0, k = 1, p = 1;
+	while(jp+k < nl)
+	{
+		unsigned char a = DG__FoldCase(rev ? n[nl-1-(ip+k)] : n[ip+k], icase);
+		unsigned char b = DG__FoldCase(rev ? n[nl-1-(jp+k)] : n[jp+k], icase);
+		if(a == b)
+		{
+			if(k == p)
+			{
+				jp += p;
+				k = 1;
+			}
+			else ++k;
+		}
+		else if(invert ? (a < b) : (a > b))
+		{
+			jp += k;
+			k = 1;
+			p = jp - ip;
+		}
+		else
+		{
+			ip = jp++;
+			k = p = 1;
+		}
+	}
+	*period = p;
+	return ip;
+}
 
-	if (str == NULL) str = *context;
+// if rev != 0, tw is initialized for searching backwards with DG__TwoWaySearchRev(),
+// which works like searching the reversed needle in the reversed haystack.
+// if icase != 0, it's initialized for a case-insensitive search, then the needle
+// doesn't need to be lowercase (it's folded on the fly, here and when searching)
+static void DG__TwoWayInit(DG__TwoWay* tw, const unsigned char* n, size_t nl, int rev, int icase)
+{
+	size_t i, p0, p1;
 
-	if (str == NULL) return NULL;
+	memset(tw->shift, 0, sizeof(tw->shift));
+	for(i=0; i<nl; ++i)
+	{
+		// for case-insensitive searches, both cases of a letter get the same entry,
+		// so haystack bytes can be looked up without folding them
+		unsigned char c = DG__FoldCase(rev ? n[nl-1-i] : n[i], icase);
+		tw->shift[c] = i+1;
+		if(icase && (unsigned char)(c - 'a') < 26)  tw->shift[c - 32] = i+1;
+	}
 
-	str += strspn(str, delim);
+	// the critical factorization is at the longer one of the two maximal suffixes
+	size_t ms = DG__TwoWayMaxSuffix(n, nl, rev, 0, icase, &p0);
+	size_t ms1 = DG__TwoWayMaxSuffix(n, nl, rev, 1, icase, &p1);
+	if(ms1+1 > ms+1)
+	{
+		ms = ms1;
+		p0 = p1;
+	}
+	tw->ms = ms;
 
-	if (*str == '\0') return NULL;
+	// p0 is a period of the right half; if it's also one of the whole needle, it's periodic
+	int periodic = 1;
+	if(!icase)
+	{
+		periodic = rev ? (memcmp(n+nl-1-ms, n+nl-1-ms-p0, ms+1) == 0)
+		               : (memcmp(n, n+p0, ms+1) == 0);
+	}
+	else
+	{
+		const unsigned char* a = rev ? n+nl-1-ms : n;
+		const unsigned char* b = rev ? n+nl-1-ms-p0 : n+p0;
+		for(i=0; i<ms+1 && periodic; ++i)  periodic = DG__FoldCase(a[i], 1) == DG__FoldCase(b[i], 1);
+	}
+	if(periodic)
+	{
+		tw->per = p0;
+		tw->mem0 = nl - p0;
+	}
+	else
+	{
+		tw->per = ((ms > nl-ms-1) ? ms : nl-ms-1) + 1;
+		tw->mem0 = 0;
+	}
+}
 
-	ret = str;
+// mem is the number of bytes at the start of h that are known to match - usually 0,
+// but to continue searching after a match at m, pass h = m + tw->per and mem = tw->mem0
+// icase must be the same that was passed to DG__TwoWayInit()
+static void* DG__TwoWaySearch(const DG__TwoWay* tw, const unsigned char* h, size_t hl,
+                              const unsigned char* n, size_t nl, size_t mem, int icase)
+{
+	const unsigned char* hend = h + hl;
+	size_t k;
 
-	str += strcspn(str, delim);
+	while((size_t)(hend - h) >= nl)
+	{
+		// check last byte first, on mismatch advance like Boyer-Moore-Horspool
+		size_t s = tw->shift[h[nl-1]];
+		if(s != nl)
+		{
+			k = nl - s; // if s == 0 (byte not in needle), it skips the whole needle length
+			if(k < mem)  k = mem;
+			h += k;
+			mem = 0;
+			continue;
+		}
 
-	if (*str) *str++ = '\0';
+		// compare right half
+		for(k = (tw->ms+1 > mem) ? tw->ms+1 : mem;
+		    k < nl && DG__FoldCase(n[k], icase) == DG__FoldCase(h[k], icase); ++k) {}
+		if(k < nl)
+		{
+			h += k - tw->ms;
+			mem = 0;
+			continue;
+		}
 
-	*context = str;
+		// compare left half
+		for(k = tw->ms+1; k > mem && DG__FoldCase(n[k-1], icase) == DG__FoldCase(h[k-1], icase); --k) {}
+		if(k <= mem)  return (void*)h;
 
-	return ret;
-#endif // _WIN32
+		h += tw->per;
+		mem = tw->mem0;
+	}
+	return NULL;
 }
 
-// helper for DG_strnlen() that checks the next sizeof(uintptr_t) bytes
-// (starting at cur) for '\0', returns whole string length based on base string s
-// SHOULD ONLY BE CALLED IF YOU'RE SURE THOSE BYTES CONTAIN A TERMINATING NULL BYTE!
-static size_t _DG_strnlen_nextWordOnly(const char* s, const char* cur, size_t n)
+static void* DG__memmem_twoway(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl, int icase)
 {
-
-	if(  *cur == '\0')  return cur - s;
-	if(*++cur == '\0')  return cur - s;
-	if(*++cur == '\0')  return cur - s;
-	if(*++cur == '\0')  return cur - s;
-
-  #ifdef DG_MISC_IS_64BIT // 4 more bytes per uintptr_t
-	if(*++cur == '\0')  return cur - s;
-	if(*++cur == '\0')  return cur - s;
-	if(*++cur == '\0')  return cur - s;
-	if(*++cur == '\0')  return cur - s;
-  #endif // 64bit
-
-	DG_MISC_ASSERT( 0, "_DG_strnlen_nextWordOnly() should only be called if the next word actually contains a '\0' !" );
-	return n;
+	DG__TwoWay tw;
+	DG__TwoWayInit(&tw, n, nl, 0, icase);
+	return DG__TwoWaySearch(&tw, h, hl, n, nl, 0, icase);
 }
 
-
-DG_MISC_DEF size_t DG_strnlen(const char* s, size_t n)
+// Boyer-Moore-Horspool for needles of up to DG__MEMMEM_BMH_MAXLEN bytes
+static void* DG__memmem_bmh(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl, int icase)
 {
-	DG_MISC_ASSERT(s != NULL, "Don't call DG_strnlen() with NULL!");
-
-#if (defined(__GLIBC__) || defined(__APPLE__)) && !defined(DG_MISC_NO_GNU_SOURCE)
+	DG_MISC_ASSERT(nl >= 2 && nl <= DG__MEMMEM_BMH_MAXLEN && hl >= nl, "invalid arguments to DG__memmem_bmh()");
+
+	// the needle is short enough for the shifts to fit into an unsigned short,
+	// which keeps the table small enough to be initialized quickly
+	unsigned short shift[256];
+	size_t i, work = 0;
+	for(i=0; i<256; ++i)  shift[i] = (unsigned short)nl;
+	for(i=0; i<nl-1; ++i)
+	{
+		// for case-insensitive searches, the uppercase version of each letter gets the same
+		// shift as the lowercase one, so haystack bytes can be looked up without folding them
+		shift[n[i]] = (unsigned short)(nl-1-i);
+		if(icase && (unsigned char)(n[i] - 'a') < 26)  shift[n[i] - 32] = (unsigned short)(nl-1-i);
+	}
 
-	// glibc has a very optimized version of this, use that instead
-	// apple also seems to have optimized ASM code, see
-	// http://www.opensource.apple.com/source/Libc/Libc-1044.1.2/x86_64/string/
-	return strnlen(s, n);
-#else
-	// at least microsoft and freebsd seem to use a naive strnlen() without
-	// any tricks which is usually slower than this
+	const unsigned char* cur = h;
+	const unsigned char* last = h + hl - nl; // last position the needle could start at
+	unsigned char nlast = n[nl-1];
 
-	// uses a magic trick from https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord
-	// (and probably in 1000 other places) to decide whether sizeof(uintptr_t) bytes
-	// contain a '\0' or not. without branching, with relatively few instructions
-	// that trick only works (at least in the way I've implemented it) with 32bit and 64bit systems
-	DG_MISC_STATIC_ASSERT(sizeof(uintptr_t) == 4 || sizeof(uintptr_t) == 8, DG_strnlen_only_supports_32_and_64_bit_systems);
+	while(cur <= last)
+	{
+		unsigned char c = cur[nl-1];
+		if(DG__FoldCase(c, icase) == nlast)
+		{
+			if(DG__MemEqFold(cur, n, nl-1, icase))  return (void*)cur;
+
+			work += nl;
+			if(DG__MEMMEM_TOO_MUCH_WORK(work, cur - h))
+			{
+				// pathological input, switch to Two-Way for the rest of the haystack
+				return DG__memmem_twoway(cur+1, last - cur + nl - 1, n, nl, icase);
+			}
+		}
+		cur += shift[c];
+	}
+	return NULL;
+}
 
-	// these magic numbers are used for the trick:
-#ifdef DG_MISC_IS_32BIT
-	static const uintptr_t magic1 = 0x01010101uL;
-	static const uintptr_t magic2 = 0x80808080uL;
-#elif defined(DG_MISC_IS_64BIT)
-	static const uintptr_t magic1 = 0x0101010101010101uLL;
-	static const uintptr_t magic2 = 0x8080808080808080uLL;
-#else
-	#error "no 32 or 64bit platform?!"
-#endif
+#ifdef DG__MISC_HAVE_SSE2
+// SSE2 search for needles of 2 to DG__MEMMEM_SHORT_MAXLEN bytes
+static void* DG__memmem_short_sse2(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl, int icase)
+{
+	DG_MISC_ASSERT(nl >= 2 && nl <= DG__MEMMEM_SHORT_MAXLEN && hl >= nl, "invalid arguments to DG__memmem_short_sse2()");
 
-	// size of a native "word" of this platform
-	static const size_t WordSize = sizeof(uintptr_t);
+	const unsigned char* cur = h;
+	const unsigned char* last = h + hl - nl; // last position the needle could start at
+	size_t work = 0;
 
-	// the magic trick requires at least WordSize bytes
-	// if we get less, check those bytes directly without the magic trick
-	if(n < WordSize)
+	if(hl >= nl + 15)
 	{
-		const char* cur=s;
-		
-		// the following basically unrolls this simple loop:
-		// for(size_t i=0; i<n; ++i, ++cur)
-		//     if(*cur == '\0') return cur-s;
-		// and indeed seems to be faster
+		const __m128i first = _mm_set1_epi8((char)n[0]);
+		const __m128i lastb = _mm_set1_epi8((char)n[nl-1]);
+		// the last address we can check 16 start positions at without reading past the haystack
+		const unsigned char* lastBlock = last - 15;
 
-		if(n == 0 || *cur == '\0')
-			return 0;
+		for( ; cur <= lastBlock; cur += 16)
+		{
+			__m128i bf = _mm_loadu_si128((const __m128i*)cur);
+			__m128i bl = _mm_loadu_si128((const __m128i*)(cur + nl - 1));
+			if(icase)
+			{
+				bf = DG__ToLower_sse2(bf);
+				bl = DG__ToLower_sse2(bl);
+			}
+			unsigned int mask = (unsigned int)_mm_movemask_epi8(
+					_mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, lastb)) );
+
+			while(mask != 0)
+			{
+				// first and last byte match at this position, compare the ones in between
+				const unsigned char* cand = cur + DG__LowestBitIdx(mask);
+				if(DG__MemEqFold(cand+1, n+1, nl-2, icase))  return (void*)cand;
+				mask &= mask - 1; // clear lowest set bit
+				work += nl;
+			}
+
+			if(DG__MEMMEM_TOO_MUCH_WORK(work, cur - h))
+			{
+				// pathological input, switch to Two-Way for the rest of the haystack
+				cur += 16;
+				return DG__memmem_twoway(cur, h + hl - cur, n, nl, icase);
+			}
+		}
+	}
 
-		switch(n) {
-	#ifdef DG_MISC_IS_64BIT // 64bit has 8 bytes, so check 4 more
-			case 7: if(*++cur == '\0') return cur-s;
-			        // else fall-through to check next char
-			case 6: if(*++cur == '\0') return cur-s;
-			case 5: if(*++cur == '\0') return cur-s;
-			case 4: if(*++cur == '\0') return cur-s;
-	#endif // DG_MISC_IS_64BIT
-			case 3: if(*++cur == '\0') return cur-s;
-			case 2: if(*++cur == '\0') return cur-s;
-			// no case 1:, because s[0] has already been checked in the `if` above
+	// less than 16 possible start positions left
+	for( ; cur <= last; ++cur)
+	{
+		if(DG__FoldCase(cur[0], icase) == n[0] && DG__FoldCase(cur[nl-1], icase) == n[nl-1]
+		   && DG__MemEqFold(cur+1, n+1, nl-2, icase))
+		{
+			return (void*)cur;
 		}
-		return n;
 	}
+	return NULL;
+}
+#endif // DG__MISC_HAVE_SSE2
 
-	const char* s_end = s + n; // pointer to byte *after* last valid byte
+#ifdef DG__MISC_HAVE_AVX2
+// like DG__memmem_short_sse2(), but checks 32 possible start positions at once
+DG__MISC_TARGET_AVX2
+static void* DG__memmem_short_avx2(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl, int icase)
+{
+	DG_MISC_ASSERT(nl >= 2 && nl <= DG__MEMMEM_SHORT_MAXLEN && hl >= nl, "invalid arguments to DG__memmem_short_avx2()");
 
-#ifdef DG_MISC_STRLEN_UNALIGNED
-	// on some machines it's fastest to just do unaligned WordSize-d reads
-	// for the whole string (or at least as far as possible without over-reading)
+	const unsigned char* cur = h;
+	size_t work = 0;
 
-	const char* cur = s;
-	// the last address where we can do a WordSize-d read without "over-reading"
-	// (i.e. without reading behind the end of the buffer)
-	const char* safeLast = s_end - WordSize;
-	for( ; cur <= safeLast; cur += WordSize )
+	if(hl >= nl + 31)
 	{
-		// do the magic trick on WordSize bytes at a time
-		// (as the bytes may be unaligned, use memcpy() to prevent an
-		//  unaligned load into the uintptr_t, in case the platform
-		//  doesn't support that. if it does, the compiler should convert
-		//  the memcpy() to such a load, at least when using optimizations)
+		const __m256i first = _mm256_set1_epi8((char)n[0]);
+		const __m256i lastb = _mm256_set1_epi8((char)n[nl-1]);
+		const unsigned char* lastBlock = h + hl - nl - 31;
 
-		uintptr_t tmp;
-		memcpy(&tmp, cur, WordSize);
-		// for some reason, on RPi4 32bit with really short strings the
-		// following generates faster code than memcpy() (with GCC 10.2),
-		// even though memcpy() isn't called either way
-		//tmp = *(uintptr_t*)cur;
-		uintptr_t m1 = tmp - magic1;
-		uintptr_t m2 = (~tmp) & magic2;
-		if(m1 & m2)
+		for( ; cur <= lastBlock; cur += 32)
 		{
-			return _DG_strnlen_nextWordOnly(s, cur, n);
+			__m256i bf = _mm256_loadu_si256((const __m256i*)cur);
+			__m256i bl = _mm256_loadu_si256((const __m256i*)(cur + nl - 1));
+			if(icase)
+			{
+				bf = DG__ToLower_avx2(bf);
+				bl = DG__ToLower_avx2(bl);
+			}
+			unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+					_mm256_and_si256(_mm256_cmpeq_epi8(bf, first), _mm256_cmpeq_epi8(bl, lastb)) );
+
+			while(mask != 0)
+			{
+				const unsigned char* cand = cur + DG__LowestBitIdx(mask);
+				if(DG__MemEqFold(cand+1, n+1, nl-2, icase))  return (void*)cand;
+				mask &= mask - 1;
+				work += nl;
+			}
+
+			if(DG__MEMMEM_TOO_MUCH_WORK(work, cur - h))
+			{
+				cur += 32;
+				return DG__memmem_twoway(cur, h + hl - cur, n, nl, icase);
+			}
 		}
 	}
 
-#else // ! DG_MISC_STRLEN_UNALIGNED
-	// on other machines it's faster to do aligned WordSize-d reads
+	// less than 32 possible start positions left, SSE2 can handle that
+	if((size_t)(h + hl - cur) < nl)  return NULL;
+	return DG__memmem_short_sse2(cur, h + hl - cur, n, nl, icase);
+}
+#endif // DG__MISC_HAVE_AVX2
 
-	// bitmask to align a pointer address to a multiple of WordSize
-	static const uintptr_t WordAlignMask = ~(uintptr_t)(WordSize-1);
+// DG_memmem() (or DG_memimem() if icase != 0) without the argument checks, and without
+// using glibc's memmem(), simdLevel (DG__MISC_SIMD_*) selects the kernel for short needles
+static void* DG__memmem_level(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl,
+                              int simdLevel, int icase)
+{
+	(void)simdLevel; // unused if DG_MISC_NO_SIMD is #defined
+	if(nl == 0) return (void*)h; // this is what glibc does..
+	if(hl < nl) return NULL; // also handles hl == 0
 
-	// s aligned to the next word boundary
-	uintptr_t s_alnI = ((uintptr_t)s + WordSize - 1) & WordAlignMask;
-	const uintptr_t* s_aln = (const uintptr_t *)s_alnI;
+	// all engines but Two-Way need a lowercase needle for case-insensitive searches
+	unsigned char lowerNeedle[DG__MEMMEM_BMH_MAXLEN];
+	if(icase && nl <= DG__MEMMEM_BMH_MAXLEN)
+	{
+		for(size_t i=0; i<nl; ++i)  lowerNeedle[i] = DG__FoldCase(n[i], 1);
+		n = lowerNeedle;
+	}
 
-	// check bytes between s and s_aln (if any)
-	if(s != (const char*)s_aln)
+	if(nl == 1)
 	{
-		// first try the magic trick for the first unaligned bytes ..
-		// (as they're unaligned, use memcpy() to prevent an unaligned read,
-		//  in case the platform doesn't support that. if it does, the
-		//  compiler should convert the memcpy() to such a read,
-		//  at least when using optimizations)
-		uintptr_t tmp;
-		memcpy(&tmp, s, WordSize);
-		uintptr_t m1 = tmp - magic1;
-		uintptr_t m2 = (~tmp) & magic2;
-		if(m1 & m2)
+		const unsigned char* ret = (const unsigned char*)memchr(h, n[0], hl);
+		if(icase && (unsigned char)(n[0] - 'a') < 26)
 		{
-			return _DG_strnlen_nextWordOnly(s, s, n);
+			// the uppercase letter only matters if it comes before the lowercase one
+			const unsigned char* up = (const unsigned char*)memchr(h, n[0] - 32, ret ? (size_t)(ret - h) : hl);
+			if(up != NULL)  ret = up;
 		}
+		return (void*)ret;
 	}
 
-	// in the main loop we read WordSize bytes at a time, so we may need to stop
-	// at least WordSize bytes before s_end to prevent reading past the end of the buffer
-	const uintptr_t* s_endAln = (const uintptr_t*)((uintptr_t)s_end & WordAlignMask);
-
-	// .. then use the trick to test WordSize bytes at a time,
-	// always aligned to WordSize bytes so we can use the chars
-	// casted to uintptr_t instead of copying first
-	for( ; s_aln != s_endAln; ++s_aln)
+	if(nl <= DG__MEMMEM_SHORT_MAXLEN)
 	{
-		// again, the magic trick
-		uintptr_t m1 = *s_aln - magic1;
-		uintptr_t m2 = (~(*s_aln)) & magic2;
-
-		if(m1 & m2)
-		{
-			return _DG_strnlen_nextWordOnly(s, (const char*)s_aln, n);
-		}
+  #ifdef DG__MISC_HAVE_AVX2
+		if(simdLevel >= DG__MISC_SIMD_AVX2)  return DG__memmem_short_avx2(h, hl, n, nl, icase);
+  #endif
+  #ifdef DG__MISC_HAVE_SSE2
+		if(simdLevel >= DG__MISC_SIMD_SSE2)  return DG__memmem_short_sse2(h, hl, n, nl, icase);
+  #endif
 	}
 
-	// now s_aln is at s_endAln, behind the last (full) aligned WordSize-d chunk
-	// of the string - so we only need to check the few last bytes from that point on
+	if(nl <= DG__MEMMEM_BMH_MAXLEN)  return DG__memmem_bmh(h, hl, n, nl, icase);
 
-	const char* cur = (const char*)s_endAln;
+	return DG__memmem_twoway(h, hl, n, nl, icase);
+}
 
-#endif // DG_MISC_STRLEN_UNALIGNED
+#ifdef DG__MISC_DISPATCH
+// the DG_memmem() implementations for the dispatch tables
+static void* DG__memmem_c(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl)
+{
+	return DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_NONE, 0);
+}
 
-	// if we got this far then I think it's very likely that one of the last bytes
-	// is \0, so check them directly instead of using the magic trick
-	// (which in case of a match needs to check them again anyway)
-	// the underlying assumption is that most of the time when calling strnlen()
-	// the string indeed is \0 terminated within the first n bytes
+static void* DG__memmem_sse2(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl)
+{
+	return DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_SSE2, 0);
+}
 
-	size_t remaining = s_end - cur; // should be < WordSize
-	if(remaining != 0)
-	{
-		DG_MISC_ASSERT(remaining < WordSize, "expected to have less that wordsize (sizeof(uintptr_t)) chars left");
+static void* DG__memmem_avx2(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl)
+{
+	return DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_AVX2, 0);
+}
+#endif // DG__MISC_DISPATCH
 
-		// same loop-unrolling trick as in if(n < WordSize) above
-		if(*cur == '\0')
-			return cur - s;
+DG_MISC_DEF void* DG_memmem(const void* haystack, size_t haystacklen,
+                            const void* needle, size_t needlelen)
+{
+	DG_MISC_ASSERT((haystack != NULL || haystacklen == 0)
+			&& (needle != NULL || needlelen == 0),
+			"Don't pass NULL into DG_memmem(), unless the corresponding len is 0!");
 
-		switch(remaining) {
-		#ifdef DG_MISC_IS_64BIT // 64bit has 8 bytes, so check 4 more
-			case 7: if(*++cur == '\0') return cur-s;
-			        // else fall through to check next byte
-			case 6: if(*++cur == '\0') return cur-s;
-			case 5: if(*++cur == '\0') return cur-s;
-			case 4: if(*++cur == '\0') return cur-s;
-		#endif
-			case 3: if(*++cur == '\0') return cur-s;
-			case 2: if(*++cur == '\0') return cur-s;
-			// no case 1 - we already checked one char in the if above
+#if defined(_GNU_SOURCE) && !defined(DG_MISC_NO_GNU_SOURCE)
+	// glibc has a very optimized version of this, use that instead
+	return memmem(haystack, haystacklen, needle, needlelen);
+#elif defined(DG__MISC_DISPATCH)
+	return DG__MiscGetKernels()->memmem((const unsigned char*)haystack, haystacklen,
+	                                    (const unsigned char*)needle, needlelen);
+#else
+	return DG__memmem_level((const unsigned char*)haystack, haystacklen,
+	                        (const unsigned char*)needle, needlelen, DG__MISC_SIMD_DEFAULT, 0);
+#endif // _GNU_SOURCE
+}
 
-			// if not returned yet, we'll default to return n below
-		}
-	}
+DG_MISC_DEF void* DG_memimem(const void* haystack, size_t haystacklen,
+                             const void* needle, size_t needlelen)
+{
+	DG_MISC_ASSERT((haystack != NULL || haystacklen == 0)
+			&& (needle != NULL || needlelen == 0),
+			"Don't pass NULL into DG_memimem(), unless the corresponding len is 0!");
 
-	return n;
+	return DG__memmem_level((const unsigned char*)haystack, haystacklen,
+	                        (const unsigned char*)needle, needlelen, DG__MISC_SIMD_LEVEL, 1);
+}
 
+DG_MISC_DEF char* DG_strcasestr(const char* haystack, const char* needle)
+{
+	size_t hLen = DG_strlen(haystack);
+	size_t nLen = DG_strlen(needle);
+	return (char*)DG_memimem(haystack, hLen, needle, nLen);
+}
+
+
+// plain C implementation of DG_memrchr() that checks sizeof(uintptr_t) bytes at once
+// using a variation of the trick used in DG_strnlen(): each byte of a word is XORed
+// with c, so bytes that are c become 0 - and then it checks for a 0 byte
+DG__MISC_MAYBE_UNUSED
+static void* DG__memrchr_swar(const unsigned char* b, unsigned char c, size_t len)
+{
+	static const size_t WordSize = sizeof(uintptr_t);
+	const uintptr_t cccc = DG__MISC_MAGIC1 * c; // c in every byte of the word
+	const unsigned char* cur = b + len;
+
+	// check bytewise until cur is aligned to WordSize
+	while(cur > b && ((uintptr_t)cur & (WordSize-1)) != 0)
+	{
+		--cur;
+		if(*cur == c)  return (void*)cur;
+	}
+
+	while((size_t)(cur - b) >= WordSize)
+	{
+		cur -= WordSize;
+		uintptr_t w = *(const uintptr_t*)cur ^ cccc;
+		if(DG__MISC_HAS_ZERO_BYTE(w))
+		{
+			// the trick has no false positives if the word contains a c,
+			// so at least one of these bytes is c - find the last one
+			size_t i;
+			for(i=WordSize; i>0; --i)
+			{
+				if(cur[i-1] == c)  return (void*)(cur+i-1);
+			}
+		}
+	}
+
+	// check the remaining bytes at the start of b
+	while(cur > b)
+	{
+		--cur;
+		if(*cur == c)  return (void*)cur;
+	}
+	return NULL;
+}
+
+#ifdef DG__MISC_HAVE_SSE2
+// SSE2 implementation of DG_memrchr(), checks 16 bytes at once
+DG__MISC_MAYBE_UNUSED
+static void* DG__memrchr_sse2(const unsigned char* b, unsigned char c, size_t len)
+{
+	if(len < 16)  return DG__memrchr_swar(b, c, len);
+
+	const __m128i vc = _mm_set1_epi8((char)c);
+	size_t rem = len;
+	while(rem >= 16)
+	{
+		rem -= 16;
+		__m128i v = _mm_loadu_si128((const __m128i*)(b + rem));
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, vc));
+		if(mask != 0)  return (void*)(b + rem + DG__HighestBitIdx(mask));
+	}
+	if(rem > 0)
+	{
+		// the first rem bytes haven't been checked yet. check the first 16 bytes
+		// (we know that len >= 16) and ignore the ones that were already checked
+		__m128i v = _mm_loadu_si128((const __m128i*)b);
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, vc));
+		mask &= (1u << rem) - 1;
+		if(mask != 0)  return (void*)(b + DG__HighestBitIdx(mask));
+	}
+	return NULL;
+}
+#endif // DG__MISC_HAVE_SSE2
+
+#ifdef DG__MISC_HAVE_AVX2
+// AVX2 implementation of DG_memrchr(), checks 32 bytes at once
+DG__MISC_TARGET_AVX2 DG__MISC_MAYBE_UNUSED
+static void* DG__memrchr_avx2(const unsigned char* b, unsigned char c, size_t len)
+{
+	if(len < 32)  return DG__memrchr_sse2(b, c, len);
+
+	const __m256i vc = _mm256_set1_epi8((char)c);
+	size_t rem = len;
+	while(rem >= 32)
+	{
+		rem -= 32;
+		__m256i v = _mm256_loadu_si256((const __m256i*)(b + rem));
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vc));
+		if(mask != 0)  return (void*)(b + rem + DG__HighestBitIdx(mask));
+	}
+	if(rem > 0)
+	{
+		// same as in DG__memrchr_sse2(): check first 32 bytes, ignore already checked ones
+		__m256i v = _mm256_loadu_si256((const __m256i*)b);
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vc));
+		mask &= (1u << rem) - 1;
+		if(mask != 0)  return (void*)(b + DG__HighestBitIdx(mask));
+	}
+	return NULL;
+}
+#endif // DG__MISC_HAVE_AVX2
+
+DG_MISC_DEF void* DG_memrchr(const void* buf, unsigned char c, size_t buflen)
+{
+	DG_MISC_ASSERT(buf != NULL, "Don't pass NULL into DG_memrchr()!");
+#if defined(_GNU_SOURCE) && !defined(DG_MISC_NO_GNU_SOURCE)
+	// glibc has a very optimized version of this, use that instead
+	return (void*)memrchr(buf, c, buflen);
+#elif defined(DG__MISC_DISPATCH)
+	return DG__MiscGetKernels()->memrchr((const unsigned char*)buf, c, buflen);
+#elif defined(DG__MISC_ALWAYS_AVX2)
+	return DG__memrchr_avx2((const unsigned char*)buf, c, buflen);
+#elif defined(DG__MISC_HAVE_SSE2)
+	return DG__memrchr_sse2((const unsigned char*)buf, c, buflen);
+#else
+	return DG__memrchr_swar((const unsigned char*)buf, c, buflen);
+#endif // _GNU_SOURCE
+}
+
+// DG_memrmem() uses the same search engines as DG_memmem(), just mirrored
+
+// like DG__TwoWaySearch(), but returns the last match. tw must have been
+// initialized with DG__TwoWayInit(tw, n, nl, 1, icase)
+static void* DG__TwoWaySearchRev(const DG__TwoWay* tw, const unsigned char* h, size_t hl,
+                                 const unsigned char* n, size_t nl, int icase)
+{
+	const unsigned char* e = h + hl; // end of the part of the haystack that's still searched
+	const unsigned char* nend = n + nl;
+	size_t k, mem = 0; // mem: number of bytes at end of e that are known to match
+
+	while((size_t)(e - h) >= nl)
+	{
+		// check first byte of the candidate first, on mismatch advance like Boyer-Moore-Horspool
+		size_t s = tw->shift[*(e - nl)];
+		if(s != nl)
+		{
+			k = nl - s;
+			if(k < mem)  k = mem;
+			e -= k;
+			mem = 0;
+			continue;
+		}
+
+		// compare "right" half (which is at the end of the needle)
+		for(k = (tw->ms+1 > mem) ? tw->ms+1 : mem;
+		    k < nl && DG__FoldCase(nend[-1-(ptrdiff_t)k], icase) == DG__FoldCase(e[-1-(ptrdiff_t)k], icase); ++k) {}
+		if(k < nl)
+		{
+			e -= k - tw->ms;
+			mem = 0;
+			continue;
+		}
+
+		// compare "left" half (which is at the start of the needle)
+		for(k = tw->ms+1;
+		    k > mem && DG__FoldCase(nend[-(ptrdiff_t)k], icase) == DG__FoldCase(e[-(ptrdiff_t)k], icase); --k) {}
+		if(k <= mem)  return (void*)(e - nl);
+
+		e -= tw->per;
+		mem = tw->mem0;
+	}
+	return NULL;
+}
+
+static void* DG__memrmem_twoway(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl, int icase)
+{
+	DG__TwoWay tw;
+	DG__TwoWayInit(&tw, n, nl, 1, icase);
+	return DG__TwoWaySearchRev(&tw, h, hl, n, nl, icase);
+}
+
+// Boyer-Moore-Horspool (backwards) for needles of up to DG__MEMMEM_BMH_MAXLEN bytes
+static void* DG__memrmem_bmh(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl, int icase)
+{
+	DG_MISC_ASSERT(nl >= 2 && nl <= DG__MEMMEM_BMH_MAXLEN && hl >= nl, "invalid arguments to DG__memrmem_bmh()");
+
+	unsigned short shift[256];
+	size_t i, work = 0;
+	for(i=0; i<256; ++i)  shift[i] = (unsigned short)nl;
+	for(i=nl-1; i>0; --i)
+	{
+		// same trick for case-insensitive searches as in DG__memmem_bmh()
+		shift[n[i]] = (unsigned short)i;
+		if(icase && (unsigned char)(n[i] - 'a') < 26)  shift[n[i] - 32] = (unsigned short)i;
+	}
+
+	size_t pos = hl - nl; // current position the needle could start at
+	size_t lastPos = pos;
+	unsigned char nfirst = n[0];
+
+	for(;;)
+	{
+		unsigned char c = h[pos];
+		if(DG__FoldCase(c, icase) == nfirst)
+		{
+			if(DG__MemEqFold(h+pos+1, n+1, nl-1, icase))  return (void*)(h+pos);
+
+			work += nl;
+			if(DG__MEMMEM_TOO_MUCH_WORK(work, lastPos - pos))
+			{
+				// pathological input, switch to Two-Way for the rest of the haystack
+				return DG__memrmem_twoway(h, pos + nl - 1, n, nl, icase);
+			}
+		}
+		if(pos < shift[c])  break;
+		pos -= shift[c];
+	}
+	return NULL;
+}
+
+#ifdef DG__MISC_HAVE_SSE2
+// SSE2 backwards search for needles of 2 to DG__MEMMEM_SHORT_MAXLEN bytes
+static void* DG__memrmem_short_sse2(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl, int icase)
+{
+	DG_MISC_ASSERT(nl >= 2 && nl <= DG__MEMMEM_SHORT_MAXLEN && hl >= nl, "invalid arguments to DG__memrmem_short_sse2()");
+
+	// the start positions that haven't been checked yet are 0 .. numPos-1
+	size_t numPos = hl - nl + 1;
+	size_t allPos = numPos;
+	size_t work = 0;
+
+	const __m128i first = _mm_set1_epi8((char)n[0]);
+	const __m128i lastb = _mm_set1_epi8((char)n[nl-1]);
+
+	while(numPos >= 16)
+	{
+		const unsigned char* cur = h + numPos - 16;
+		__m128i bf = _mm_loadu_si128((const __m128i*)cur);
+		__m128i bl = _mm_loadu_si128((const __m128i*)(cur + nl - 1));
+		if(icase)
+		{
+			bf = DG__ToLower_sse2(bf);
+			bl = DG__ToLower_sse2(bl);
+		}
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(
+				_mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, lastb)) );
+
+		while(mask != 0)
+		{
+			// first and last byte match at this position, compare the ones in between
+			int idx = DG__HighestBitIdx(mask);
+			if(DG__MemEqFold(cur+idx+1, n+1, nl-2, icase))  return (void*)(cur+idx);
+			mask &= ~(1u << idx); // clear highest set bit
+			work += nl;
+		}
+
+		numPos -= 16;
+		if(DG__MEMMEM_TOO_MUCH_WORK(work, allPos - numPos))
+		{
+			// pathological input, switch to Two-Way for the rest of the haystack
+			return DG__memrmem_twoway(h, numPos + nl - 1, n, nl, icase);
+		}
+	}
+
+	// less than 16 possible start positions left
+	while(numPos > 0)
+	{
+		const unsigned char* cur = h + (--numPos);
+		if(DG__FoldCase(cur[0], icase) == n[0] && DG__FoldCase(cur[nl-1], icase) == n[nl-1]
+		   && DG__MemEqFold(cur+1, n+1, nl-2, icase))
+		{
+			return (void*)cur;
+		}
+	}
+	return NULL;
+}
+#endif // DG__MISC_HAVE_SSE2
+
+#ifdef DG__MISC_HAVE_AVX2
+// like DG__memrmem_short_sse2(), but checks 32 possible start positions at once
+DG__MISC_TARGET_AVX2
+static void* DG__memrmem_short_avx2(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl, int icase)
+{
+	DG_MISC_ASSERT(nl >= 2 && nl <= DG__MEMMEM_SHORT_MAXLEN && hl >= nl, "invalid arguments to DG__memrmem_short_avx2()");
+
+	size_t numPos = hl - nl + 1;
+	size_t allPos = numPos;
+	size_t work = 0;
+
+	const __m256i first = _mm256_set1_epi8((char)n[0]);
+	const __m256i lastb = _mm256_set1_epi8((char)n[nl-1]);
+
+	while(numPos >= 32)
+	{
+		const unsigned char* cur = h + numPos - 32;
+		__m256i bf = _mm256_loadu_si256((const __m256i*)cur);
+		__m256i bl = _mm256_loadu_si256((const __m256i*)(cur + nl - 1));
+		if(icase)
+		{
+			bf = DG__ToLower_avx2(bf);
+			bl = DG__ToLower_avx2(bl);
+		}
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+				_mm256_and_si256(_mm256_cmpeq_epi8(bf, first), _mm256_cmpeq_epi8(bl, lastb)) );
+
+		while(mask != 0)
+		{
+			int idx = DG__HighestBitIdx(mask);
+			if(DG__MemEqFold(cur+idx+1, n+1, nl-2, icase))  return (void*)(cur+idx);
+			mask &= ~(1u << idx);
+			work += nl;
+		}
+
+		numPos -= 32;
+		if(DG__MEMMEM_TOO_MUCH_WORK(work, allPos - numPos))
+		{
+			return DG__memrmem_twoway(h, numPos + nl - 1, n, nl, icase);
+		}
+	}
+
+	// less than 32 possible start positions left, SSE2 can handle that
+	if(numPos == 0)  return NULL;
+	return DG__memrmem_short_sse2(h, numPos + nl - 1, n, nl, icase);
+}
+#endif // DG__MISC_HAVE_AVX2
+
+// DG_memrmem() (or DG_memrimem() if icase != 0) without the argument checks,
+// simdLevel (DG__MISC_SIMD_*) selects the kernel for short needles
+static void* DG__memrmem_level(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl,
+                               int simdLevel, int icase)
+{
+	(void)simdLevel; // unused if DG_MISC_NO_SIMD is #defined
+	if(nl == 0) return (void*)(h+hl); // this is kinda analog to DG_memmem()'s behavior
+	if(hl < nl) return NULL; // also handles hl == 0
+
+	// all engines but Two-Way need a lowercase needle for case-insensitive searches
+	unsigned char lowerNeedle[DG__MEMMEM_BMH_MAXLEN];
+	if(icase && nl <= DG__MEMMEM_BMH_MAXLEN)
+	{
+		for(size_t i=0; i<nl; ++i)  lowerNeedle[i] = DG__FoldCase(n[i], 1);
+		n = lowerNeedle;
+	}
+
+	if(nl == 1)
+	{
+		const unsigned char* ret = (const unsigned char*)DG_memrchr(h, n[0], hl);
+		if(icase && (unsigned char)(n[0] - 'a') < 26)
+		{
+			// the uppercase letter only matters if it comes after the lowercase one
+			const unsigned char* start = ret ? ret+1 : h;
+			const unsigned char* up = (const unsigned char*)DG_memrchr(start, n[0] - 32, h + hl - start);
+			if(up != NULL)  ret = up;
+		}
+		return (void*)ret;
+	}
+
+	if(nl <= DG__MEMMEM_SHORT_MAXLEN)
+	{
+  #ifdef DG__MISC_HAVE_AVX2
+		if(simdLevel >= DG__MISC_SIMD_AVX2)  return DG__memrmem_short_avx2(h, hl, n, nl, icase);
+  #endif
+  #ifdef DG__MISC_HAVE_SSE2
+		if(simdLevel >= DG__MISC_SIMD_SSE2)  return DG__memrmem_short_sse2(h, hl, n, nl, icase);
+  #endif
+	}
+
+	if(nl <= DG__MEMMEM_BMH_MAXLEN)  return DG__memrmem_bmh(h, hl, n, nl, icase);
+
+	return DG__memrmem_twoway(h, hl, n, nl, icase);
+}
+
+#ifdef DG__MISC_DISPATCH
+// the DG_memrmem() implementations for the dispatch tables
+static void* DG__memrmem_c(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl)
+{
+	return DG__memrmem_level(h, hl, n, nl, DG__MISC_SIMD_NONE, 0);
+}
+
+static void* DG__memrmem_sse2(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl)
+{
+	return DG__memrmem_level(h, hl, n, nl, DG__MISC_SIMD_SSE2, 0);
+}
+
+static void* DG__memrmem_avx2(const unsigned char* h, size_t hl, const unsigned char* n, size_t nl)
+{
+	return DG__memrmem_level(h, hl, n, nl, DG__MISC_SIMD_AVX2, 0);
+}
+#endif // DG__MISC_DISPATCH
+
+DG_MISC_DEF void* DG_memrmem(const void* haystack, size_t haystacklen,
+                             const void* needle, size_t needlelen)
+{
+	DG_MISC_ASSERT((haystack != NULL || haystacklen == 0)
+			&& (needle != NULL || needlelen == 0),
+			"Don't pass NULL into DG_memrmem(), unless the corresponding len is 0!");
+
+#ifdef DG__MISC_DISPATCH
+	return DG__MiscGetKernels()->memrmem((const unsigned char*)haystack, haystacklen,
+	                                     (const unsigned char*)needle, needlelen);
+#else
+	return DG__memrmem_level((const unsigned char*)haystack, haystacklen,
+	                         (const unsigned char*)needle, needlelen, DG__MISC_SIMD_DEFAULT, 0);
+#endif
+}
+
+DG_MISC_DEF char* DG_strrstr(const char* haystack, const char* needle)
+{
+	size_t hLen = DG_strlen(haystack);
+	size_t nLen = DG_strlen(needle);
+	return (char*)DG_memrmem(haystack, hLen, needle, nLen);
+}
+
+DG_MISC_DEF void* DG_memrimem(const void* haystack, size_t haystacklen,
+                              const void* needle, size_t needlelen)
+{
+	DG_MISC_ASSERT((haystack != NULL || haystacklen == 0)
+			&& (needle != NULL || needlelen == 0),
+			"Don't pass NULL into DG_memrimem(), unless the corresponding len is 0!");
+
+	return DG__memrmem_level((const unsigned char*)haystack, haystacklen,
+	                         (const unsigned char*)needle, needlelen, DG__MISC_SIMD_LEVEL, 1);
+}
+
+DG_MISC_DEF char* DG_strrcasestr(const char* haystack, const char* needle)
+{
+	size_t hLen = DG_strlen(haystack);
+	size_t nLen = DG_strlen(needle);
+	return (char*)DG_memrimem(haystack, hLen, needle, nLen);
+}
+
+// DG_strncasecmp() compares blocks of 16 (or 32) bytes at once, after converting both
+// to lowercase in the registers. As the strings (or n) may end anywhere in such a block,
+// the unaligned loads must not cross a page boundary (4096 bytes is the smallest page
+// size on x86). When a block would cross one, it's loaded from further back instead,
+// so it ends right at the page boundary - the bytes before i have already been compared
+// and are known to be equal (and not '\0'), so comparing them again doesn't change the
+// result. Only at the very start of the strings this isn't possible, there the bytes
+// before the page boundary are compared one by one.
+#define DG__STRCASECMP_PAGESIZE 4096
+
+// the number of bytes from a+i and b+i to the next page boundary, whichever is closer
+static size_t DG__StrcasecmpPageRest(const unsigned char* a, const unsigned char* b, size_t i)
+{
+	size_t restA = DG__STRCASECMP_PAGESIZE - ((uintptr_t)(a+i) & (DG__STRCASECMP_PAGESIZE-1));
+	size_t restB = DG__STRCASECMP_PAGESIZE - ((uintptr_t)(b+i) & (DG__STRCASECMP_PAGESIZE-1));
+	return (restA < restB) ? restA : restB;
+}
+
+// compares a[i] and b[i] case-insensitively, returns 1 and sets *ret to the result
+// of the whole comparison if they differ or if it's the end of the strings, else 0
+static int DG__StrcasecmpByte(const unsigned char* a, const unsigned char* b, size_t i, int* ret)
+{
+	unsigned char ca = DG__FoldCase(a[i], 1);
+	unsigned char cb = DG__FoldCase(b[i], 1);
+	*ret = (int)ca - (int)cb;
+	return ca != cb || ca == '\0';
+}
+
+DG__MISC_MAYBE_UNUSED
+static int DG__strncasecmp_c(const unsigned char* a, const unsigned char* b, size_t n)
+{
+	int ret = 0;
+	for(size_t i=0; i<n; ++i)
+	{
+		if(DG__StrcasecmpByte(a, b, i, &ret))  return ret;
+	}
+	return 0;
+}
+
+#ifdef DG__MISC_HAVE_SSE2
+// reads past the end of the strings (but never into another page), so ASan must not check it
+DG__MISC_NO_ASAN DG__MISC_MAYBE_UNUSED
+static int DG__strncasecmp_sse2(const unsigned char* a, const unsigned char* b, size_t n)
+{
+	int ret = 0;
+	size_t i = 0;
+	while(i < n)
+	{
+		// the last block to compare before the next page boundary of a or b
+		size_t lastBlock = i;
+		size_t pageRest = DG__StrcasecmpPageRest(a, b, i);
+		if(pageRest >= 16)
+		{
+			lastBlock = i + pageRest - 16;
+		}
+		else if(i >= 16 - pageRest)
+		{
+			// load the block from further back, so it ends at the page boundary
+			i -= 16 - pageRest;
+			lastBlock = i;
+		}
+		else
+		{
+			if(DG__StrcasecmpByte(a, b, i++, &ret))  return ret;
+			continue;
+		}
+
+		for( ; i <= lastBlock; i += 16)
+		{
+			__m128i va = _mm_loadu_si128((const __m128i*)(a+i));
+			__m128i vb = _mm_loadu_si128((const __m128i*)(b+i));
+			__m128i eq = _mm_cmpeq_epi8(DG__ToLower_sse2(va), DG__ToLower_sse2(vb));
+			// bits for bytes that differ (after lowercasing) or that end a
+			unsigned int mask = ((unsigned int)_mm_movemask_epi8(eq) ^ 0xFFFFu)
+			                    | (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(va, _mm_setzero_si128()));
+			size_t rem = n - i;
+			if(rem < 16)  mask &= (1u << rem) - 1; // ignore the bytes after n
+			if(mask != 0)
+			{
+				DG__StrcasecmpByte(a, b, i + DG__LowestBitIdx(mask), &ret);
+				return ret;
+			}
+			if(rem <= 16)  return 0;
+		}
+	}
+	return 0;
+}
+#endif // DG__MISC_HAVE_SSE2
+
+#ifdef DG__MISC_HAVE_AVX2
+// like DG__strncasecmp_sse2(), but compares 32 bytes at once
+DG__MISC_TARGET_AVX2 DG__MISC_NO_ASAN DG__MISC_MAYBE_UNUSED
+static int DG__strncasecmp_avx2(const unsigned char* a, const unsigned char* b, size_t n)
+{
+	int ret = 0;
+	size_t i = 0;
+	while(i < n)
+	{
+		size_t lastBlock = i;
+		size_t pageRest = DG__StrcasecmpPageRest(a, b, i);
+		if(pageRest >= 32)
+		{
+			lastBlock = i + pageRest - 32;
+		}
+		else if(i >= 32 - pageRest)
+		{
+			i -= 32 - pageRest;
+			lastBlock = i;
+		}
+		else
+		{
+			if(DG__StrcasecmpByte(a, b, i++, &ret))  return ret;
+			continue;
+		}
+
+		for( ; i <= lastBlock; i += 32)
+		{
+			__m256i va = _mm256_loadu_si256((const __m256i*)(a+i));
+			__m256i vb = _mm256_loadu_si256((const __m256i*)(b+i));
+			__m256i eq = _mm256_cmpeq_epi8(DG__ToLower_avx2(va), DG__ToLower_avx2(vb));
+			unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(eq)
+			                    | (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, _mm256_setzero_si256()));
+			size_t rem = n - i;
+			if(rem < 32)  mask &= (1u << rem) - 1;
+			if(mask != 0)
+			{
+				DG__StrcasecmpByte(a, b, i + DG__LowestBitIdx(mask), &ret);
+				return ret;
+			}
+			if(rem <= 32)  return 0;
+		}
+	}
+	return 0;
+}
+#endif // DG__MISC_HAVE_AVX2
+
+#undef DG__STRCASECMP_PAGESIZE
+
+// DG_strncasecmp() without the argument checks, simdLevel (DG__MISC_SIMD_*) selects the kernel
+static int DG__strncasecmp_level(const unsigned char* a, const unsigned char* b, size_t n, int simdLevel)
+{
+	(void)simdLevel; // unused if DG_MISC_NO_SIMD is #defined
+  #ifdef DG__MISC_HAVE_AVX2
+	if(simdLevel >= DG__MISC_SIMD_AVX2)  return DG__strncasecmp_avx2(a, b, n);
+  #endif
+  #ifdef DG__MISC_HAVE_SSE2
+	if(simdLevel >= DG__MISC_SIMD_SSE2)  return DG__strncasecmp_sse2(a, b, n);
+  #endif
+	return DG__strncasecmp_c(a, b, n);
+}
+
+DG_MISC_DEF int DG_strncasecmp(const char* s1, const char* s2, size_t n)
+{
+	DG_MISC_ASSERT((s1 != NULL && s2 != NULL) || n == 0, "Don't pass NULL into DG_strncasecmp()!");
+	return DG__strncasecmp_level((const unsigned char*)s1, (const unsigned char*)s2, n, DG__MISC_SIMD_LEVEL);
+}
+
+// marks "no needle" in DG_MultiNeedle::stateNeedle and ::nextSame
+#define DG__MULTINEEDLE_NONE ((size_t)-1)
+// if the needles start with at most this many different bytes,
+// SSE2 is used to skip bytes that can't start a match
+#define DG__MULTINEEDLE_SIMD_MAXFIRST 8
+
+// DG_MultiNeedle is an Aho-Corasick automaton that has been turned into a DFA,
+// i.e. every state has a transition for every byte (class), so no failure links
+// need to be followed while searching. State 0 is the root (nothing matched yet).
+struct DG_MultiNeedle {
+	unsigned int* trans;    // next state for each state and byte class: trans[state*numClasses + class]
+	unsigned int* report;   // per state: the state itself if a needle ends there, else dictLink[state]
+	unsigned int* dictLink; // per state: next state on its failure path that a needle ends at, or 0
+	size_t* stateNeedle;    // per state: lowest ID of the needles ending at that state, or NONE
+	size_t* nextSame;       // per needle: next higher ID of an identical needle, or NONE
+	size_t* needleLens;
+	size_t numNeedles;
+	size_t maxNeedleLen;
+	unsigned int numStates;
+	unsigned int numClasses;
+
+	int numFirstBytes; // number of different bytes the needles start with
+	unsigned char firstBytes[DG__MULTINEEDLE_SIMD_MAXFIRST]; // only set if numFirstBytes is small enough
+	unsigned char isFirstByte[256];
+	// bytes that don't appear in any needle all share class 0, the others get their own.
+	// this keeps the transition table small
+	unsigned char byteClass[256];
+};
+
+DG_MISC_DEF void DG_MultiNeedle_Free(DG_MultiNeedle* mn)
+{
+	if(mn == NULL)  return;
+
+	free(mn->trans);
+	free(mn->report);
+	free(mn->dictLink);
+	free(mn->stateNeedle);
+	free(mn->nextSame);
+	free(mn->needleLens);
+	free(mn);
+}
+
+DG_MISC_DEF DG_MultiNeedle* DG_MultiNeedle_Create(const char* const* needles,
+                                                  const size_t* needleLens, size_t numNeedles)
+{
+	DG_MISC_ASSERT(numNeedles == 0 || (needles != NULL && needleLens != NULL),
+	               "Don't pass NULL into DG_MultiNeedle_Create()!");
+
+	size_t sumLens = 0;
+	int numBytes = 0;
+	unsigned char usedBytes[256] = {0};
+	for(size_t i=0; i<numNeedles; ++i)
+	{
+		size_t len = needleLens[i];
+		DG_MISC_ASSERT(len > 0 && needles[i] != NULL, "The needles passed to DG_MultiNeedle_Create() must not be empty!");
+		if(len == 0 || needles[i] == NULL)  return NULL;
+
+		for(size_t j=0; j<len; ++j)
+		{
+			unsigned char b = (unsigned char)needles[i][j];
+			if(!usedBytes[b])
+			{
+				usedBytes[b] = 1;
+				++numBytes;
+			}
+		}
+		sumLens += len;
+		// make sure the state IDs fit into unsigned int and the table size doesn't overflow
+		if(sumLens >= UINT_MAX / 257 || sumLens >= ((size_t)-1) / (257 * sizeof(unsigned int)))
+			return NULL;
+	}
+
+	DG_MultiNeedle* mn = (DG_MultiNeedle*)calloc(1, sizeof(DG_MultiNeedle));
+	if(mn == NULL)  return NULL;
+
+	// if all 256 byte values are used, none is left for class 0
+	unsigned int numClasses = (numBytes == 256) ? 0 : 1;
+	for(int b=0; b<256; ++b)
+	{
+		if(usedBytes[b])  mn->byteClass[b] = (unsigned char)numClasses++;
+	}
+
+	// there are at most sumLens states (+ root), one per needle byte
+	size_t maxStates = sumLens + 1;
+	mn->numClasses = numClasses;
+	mn->numNeedles = numNeedles;
+	mn->trans = (unsigned int*)calloc(maxStates * numClasses, sizeof(unsigned int));
+	mn->report = (unsigned int*)malloc(maxStates * sizeof(unsigned int));
+	mn->dictLink = (unsigned int*)malloc(maxStates * sizeof(unsigned int));
+	mn->stateNeedle = (size_t*)malloc(maxStates * sizeof(size_t));
+	mn->nextSame = (size_t*)malloc((numNeedles+1) * sizeof(size_t));
+	mn->needleLens = (size_t*)malloc((numNeedles+1) * sizeof(size_t));
+	// only needed while creating the automaton
+	unsigned int* fail = (unsigned int*)malloc(maxStates * sizeof(unsigned int));
+	unsigned int* queue = (unsigned int*)malloc(maxStates * sizeof(unsigned int));
+
+	if(mn->trans == NULL || mn->report == NULL || mn->dictLink == NULL || mn->stateNeedle == NULL
+	   || mn->nextSame == NULL || mn->needleLens == NULL || fail == NULL || queue == NULL)
+	{
+		free(fail);
+		free(queue);
+		DG_MultiNeedle_Free(mn);
+		return NULL;
+	}
+
+	unsigned int* trans = mn->trans;
+	mn->stateNeedle[0] = DG__MULTINEEDLE_NONE;
+
+	// step 1: build a trie of all needles. while doing that, a transition to 0
+	// means "no child for that byte" (no needle leads back to the root)
+	unsigned int numStates = 1;
+	for(size_t i=0; i<numNeedles; ++i)
+	{
+		const unsigned char* n = (const unsigned char*)needles[i];
+		size_t len = needleLens[i];
+		unsigned int s = 0;
+		for(size_t j=0; j<len; ++j)
+		{
+			unsigned int* t = &trans[s*numClasses + mn->byteClass[n[j]]];
+			if(*t == 0)
+			{
+				mn->stateNeedle[numStates] = DG__MULTINEEDLE_NONE;
+				*t = numStates++;
+			}
+			s = *t;
+		}
+
+		mn->needleLens[i] = len;
+		mn->nextSame[i] = DG__MULTINEEDLE_NONE;
+		if(len > mn->maxNeedleLen)  mn->maxNeedleLen = len;
+
+		if(mn->stateNeedle[s] == DG__MULTINEEDLE_NONE)
+		{
+			mn->stateNeedle[s] = i;
+		}
+		else // the same needle was passed more than once, append i to list of IDs
+		{
+			size_t id = mn->stateNeedle[s];
+			while(mn->nextSame[id] != DG__MULTINEEDLE_NONE)
+				id = mn->nextSame[id];
+			mn->nextSame[id] = i;
+		}
+
+		unsigned char b = n[0];
+		if(!mn->isFirstByte[b])
+		{
+			mn->isFirstByte[b] = 1;
+			if(mn->numFirstBytes < DG__MULTINEEDLE_SIMD_MAXFIRST)
+				mn->firstBytes[mn->numFirstBytes] = b;
+			++mn->numFirstBytes;
+		}
+	}
+
+	// step 2: calculate the failure links (longest proper suffix of a state that is
+	// also a state) in breadth-first order, and use them to fill in the missing
+	// transitions, so the trie becomes a DFA.
+	// when a row of trans is processed, all its non-0 entries are still children in the trie.
+	size_t qHead = 0, qTail = 0;
+	mn->dictLink[0] = 0;
+	fail[0] = 0;
+	for(unsigned int c=0; c<numClasses; ++c)
+	{
+		unsigned int child = trans[c];
+		if(child != 0)
+		{
+			fail[child] = 0;
+			mn->dictLink[child] = 0;
+			queue[qTail++] = child;
+		}
+		// else: missing transitions from the root just lead back to the root, i.e. 0
+	}
+	while(qHead < qTail)
+	{
+		unsigned int s = queue[qHead++];
+		unsigned int* row = &trans[s*numClasses];
+		const unsigned int* failRow = &trans[fail[s]*numClasses]; // already complete
+		for(unsigned int c=0; c<numClasses; ++c)
+		{
+			unsigned int child = row[c];
+			if(child != 0)
+			{
+				unsigned int f = failRow[c];
+				fail[child] = f;
+				mn->dictLink[child] = (mn->stateNeedle[f] != DG__MULTINEEDLE_NONE) ? f : mn->dictLink[f];
+				queue[qTail++] = child;
+			}
+			else
+			{
+				row[c] = failRow[c];
+			}
+		}
+	}
+
+	for(unsigned int s=0; s<numStates; ++s)
+	{
+		mn->report[s] = (mn->stateNeedle[s] != DG__MULTINEEDLE_NONE) ? s : mn->dictLink[s];
+	}
+	mn->numStates = numStates;
+
+	free(fail);
+	free(queue);
+
+	// the transition table was allocated for the worst case, shrink it
+	// (if that fails for whatever reason, just keep the bigger one)
+	trans = (unsigned int*)realloc(mn->trans, (size_t)numStates * numClasses * sizeof(unsigned int));
+	if(trans != NULL)  mn->trans = trans;
+
+	return mn;
+}
+
+// returns the index of the first byte at or after h[i] that a needle starts with,
+// or hl if there is none
+static size_t DG__MultiNeedleSkip(const DG_MultiNeedle* mn, const unsigned char* h, size_t i, size_t hl)
+{
+	if(mn->isFirstByte[h[i]])  return i;
+	// no needles => no byte can start a match
+	if(mn->numFirstBytes == 0)  return hl;
+
+	if(mn->numFirstBytes == 1)
+	{
+		const unsigned char* p = (const unsigned char*)memchr(h+i, mn->firstBytes[0], hl-i);
+		return (p != NULL) ? (size_t)(p - h) : hl;
+	}
+
+#ifdef DG__MISC_HAVE_SSE2
+	if(mn->numFirstBytes <= DG__MULTINEEDLE_SIMD_MAXFIRST)
+	{
+		// compare 16 bytes at once with all the bytes the needles start with
+		__m128i first[DG__MULTINEEDLE_SIMD_MAXFIRST];
+		int numFirst = mn->numFirstBytes;
+		for(int k=0; k<numFirst; ++k)
+			first[k] = _mm_set1_epi8((char)mn->firstBytes[k]);
+
+		for( ; i + 16 <= hl; i += 16)
+		{
+			__m128i block = _mm_loadu_si128((const __m128i*)(h + i));
+			__m128i eq = _mm_cmpeq_epi8(block, first[0]);
+			for(int k=1; k<numFirst; ++k)
+				eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, first[k]));
+			int mask = _mm_movemask_epi8(eq);
+			if(mask != 0)
+				return i + DG__LowestBitIdx((unsigned int)mask);
+		}
+	}
+#endif // DG__MISC_HAVE_SSE2
+
+	while(i < hl && !mn->isFirstByte[h[i]])
+		++i;
+	return i;
+}
+
+// feeds the bytes from h[*pos] on into the automaton (that is in *state) until a
+// needle ends. returns 1 and sets *pos to the index after the last byte of the match
+// (and *state to the state it ends in), or returns 0 if it reached the end of h
+static int DG__MultiNeedleNext(const DG_MultiNeedle* mn, const unsigned char* h, size_t hl,
+                               size_t* pos, unsigned int* state)
+{
+	const unsigned int* trans = mn->trans;
+	const unsigned int* report = mn->report;
+	const unsigned char* byteClass = mn->byteClass;
+	unsigned int numClasses = mn->numClasses;
+	unsigned int s = *state;
+	size_t i = *pos;
+
+	while(i < hl)
+	{
+		if(s == 0)
+		{
+			// in the root state, bytes that no needle starts with just lead
+			// back to the root, so skip them as quickly as possible
+			i = DG__MultiNeedleSkip(mn, h, i, hl);
+			if(i == hl)  break;
+		}
+		s = trans[s*numClasses + byteClass[h[i]]];
+		++i;
+		if(report[s] != 0)
+		{
+			*pos = i;
+			*state = s;
+			return 1;
+		}
+	}
+	*pos = hl;
+	*state = s;
+	return 0;
+}
+
+DG_MISC_DEF void* DG_memmem_multi(const void* haystack, size_t haystacklen,
+                                  const DG_MultiNeedle* mn, size_t* matchedNeedle)
+{
+	DG_MISC_ASSERT(mn != NULL, "Don't pass a NULL DG_MultiNeedle into DG_memmem_multi()!");
+	DG_MISC_ASSERT(haystack != NULL || haystacklen == 0,
+	               "Don't pass NULL into DG_memmem_multi(), unless haystacklen is 0!");
+
+	const unsigned char* h = (const unsigned char*)haystack;
+	size_t pos = 0;
+	unsigned int state = 0;
+	size_t bestStart = haystacklen;
+	size_t bestID = DG__MULTINEEDLE_NONE;
+	size_t limit = haystacklen;
+
+	// the first match found is the first to *end*, but another needle that is
+	// longer could start before it and end later - so keep searching until
+	// all needles starting at or before the best match so far have ended
+	while(DG__MultiNeedleNext(mn, h, limit, &pos, &state))
+	{
+		// of all needles ending at pos, the one ending in report[state] is the longest,
+		// so it starts first. (different needles with the same start and end are
+		// identical and the list of their IDs is sorted, so the first one is the lowest)
+		size_t id = mn->stateNeedle[mn->report[state]];
+		size_t start = pos - mn->needleLens[id];
+		if(start < bestStart || (start == bestStart && id < bestID))
+		{
+			bestStart = start;
+			bestID = id;
+			if(bestStart + mn->maxNeedleLen < limit)
+				limit = bestStart + mn->maxNeedleLen;
+		}
+	}
+
+	if(bestID == DG__MULTINEEDLE_NONE)  return NULL;
+
+	if(matchedNeedle != NULL)  *matchedNeedle = bestID;
+	return (void*)(h + bestStart);
+}
+
+DG_MISC_DEF size_t DG_memmem_multi_all(const void* haystack, size_t haystacklen,
+                                       const DG_MultiNeedle* mn,
+                                       DG_MultiNeedle_MatchFn onMatch, void* userData)
+{
+	DG_MISC_ASSERT(mn != NULL && onMatch != NULL, "Don't pass NULL for mn or onMatch into DG_memmem_multi_all()!");
+	DG_MISC_ASSERT(haystack != NULL || haystacklen == 0,
+	               "Don't pass NULL into DG_memmem_multi_all(), unless haystacklen is 0!");
+
+	const unsigned char* h = (const unsigned char*)haystack;
+	size_t pos = 0;
+	unsigned int state = 0;
+	size_t numMatches = 0;
+
+	while(DG__MultiNeedleNext(mn, h, haystacklen, &pos, &state))
+	{
+		// all needles ending here: the ones ending at report[state],
+		// then the ones along the dictionary links (which are shorter)
+		for(unsigned int s = mn->report[state]; s != 0; s = mn->dictLink[s])
+		{
+			for(size_t id = mn->stateNeedle[s]; id != DG__MULTINEEDLE_NONE; id = mn->nextSame[id])
+			{
+				++numMatches;
+				if(!onMatch(userData, id, pos - mn->needleLens[id]))
+					return numMatches;
+			}
+		}
+	}
+	return numMatches;
+}
+
+struct DG_MemmemStream {
+	unsigned char* needle;
+	size_t needleLen;
+	// the last needleLen-1 bytes of the stream (or less, at its beginning) followed by
+	// the first needleLen-1 bytes of the current chunk, to find matches that span both
+	unsigned char* carry;
+	size_t carryLen;
+	unsigned long long pos; // offset (in the stream) of the current chunk
+	int stopped;
+	// long needles are searched with Two-Way, precomputed once and also used to find
+	// the next overlapping match in linear time. shorter ones just use DG_memmem()
+	int useTwoWay;
+	DG__TwoWay tw;
+};
+
+DG_MISC_DEF DG_MemmemStream* DG_MemmemStream_Create(const void* needle, size_t needlelen)
+{
+	DG_MISC_ASSERT(needle != NULL && needlelen > 0, "Don't pass an empty needle into DG_MemmemStream_Create()!");
+	if(needle == NULL || needlelen == 0 || needlelen > (((size_t)-1) - sizeof(DG_MemmemStream)) / 3)
+		return NULL;
+
+	// needle and carry buffer are in the same allocation, after the struct
+	DG_MemmemStream* ms = (DG_MemmemStream*)malloc(sizeof(DG_MemmemStream) + 3*needlelen);
+	if(ms == NULL)  return NULL;
+
+	ms->needle = (unsigned char*)(ms + 1);
+	ms->carry = ms->needle + needlelen;
+	memcpy(ms->needle, needle, needlelen);
+	ms->needleLen = needlelen;
+	ms->useTwoWay = (needlelen > DG__MEMMEM_SHORT_MAXLEN);
+	if(ms->useTwoWay)
+		DG__TwoWayInit(&ms->tw, ms->needle, needlelen, 0, 0);
+
+	DG_MemmemStream_Reset(ms);
+	return ms;
+}
+
+DG_MISC_DEF void DG_MemmemStream_Reset(DG_MemmemStream* ms)
+{
+	DG_MISC_ASSERT(ms != NULL, "Don't pass NULL into DG_MemmemStream_Reset()!");
+	ms->carryLen = 0;
+	ms->pos = 0;
+	ms->stopped = 0;
+}
+
+DG_MISC_DEF void DG_MemmemStream_Free(DG_MemmemStream* ms)
+{
+	free(ms); // needle and carry are in the same allocation
+}
+
+// passes all matches in buf that start before maxStart to onMatch
+// (buf[0] is at offset bufPos in the stream) and increments *numMatches for each.
+// returns 0 if onMatch asked to stop, else 1
+static int DG__MemmemStreamSearch(DG_MemmemStream* ms, const unsigned char* buf, size_t len, size_t maxStart,
+                                  unsigned long long bufPos, DG_MemmemStream_MatchFn onMatch,
+                                  void* userData, size_t* numMatches)
+{
+	const unsigned char* n = ms->needle;
+	size_t nl = ms->needleLen;
+	const unsigned char* cur = buf;
+	const unsigned char* end = buf + len;
+	size_t mem = 0;
+
+	while((size_t)(end - cur) >= nl)
+	{
+		const unsigned char* m = ms->useTwoWay
+			? (const unsigned char*)DG__TwoWaySearch(&ms->tw, cur, end - cur, n, nl, mem, 0)
+			: (const unsigned char*)DG_memmem(cur, end - cur, n, nl);
+		if(m == NULL || (size_t)(m - buf) >= maxStart)  break;
+
+		++*numMatches;
+		if(!onMatch(userData, bufPos + (size_t)(m - buf)))
+		{
+			ms->stopped = 1;
+			return 0;
+		}
+
+		if(ms->useTwoWay)
+		{
+			// no other match can start before m + per
+			if((size_t)(end - m) < ms->tw.per)  break;
+			cur = m + ms->tw.per;
+			mem = ms->tw.mem0;
+		}
+		else
+		{
+			cur = m + 1;
+		}
+	}
+	return 1;
+}
+
+DG_MISC_DEF size_t DG_MemmemStream_Feed(DG_MemmemStream* ms, const void* chunk, size_t chunklen,
+                                        DG_MemmemStream_MatchFn onMatch, void* userData)
+{
+	DG_MISC_ASSERT(ms != NULL && onMatch != NULL, "Don't pass NULL for ms or onMatch into DG_MemmemStream_Feed()!");
+	DG_MISC_ASSERT(chunk != NULL || chunklen == 0,
+	               "Don't pass a NULL chunk into DG_MemmemStream_Feed(), unless chunklen is 0!");
+
+	size_t numMatches = 0;
+	if(ms->stopped || chunklen == 0)  return 0;
+
+	const unsigned char* c = (const unsigned char*)chunk;
+	size_t keep = ms->needleLen - 1; // number of bytes that must be carried over to the next chunk
+	size_t carryLen = ms->carryLen;
+	size_t head = (chunklen < keep) ? chunklen : keep;
+
+	// first the matches that start in the carried over bytes and end in this chunk
+	// (they can't be completely in the carried bytes, those are shorter than the needle).
+	// only those that start before carryLen, the others are found in the chunk itself below
+	memcpy(ms->carry + carryLen, c, head);
+	if(carryLen > 0 && !DG__MemmemStreamSearch(ms, ms->carry, carryLen + head, carryLen,
+	                                           ms->pos - carryLen, onMatch, userData, &numMatches))
+	{
+		return numMatches;
+	}
+
+	// then the matches in the chunk itself
+	if(!DG__MemmemStreamSearch(ms, c, chunklen, chunklen, ms->pos, onMatch, userData, &numMatches))
+		return numMatches;
+
+	// remember the last (up to) keep bytes of the stream for the next chunk
+	if(chunklen >= keep)
+	{
+		memcpy(ms->carry, c + chunklen - keep, keep);
+		ms->carryLen = keep;
+	}
+	else // the whole chunk has already been copied into carry, behind the old carried bytes
+	{
+		size_t total = carryLen + chunklen;
+		size_t newLen = (total < keep) ? total : keep;
+		memmove(ms->carry, ms->carry + total - newLen, newLen);
+		ms->carryLen = newLen;
+	}
+	ms->pos += chunklen;
+
+	return numMatches;
+}
+
+// DG_FileFind() and DG_FileFindLast() map (and search) the file in windows of (at most)
+// this size, plus needlelen-1 bytes so matches spanning two windows are found.
+// (mapping a multi-GB file at once wouldn't even work on 32bit)
+#ifdef DG_MISC_IS_64BIT
+  #define DG__FILEFIND_WINDOW ((unsigned long long)1 << 30)
+#else
+  #define DG__FILEFIND_WINDOW ((unsigned long long)1 << 26)
+#endif
+// DG_FileFindLast() starts with a window of this size at the end of the file and doubles
+// it for each following window, so things like trailers are found without reading much
+#define DG__FILEFIND_FIRST_WINDOW_LAST ((unsigned long long)1 << 20)
+
+typedef struct {
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping; // NULL for empty files, they can't be mapped
+#else
+	int fd;
+#endif
+	unsigned long long size;
+	unsigned long long granularity; // offsets of mappings must be a multiple of this
+} DG__MappedFile;
+
+// returns 0 on success, -1 on error
+static int DG__MappedFileOpen(DG__MappedFile* mf, const char* path, int backwards)
+{
+#ifdef _WIN32
+	SYSTEM_INFO sysInfo;
+	LARGE_INTEGER size;
+	// this is as close as Windows gets to madvise()
+	DWORD flags = backwards ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN;
+
+	mf->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+	                       FILE_ATTRIBUTE_NORMAL | flags, NULL);
+	if(mf->file == INVALID_HANDLE_VALUE)  return -1;
+
+	if(!GetFileSizeEx(mf->file, &size))
+	{
+		CloseHandle(mf->file);
+		return -1;
+	}
+	mf->size = (unsigned long long)size.QuadPart;
+	mf->mapping = NULL;
+	if(mf->size > 0)
+	{
+		mf->mapping = CreateFileMappingA(mf->file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if(mf->mapping == NULL)
+		{
+			CloseHandle(mf->file);
+			return -1;
+		}
+	}
+	GetSystemInfo(&sysInfo);
+	mf->granularity = sysInfo.dwAllocationGranularity;
+#else
+	struct stat st;
+	(void)backwards; // madvise() is called per window in DG__MappedFileMap()
+
+	mf->fd = open(path, O_RDONLY);
+	if(mf->fd < 0)  return -1;
+
+	if(fstat(mf->fd, &st) != 0)
+	{
+		close(mf->fd);
+		return -1;
+	}
+	mf->size = (unsigned long long)st.st_size;
+	long pageSize = sysconf(_SC_PAGESIZE);
+	mf->granularity = (pageSize > 0) ? (unsigned long long)pageSize : 4096;
+#endif
+	return 0;
+}
+
+static void DG__MappedFileClose(DG__MappedFile* mf)
+{
+#ifdef _WIN32
+	if(mf->mapping != NULL)  CloseHandle(mf->mapping);
+	CloseHandle(mf->file);
+#else
+	close(mf->fd);
+#endif
+}
+
+// maps len bytes of the file, starting at offset (must be a multiple of granularity).
+// returns NULL on error
+static const unsigned char* DG__MappedFileMap(DG__MappedFile* mf, unsigned long long offset,
+                                              size_t len, int backwards)
+{
+#ifdef _WIN32
+	(void)backwards;
+	return (const unsigned char*)MapViewOfFile(mf->mapping, FILE_MAP_READ,
+	                                           (DWORD)(offset >> 32), (DWORD)offset, len);
+#else
+	if(offset != (unsigned long long)(off_t)offset)  return NULL; // 32bit off_t
+	void* ret = mmap(NULL, len, PROT_READ, MAP_PRIVATE, mf->fd, (off_t)offset);
+	if(ret == MAP_FAILED)  return NULL;
+
+  #if defined(MADV_SEQUENTIAL) && defined(MADV_WILLNEED)
+	// the kernel's readahead only helps when reading forwards, so when searching
+	// backwards, tell it to read the whole (relatively small) window in right away
+	madvise(ret, len, backwards ? MADV_WILLNEED : MADV_SEQUENTIAL);
+  #else
+	(void)backwards;
+  #endif
+	return (const unsigned char*)ret;
+#endif
+}
+
+static void DG__MappedFileUnmap(const unsigned char* ptr, size_t len)
+{
+#ifdef _WIN32
+	(void)len;
+	UnmapViewOfFile(ptr);
+#else
+	munmap((void*)ptr, len);
+#endif
+}
+
+static int DG__FileFind(const char* path, const void* needle, size_t needlelen,
+                        unsigned long long* offset, int backwards)
+{
+	DG_MISC_ASSERT(path != NULL && offset != NULL && (needle != NULL || needlelen == 0),
+	               "Don't pass NULL for path, offset or needle into DG_FileFind() or DG_FileFindLast()!");
+
+	DG__MappedFile mf;
+	if(DG__MappedFileOpen(&mf, path, backwards) != 0)  return -1;
+
+	unsigned long long size = mf.size;
+	int ret = 0;
+	if(needlelen == 0) // like DG_memmem() and DG_memrmem()
+	{
+		*offset = backwards ? size : 0;
+		ret = 1;
+	}
+	else if(size >= needlelen)
+	{
+		unsigned long long overlap = needlelen - 1;
+		unsigned long long start, end;
+		if(backwards)
+		{
+			unsigned long long winSize = DG__FILEFIND_FIRST_WINDOW_LAST;
+			end = size;
+			do {
+				if(winSize < needlelen)  winSize = needlelen;
+				start = (end > winSize) ? end - winSize : 0;
+				start -= start % mf.granularity;
+
+				size_t len = (size_t)(end - start);
+				const unsigned char* p = DG__MappedFileMap(&mf, start, len, 1);
+				if(p == NULL)
+				{
+					ret = -1;
+					break;
+				}
+				const unsigned char* m = (const unsigned char*)DG_memrmem(p, len, needle, needlelen);
+				if(m != NULL)
+				{
+					*offset = start + (size_t)(m - p);
+					ret = 1;
+				}
+				DG__MappedFileUnmap(p, len);
+
+				// matches starting at start or later have been searched now,
+				// but one could still start before start and end in this window
+				end = start + overlap;
+				if(winSize < DG__FILEFIND_WINDOW)  winSize *= 2;
+			} while(ret == 0 && start > 0);
+		}
+		else
+		{
+			for(start = 0; start + needlelen <= size; start += DG__FILEFIND_WINDOW)
+			{
+				end = start + DG__FILEFIND_WINDOW + overlap;
+				if(end > size)  end = size;
+
+				size_t len = (size_t)(end - start);
+				const unsigned char* p = DG__MappedFileMap(&mf, start, len, 0);
+				if(p == NULL)
+				{
+					ret = -1;
+					break;
+				}
+				const unsigned char* m = (const unsigned char*)DG_memmem(p, len, needle, needlelen);
+				if(m != NULL)
+				{
+					*offset = start + (size_t)(m - p);
+					ret = 1;
+				}
+				DG__MappedFileUnmap(p, len);
+				if(ret != 0)  break;
+			}
+		}
+	}
+
+	DG__MappedFileClose(&mf);
+	return ret;
+}
+
+DG_MISC_DEF int DG_FileFind(const char* path, const void* needle, size_t needlelen,
+                            unsigned long long* offset)
+{
+	return DG__FileFind(path, needle, needlelen, offset, 0);
+}
+
+DG_MISC_DEF int DG_FileFindLast(const char* path, const void* needle, size_t needlelen,
+                                unsigned long long* offset)
+{
+	return DG__FileFind(path, needle, needlelen, offset, 1);
+}
+
+// DG_memmem_parallel*() split the haystack into segments of this size (or needlelen,
+// if that's bigger), which are searched one after another by each of the jobs
+#define DG__MEMMEM_PARALLEL_SEGMENT ((size_t)4 << 20)
+
+typedef struct {
+	const unsigned char* h;
+	size_t hl;
+	const unsigned char* n;
+	size_t nl;
+	size_t segSize;
+	size_t numSegs;
+	volatile size_t nextSeg; // next segment to search
+	volatile size_t bestPos; // position of first match found so far, hl if none
+} DG__MemmemParallel;
+
+// called (in parallel) by the DG_MemmemRunJobsFn, searches segments until there are none left
+static void DG__MemmemParallelJob(void* jobData)
+{
+	DG__MemmemParallel* mp = (DG__MemmemParallel*)jobData;
+	for(;;)
+	{
+		size_t seg = DG__AtomicFetchAdd(&mp->nextSeg, 1);
+		if(seg >= mp->numSegs)  return;
+
+		size_t start = seg * mp->segSize;
+		// segments are handed out in order, so if a match before this segment has been
+		// found, all the segments left (incl. this one) can be skipped
+		if(start > DG__AtomicLoad(&mp->bestPos))  return;
+
+		// the segment is extended by nl-1 bytes to find matches that span two segments
+		size_t len = mp->hl - start;
+		if(len > mp->segSize + mp->nl - 1)  len = mp->segSize + mp->nl - 1;
+		const unsigned char* m = (const unsigned char*)DG_memmem(mp->h + start, len, mp->n, mp->nl);
+		if(m != NULL)
+		{
+			// another job might have found a match at the same time, keep the first one
+			size_t pos = (size_t)(m - mp->h);
+			size_t best = DG__AtomicLoad(&mp->bestPos);
+			while(pos < best)
+			{
+				size_t old = DG__AtomicCompareExchange(&mp->bestPos, best, pos);
+				if(old == best)  break;
+				best = old;
+			}
+		}
+	}
+}
+
+DG_MISC_DEF void* DG_memmem_parallel_jobs(const void* haystack, size_t haystacklen,
+                                          const void* needle, size_t needlelen,
+                                          DG_MemmemRunJobsFn runJobs, void* userData, int numJobs)
+{
+	DG_MISC_ASSERT((haystack != NULL || haystacklen == 0) && (needle != NULL || needlelen == 0),
+	               "Don't pass NULL into DG_memmem_parallel*(), unless the corresponding len is 0!");
+	DG_MISC_ASSERT(runJobs != NULL, "Don't pass a NULL runJobs into DG_memmem_parallel_jobs()!");
+
+	size_t segSize = (needlelen > DG__MEMMEM_PARALLEL_SEGMENT) ? needlelen : DG__MEMMEM_PARALLEL_SEGMENT;
+	if(numJobs <= 1 || haystacklen < needlelen || haystacklen / 2 < segSize)
+	{
+		// not worth the trouble
+		return DG_memmem(haystack, haystacklen, needle, needlelen);
+	}
+
+	DG__MemmemParallel mp;
+	mp.h = (const unsigned char*)haystack;
+	mp.hl = haystacklen;
+	mp.n = (const unsigned char*)needle;
+	mp.nl = needlelen;
+	mp.segSize = segSize;
+	// the last position a match can start at is haystacklen - needlelen
+	mp.numSegs = (haystacklen - needlelen) / segSize + 1;
+	mp.nextSeg = 0;
+	mp.bestPos = haystacklen;
+
+	runJobs(userData, DG__MemmemParallelJob, &mp, numJobs);
+
+	// runJobs() might not have called the job at all - in that case, do it now
+	if(DG__AtomicLoad(&mp.nextSeg) < mp.numSegs)
+		DG__MemmemParallelJob(&mp);
+
+	size_t bestPos = DG__AtomicLoad(&mp.bestPos);
+	return (bestPos < haystacklen) ? (void*)(mp.h + bestPos) : NULL;
+}
+
+#ifdef DG_MISC_WITH_THREADS
+
+typedef struct {
+	DG_MemmemJobFn job;
+	void* jobData;
+} DG__ThreadJob;
+
+#ifdef _WIN32
+static DWORD WINAPI DG__ThreadMain(LPVOID arg)
+{
+	DG__ThreadJob* tj = (DG__ThreadJob*)arg;
+	tj->job(tj->jobData);
+	return 0;
+}
+#else
+static void* DG__ThreadMain(void* arg)
+{
+	DG__ThreadJob* tj = (DG__ThreadJob*)arg;
+	tj->job(tj->jobData);
+	return NULL;
+}
+#endif
+
+// max. number of threads used by DG_memmem_parallel()
+#define DG__MISC_MAX_THREADS 64
+
+// a DG_MemmemRunJobsFn that runs job on numJobs-1 new threads and the calling thread.
+// if creating a thread fails, the job just runs on fewer threads
+static void DG__RunJobsOnThreads(void* userData, DG_MemmemJobFn job, void* jobData, int numJobs)
+{
+	DG__ThreadJob tj;
+	int numThreads = 0;
+#ifdef _WIN32
+	HANDLE threads[DG__MISC_MAX_THREADS];
+#else
+	pthread_t threads[DG__MISC_MAX_THREADS];
+#endif
+	(void)userData;
+	tj.job = job;
+	tj.jobData = jobData;
+	if(numJobs > DG__MISC_MAX_THREADS)  numJobs = DG__MISC_MAX_THREADS;
+
+	for(int i=1; i<numJobs; ++i)
+	{
+#ifdef _WIN32
+		threads[numThreads] = CreateThread(NULL, 0, DG__ThreadMain, &tj, 0, NULL);
+		if(threads[numThreads] == NULL)  break;
+#else
+		if(pthread_create(&threads[numThreads], NULL, DG__ThreadMain, &tj) != 0)  break;
+#endif
+		++numThreads;
+	}
+
+	job(jobData);
+
+	for(int i=0; i<numThreads; ++i)
+	{
+#ifdef _WIN32
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+#else
+		pthread_join(threads[i], NULL);
+#endif
+	}
+}
+
+DG_MISC_DEF void* DG_memmem_parallel(const void* haystack, size_t haystacklen,
+                                     const void* needle, size_t needlelen, int numThreads)
+{
+	if(numThreads <= 0)
+	{
+#ifdef _WIN32
+		SYSTEM_INFO sysInfo;
+		GetSystemInfo(&sysInfo);
+		numThreads = (int)sysInfo.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+		long numCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+		numThreads = (numCPUs > DG__MISC_MAX_THREADS) ? DG__MISC_MAX_THREADS : (int)numCPUs;
+#endif
+	}
+	return DG_memmem_parallel_jobs(haystack, haystacklen, needle, needlelen,
+	                               DG__RunJobsOnThreads, NULL, numThreads);
+}
+
+#endif // DG_MISC_WITH_THREADS
+
+/* 
+ * public domain strtok_r() by Charlie Gordon
+ * see http://groups.google.com/group/comp.lang.c/msg/2ab1ecbb86646684
+ * and http://groups.google.com/group/comp.lang.c/msg/7c7b39328fefab9c
+ * with a fix from Fletcher T. Penney, also in public domain,
+ * see https://github.com/fletcher/MultiMarkdown-4/blob/master/strtok.c
+ */
+DG_MISC_DEF char* DG_strtok_r(char* str, const char* delim, char** context)
+{
+	DG_MISC_ASSERT(context && delim, "Don't call DG_strtok_r() with delim or context set to NULL!");
+	DG_MISC_ASSERT(str || *context, "Don't call DG_strtok_r() with *context and str both set to NULL!");
+
+#if !defined(DG_MISC_NO_GNU_SOURCE) && !defined(_WIN32)
+
+	// I think every interesting platform except for Windows supports strtok_r
+	// (if not, add it above with "&& !defined(_OTHER_CRAPPY_PLATFORM)")
+	return strtok_r(str, delim, context);
+
+#else // Windows
+
+	// I don't wanna use MSVC's strtok_s(), because C11 defines a function with
+	// that name but a totally different signature.. and it's not supported
+	// by old MSVC versions.
+	char* ret;
+
+	if (str == NULL) str = *context;
+
+	if (str == NULL) return NULL;
+
+	str += strspn(str, delim);
+
+	if (*str == '\0') return NULL;
+
+	ret = str;
+
+	str += strcspn(str, delim);
+
+	if (*str) *str++ = '\0';
+
+	*context = str;
+
+	return ret;
+#endif // _WIN32
+}
+
+// DG_StrSplitIter uses SIMD to look for up to that many different delimiters
+#define DG__STRSPLIT_SIMD_MAXDELIMS 8
+DG_MISC_STATIC_ASSERT(sizeof(((DG_StrSplitIter*)0)->delims) == DG__STRSPLIT_SIMD_MAXDELIMS,
+                      delims_array_must_match_simd_maxdelims);
+
+DG_MISC_DEF void DG_StrSplitIter_Init(DG_StrSplitIter* it, const char* str, size_t len,
+                                      const char* delims, int flags)
+{
+	DG_MISC_ASSERT(it && delims && (str || len == 0), "Don't call DG_StrSplitIter_Init() with it, str or delims set to NULL!");
+
+	memset(it->delimSet, 0, sizeof(it->delimSet));
+	it->numDelims = 0;
+	for(const unsigned char* d = (const unsigned char*)delims; *d != '\0'; ++d)
+	{
+		unsigned int bit = 1u << (*d & 31);
+		if(it->delimSet[*d >> 5] & bit)  continue; // duplicate
+		it->delimSet[*d >> 5] |= bit;
+		if(it->numDelims < DG__STRSPLIT_SIMD_MAXDELIMS)
+			it->delims[it->numDelims] = *d;
+		++it->numDelims;
+	}
+	it->cur = str;
+	it->end = (str != NULL) ? str + len : NULL;
+	it->flags = flags;
+}
+
+static int DG__StrSplitIsDelim(const DG_StrSplitIter* it, unsigned char c)
+{
+	return (it->delimSet[c >> 5] >> (c & 31)) & 1;
+}
+
+// returns the first delimiter in [p, end), or end if there is none
+static const char* DG__StrSplitFindDelim(const DG_StrSplitIter* it, const char* p, const char* end)
+{
+	int numDelims = it->numDelims;
+	if(numDelims == 0)  return end;
+	if(numDelims == 1)
+	{
+		const char* d = (const char*)memchr(p, it->delims[0], end - p);
+		return (d != NULL) ? d : end;
+	}
+
+#ifdef DG__MISC_HAVE_SSE2
+	if(numDelims <= DG__STRSPLIT_SIMD_MAXDELIMS && end - p >= 16)
+	{
+		// compare 16 bytes at once with all the delimiters
+		__m128i delims[DG__STRSPLIT_SIMD_MAXDELIMS];
+		for(int k=0; k<numDelims; ++k)
+			delims[k] = _mm_set1_epi8((char)it->delims[k]);
+
+		const char* lastBlock = end - 16;
+		for(;;)
+		{
+			__m128i block = _mm_loadu_si128((const __m128i*)p);
+			__m128i eq = _mm_cmpeq_epi8(block, delims[0]);
+			for(int k=1; k<numDelims; ++k)
+				eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, delims[k]));
+			unsigned int mask = (unsigned int)_mm_movemask_epi8(eq);
+			if(mask != 0)
+				return p + DG__LowestBitIdx(mask);
+			if(p == lastBlock)
+				return end;
+			// the last block may overlap with this one, that's cheaper than a scalar tail
+			p = (p + 16 <= lastBlock) ? p + 16 : lastBlock;
+		}
+	}
+#endif // DG__MISC_HAVE_SSE2
+
+	while(p < end && !DG__StrSplitIsDelim(it, (unsigned char)*p))
+		++p;
+	return p;
+}
+
+DG_MISC_DEF int DG_StrSplitIter_Next(DG_StrSplitIter* it, const char** token, size_t* tokenLen)
+{
+	DG_MISC_ASSERT(it && token && tokenLen, "Don't call DG_StrSplitIter_Next() with NULL arguments!");
+
+	const char* p = it->cur;
+	const char* end = it->end;
+	if(p == NULL)  return 0;
+
+	if(!(it->flags & DG_STRSPLIT_KEEP_EMPTY))
+	{
+		// delimiters between tokens are usually short runs, so no SIMD here
+		while(p < end && DG__StrSplitIsDelim(it, (unsigned char)*p))
+			++p;
+		if(p == end)
+		{
+			it->cur = NULL;
+			return 0;
+		}
+	}
+
+	const char* d = DG__StrSplitFindDelim(it, p, end);
+	*token = p;
+	*tokenLen = d - p;
+	// if the token ended at a delimiter, the next one starts behind it.
+	// with DG_STRSPLIT_KEEP_EMPTY that's even true if the delimiter is the last char
+	it->cur = (d < end) ? d + 1 : NULL;
+	return 1;
+}
+
+// helper for DG_strnlen() that checks the next sizeof(uintptr_t) bytes
+// (starting at cur) for '\0', returns whole string length based on base string s
+// SHOULD ONLY BE CALLED IF YOU'RE SURE THOSE BYTES CONTAIN A TERMINATING NULL BYTE!
+DG__MISC_MAYBE_UNUSED
+static size_t _DG_strnlen_nextWordOnly(const char* s, const char* cur, size_t n)
+{
+
+	if(  *cur == '\0')  return cur - s;
+	if(*++cur == '\0')  return cur - s;
+	if(*++cur == '\0')  return cur - s;
+	if(*++cur == '\0')  return cur - s;
+
+  #ifdef DG_MISC_IS_64BIT // 4 more bytes per uintptr_t
+	if(*++cur == '\0')  return cur - s;
+	if(*++cur == '\0')  return cur - s;
+	if(*++cur == '\0')  return cur - s;
+	if(*++cur == '\0')  return cur - s;
+  #endif // 64bit
+
+	DG_MISC_ASSERT( 0, "_DG_strnlen_nextWordOnly() should only be called if the next word actually contains a '\0' !" );
+	return n;
+}
+
+
+// plain C implementation of DG_strnlen()
+// at least microsoft and freebsd seem to use a naive strnlen() without
+// any tricks which is usually slower than this
+DG__MISC_MAYBE_UNUSED
+static size_t DG__strnlen_swar(const char* s, size_t n)
+{
+
+	// uses a magic trick from https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord
+	// (and probably in 1000 other places) to decide whether sizeof(uintptr_t) bytes
+	// contain a '\0' or not. without branching, with relatively few instructions
+	// that trick only works (at least in the way I've implemented it) with 32bit and 64bit systems
+	DG_MISC_STATIC_ASSERT(sizeof(uintptr_t) == 4 || sizeof(uintptr_t) == 8, DG_strnlen_only_supports_32_and_64_bit_systems);
+
+	// the magic numbers used for the trick are DG__MISC_MAGIC1 and DG__MISC_MAGIC2
+	static const uintptr_t magic1 = DG__MISC_MAGIC1;
+	static const uintptr_t magic2 = DG__MISC_MAGIC2;
+
+	// size of a native "word" of this platform
+	static const size_t WordSize = sizeof(uintptr_t);
+
+	// the magic trick requires at least WordSize bytes
+	// if we get less, check those bytes directly without the magic trick
+	if(n < WordSize)
+	{
+		const char* cur=s;
+		
+		// the following basically unrolls this simple loop:
+		// for(size_t i=0; i<n; ++i, ++cur)
+		//     if(*cur == '\0') return cur-s;
+		// and indeed seems to be faster
+
+		if(n == 0 || *cur == '\0')
+			return 0;
+
+		switch(n) {
+	#ifdef DG_MISC_IS_64BIT // 64bit has 8 bytes, so check 4 more
+			case 7: if(*++cur == '\0') return cur-s;
+			        // else fall-through to check next char
+			case 6: if(*++cur == '\0') return cur-s;
+			case 5: if(*++cur == '\0') return cur-s;
+			case 4: if(*++cur == '\0') return cur-s;
+	#endif // DG_MISC_IS_64BIT
+			case 3: if(*++cur == '\0') return cur-s;
+			case 2: if(*++cur == '\0') return cur-s;
+			// no case 1:, because s[0] has already been checked in the `if` above
+		}
+		return n;
+	}
+
+	const char* s_end = s + n; // pointer to byte *after* last valid byte
+
+#ifdef DG_MISC_STRLEN_UNALIGNED
+	// on some machines it's fastest to just do unaligned WordSize-d reads
+	// for the whole string (or at least as far as possible without over-reading)
+
+	const char* cur = s;
+	// the last address where we can do a WordSize-d read without "over-reading"
+	// (i.e. without reading behind the end of the buffer)
+	const char* safeLast = s_end - WordSize;
+	for( ; cur <= safeLast; cur += WordSize )
+	{
+		// do the magic trick on WordSize bytes at a time
+		// (as the bytes may be unaligned, use memcpy() to prevent an
+		//  unaligned load into the uintptr_t, in case the platform
+		//  doesn't support that. if it does, the compiler should convert
+		//  the memcpy() to such a load, at least when using optimizations)
+
+		uintptr_t tmp;
+		memcpy(&tmp, cur, WordSize);
+		// for some reason, on RPi4 32bit with really short strings the
+		// following generates faster code than memcpy() (with GCC 10.2),
+		// even though memcpy() isn't called either way
+		//tmp = *(uintptr_t*)cur;
+		uintptr_t m1 = tmp - magic1;
+		uintptr_t m2 = (~tmp) & magic2;
+		if(m1 & m2)
+		{
+			return _DG_strnlen_nextWordOnly(s, cur, n);
+		}
+	}
+
+#else // ! DG_MISC_STRLEN_UNALIGNED
+	// on other machines it's faster to do aligned WordSize-d reads
+
+	// bitmask to align a pointer address to a multiple of WordSize
+	static const uintptr_t WordAlignMask = ~(uintptr_t)(WordSize-1);
+
+	// s aligned to the next word boundary
+	uintptr_t s_alnI = ((uintptr_t)s + WordSize - 1) & WordAlignMask;
+	const uintptr_t* s_aln = (const uintptr_t *)s_alnI;
+
+	// check bytes between s and s_aln (if any) one by one - reading a whole
+	// (unaligned) word there could cross into the next page if the string is
+	// shorter than that and the page after it isn't mapped, which would crash
+	for(const char* cur = s; cur != (const char*)s_aln; ++cur)
+	{
+		if(*cur == '\0')  return cur - s;
+	}
+
+	// in the main loop we read WordSize bytes at a time, so we may need to stop
+	// at least WordSize bytes before s_end to prevent reading past the end of the buffer
+	const uintptr_t* s_endAln = (const uintptr_t*)((uintptr_t)s_end & WordAlignMask);
+
+	// .. then use the trick to test WordSize bytes at a time,
+	// always aligned to WordSize bytes so we can use the chars
+	// casted to uintptr_t instead of copying first
+	for( ; s_aln != s_endAln; ++s_aln)
+	{
+		// again, the magic trick
+		uintptr_t m1 = *s_aln - magic1;
+		uintptr_t m2 = (~(*s_aln)) & magic2;
+
+		if(m1 & m2)
+		{
+			return _DG_strnlen_nextWordOnly(s, (const char*)s_aln, n);
+		}
+	}
+
+	// now s_aln is at s_endAln, behind the last (full) aligned WordSize-d chunk
+	// of the string - so we only need to check the few last bytes from that point on
+
+	const char* cur = (const char*)s_endAln;
+
+#endif // DG_MISC_STRLEN_UNALIGNED
+
+	// if we got this far then I think it's very likely that one of the last bytes
+	// is \0, so check them directly instead of using the magic trick
+	// (which in case of a match needs to check them again anyway)
+	// the underlying assumption is that most of the time when calling strnlen()
+	// the string indeed is \0 terminated within the first n bytes
+
+	size_t remaining = s_end - cur; // should be < WordSize
+	if(remaining != 0)
+	{
+		DG_MISC_ASSERT(remaining < WordSize, "expected to have less that wordsize (sizeof(uintptr_t)) chars left");
+
+		// same loop-unrolling trick as in if(n < WordSize) above
+		if(*cur == '\0')
+			return cur - s;
+
+		switch(remaining) {
+		#ifdef DG_MISC_IS_64BIT // 64bit has 8 bytes, so check 4 more
+			case 7: if(*++cur == '\0') return cur-s;
+			        // else fall through to check next byte
+			case 6: if(*++cur == '\0') return cur-s;
+			case 5: if(*++cur == '\0') return cur-s;
+			case 4: if(*++cur == '\0') return cur-s;
+		#endif
+			case 3: if(*++cur == '\0') return cur-s;
+			case 2: if(*++cur == '\0') return cur-s;
+			// no case 1 - we already checked one char in the if above
+
+			// if not returned yet, we'll default to return n below
+		}
+	}
+
+	return n;
+}
+
+// returns the length of the string s (but at most n), if block is the address of a
+// vector of 16 or 32 bytes that has been compared to '\0', resulting in mask
+DG__MISC_MAYBE_UNUSED
+static size_t DG__strnlen_found(const char* s, const char* block, unsigned int mask, size_t n)
+{
+	size_t len = (size_t)(block - s) + DG__LowestBitIdx(mask);
+	return (len < n) ? len : n;
+}
+
+#ifdef DG__MISC_HAVE_SSE2
+
+// SSE2 implementation of DG_strnlen(), used if DG_MISC_STRLEN_SIMD is #defined.
+// It only does aligned reads of 16 bytes (or 64 bytes at once, also aligned).
+// Those can contain bytes before s or behind the end of the string, but never cross
+// a page boundary, so it never reads from a page the string isn't in and can't crash.
+// Still, ASan and Valgrind don't like it (and that's why it's opt-in).
+DG__MISC_NO_ASAN DG__MISC_MAYBE_UNUSED
+static size_t DG__strnlen_sse2(const char* s, size_t n)
+{
+	if(n == 0)  return 0;
+	// s+n must not wrap around (DG_strlen() passes the max. possible length)
+	if(n > ~(uintptr_t)0 - (uintptr_t)s)  n = ~(uintptr_t)0 - (uintptr_t)s;
+
+	uintptr_t end = (uintptr_t)s + n; // not a pointer, s+n might not be valid
+	const __m128i zero = _mm_setzero_si128();
+	unsigned int misalign = (unsigned int)((uintptr_t)s & 15);
+	const char* cur = s - misalign;
+
+	unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)cur), zero));
+	mask >>= misalign; // ignore the bytes before s
+	if(mask != 0)  return DG__strnlen_found(s, s, mask, n);
+
+	// single blocks until cur is 64 byte aligned..
+	for(cur += 16; ((uintptr_t)cur & 63) != 0; cur += 16)
+	{
+		if((uintptr_t)cur >= end)  return n;
+		mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)cur), zero));
+		if(mask != 0)  return DG__strnlen_found(s, cur, mask, n);
+	}
+
+	// .. then 64 bytes at once, that group of 4 blocks can't cross a page boundary either
+	for( ; (uintptr_t)cur < end; cur += 64)
+	{
+		__m128i a = _mm_load_si128((const __m128i*)cur);
+		__m128i b = _mm_load_si128((const __m128i*)(cur + 16));
+		__m128i c = _mm_load_si128((const __m128i*)(cur + 32));
+		__m128i d = _mm_load_si128((const __m128i*)(cur + 48));
+		// the minimum of all bytes is 0 if any of them is 0
+		__m128i min = _mm_min_epu8(_mm_min_epu8(a, b), _mm_min_epu8(c, d));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(min, zero)) != 0)
+		{
+			// find the block with the '\0'
+			mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(a, zero));
+			if(mask != 0)  return DG__strnlen_found(s, cur, mask, n);
+			mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(b, zero));
+			if(mask != 0)  return DG__strnlen_found(s, cur + 16, mask, n);
+			mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(c, zero));
+			if(mask != 0)  return DG__strnlen_found(s, cur + 32, mask, n);
+			mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(d, zero));
+			return DG__strnlen_found(s, cur + 48, mask, n);
+		}
+	}
+	return n;
+}
+#endif // DG__MISC_HAVE_SSE2
+
+#ifdef DG__MISC_HAVE_AVX2
+// like DG__strnlen_sse2(), but with aligned 32 byte reads (128 bytes at once)
+DG__MISC_TARGET_AVX2 DG__MISC_NO_ASAN DG__MISC_MAYBE_UNUSED
+static size_t DG__strnlen_avx2(const char* s, size_t n)
+{
+	if(n == 0)  return 0;
+	if(n > ~(uintptr_t)0 - (uintptr_t)s)  n = ~(uintptr_t)0 - (uintptr_t)s;
+
+	uintptr_t end = (uintptr_t)s + n; // not a pointer, s+n might not be valid
+	const __m256i zero = _mm256_setzero_si256();
+	unsigned int misalign = (unsigned int)((uintptr_t)s & 31);
+	const char* cur = s - misalign;
+
+	unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)cur), zero));
+	mask >>= misalign; // ignore the bytes before s
+	if(mask != 0)  return DG__strnlen_found(s, s, mask, n);
+
+	// single blocks until cur is 128 byte aligned..
+	for(cur += 32; ((uintptr_t)cur & 127) != 0; cur += 32)
+	{
+		if((uintptr_t)cur >= end)  return n;
+		mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)cur), zero));
+		if(mask != 0)  return DG__strnlen_found(s, cur, mask, n);
+	}
+
+	// .. then 128 bytes at once
+	for( ; (uintptr_t)cur < end; cur += 128)
+	{
+		__m256i a = _mm256_load_si256((const __m256i*)cur);
+		__m256i b = _mm256_load_si256((const __m256i*)(cur + 32));
+		__m256i c = _mm256_load_si256((const __m256i*)(cur + 64));
+		__m256i d = _mm256_load_si256((const __m256i*)(cur + 96));
+		__m256i min = _mm256_min_epu8(_mm256_min_epu8(a, b), _mm256_min_epu8(c, d));
+		if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(min, zero)) != 0)
+		{
+			mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero));
+			if(mask != 0)  return DG__strnlen_found(s, cur, mask, n);
+			mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, zero));
+			if(mask != 0)  return DG__strnlen_found(s, cur + 32, mask, n);
+			mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, zero));
+			if(mask != 0)  return DG__strnlen_found(s, cur + 64, mask, n);
+			mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(d, zero));
+			return DG__strnlen_found(s, cur + 96, mask, n);
+		}
+	}
+	return n;
+}
+#endif // DG__MISC_HAVE_AVX2
+
+DG_MISC_DEF size_t DG_strnlen(const char* s, size_t n)
+{
+	DG_MISC_ASSERT(s != NULL, "Don't call DG_strnlen() with NULL!");
+
+#if (defined(__GLIBC__) || defined(__APPLE__)) && !defined(DG_MISC_NO_GNU_SOURCE)
+
+	// glibc has a very optimized version of this, use that instead
+	// apple also seems to have optimized ASM code, see
+	// http://www.opensource.apple.com/source/Libc/Libc-1044.1.2/x86_64/string/
+	return strnlen(s, n);
+#elif defined(DG__MISC_DISPATCH)
+	return DG__MiscGetKernels()->strnlen(s, n);
+#elif defined(DG_MISC_STRLEN_SIMD) && defined(DG__MISC_ALWAYS_AVX2)
+	return DG__strnlen_avx2(s, n);
+#elif defined(DG_MISC_STRLEN_SIMD) && defined(DG__MISC_HAVE_SSE2)
+	return DG__strnlen_sse2(s, n);
+#else
+	return DG__strnlen_swar(s, n);
 #endif // __GLIBC__
 }
 
-#ifdef _WIN32
-/* value of _MSC_VER macro for different MSVC versions,
- * so I don't have to google that over and over again
- * (from http://sourceforge.net/p/predef/wiki/Compilers/#microsoft-visual-c
- *  and https://learn.microsoft.com/en-us/cpp/overview/compiler-versions?view=msvc-170
- *  and https://github.com/microsoft/STL/wiki/Macro-_MSVC_STL_UPDATE)
- * Note that _MSC_FULL_VER also exists (from Visual C++ 6.0 SP6 on?), if even finer
- * granularity is needed (likely only to work around very specific compiler bugs).
- *
- * Visual C++    _MSC_VER
- *
- * 18.0  (2026)  1950 // Visual Studio 2026 18.0
- *
- * 17.14 (2022)  1944
- * 17.13 (2022)  1943
- * 17.12 (2022)  1942
- * 17.11 (2022)  1941
- * 17.10 (2022)  1940
- * 17.9  (2022)  1939
- * 17.8  (2022)  1938
- * 17.7  (2022)  1937
- * 17.6  (2022)  1936
- * 17.5  (2022)  1935
- * 17.4  (2022)  1934
- * 17.3  (2022)  1933
- * 17.2  (2022)  1932
- * 17.1  (2022)  1931
- * 17.0  (2022)  1930 // Visual Studio 2022 RTW ("Release to Web")
- *
- * 16.11.14 (2019) 1929 _MSVC_STL_UPDATE: 202105 // /std:c++20 complete, incl. library
- * 16.11 (2019)  1929   _MSVC_STL_UPDATE: 202104
- * 16.10 (2019)  1929 // Visual Studio 2019 16.10 and 16.11 and 16.11.14
- * 16.8  (2019)  1928 // Visual Studio 2019 16.8 and 16.9
- * 16.7  (2019)  1927
- * 16.6  (2019)  1926
- * 16.5  (2019)  1925
- * 16.4  (2019)  1924
- * 16.3  (2019)  1923
- * 16.2  (2019)  1922
- * 16.1  (2019)  1921
- * 16.0  (2019)  1920 // Visual Studio 2019 RTW
- *
- * 15.9 (2017)   1916
- * 15.8 (2017)   1915
- * 15.7 (2017)   1914
- * 15.6 (2017)   1913
- * 15.5 (2017)   1912
- * 15.3 (2017)   1911 // "Visual Studio 2017 Version 15.3 Preview"
- * 15.0 (2017)   1910 // Visual Studio 2017 RTW
- *
- * 14.0 (2015)   1900
- *
- * Note: from VS 2015 on (*at least* up to VS2026) the compiler redistributable runtimes are
- *       backwards compatible (e.g. the one for VS2022 also works for binaries created with VS2015)
- *       see https://learn.microsoft.com/en-us/cpp/windows/latest-supported-vc-redist?view=msvc-170
- *
- * 12.0 (2013)   1800
- * 11.0 (2012)   1700
- * 10.0 (2010)   1600
- * 9.0  (2008)   1500
- * 8.0  (2005)   1400 // first with 64bit support?
- * 7.1  (2003)   1310
- * 7.0           1300
- * 6.0           1200
- * 5.0           1100
- * 4.2           1020
- * 4.0           1000
- * 3.0           900
- * 1.0           800
- */
+#ifdef _WIN32
+/* value of _MSC_VER macro for different MSVC versions,
+ * so I don't have to google that over and over again
+ * (from http://sourceforge.net/p/predef/wiki/Compilers/#microsoft-visual-c
+ *  and https://learn.microsoft.com/en-us/cpp/overview/compiler-versions?view=msvc-170
+ *  and https://github.com/microsoft/STL/wiki/Macro-_MSVC_STL_UPDATE)
+ * Note that _MSC_FULL_VER also exists (from Visual C++ 6.0 SP6 on?), if even finer
+ * granularity is needed (likely only to work around very specific compiler bugs).
+ *
+ * Visual C++    _MSC_VER
+ *
+ * 18.0  (2026)  1950 // Visual Studio 2026 18.0
+ *
+ * 17.14 (2022)  1944
+ * 17.13 (2022)  1943
+ * 17.12 (2022)  1942
+ * 17.11 (2022)  1941
+ * 17.10 (2022)  1940
+ * 17.9  (2022)  1939
+ * 17.8  (2022)  1938
+ * 17.7  (2022)  1937
+ * 17.6  (2022)  1936
+ * 17.5  (2022)  1935
+ * 17.4  (2022)  1934
+ * 17.3  (2022)  1933
+ * 17.2  (2022)  1932
+ * 17.1  (2022)  1931
+ * 17.0  (2022)  1930 // Visual Studio 2022 RTW ("Release to Web")
+ *
+ * 16.11.14 (2019) 1929 _MSVC_STL_UPDATE: 202105 // /std:c++20 complete, incl. library
+ * 16.11 (2019)  1929   _MSVC_STL_UPDATE: 202104
+ * 16.10 (2019)  1929 // Visual Studio 2019 16.10 and 16.11 and 16.11.14
+ * 16.8  (2019)  1928 // Visual Studio 2019 16.8 and 16.9
+ * 16.7  (2019)  1927
+ * 16.6  (2019)  1926
+ * 16.5  (2019)  1925
+ * 16.4  (2019)  1924
+ * 16.3  (2019)  1923
+ * 16.2  (2019)  1922
+ * 16.1  (2019)  1921
+ * 16.0  (2019)  1920 // Visual Studio 2019 RTW
+ *
+ * 15.9 (2017)   1916
+ * 15.8 (2017)   1915
+ * 15.7 (2017)   1914
+ * 15.6 (2017)   1913
+ * 15.5 (2017)   1912
+ * 15.3 (2017)   1911 // "Visual Studio 2017 Version 15.3 Preview"
+ * 15.0 (2017)   1910 // Visual Studio 2017 RTW
+ *
+ * 14.0 (2015)   1900
+ *
+ * Note: from VS 2015 on (*at least* up to VS2026) the compiler redistributable runtimes are
+ *       backwards compatible (e.g. the one for VS2022 also works for binaries created with VS2015)
+ *       see https://learn.microsoft.com/en-us/cpp/windows/latest-supported-vc-redist?view=msvc-170
+ *
+ * 12.0 (2013)   1800
+ * 11.0 (2012)   1700
+ * 10.0 (2010)   1600
+ * 9.0  (2008)   1500
+ * 8.0  (2005)   1400 // first with 64bit support?
+ * 7.1  (2003)   1310
+ * 7.0           1300
+ * 6.0           1200
+ * 5.0           1100
+ * 4.2           1020
+ * 4.0           1000
+ * 3.0           900
+ * 1.0           800
+ */
+
+/* Value of __STDC_VERSION__ macro for different C versions
+ * (https://en.cppreference.com/w/c/preprocessor/replace#Predefined_macros)
+ *
+ * C23: 202311L
+ * C17: 201710L
+ * C11: 201112L
+ * C99: 199901L
+ * C95: 199409L
+ * (C89 presumably doesn't have this defined)
+ */
+
+/* Value of __cplusplus macro for different C++ versions
+ * (https://en.cppreference.com/w/cpp/preprocessor/replace#Predefined_macros)
+ * ! VisualC++ needs _MSVC_LANG instead, unless the /Zc:__cplusplus compiler option is set:
+ * ! https://learn.microsoft.com/en-us/cpp/build/reference/zc-cplusplus
+ *
+ * C++23:    202302L
+ * C++20:    202002L
+ * C++17:    201703L
+ * C++14:    201402L
+ * C++11:    201103L
+ * C++98/03: 199711L
+ */
+
+#ifndef DG_strlen // if it's not just a #define for regular strlen
+
+// plain C implementation of DG_strlen()
+DG__MISC_MAYBE_UNUSED
+static size_t DG__strlen_c(const char* s)
+{
+#ifdef DG_MISC_STRLEN_OVERREAD
+	// glibc's strlen() is *fucking* fast (with custom ASM), Apple also has custom ASM,
+	// freebsd uses the same trick as DG_strnlen() and is slightly faster...
+	// but Microsoft's strlen() (in some version I tested years ago)
+	// was slower than DG_strnlen(), so use this for Windows before VS2015..
+	// I don't feel like duplicating all that strnlen() code, so let's just pass
+	// the max. possible length, until almost the highest address a pointer can store.
+	// Only "almost" to avoid ugly integer wrapping when DG_strnlen() does something
+	// like for(const char* cur=s; cur<s+n; cur += sizeof(uintptr_t))
+
+	// the following might read up to sizeof(uintptr_t)-1 bytes past the end of the buffer
+	// (to read a full aligned uintptr_t). that *should* not hurt usually, but ASan hates it
+	static const uintptr_t maxaddr = ~((uintptr_t)0);
+	return DG_strnlen(s, maxaddr - (uintptr_t)s - sizeof(uintptr_t));
+#else
+	// if we're not allowed to read past the end of the buffer,
+	// there's no hope for optimizations - do the naive loop.
+	const char* cur = s;
+	while(*cur != '\0')
+		++cur;
+	return cur - s;
+#endif
+}
+
+#ifdef DG__MISC_HAVE_SSE2
+// for DG_MISC_STRLEN_SIMD, see DG__strnlen_sse2()
+DG__MISC_MAYBE_UNUSED
+static size_t DG__strlen_sse2(const char* s)
+{
+	return DG__strnlen_sse2(s, (size_t)-1); // it makes sure that s+n doesn't wrap around
+}
+#endif
+
+#ifdef DG__MISC_HAVE_AVX2
+DG__MISC_TARGET_AVX2 DG__MISC_MAYBE_UNUSED
+static size_t DG__strlen_avx2(const char* s)
+{
+	return DG__strnlen_avx2(s, (size_t)-1);
+}
+#endif
+
+DG_MISC_DEF size_t DG_strlen(const char* s)
+{
+#ifdef DG__MISC_DISPATCH
+	return DG__MiscGetKernels()->strlen(s);
+#elif defined(DG_MISC_STRLEN_SIMD) && defined(DG__MISC_ALWAYS_AVX2)
+	return DG__strlen_avx2(s);
+#elif defined(DG_MISC_STRLEN_SIMD) && defined(DG__MISC_HAVE_SSE2)
+	return DG__strlen_sse2(s);
+#else
+	return DG__strlen_c(s);
+#endif
+}
+
+#endif // DG_strlen
+
+#ifndef DG_vsnprintf // if it's not just a #define for regular vsnprintf
+
+DG_MISC_DEF int DG_vsnprintf(char *dst, size_t size, const char *format, va_list ap)
+{
+	DG_MISC_ASSERT(format, "Don't pass a NULL format into DG_vsnprintf()!");
+	// TODO: assert(size <= INT_MAX && "Don't pass a size > INT_MAX to DG_vsnprintf()!"); ??
+	//       after all, we're supposed to return the number of bytes written.. as an int.
+
+	int ret = -1;
+	if(dst != NULL && size > 0)
+	{
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+		// I think MSVC2005 introduced _vsnprintf_s().
+		// this shuts up _vsnprintf() security/deprecation warnings.
+		ret = _vsnprintf_s(dst, size, _TRUNCATE, format, ap);
+#else
+		ret = _vsnprintf(dst, size, format, ap);
+		dst[size-1] = '\0'; // ensure '\0'-termination
+#endif
+	}
+
+	if(ret == -1)
+	{
+		// _vsnprintf() returns -1 if the output is truncated
+		// it's also -1 if dst or size were NULL/0, so the user didn't want to write
+		// we want to return the number of characters that would've been
+		// needed, though.. fortunately _vscprintf() calculates that.
+		ret = _vscprintf(format, ap);
+
+		// NOTE: on ancient MSVC versions you may get an error because
+		//  _vscprintf() is not supported.. I don't know when it started being
+		//  supported and I don't want to silently make this function incorrect
+		//  anyway.. feel free to comment out that line yourself, -1 will be
+		//  returned in case of a too short buffer then.
+		//  At least it'll still be '\0'-terminated.
+	}
+
+	return ret;
+}
+#endif // DG_vsnprintf
+
+#ifndef DG_snprintf // if it's not just a #define to regular snprintf()
+
+DG_MISC_DEF int DG_snprintf(char *dst, size_t size, const char *format, ...)
+{
+	DG_MISC_ASSERT(format, "Don't pass a NULL format into DG_snprintf()!");
+
+	int ret = 0;
+
+	va_list argptr;
+	va_start( argptr, format );
+
+	ret = DG_vsnprintf(dst, size, format, argptr);
+
+	va_end( argptr );
+
+	return ret;
+}
+#endif // DG_snprintf is defined
+
+#endif // _WIN32
+
+DG_MISC_DEF void DG_StrBuf_Init(DG_StrBuf* sb)
+{
+	DG_MISC_ASSERT(sb != NULL, "Don't pass NULL into DG_StrBuf_Init()!");
+	sb->str = NULL;
+	sb->len = 0;
+	sb->cap = 0;
+	sb->external = 0;
+}
+
+DG_MISC_DEF void DG_StrBuf_InitExternal(DG_StrBuf* sb, char* buf, size_t bufSize)
+{
+	DG_MISC_ASSERT(sb != NULL, "Don't pass NULL into DG_StrBuf_InitExternal()!");
+	if(buf == NULL || bufSize == 0)
+	{
+		DG_StrBuf_Init(sb);
+		return;
+	}
+	buf[0] = '\0';
+	sb->str = buf;
+	sb->len = 0;
+	sb->cap = bufSize;
+	sb->external = 1;
+}
+
+DG_MISC_DEF void DG_StrBuf_Free(DG_StrBuf* sb)
+{
+	DG_MISC_ASSERT(sb != NULL, "Don't pass NULL into DG_StrBuf_Free()!");
+	if(!sb->external)
+		free(sb->str);
+	DG_StrBuf_Init(sb);
+}
+
+DG_MISC_DEF void DG_StrBuf_Clear(DG_StrBuf* sb)
+{
+	DG_MISC_ASSERT(sb != NULL, "Don't pass NULL into DG_StrBuf_Clear()!");
+	sb->len = 0;
+	if(sb->str != NULL)
+		sb->str[0] = '\0';
+}
+
+DG_MISC_DEF int DG_StrBuf_Reserve(DG_StrBuf* sb, size_t extraLen)
+{
+	DG_MISC_ASSERT(sb != NULL, "Don't pass NULL into DG_StrBuf_Reserve()!");
+	size_t len = sb->len;
+	if(extraLen >= ((size_t)-1) - len)  return 0; // len + extraLen + 1 would overflow
+
+	size_t minCap = len + extraLen + 1;
+	if(minCap <= sb->cap)  return 1;
+
+	// grow geometrically, so appending n chars one by one is O(n) in total
+	size_t newCap = (sb->cap <= ((size_t)-1)/2) ? sb->cap*2 : minCap;
+	if(newCap < minCap)  newCap = minCap;
+	if(newCap < 64)  newCap = 64;
+
+	char* p;
+	if(sb->external || sb->str == NULL)
+	{
+		// don't touch the external buffer, just copy it (like da_init_external())
+		p = (char*)malloc(newCap);
+		if(p == NULL)  return 0;
+		if(len > 0)
+			memcpy(p, sb->str, len);
+		p[len] = '\0';
+	}
+	else
+	{
+		p = (char*)realloc(sb->str, newCap);
+		if(p == NULL)  return 0; // sb->str is still valid
+	}
+	sb->str = p;
+	sb->cap = newCap;
+	sb->external = 0;
+	return 1;
+}
+
+DG_MISC_DEF int DG_StrBuf_AppendN(DG_StrBuf* sb, const char* str, size_t len)
+{
+	DG_MISC_ASSERT(sb && (str || len == 0), "Don't pass NULL into DG_StrBuf_AppendN()!");
+	if(len >= sb->cap - sb->len && !DG_StrBuf_Reserve(sb, len))
+		return 0;
+	memcpy(sb->str + sb->len, str, len);
+	sb->len += len;
+	sb->str[sb->len] = '\0';
+	return 1;
+}
+
+DG_MISC_DEF int DG_StrBuf_Append(DG_StrBuf* sb, const char* str)
+{
+	DG_MISC_ASSERT(str != NULL, "Don't pass a NULL string into DG_StrBuf_Append()!");
+	return DG_StrBuf_AppendN(sb, str, strlen(str));
+}
+
+DG_MISC_DEF int DG_StrBuf_AppendChar(DG_StrBuf* sb, char c)
+{
+	DG_MISC_ASSERT(sb != NULL, "Don't pass NULL into DG_StrBuf_AppendChar()!");
+	if(sb->len + 1 >= sb->cap && !DG_StrBuf_Reserve(sb, 1))
+		return 0;
+	sb->str[sb->len++] = c;
+	sb->str[sb->len] = '\0';
+	return 1;
+}
+
+#if defined(va_copy)
+  #define DG__VA_COPY(dst, src)  va_copy(dst, src)
+#elif defined(__va_copy)
+  #define DG__VA_COPY(dst, src)  __va_copy(dst, src)
+#elif defined(_MSC_VER) // MSVC before 2013 doesn't have va_copy, but there va_list is just a pointer
+  #define DG__VA_COPY(dst, src)  ((dst) = (src))
+#else
+  #error "DG_StrBuf_AppendVF() needs va_copy()"
+#endif
+
+DG_MISC_DEF int DG_StrBuf_AppendVF(DG_StrBuf* sb, const char* format, va_list ap)
+{
+	DG_MISC_ASSERT(sb && format, "Don't pass NULL into DG_StrBuf_AppendVF()!");
+
+	// format directly into the free space at the end of the buffer,
+	// if that's too small grow it and format again
+	size_t spare = sb->cap - sb->len;
+	va_list ap2;
+	DG__VA_COPY(ap2, ap);
+	int n = DG_vsnprintf((sb->str != NULL) ? sb->str + sb->len : NULL, spare, format, ap);
+	if(n >= 0 && (size_t)n >= spare)
+	{
+		if(DG_StrBuf_Reserve(sb, (size_t)n))
+			DG_vsnprintf(sb->str + sb->len, sb->cap - sb->len, format, ap2);
+		else
+			n = -1;
+	}
+	va_end(ap2);
+
+	if(n < 0)
+	{
+		// the truncated output may have overwritten the terminating '\0'
+		if(sb->str != NULL)
+			sb->str[sb->len] = '\0';
+		return 0;
+	}
+	sb->len += (size_t)n;
+	return 1;
+}
+
+DG_MISC_DEF int DG_StrBuf_AppendF(DG_StrBuf* sb, const char* format, ...)
+{
+	va_list argptr;
+	va_start( argptr, format );
+	int ret = DG_StrBuf_AppendVF(sb, format, argptr);
+	va_end( argptr );
+	return ret;
+}
+
+DG_MISC_DEF char* DG_StrBuf_Detach(DG_StrBuf* sb, size_t* len)
+{
+	DG_MISC_ASSERT(sb != NULL, "Don't pass NULL into DG_StrBuf_Detach()!");
+	char* ret;
+	size_t retLen = sb->len;
+	if(sb->external || sb->str == NULL)
+	{
+		// the external buffer can't be passed on (and can be reused), so return a copy
+		ret = (char*)malloc(retLen + 1);
+		if(ret == NULL)  return NULL;
+		if(retLen > 0)
+			memcpy(ret, sb->str, retLen);
+		ret[retLen] = '\0';
+		DG_StrBuf_Clear(sb);
+	}
+	else
+	{
+		ret = sb->str;
+		DG_StrBuf_Init(sb);
+	}
+	if(len != NULL)
+		*len = retLen;
+	return ret;
+}
+
+// the strings of a DG_StrPool are stored in blocks of (at least) this size
+#define DG__STRPOOL_BLOCK_SIZE 16384
+
+// strings longer than this get a block of their own, so they don't waste
+// the rest of the current block
+#define DG__STRPOOL_BIG_STRING (DG__STRPOOL_BLOCK_SIZE / 4)
+
+typedef struct DG__StrPoolBlock {
+	struct DG__StrPoolBlock* next;
+	// the strings follow directly after this header
+} DG__StrPoolBlock;
+
+typedef struct DG__StrPoolEntry {
+	const char* str;
+	unsigned int len;
+	unsigned int hash; // stored so growing the index doesn't need to hash the strings again
+} DG__StrPoolEntry;
+
+// each string is stored in the blocks as its ID (unaligned) followed by the string
+// itself and a terminating '\0', so DG_StrPool_GetID() doesn't need a lookup
+#define DG__STRPOOL_ID_SIZE sizeof(unsigned int)
+
+// 32-bit hash of the string for the index: reads 8 bytes at a time, mixes them with
+// multiplications and finishes with the avalanche step of MurmurHash3's fmix64()
+static unsigned int DG__StrPoolHash(const char* str, size_t len)
+{
+	unsigned long long h = 0x9E3779B97F4A7C15ull ^ len;
+	unsigned long long w;
+	while(len >= 8)
+	{
+		memcpy(&w, str, 8); // compiles to a single (unaligned) load
+		h = (h ^ w) * 0xBF58476D1CE4E5B9ull;
+		h ^= h >> 31;
+		str += 8;
+		len -= 8;
+	}
+	if(len >= 4)
+	{
+		// the last 4 to 7 bytes, as two (maybe overlapping) 4 byte reads
+		unsigned int lo, hi;
+		memcpy(&lo, str, 4);
+		memcpy(&hi, str + len - 4, 4);
+		h = (h ^ (lo | ((unsigned long long)hi << 32))) * 0xBF58476D1CE4E5B9ull;
+	}
+	else if(len > 0)
+	{
+		// 1 to 3 bytes: the first, the middle and the last one (like wyhash does it)
+		w = ((unsigned long long)(unsigned char)str[0] << 16)
+		    | ((unsigned long long)(unsigned char)str[len >> 1] << 8) | (unsigned char)str[len - 1];
+		h = (h ^ w) * 0xBF58476D1CE4E5B9ull;
+	}
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDull;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ull;
+	h ^= h >> 33;
+	return (unsigned int)h;
+}
+
+// returns the index slot that contains the string (hash was calculated with
+// DG__StrPoolHash()), or the empty slot where it would be inserted
+static unsigned int* DG__StrPoolLookup(const DG_StrPool* pool, const char* str, size_t len, unsigned int hash)
+{
+	// linear probing, indexSize is a power of two and the index is at most half full
+	unsigned int mask = pool->indexSize - 1;
+	unsigned int i = hash & mask;
+	for(;;)
+	{
+		unsigned int* slot = &pool->index[i];
+		if(*slot == 0)  return slot;
+		const DG__StrPoolEntry* e = &pool->entries[*slot - 1];
+		if(e->hash == hash && e->len == len && memcmp(e->str, str, len) == 0)
+			return slot;
+		i = (i + 1) & mask;
+	}
+}
+
+// doubles the size of the index (or creates it), returns 0 if allocation failed
+static int DG__StrPoolGrowIndex(DG_StrPool* pool)
+{
+	unsigned int newSize = (pool->indexSize != 0) ? pool->indexSize * 2 : 64;
+	if(newSize < pool->indexSize)  return 0; // overflow
+	unsigned int* newIndex = (unsigned int*)calloc(newSize, sizeof(unsigned int));
+	if(newIndex == NULL)  return 0;
+
+	unsigned int mask = newSize - 1;
+	for(unsigned int id=0; id < pool->numStrings; ++id)
+	{
+		unsigned int i = pool->entries[id].hash & mask;
+		while(newIndex[i] != 0)  i = (i + 1) & mask;
+		newIndex[i] = id + 1;
+	}
+	free(pool->index);
+	pool->index = newIndex;
+	pool->indexSize = newSize;
+	return 1;
+}
+
+// returns memory for a string of len chars (+ ID and '\0') in the blocks, NULL if allocation failed
+static char* DG__StrPoolAlloc(DG_StrPool* pool, size_t len)
+{
+	size_t size = DG__STRPOOL_ID_SIZE + len + 1;
+	if(size <= pool->blockRest)
+	{
+		char* ret = pool->blockPos;
+		pool->blockPos += size;
+		pool->blockRest -= size;
+		return ret;
+	}
+
+	int bigString = (len > DG__STRPOOL_BIG_STRING);
+	size_t blockSize = bigString ? size : DG__STRPOOL_BLOCK_SIZE;
+	DG__StrPoolBlock* block = (DG__StrPoolBlock*)malloc(sizeof(DG__StrPoolBlock) + blockSize);
+	if(block == NULL)  return NULL;
+	char* ret = (char*)(block + 1);
+
+	if(bigString && pool->blocks != NULL)
+	{
+		// insert it after the current block, which remains current
+		block->next = pool->blocks->next;
+		pool->blocks->next = block;
+	}
+	else
+	{
+		block->next = pool->blocks;
+		pool->blocks = block;
+		pool->blockPos = ret + size;
+		pool->blockRest = blockSize - size;
+	}
+	return ret;
+}
+
+DG_MISC_DEF void DG_StrPool_Init(DG_StrPool* pool)
+{
+	DG_MISC_ASSERT(pool != NULL, "Don't pass NULL into DG_StrPool_Init()!");
+	memset(pool, 0, sizeof(*pool));
+}
+
+DG_MISC_DEF void DG_StrPool_Free(DG_StrPool* pool)
+{
+	DG_MISC_ASSERT(pool != NULL, "Don't pass NULL into DG_StrPool_Free()!");
+	DG__StrPoolBlock* block = pool->blocks;
+	while(block != NULL)
+	{
+		DG__StrPoolBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+	free(pool->entries);
+	free(pool->index);
+	DG_StrPool_Init(pool);
+}
+
+DG_MISC_DEF unsigned int DG_StrPool_InternID(DG_StrPool* pool, const char* str, size_t len)
+{
+	DG_MISC_ASSERT(pool && (str || len == 0), "Don't pass NULL into DG_StrPool_InternID()!");
+	if(len >= 0xFFFFFFFFu)  return DG_STRPOOL_INVALID_ID; // doesn't fit into DG__StrPoolEntry::len
+	if(str == NULL)  str = "";
+
+	unsigned int hash = DG__StrPoolHash(str, len);
+	unsigned int* slot = NULL;
+	if(pool->indexSize != 0)
+	{
+		slot = DG__StrPoolLookup(pool, str, len, hash);
+		if(*slot != 0)  return *slot - 1; // already interned
+	}
+
+	// it's a new string. make sure everything that's needed can be allocated
+	// before changing anything, so the pool remains unchanged if that fails
+	if(pool->numStrings == DG_STRPOOL_INVALID_ID - 1)  return DG_STRPOOL_INVALID_ID;
+	if(pool->numStrings == pool->entriesCap)
+	{
+		unsigned int newCap = (pool->entriesCap != 0) ? pool->entriesCap * 2 : 32;
+		if(newCap < pool->entriesCap || newCap > DG_STRPOOL_INVALID_ID - 1)  newCap = DG_STRPOOL_INVALID_ID - 1;
+		size_t newSize = (size_t)newCap * sizeof(DG__StrPoolEntry);
+		if(newSize / sizeof(DG__StrPoolEntry) != newCap)  return DG_STRPOOL_INVALID_ID; // overflow on 32-bit
+		DG__StrPoolEntry* newEntries = (DG__StrPoolEntry*)realloc(pool->entries, newSize);
+		if(newEntries == NULL)  return DG_STRPOOL_INVALID_ID;
+		pool->entries = newEntries;
+		pool->entriesCap = newCap;
+	}
+	// keep the index at most half full, so the probe sequences stay short
+	if(pool->numStrings + 1 > pool->indexSize / 2)
+	{
+		if(!DG__StrPoolGrowIndex(pool))  return DG_STRPOOL_INVALID_ID;
+		slot = DG__StrPoolLookup(pool, str, len, hash);
+	}
+	char* mem = DG__StrPoolAlloc(pool, len);
+	if(mem == NULL)  return DG_STRPOOL_INVALID_ID;
+
+	unsigned int id = pool->numStrings++;
+	memcpy(mem, &id, DG__STRPOOL_ID_SIZE);
+	char* copy = mem + DG__STRPOOL_ID_SIZE;
+	memcpy(copy, str, len);
+	copy[len] = '\0';
+
+	DG__StrPoolEntry* e = &pool->entries[id];
+	e->str = copy;
+	e->len = (unsigned int)len;
+	e->hash = hash;
+	*slot = id + 1;
+	return id;
+}
+
+DG_MISC_DEF const char* DG_StrPool_InternN(DG_StrPool* pool, const char* str, size_t len)
+{
+	unsigned int id = DG_StrPool_InternID(pool, str, len);
+	return (id != DG_STRPOOL_INVALID_ID) ? pool->entries[id].str : NULL;
+}
+
+DG_MISC_DEF const char* DG_StrPool_Intern(DG_StrPool* pool, const char* str)
+{
+	DG_MISC_ASSERT(str != NULL, "Don't pass a NULL string into DG_StrPool_Intern()!");
+	return DG_StrPool_InternN(pool, str, strlen(str));
+}
+
+DG_MISC_DEF unsigned int DG_StrPool_Find(const DG_StrPool* pool, const char* str, size_t len)
+{
+	DG_MISC_ASSERT(pool && (str || len == 0), "Don't pass NULL into DG_StrPool_Find()!");
+	if(pool->indexSize == 0 || len >= 0xFFFFFFFFu)  return DG_STRPOOL_INVALID_ID;
+	if(str == NULL)  str = "";
+
+	unsigned int* slot = DG__StrPoolLookup(pool, str, len, DG__StrPoolHash(str, len));
+	return *slot - 1; // if *slot is 0 (not found), this wraps around to DG_STRPOOL_INVALID_ID
+}
+
+DG_MISC_DEF const char* DG_StrPool_Get(const DG_StrPool* pool, unsigned int id)
+{
+	DG_MISC_ASSERT(pool != NULL && id < pool->numStrings, "Invalid ID passed to DG_StrPool_Get()!");
+	return pool->entries[id].str;
+}
+
+DG_MISC_DEF size_t DG_StrPool_Len(const DG_StrPool* pool, unsigned int id)
+{
+	DG_MISC_ASSERT(pool != NULL && id < pool->numStrings, "Invalid ID passed to DG_StrPool_Len()!");
+	return pool->entries[id].len;
+}
+
+DG_MISC_DEF unsigned int DG_StrPool_GetID(const DG_StrPool* pool, const char* interned)
+{
+	DG_MISC_ASSERT(pool != NULL && interned != NULL, "Don't pass NULL into DG_StrPool_GetID()!");
+	unsigned int id;
+	memcpy(&id, interned - DG__STRPOOL_ID_SIZE, DG__STRPOOL_ID_SIZE);
+	DG_MISC_ASSERT(id < pool->numStrings && pool->entries[id].str == interned,
+	               "The string passed to DG_StrPool_GetID() is not from this pool!");
+	(void)pool; // only used in the assertion
+	return id;
+}
+
+// "00" "01" ... "99", so two digits can be written at once
+static const char DG__digitPairs[201] =
+	"00010203040506070809" "10111213141516171819" "20212223242526272829"
+	"30313233343536373839" "40414243444546474849" "50515253545556575859"
+	"60616263646566676869" "70717273747576777879" "80818283848586878889"
+	"90919293949596979899";
+
+// returns the number of decimal digits of v
+static int DG__NumDigits(uint64_t v)
+{
+	int n = 1;
+	for(;;)
+	{
+		if(v < 10)     return n;
+		if(v < 100)    return n+1;
+		if(v < 1000)   return n+2;
+		if(v < 10000)  return n+3;
+		v /= 10000;
+		n += 4;
+	}
+}
+
+// writes the digits of v backwards, the last one to end[-1]
+static void DG__WriteDigitsBackwards(char* end, uint64_t v)
+{
+	// 64bit divisions are slow on 32bit CPUs, so split v into chunks
+	// of 8 digits that can be handled with 32bit operations
+	while(v > 0xFFFFFFFFu)
+	{
+		uint32_t chunk = (uint32_t)(v % 100000000u);
+		v /= 100000000u;
+		for(int i=0; i<4; ++i)
+		{
+			end -= 2;
+			memcpy(end, DG__digitPairs + (chunk % 100)*2, 2);
+			chunk /= 100;
+		}
+	}
+	uint32_t v32 = (uint32_t)v;
+	while(v32 >= 100)
+	{
+		end -= 2;
+		memcpy(end, DG__digitPairs + (v32 % 100)*2, 2);
+		v32 /= 100;
+	}
+	if(v32 >= 10)
+		memcpy(end-2, DG__digitPairs + v32*2, 2);
+	else
+		end[-1] = (char)('0' + v32);
+}
+
+DG_MISC_DEF size_t DG_u64toa(char* buf, unsigned long long v)
+{
+	DG_MISC_ASSERT(buf != NULL, "Don't pass a NULL buffer into DG_u64toa()!");
+	int len = DG__NumDigits(v);
+	DG__WriteDigitsBackwards(buf + len, v);
+	buf[len] = '\0';
+	return len;
+}
+
+DG_MISC_DEF size_t DG_i64toa(char* buf, long long v)
+{
+	DG_MISC_ASSERT(buf != NULL, "Don't pass a NULL buffer into DG_i64toa()!");
+	if(v < 0)
+	{
+		buf[0] = '-';
+		// negating as unsigned also works for the smallest long long
+		return 1 + DG_u64toa(buf+1, 0uLL - (unsigned long long)v);
+	}
+	return DG_u64toa(buf, (unsigned long long)v);
+}
+
+// DG_dtoa() and DG_ftoa() use the Grisu3 algorithm by Florian Loitsch, see
+// "Printing Floating-Point Numbers Quickly and Accurately with Integers" (PLDI 2010)
+// and the double-conversion library (https://github.com/google/double-conversion)
+// which this is based on. Grisu3 finds the shortest digits for >99.5% of all numbers
+// and detects when it can't; for those the digits are found with DG__ShortestFallback()
+
+// they take the IEEE 754 bits of the numbers apart
+DG_MISC_STATIC_ASSERT(sizeof(double) == 8, double_must_be_64bit);
+DG_MISC_STATIC_ASSERT(sizeof(float) == 4, float_must_be_32bit);
+
+// "do-it-yourself floating point": f * 2^e
+typedef struct {
+	uint64_t f;
+	int e;
+} DG__DiyFp;
+
+static DG__DiyFp DG__DiyFpMake(uint64_t f, int e)
+{
+	DG__DiyFp ret;
+	ret.f = f;
+	ret.e = e;
+	return ret;
+}
+
+// shifts f to the left until its highest bit is set
+static DG__DiyFp DG__DiyFpNormalize(DG__DiyFp x)
+{
+	while((x.f & 0xFF00000000000000uLL) == 0)
+	{
+		x.f <<= 8;
+		x.e -= 8;
+	}
+	while((x.f & 0x8000000000000000uLL) == 0)
+	{
+		x.f <<= 1;
+		x.e -= 1;
+	}
+	return x;
+}
+
+// multiplies x and y, only keeps the (rounded) upper 64 bits of the 128 bit product
+static DG__DiyFp DG__DiyFpMul(DG__DiyFp x, DG__DiyFp y)
+{
+	const uint64_t M32 = 0xFFFFFFFFu;
+	uint64_t a = x.f >> 32, b = x.f & M32;
+	uint64_t c = y.f >> 32, d = y.f & M32;
+	uint64_t ac = a*c, bc = b*c, ad = a*d, bd = b*d;
+	uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+	tmp += 1u << 31; // round
+	return DG__DiyFpMake(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64);
+}
+
+// 10^k = f * 2^e, for k = -348, -340, ..., 340 (with f rounded and normalized)
+static const struct {
+	uint64_t f;
+	short e;
+	short k;
+} DG__cachedPowers[] = {
+	{ 0xFA8FD5A0081C0288uLL, -1220, -348 }, { 0xBAAEE17FA23EBF76uLL, -1193, -340 }, { 0x8B16FB203055AC76uLL, -1166, -332 },
+	{ 0xCF42894A5DCE35EAuLL, -1140, -324 }, { 0x9A6BB0AA55653B2DuLL, -1113, -316 }, { 0xE61ACF033D1A45DFuLL, -1087, -308 },
+	{ 0xAB70FE17C79AC6CAuLL, -1060, -300 }, { 0xFF77B1FCBEBCDC4FuLL, -1034, -292 }, { 0xBE5691EF416BD60CuLL, -1007, -284 },
+	{ 0x8DD01FAD907FFC3CuLL,  -980, -276 }, { 0xD3515C2831559A83uLL,  -954, -268 }, { 0x9D71AC8FADA6C9B5uLL,  -927, -260 },
+	{ 0xEA9C227723EE8BCBuLL,  -901, -252 }, { 0xAECC49914078536DuLL,  -874, -244 }, { 0x823C12795DB6CE57uLL,  -847, -236 },
+	{ 0xC21094364DFB5637uLL,  -821, -228 }, { 0x9096EA6F3848984FuLL,  -794, -220 }, { 0xD77485CB25823AC7uLL,  -768, -212 },
+	{ 0xA086CFCD97BF97F4uLL,  -741, -204 }, { 0xEF340A98172AACE5uLL,  -715, -196 }, { 0xB23867FB2A35B28EuLL,  -688, -188 },
+	{ 0x84C8D4DFD2C63F3BuLL,  -661, -180 }, { 0xC5DD44271AD3CDBAuLL,  -635, -172 }, { 0x936B9FCEBB25C996uLL,  -608, -164 },
+	{ 0xDBAC6C247D62A584uLL,  -582, -156 }, { 0xA3AB66580D5FDAF6uLL,  -555, -148 }, { 0xF3E2F893DEC3F126uLL,  -529, -140 },
+	{ 0xB5B5ADA8AAFF80B8uLL,  -502, -132 }, { 0x87625F056C7C4A8BuLL,  -475, -124 }, { 0xC9BCFF6034C13053uLL,  -449, -116 },
+	{ 0x964E858C91BA2655uLL,  -422, -108 }, { 0xDFF9772470297EBDuLL,  -396, -100 }, { 0xA6DFBD9FB8E5B88FuLL,  -369,  -92 },
+	{ 0xF8A95FCF88747D94uLL,  -343,  -84 }, { 0xB94470938FA89BCFuLL,  -316,  -76 }, { 0x8A08F0F8BF0F156BuLL,  -289,  -68 },
+	{ 0xCDB02555653131B6uLL,  -263,  -60 }, { 0x993FE2C6D07B7FACuLL,  -236,  -52 }, { 0xE45C10C42A2B3B06uLL,  -210,  -44 },
+	{ 0xAA242499697392D3uLL,  -183,  -36 }, { 0xFD87B5F28300CA0EuLL,  -157,  -28 }, { 0xBCE5086492111AEBuLL,  -130,  -20 },
+	{ 0x8CBCCC096F5088CCuLL,  -103,  -12 }, { 0xD1B71758E219652CuLL,   -77,   -4 }, { 0x9C40000000000000uLL,   -50,    4 },
+	{ 0xE8D4A51000000000uLL,   -24,   12 }, { 0xAD78EBC5AC620000uLL,     3,   20 }, { 0x813F3978F8940984uLL,    30,   28 },
+	{ 0xC097CE7BC90715B3uLL,    56,   36 }, { 0x8F7E32CE7BEA5C70uLL,    83,   44 }, { 0xD5D238A4ABE98068uLL,   109,   52 },
+	{ 0x9F4F2726179A2245uLL,   136,   60 }, { 0xED63A231D4C4FB27uLL,   162,   68 }, { 0xB0DE65388CC8ADA8uLL,   189,   76 },
+	{ 0x83C7088E1AAB65DBuLL,   216,   84 }, { 0xC45D1DF942711D9AuLL,   242,   92 }, { 0x924D692CA61BE758uLL,   269,  100 },
+	{ 0xDA01EE641A708DEAuLL,   295,  108 }, { 0xA26DA3999AEF774AuLL,   322,  116 }, { 0xF209787BB47D6B85uLL,   348,  124 },
+	{ 0xB454E4A179DD1877uLL,   375,  132 }, { 0x865B86925B9BC5C2uLL,   402,  140 }, { 0xC83553C5C8965D3DuLL,   428,  148 },
+	{ 0x952AB45CFA97A0B3uLL,   455,  156 }, { 0xDE469FBD99A05FE3uLL,   481,  164 }, { 0xA59BC234DB398C25uLL,   508,  172 },
+	{ 0xF6C69A72A3989F5CuLL,   534,  180 }, { 0xB7DCBF5354E9BECEuLL,   561,  188 }, { 0x88FCF317F22241E2uLL,   588,  196 },
+	{ 0xCC20CE9BD35C78A5uLL,   614,  204 }, { 0x98165AF37B2153DFuLL,   641,  212 }, { 0xE2A0B5DC971F303AuLL,   667,  220 },
+	{ 0xA8D9D1535CE3B396uLL,   694,  228 }, { 0xFB9B7CD9A4A7443CuLL,   720,  236 }, { 0xBB764C4CA7A44410uLL,   747,  244 },
+	{ 0x8BAB8EEFB6409C1AuLL,   774,  252 }, { 0xD01FEF10A657842CuLL,   800,  260 }, { 0x9B10A4E5E9913129uLL,   827,  268 },
+	{ 0xE7109BFBA19C0C9DuLL,   853,  276 }, { 0xAC2820D9623BF429uLL,   880,  284 }, { 0x80444B5E7AA7CF85uLL,   907,  292 },
+	{ 0xBF21E44003ACDD2DuLL,   933,  300 }, { 0x8E679C2F5E44FF8FuLL,   960,  308 }, { 0xD433179D9C8CB841uLL,   986,  316 },
+	{ 0x9E19DB92B4E31BA9uLL,  1013,  324 }, { 0xEB96BF6EBADF77D9uLL,  1039,  332 }, { 0xAF87023B9BF0EE6BuLL,  1066,  340 },};
+
+// the digits are generated from v * 10^k, which should have a binary exponent in this range
+#define DG__GRISU_MIN_EXP  -60
+#define DG__GRISU_MAX_EXP  -32
+
+// the highest number of digits Grisu3 generates for a double (DG_ftoa() needs fewer)
+#define DG__GRISU_MAX_DIGITS  17
+
+// returns the cached power of ten that, multiplied with a normalized DG__DiyFp with
+// exponent e, gives a binary exponent between DG__GRISU_MIN_EXP and DG__GRISU_MAX_EXP
+static DG__DiyFp DG__GrisuCachedPower(int e, int* k)
+{
+	// the decimal exponent of the smallest power of ten that is big enough
+	// (ceil() of the product, without needing libm)
+	double dk = (DG__GRISU_MIN_EXP - (e + 64) + 63) * 0.30102999566398114; // log10(2)
+	int minK = (int)dk;
+	if(minK < dk)  ++minK;
+	int idx = (348 + minK - 1) / 8 + 1;
+	*k = DG__cachedPowers[idx].k;
+	return DG__DiyFpMake(DG__cachedPowers[idx].f, DG__cachedPowers[idx].e);
+}
+
+// adjusts the last digit to get as close as possible to w (that's distTooHighW below
+// the too high upper boundary) and checks if the result is guaranteed to be correct
+static int DG__GrisuRoundWeed(char* digits, int numDigits, uint64_t distTooHighW,
+                              uint64_t unsafeInterval, uint64_t rest, uint64_t tenKappa, uint64_t unit)
+{
+	uint64_t smallDist = distTooHighW - unit;
+	uint64_t bigDist = distTooHighW + unit;
+	// decrementing the last digit brings the number closer to w (as long as
+	// it stays in the unsafe interval)
+	while(rest < smallDist && unsafeInterval - rest >= tenKappa
+	      && (rest + tenKappa < smallDist || smallDist - rest >= rest + tenKappa - smallDist))
+	{
+		--digits[numDigits-1];
+		rest += tenKappa;
+	}
+	// if decrementing it once more could be closer to the real w, we can't tell which is right
+	if(rest < bigDist && unsafeInterval - rest >= tenKappa
+	   && (rest + tenKappa < bigDist || bigDist - rest > rest + tenKappa - bigDist))
+	{
+		return 0;
+	}
+	// the result must be safely within the interval (considering the imprecision)
+	return (2*unit <= rest) && (rest <= unsafeInterval - 4*unit);
+}
+
+// generates the shortest digits for a number between low and high (all scaled with
+// the same power of ten) that is as close as possible to w. the number is
+// digits * 10^kappa. returns 0 if the result is not guaranteed to be correct
+static int DG__GrisuDigitGen(DG__DiyFp low, DG__DiyFp w, DG__DiyFp high,
+                             char* digits, int* numDigits, int* kappa)
+{
+	// low, w and high are imprecise (by up to one unit), so only use
+	// digits that are correct for all numbers in the unsafe interval
+	uint64_t unit = 1;
+	uint64_t tooLow = low.f - unit;
+	uint64_t tooHigh = high.f + unit;
+	uint64_t unsafeInterval = tooHigh - tooLow;
+	int shift = -w.e; // one = 1 << shift, integrals = tooHigh / one
+	uint64_t one = (uint64_t)1 << shift;
+	uint32_t integrals = (uint32_t)(tooHigh >> shift);
+	uint64_t fractionals = tooHigh & (one - 1);
+
+	// the biggest power of ten <= integrals
+	uint32_t divisor = 0;
+	int divisorExpPlusOne = 0;
+	if(integrals > 0)
+	{
+		uint64_t p = 1;
+		while(p*10 <= integrals)
+		{
+			p *= 10;
+			++divisorExpPlusOne;
+		}
+		divisor = (uint32_t)p;
+		++divisorExpPlusOne;
+	}
+
+	*kappa = divisorExpPlusOne;
+	*numDigits = 0;
+	while(*kappa > 0)
+	{
+		digits[(*numDigits)++] = (char)('0' + integrals / divisor);
+		integrals %= divisor;
+		--*kappa;
+		uint64_t rest = ((uint64_t)integrals << shift) + fractionals;
+		if(rest < unsafeInterval)
+		{
+			return DG__GrisuRoundWeed(digits, *numDigits, tooHigh - w.f, unsafeInterval,
+			                          rest, (uint64_t)divisor << shift, unit);
+		}
+		divisor /= 10;
+	}
+
+	// integrals are done, continue with the fractionals (and scale the imprecision with them)
+	for(;;)
+	{
+		fractionals *= 10;
+		unit *= 10;
+		unsafeInterval *= 10;
+		digits[(*numDigits)++] = (char)('0' + (int)(fractionals >> shift));
+		fractionals &= one - 1;
+		--*kappa;
+		if(fractionals < unsafeInterval)
+		{
+			return DG__GrisuRoundWeed(digits, *numDigits, (tooHigh - w.f) * unit,
+			                          unsafeInterval, fractionals, one, unit);
+		}
+		if(*numDigits >= DG__GRISU_MAX_DIGITS)  return 0; // shouldn't happen, but don't overflow digits
+	}
+}
+
+// finds the shortest digits for the positive number f * 2^e, which is a double or float
+// with hiddenBit as its implicit leading significand bit (already set in f, unless it's
+// a denormal) and minExp as exponent of denormals.
+// the number is digits * 10^decExp, returns 0 if Grisu3 couldn't decide
+static int DG__Grisu3(uint64_t f, int e, uint64_t hiddenBit, int minExp,
+                      char* digits, int* numDigits, int* decExp)
+{
+	DG__DiyFp w = DG__DiyFpNormalize(DG__DiyFpMake(f, e));
+
+	// the boundaries are halfway to the neighboring numbers; they're closer
+	// on the lower side if f is a power of two (except for the smallest normal)
+	DG__DiyFp plus = DG__DiyFpNormalize(DG__DiyFpMake((f << 1) + 1, e - 1));
+	DG__DiyFp minus;
+	if(f == hiddenBit && e != minExp)
+		minus = DG__DiyFpMake((f << 2) - 1, e - 2);
+	else
+		minus = DG__DiyFpMake((f << 1) - 1, e - 1);
+	minus.f <<= minus.e - plus.e;
+	minus.e = plus.e;
+
+	int mk;
+	DG__DiyFp tenMk = DG__GrisuCachedPower(w.e, &mk);
+	DG__DiyFp scaledW = DG__DiyFpMul(w, tenMk);
+	DG__DiyFp scaledMinus = DG__DiyFpMul(minus, tenMk);
+	DG__DiyFp scaledPlus = DG__DiyFpMul(plus, tenMk);
+
+	int kappa;
+	int ret = DG__GrisuDigitGen(scaledMinus, scaledW, scaledPlus, digits, numDigits, &kappa);
+	*decExp = kappa - mk;
+	return ret;
+}
+
+// for the rare cases Grisu3 can't handle: uses printf() with more and more digits
+// until the result reads back as v. returns the number of digits (v = digits * 10^decExp)
+// minDigits is the number of digits Grisu3 generated before giving up: it found the shortest
+// digits for an interval that contains the real one, so fewer digits can't be enough
+static int DG__ShortestFallback(double v, int isFloat, int minDigits, char* digits, int* decExp)
+{
+	char tmp[40];
+	char num[40];
+	int maxDigits = isFloat ? 9 : DG__GRISU_MAX_DIGITS;
+	if(minDigits < 1 || minDigits > maxDigits)  minDigits = 1;
+	for(int prec=minDigits; ; ++prec)
+	{
+		// tmp is like "1.2345e+07", but the decimal point depends on the locale,
+		// so only take the digits
+		DG_snprintf(tmp, sizeof(tmp), "%.*e", prec-1, v);
+		int numDigits = 0;
+		const char* p = tmp;
+		for( ; *p != 'e' && *p != 'E' && *p != '\0'; ++p)
+		{
+			if(*p >= '0' && *p <= '9')
+				digits[numDigits++] = *p;
+		}
+		*decExp = ((*p != '\0') ? atoi(p+1) : 0) - (numDigits - 1);
+
+		// without a decimal point, strtod() doesn't depend on the locale either
+		memcpy(num, digits, numDigits);
+		DG_snprintf(num + numDigits, sizeof(num) - numDigits, "e%d", *decExp);
+		if(prec >= maxDigits)  return numDigits;
+		if(isFloat ? (strtof(num, NULL) == (float)v) : (strtod(num, NULL) == v))
+			return numDigits;
+	}
+}
+
+// writes the number (-)digits * 10^decExp to buf, in the format documented at DG_dtoa()
+static size_t DG__FormatShortest(char* buf, int neg, const char* digits, int numDigits, int decExp)
+{
+	while(numDigits > 1 && digits[numDigits-1] == '0')
+	{
+		--numDigits;
+		++decExp;
+	}
+
+	char* out = buf;
+	if(neg)  *out++ = '-';
+
+	int n = numDigits + decExp; // the number is 0.digits * 10^n
+	if(numDigits <= n && n <= 21)
+	{
+		// integer: 1234000
+		memcpy(out, digits, numDigits);
+		out += numDigits;
+		memset(out, '0', n - numDigits);
+		out += n - numDigits;
+	}
+	else if(0 < n && n <= 21)
+	{
+		// 123.4
+		memcpy(out, digits, n);
+		out += n;
+		*out++ = '.';
+		memcpy(out, digits + n, numDigits - n);
+		out += numDigits - n;
+	}
+	else if(-6 < n && n <= 0)
+	{
+		// 0.001234
+		*out++ = '0';
+		*out++ = '.';
+		memset(out, '0', -n);
+		out += -n;
+		memcpy(out, digits, numDigits);
+		out += numDigits;
+	}
+	else
+	{
+		// 1.234e+56
+		*out++ = digits[0];
+		if(numDigits > 1)
+		{
+			*out++ = '.';
+			memcpy(out, digits + 1, numDigits - 1);
+			out += numDigits - 1;
+		}
+		int exp = n - 1;
+		*out++ = 'e';
+		*out++ = (exp < 0) ? '-' : '+';
+		out += DG_u64toa(out, (exp < 0) ? -exp : exp);
+	}
+	*out = '\0';
+	return out - buf;
+}
+
+// for the special cases of DG_dtoa() and DG_ftoa() (inf, nan, 0)
+static size_t DG__FormatSpecial(char* buf, const char* str)
+{
+	size_t len = strlen(str);
+	memcpy(buf, str, len+1);
+	return len;
+}
+
+DG_MISC_DEF size_t DG_dtoa(char* buf, double v)
+{
+	DG_MISC_ASSERT(buf != NULL, "Don't pass a NULL buffer into DG_dtoa()!");
+
+	uint64_t bits;
+	memcpy(&bits, &v, sizeof(bits));
+	int neg = (int)(bits >> 63);
+	int biasedExp = (int)((bits >> 52) & 0x7FF);
+	uint64_t significand = bits & ((1uLL << 52) - 1);
+
+	if(biasedExp == 0x7FF)
+		return DG__FormatSpecial(buf, (significand != 0) ? "nan" : (neg ? "-inf" : "inf"));
+	if(biasedExp == 0 && significand == 0)
+		return DG__FormatSpecial(buf, neg ? "-0" : "0");
+
+	// v = f * 2^e
+	uint64_t f = (biasedExp != 0) ? (significand | (1uLL << 52)) : significand;
+	int e = ((biasedExp != 0) ? biasedExp : 1) - 1075;
+
+	char digits[DG__GRISU_MAX_DIGITS + 8];
+	int numDigits, decExp;
+	if(!DG__Grisu3(f, e, 1uLL << 52, 1 - 1075, digits, &numDigits, &decExp))
+		numDigits = DG__ShortestFallback(neg ? -v : v, 0, numDigits, digits, &decExp);
+
+	return DG__FormatShortest(buf, neg, digits, numDigits, decExp);
+}
+
+DG_MISC_DEF size_t DG_ftoa(char* buf, float v)
+{
+	DG_MISC_ASSERT(buf != NULL, "Don't pass a NULL buffer into DG_ftoa()!");
+
+	uint32_t bits;
+	memcpy(&bits, &v, sizeof(bits));
+	int neg = (int)(bits >> 31);
+	int biasedExp = (int)((bits >> 23) & 0xFF);
+	uint32_t significand = bits & ((1u << 23) - 1);
+
+	if(biasedExp == 0xFF)
+		return DG__FormatSpecial(buf, (significand != 0) ? "nan" : (neg ? "-inf" : "inf"));
+	if(biasedExp == 0 && significand == 0)
+		return DG__FormatSpecial(buf, neg ? "-0" : "0");
+
+	uint64_t f = (biasedExp != 0) ? (significand | (1u << 23)) : significand;
+	int e = ((biasedExp != 0) ? biasedExp : 1) - 150;
+
+	char digits[DG__GRISU_MAX_DIGITS + 8];
+	int numDigits, decExp;
+	if(!DG__Grisu3(f, e, 1u << 23, 1 - 150, digits, &numDigits, &decExp))
+		numDigits = DG__ShortestFallback(neg ? -v : v, 1, numDigits, digits, &decExp);
+
+	return DG__FormatShortest(buf, neg, digits, numDigits, decExp);
+}
+
+// returns the value of the digit c ('0'-'9', 'a'-'z' or 'A'-'Z'), or 255 if it isn't one
+static unsigned int DG__DigitValue(unsigned char c)
+{
+	if(c >= '0' && c <= '9')  return c - '0';
+	c |= 0x20; // to lowercase (if it's a letter)
+	if(c >= 'a' && c <= 'z')  return c - 'a' + 10;
+	return 255;
+}
+
+// parses an unsigned integer from [str, end), see DG_strtou64()
+static const char* DG__ParseUInt(const char* str, const char* end, unsigned long long* value,
+                                 int base, int* error)
+{
+	DG_MISC_ASSERT(base >= 2 && base <= 36, "The base for DG_strtou64() or DG_strtoi64() must be between 2 and 36!");
+	const char* p = str;
+	uint64_t v = 0;
+	if(base == 10)
+	{
+		// 19 decimal digits always fit into 64 bits, so no overflow check is needed for them
+		const char* noOverflowEnd = (end - p > 19) ? p + 19 : end;
+		while(p < noOverflowEnd && (unsigned char)(*p - '0') < 10)
+		{
+			v = v*10 + (*p - '0');
+			++p;
+		}
+	}
+	const uint64_t maxDiv = ((uint64_t)-1) / (unsigned)base;
+	const unsigned int maxRem = (unsigned int)(((uint64_t)-1) % (unsigned)base);
+	int overflow = 0;
+	for( ; p < end; ++p)
+	{
+		unsigned int digit = DG__DigitValue((unsigned char)*p);
+		if(digit >= (unsigned)base)  break;
+		if(v > maxDiv || (v == maxDiv && digit > maxRem))
+			overflow = 1; // keep going to find the end of the number
+		else
+			v = v*base + digit;
+	}
+
+	if(p == str)
+	{
+		*error = DG_PARSE_INVALID;
+		return str;
+	}
+	if(overflow)
+	{
+		*error = DG_PARSE_RANGE;
+		return p;
+	}
+	*value = v;
+	*error = DG_PARSE_OK;
+	return p;
+}
+
+DG_MISC_DEF const char* DG_strtou64(const char* str, size_t len, unsigned long long* value,
+                                    int base, int* error)
+{
+	DG_MISC_ASSERT(value && (str || len == 0), "Don't pass NULL into DG_strtou64()!");
+	int err;
+	const char* ret = (len > 0) ? DG__ParseUInt(str, str + len, value, base, &err) : str;
+	if(error != NULL)
+		*error = (len > 0) ? err : DG_PARSE_INVALID;
+	return ret;
+}
+
+DG_MISC_DEF const char* DG_strtoi64(const char* str, size_t len, long long* value,
+                                    int base, int* error)
+{
+	DG_MISC_ASSERT(value && (str || len == 0), "Don't pass NULL into DG_strtoi64()!");
+	int err = DG_PARSE_INVALID;
+	const char* ret = str;
+	if(len > 0)
+	{
+		int neg = (str[0] == '-');
+		unsigned long long v;
+		const char* digits = str + neg;
+		ret = DG__ParseUInt(digits, str + len, &v, base, &err);
+		if(ret == digits)
+		{
+			ret = str; // just "-" is no number
+		}
+		else if(err == DG_PARSE_OK)
+		{
+			const unsigned long long maxPos = ((unsigned long long)-1) >> 1;
+			if(v > maxPos + neg)
+				err = DG_PARSE_RANGE;
+			else if(neg)
+				*value = (v == 0) ? 0 : -(long long)(v - 1) - 1; // so -2^63 doesn't overflow
+			else
+				*value = (long long)v;
+		}
+	}
+	if(error != NULL)
+		*error = err;
+	return ret;
+}
+
+// 10^q as 128 bit number (high and low 64 bits), normalized (highest bit set) and
+// rounded down, for q = DG__POW10_MIN_EXP ... DG__POW10_MAX_EXP
+#define DG__POW10_MIN_EXP -342
+#define DG__POW10_MAX_EXP 308
+static const uint64_t DG__pow10x128[DG__POW10_MAX_EXP - DG__POW10_MIN_EXP + 1][2] = {
+	{ 0xEEF453D6923BD65AuLL, 0x113FAA2906A13B3FuLL }, { 0x9558B4661B6565F8uLL, 0x4AC7CA59A424C507uLL },  // 1e-342, 1e-341
+	{ 0xBAAEE17FA23EBF76uLL, 0x5D79BCF00D2DF649uLL }, { 0xE95A99DF8ACE6F53uLL, 0xF4D82C2C107973DCuLL },  // 1e-340, 1e-339
+	{ 0x91D8A02BB6C10594uLL, 0x79071B9B8A4BE869uLL }, { 0xB64EC836A47146F9uLL, 0x9748E2826CDEE284uLL },  // 1e-338, 1e-337
+	{ 0xE3E27A444D8D98B7uLL, 0xFD1B1B2308169B25uLL }, { 0x8E6D8C6AB0787F72uLL, 0xFE30F0F5E50E20F7uLL },  // 1e-336, 1e-335
+	{ 0xB208EF855C969F4FuLL, 0xBDBD2D335E51A935uLL }, { 0xDE8B2B66B3BC4723uLL, 0xAD2C788035E61382uLL },  // 1e-334, 1e-333
+	{ 0x8B16FB203055AC76uLL, 0x4C3BCB5021AFCC31uLL }, { 0xADDCB9E83C6B1793uLL, 0xDF4ABE242A1BBF3DuLL },  // 1e-332, 1e-331
+	{ 0xD953E8624B85DD78uLL, 0xD71D6DAD34A2AF0DuLL }, { 0x87D4713D6F33AA6BuLL, 0x8672648C40E5AD68uLL },  // 1e-330, 1e-329
+	{ 0xA9C98D8CCB009506uLL, 0x680EFDAF511F18C2uLL }, { 0xD43BF0EFFDC0BA48uLL, 0x0212BD1B2566DEF2uLL },  // 1e-328, 1e-327
+	{ 0x84A57695FE98746DuLL, 0x014BB630F7604B57uLL }, { 0xA5CED43B7E3E9188uLL, 0x419EA3BD35385E2DuLL },  // 1e-326, 1e-325
+	{ 0xCF42894A5DCE35EAuLL, 0x52064CAC828675B9uLL }, { 0x818995CE7AA0E1B2uLL, 0x7343EFEBD1940993uLL },  // 1e-324, 1e-323
+	{ 0xA1EBFB4219491A1FuLL, 0x1014EBE6C5F90BF8uLL }, { 0xCA66FA129F9B60A6uLL, 0xD41A26E077774EF6uLL },  // 1e-322, 1e-321
+	{ 0xFD00B897478238D0uLL, 0x8920B098955522B4uLL }, { 0x9E20735E8CB16382uLL, 0x55B46E5F5D5535B0uLL },  // 1e-320, 1e-319
+	{ 0xC5A890362FDDBC62uLL, 0xEB2189F734AA831DuLL }, { 0xF712B443BBD52B7BuLL, 0xA5E9EC7501D523E4uLL },  // 1e-318, 1e-317
+	{ 0x9A6BB0AA55653B2DuLL, 0x47B233C92125366EuLL }, { 0xC1069CD4EABE89F8uLL, 0x999EC0BB696E840AuLL },  // 1e-316, 1e-315
+	{ 0xF148440A256E2C76uLL, 0xC00670EA43CA250DuLL }, { 0x96CD2A865764DBCAuLL, 0x380406926A5E5728uLL },  // 1e-314, 1e-313
+	{ 0xBC807527ED3E12BCuLL, 0xC605083704F5ECF2uLL }, { 0xEBA09271E88D976BuLL, 0xF7864A44C633682EuLL },  // 1e-312, 1e-311
+	{ 0x93445B8731587EA3uLL, 0x7AB3EE6AFBE0211DuLL }, { 0xB8157268FDAE9E4CuLL, 0x5960EA05BAD82964uLL },  // 1e-310, 1e-309
+	{ 0xE61ACF033D1A45DFuLL, 0x6FB92487298E33BDuLL }, { 0x8FD0C16206306BABuLL, 0xA5D3B6D479F8E056uLL },  // 1e-308, 1e-307
+	{ 0xB3C4F1BA87BC8696uLL, 0x8F48A4899877186CuLL }, { 0xE0B62E2929ABA83CuLL, 0x331ACDABFE94DE87uLL },  // 1e-306, 1e-305
+	{ 0x8C71DCD9BA0B4925uLL, 0x9FF0C08B7F1D0B14uLL }, { 0xAF8E5410288E1B6FuLL, 0x07ECF0AE5EE44DD9uLL },  // 1e-304, 1e-303
+	{ 0xDB71E91432B1A24AuLL, 0xC9E82CD9F69D6150uLL }, { 0x892731AC9FAF056EuLL, 0xBE311C083A225CD2uLL },  // 1e-302, 1e-301
+	{ 0xAB70FE17C79AC6CAuLL, 0x6DBD630A48AAF406uLL }, { 0xD64D3D9DB981787DuLL, 0x092CBBCCDAD5B108uLL },  // 1e-300, 1e-299
+	{ 0x85F0468293F0EB4EuLL, 0x25BBF56008C58EA5uLL }, { 0xA76C582338ED2621uLL, 0xAF2AF2B80AF6F24EuLL },  // 1e-298, 1e-297
+	{ 0xD1476E2C07286FAAuLL, 0x1AF5AF660DB4AEE1uLL }, { 0x82CCA4DB847945CAuLL, 0x50D98D9FC890ED4DuLL },  // 1e-296, 1e-295
+	{ 0xA37FCE126597973CuLL, 0xE50FF107BAB528A0uLL }, { 0xCC5FC196FEFD7D0CuLL, 0x1E53ED49A96272C8uLL },  // 1e-294, 1e-293
+	{ 0xFF77B1FCBEBCDC4FuLL, 0x25E8E89C13BB0F7AuLL }, { 0x9FAACF3DF73609B1uLL, 0x77B191618C54E9ACuLL },  // 1e-292, 1e-291
+	{ 0xC795830D75038C1DuLL, 0xD59DF5B9EF6A2417uLL }, { 0xF97AE3D0D2446F25uLL, 0x4B0573286B44AD1DuLL },  // 1e-290, 1e-289
+	{ 0x9BECCE62836AC577uLL, 0x4EE367F9430AEC32uLL }, { 0xC2E801FB244576D5uLL, 0x229C41F793CDA73FuLL },  // 1e-288, 1e-287
+	{ 0xF3A20279ED56D48AuLL, 0x6B43527578C1110FuLL }, { 0x9845418C345644D6uLL, 0x830A13896B78AAA9uLL },  // 1e-286, 1e-285
+	{ 0xBE5691EF416BD60CuLL, 0x23CC986BC656D553uLL }, { 0xEDEC366B11C6CB8FuLL, 0x2CBFBE86B7EC8AA8uLL },  // 1e-284, 1e-283
+	{ 0x94B3A202EB1C3F39uLL, 0x7BF7D71432F3D6A9uLL }, { 0xB9E08A83A5E34F07uLL, 0xDAF5CCD93FB0CC53uLL },  // 1e-282, 1e-281
+	{ 0xE858AD248F5C22C9uLL, 0xD1B3400F8F9CFF68uLL }, { 0x91376C36D99995BEuLL, 0x23100809B9C21FA1uLL },  // 1e-280, 1e-279
+	{ 0xB58547448FFFFB2DuLL, 0xABD40A0C2832A78AuLL }, { 0xE2E69915B3FFF9F9uLL, 0x16C90C8F323F516CuLL },  // 1e-278, 1e-277
+	{ 0x8DD01FAD907FFC3BuLL, 0xAE3DA7D97F6792E3uLL }, { 0xB1442798F49FFB4AuLL, 0x99CD11CFDF41779CuLL },  // 1e-276, 1e-275
+	{ 0xDD95317F31C7FA1DuLL, 0x40405643D711D583uLL }, { 0x8A7D3EEF7F1CFC52uLL, 0x482835EA666B2572uLL },  // 1e-274, 1e-273
+	{ 0xAD1C8EAB5EE43B66uLL, 0xDA3243650005EECFuLL }, { 0xD863B256369D4A40uLL, 0x90BED43E40076A82uLL },  // 1e-272, 1e-271
+	{ 0x873E4F75E2224E68uLL, 0x5A7744A6E804A291uLL }, { 0xA90DE3535AAAE202uLL, 0x711515D0A205CB36uLL },  // 1e-270, 1e-269
+	{ 0xD3515C2831559A83uLL, 0x0D5A5B44CA873E03uLL }, { 0x8412D9991ED58091uLL, 0xE858790AFE9486C2uLL },  // 1e-268, 1e-267
+	{ 0xA5178FFF668AE0B6uLL, 0x626E974DBE39A872uLL }, { 0xCE5D73FF402D98E3uLL, 0xFB0A3D212DC8128FuLL },  // 1e-266, 1e-265
+	{ 0x80FA687F881C7F8EuLL, 0x7CE66634BC9D0B99uLL }, { 0xA139029F6A239F72uLL, 0x1C1FFFC1EBC44E80uLL },  // 1e-264, 1e-263
+	{ 0xC987434744AC874EuLL, 0xA327FFB266B56220uLL }, { 0xFBE9141915D7A922uLL, 0x4BF1FF9F0062BAA8uLL },  // 1e-262, 1e-261
+	{ 0x9D71AC8FADA6C9B5uLL, 0x6F773FC3603DB4A9uLL }, { 0xC4CE17B399107C22uLL, 0xCB550FB4384D21D3uLL },  // 1e-260, 1e-259
+	{ 0xF6019DA07F549B2BuLL, 0x7E2A53A146606A48uLL }, { 0x99C102844F94E0FBuLL, 0x2EDA7444CBFC426DuLL },  // 1e-258, 1e-257
+	{ 0xC0314325637A1939uLL, 0xFA911155FEFB5308uLL }, { 0xF03D93EEBC589F88uLL, 0x793555AB7EBA27CAuLL },  // 1e-256, 1e-255
+	{ 0x96267C7535B763B5uLL, 0x4BC1558B2F3458DEuLL }, { 0xBBB01B9283253CA2uLL, 0x9EB1AAEDFB016F16uLL },  // 1e-254, 1e-253
+	{ 0xEA9C227723EE8BCBuLL, 0x465E15A979C1CADCuLL }, { 0x92A1958A7675175FuLL, 0x0BFACD89EC191EC9uLL },  // 1e-252, 1e-251
+	{ 0xB749FAED14125D36uLL, 0xCEF980EC671F667BuLL }, { 0xE51C79A85916F484uLL, 0x82B7E12780E7401AuLL },  // 1e-250, 1e-249
+	{ 0x8F31CC0937AE58D2uLL, 0xD1B2ECB8B0908810uLL }, { 0xB2FE3F0B8599EF07uLL, 0x861FA7E6DCB4AA15uLL },  // 1e-248, 1e-247
+	{ 0xDFBDCECE67006AC9uLL, 0x67A791E093E1D49AuLL }, { 0x8BD6A141006042BDuLL, 0xE0C8BB2C5C6D24E0uLL },  // 1e-246, 1e-245
+	{ 0xAECC49914078536DuLL, 0x58FAE9F773886E18uLL }, { 0xDA7F5BF590966848uLL, 0xAF39A475506A899EuLL },  // 1e-244, 1e-243
+	{ 0x888F99797A5E012DuLL, 0x6D8406C952429603uLL }, { 0xAAB37FD7D8F58178uLL, 0xC8E5087BA6D33B83uLL },  // 1e-242, 1e-241
+	{ 0xD5605FCDCF32E1D6uLL, 0xFB1E4A9A90880A64uLL }, { 0x855C3BE0A17FCD26uLL, 0x5CF2EEA09A55067FuLL },  // 1e-240, 1e-239
+	{ 0xA6B34AD8C9DFC06FuLL, 0xF42FAA48C0EA481EuLL }, { 0xD0601D8EFC57B08BuLL, 0xF13B94DAF124DA26uLL },  // 1e-238, 1e-237
+	{ 0x823C12795DB6CE57uLL, 0x76C53D08D6B70858uLL }, { 0xA2CB1717B52481EDuLL, 0x54768C4B0C64CA6EuLL },  // 1e-236, 1e-235
+	{ 0xCB7DDCDDA26DA268uLL, 0xA9942F5DCF7DFD09uLL }, { 0xFE5D54150B090B02uLL, 0xD3F93B35435D7C4CuLL },  // 1e-234, 1e-233
+	{ 0x9EFA548D26E5A6E1uLL, 0xC47BC5014A1A6DAFuLL }, { 0xC6B8E9B0709F109AuLL, 0x359AB6419CA1091BuLL },  // 1e-232, 1e-231
+	{ 0xF867241C8CC6D4C0uLL, 0xC30163D203C94B62uLL }, { 0x9B407691D7FC44F8uLL, 0x79E0DE63425DCF1DuLL },  // 1e-230, 1e-229
+	{ 0xC21094364DFB5636uLL, 0x985915FC12F542E4uLL }, { 0xF294B943E17A2BC4uLL, 0x3E6F5B7B17B2939DuLL },  // 1e-228, 1e-227
+	{ 0x979CF3CA6CEC5B5AuLL, 0xA705992CEECF9C42uLL }, { 0xBD8430BD08277231uLL, 0x50C6FF782A838353uLL },  // 1e-226, 1e-225
+	{ 0xECE53CEC4A314EBDuLL, 0xA4F8BF5635246428uLL }, { 0x940F4613AE5ED136uLL, 0x871B7795E136BE99uLL },  // 1e-224, 1e-223
+	{ 0xB913179899F68584uLL, 0x28E2557B59846E3FuLL }, { 0xE757DD7EC07426E5uLL, 0x331AEADA2FE589CFuLL },  // 1e-222, 1e-221
+	{ 0x9096EA6F3848984FuLL, 0x3FF0D2C85DEF7621uLL }, { 0xB4BCA50B065ABE63uLL, 0x0FED077A756B53A9uLL },  // 1e-220, 1e-219
+	{ 0xE1EBCE4DC7F16DFBuLL, 0xD3E8495912C62894uLL }, { 0x8D3360F09CF6E4BDuLL, 0x64712DD7ABBBD95CuLL },  // 1e-218, 1e-217
+	{ 0xB080392CC4349DECuLL, 0xBD8D794D96AACFB3uLL }, { 0xDCA04777F541C567uLL, 0xECF0D7A0FC5583A0uLL },  // 1e-216, 1e-215
+	{ 0x89E42CAAF9491B60uLL, 0xF41686C49DB57244uLL }, { 0xAC5D37D5B79B6239uLL, 0x311C2875C522CED5uLL },  // 1e-214, 1e-213
+	{ 0xD77485CB25823AC7uLL, 0x7D633293366B828BuLL }, { 0x86A8D39EF77164BCuLL, 0xAE5DFF9C02033197uLL },  // 1e-212, 1e-211
+	{ 0xA8530886B54DBDEBuLL, 0xD9F57F830283FDFCuLL }, { 0xD267CAA862A12D66uLL, 0xD072DF63C324FD7BuLL },  // 1e-210, 1e-209
+	{ 0x8380DEA93DA4BC60uLL, 0x4247CB9E59F71E6DuLL }, { 0xA46116538D0DEB78uLL, 0x52D9BE85F074E608uLL },  // 1e-208, 1e-207
+	{ 0xCD795BE870516656uLL, 0x67902E276C921F8BuLL }, { 0x806BD9714632DFF6uLL, 0x00BA1CD8A3DB53B6uLL },  // 1e-206, 1e-205
+	{ 0xA086CFCD97BF97F3uLL, 0x80E8A40ECCD228A4uLL }, { 0xC8A883C0FDAF7DF0uLL, 0x6122CD128006B2CDuLL },  // 1e-204, 1e-203
+	{ 0xFAD2A4B13D1B5D6CuLL, 0x796B805720085F81uLL }, { 0x9CC3A6EEC6311A63uLL, 0xCBE3303674053BB0uLL },  // 1e-202, 1e-201
+	{ 0xC3F490AA77BD60FCuLL, 0xBEDBFC4411068A9CuLL }, { 0xF4F1B4D515ACB93BuLL, 0xEE92FB5515482D44uLL },  // 1e-200, 1e-199
+	{ 0x991711052D8BF3C5uLL, 0x751BDD152D4D1C4AuLL }, { 0xBF5CD54678EEF0B6uLL, 0xD262D45A78A0635DuLL },  // 1e-198, 1e-197
+	{ 0xEF340A98172AACE4uLL, 0x86FB897116C87C34uLL }, { 0x9580869F0E7AAC0EuLL, 0xD45D35E6AE3D4DA0uLL },  // 1e-196, 1e-195
+	{ 0xBAE0A846D2195712uLL, 0x8974836059CCA109uLL }, { 0xE998D258869FACD7uLL, 0x2BD1A438703FC94BuLL },  // 1e-194, 1e-193
+	{ 0x91FF83775423CC06uLL, 0x7B6306A34627DDCFuLL }, { 0xB67F6455292CBF08uLL, 0x1A3BC84C17B1D542uLL },  // 1e-192, 1e-191
+	{ 0xE41F3D6A7377EECAuLL, 0x20CABA5F1D9E4A93uLL }, { 0x8E938662882AF53EuLL, 0x547EB47B7282EE9CuLL },  // 1e-190, 1e-189
+	{ 0xB23867FB2A35B28DuLL, 0xE99E619A4F23AA43uLL }, { 0xDEC681F9F4C31F31uLL, 0x6405FA00E2EC94D4uLL },  // 1e-188, 1e-187
+	{ 0x8B3C113C38F9F37EuLL, 0xDE83BC408DD3DD04uLL }, { 0xAE0B158B4738705EuLL, 0x9624AB50B148D445uLL },  // 1e-186, 1e-185
+	{ 0xD98DDAEE19068C76uLL, 0x3BADD624DD9B0957uLL }, { 0x87F8A8D4CFA417C9uLL, 0xE54CA5D70A80E5D6uLL },  // 1e-184, 1e-183
+	{ 0xA9F6D30A038D1DBCuLL, 0x5E9FCF4CCD211F4CuLL }, { 0xD47487CC8470652BuLL, 0x7647C3200069671FuLL },  // 1e-182, 1e-181
+	{ 0x84C8D4DFD2C63F3BuLL, 0x29ECD9F40041E073uLL }, { 0xA5FB0A17C777CF09uLL, 0xF468107100525890uLL },  // 1e-180, 1e-179
+	{ 0xCF79CC9DB955C2CCuLL, 0x7182148D4066EEB4uLL }, { 0x81AC1FE293D599BFuLL, 0xC6F14CD848405530uLL },  // 1e-178, 1e-177
+	{ 0xA21727DB38CB002FuLL, 0xB8ADA00E5A506A7CuLL }, { 0xCA9CF1D206FDC03BuLL, 0xA6D90811F0E4851CuLL },  // 1e-176, 1e-175
+	{ 0xFD442E4688BD304AuLL, 0x908F4A166D1DA663uLL }, { 0x9E4A9CEC15763E2EuLL, 0x9A598E4E043287FEuLL },  // 1e-174, 1e-173
+	{ 0xC5DD44271AD3CDBAuLL, 0x40EFF1E1853F29FDuLL }, { 0xF7549530E188C128uLL, 0xD12BEE59E68EF47CuLL },  // 1e-172, 1e-171
+	{ 0x9A94DD3E8CF578B9uLL, 0x82BB74F8301958CEuLL }, { 0xC13A148E3032D6E7uLL, 0xE36A52363C1FAF01uLL },  // 1e-170, 1e-169
+	{ 0xF18899B1BC3F8CA1uLL, 0xDC44E6C3CB279AC1uLL }, { 0x96F5600F15A7B7E5uLL, 0x29AB103A5EF8C0B9uLL },  // 1e-168, 1e-167
+	{ 0xBCB2B812DB11A5DEuLL, 0x7415D448F6B6F0E7uLL }, { 0xEBDF661791D60F56uLL, 0x111B495B3464AD21uLL },  // 1e-166, 1e-165
+	{ 0x936B9FCEBB25C995uLL, 0xCAB10DD900BEEC34uLL }, { 0xB84687C269EF3BFBuLL, 0x3D5D514F40EEA742uLL },  // 1e-164, 1e-163
+	{ 0xE65829B3046B0AFAuLL, 0x0CB4A5A3112A5112uLL }, { 0x8FF71A0FE2C2E6DCuLL, 0x47F0E785EABA72ABuLL },  // 1e-162, 1e-161
+	{ 0xB3F4E093DB73A093uLL, 0x59ED216765690F56uLL }, { 0xE0F218B8D25088B8uLL, 0x306869C13EC3532CuLL },  // 1e-160, 1e-159
+	{ 0x8C974F7383725573uLL, 0x1E414218C73A13FBuLL }, { 0xAFBD2350644EEACFuLL, 0xE5D1929EF90898FAuLL },  // 1e-158, 1e-157
+	{ 0xDBAC6C247D62A583uLL, 0xDF45F746B74ABF39uLL }, { 0x894BC396CE5DA772uLL, 0x6B8BBA8C328EB783uLL },  // 1e-156, 1e-155
+	{ 0xAB9EB47C81F5114FuLL, 0x066EA92F3F326564uLL }, { 0xD686619BA27255A2uLL, 0xC80A537B0EFEFEBDuLL },  // 1e-154, 1e-153
+	{ 0x8613FD0145877585uLL, 0xBD06742CE95F5F36uLL }, { 0xA798FC4196E952E7uLL, 0x2C48113823B73704uLL },  // 1e-152, 1e-151
+	{ 0xD17F3B51FCA3A7A0uLL, 0xF75A15862CA504C5uLL }, { 0x82EF85133DE648C4uLL, 0x9A984D73DBE722FBuLL },  // 1e-150, 1e-149
+	{ 0xA3AB66580D5FDAF5uLL, 0xC13E60D0D2E0EBBAuLL }, { 0xCC963FEE10B7D1B3uLL, 0x318DF905079926A8uLL },  // 1e-148, 1e-147
+	{ 0xFFBBCFE994E5C61FuLL, 0xFDF17746497F7052uLL }, { 0x9FD561F1FD0F9BD3uLL, 0xFEB6EA8BEDEFA633uLL },  // 1e-146, 1e-145
+	{ 0xC7CABA6E7C5382C8uLL, 0xFE64A52EE96B8FC0uLL }, { 0xF9BD690A1B68637BuLL, 0x3DFDCE7AA3C673B0uLL },  // 1e-144, 1e-143
+	{ 0x9C1661A651213E2DuLL, 0x06BEA10CA65C084EuLL }, { 0xC31BFA0FE5698DB8uLL, 0x486E494FCFF30A62uLL },  // 1e-142, 1e-141
+	{ 0xF3E2F893DEC3F126uLL, 0x5A89DBA3C3EFCCFAuLL }, { 0x986DDB5C6B3A76B7uLL, 0xF89629465A75E01CuLL },  // 1e-140, 1e-139
+	{ 0xBE89523386091465uLL, 0xF6BBB397F1135823uLL }, { 0xEE2BA6C0678B597FuLL, 0x746AA07DED582E2CuLL },  // 1e-138, 1e-137
+	{ 0x94DB483840B717EFuLL, 0xA8C2A44EB4571CDCuLL }, { 0xBA121A4650E4DDEBuLL, 0x92F34D62616CE413uLL },  // 1e-136, 1e-135
+	{ 0xE896A0D7E51E1566uLL, 0x77B020BAF9C81D17uLL }, { 0x915E2486EF32CD60uLL, 0x0ACE1474DC1D122EuLL },  // 1e-134, 1e-133
+	{ 0xB5B5ADA8AAFF80B8uLL, 0x0D819992132456BAuLL }, { 0xE3231912D5BF60E6uLL, 0x10E1FFF697ED6C69uLL },  // 1e-132, 1e-131
+	{ 0x8DF5EFABC5979C8FuLL, 0xCA8D3FFA1EF463C1uLL }, { 0xB1736B96B6FD83B3uLL, 0xBD308FF8A6B17CB2uLL },  // 1e-130, 1e-129
+	{ 0xDDD0467C64BCE4A0uLL, 0xAC7CB3F6D05DDBDEuLL }, { 0x8AA22C0DBEF60EE4uLL, 0x6BCDF07A423AA96BuLL },  // 1e-128, 1e-127
+	{ 0xAD4AB7112EB3929DuLL, 0x86C16C98D2C953C6uLL }, { 0xD89D64D57A607744uLL, 0xE871C7BF077BA8B7uLL },  // 1e-126, 1e-125
+	{ 0x87625F056C7C4A8BuLL, 0x11471CD764AD4972uLL }, { 0xA93AF6C6C79B5D2DuLL, 0xD598E40D3DD89BCFuLL },  // 1e-124, 1e-123
+	{ 0xD389B47879823479uLL, 0x4AFF1D108D4EC2C3uLL }, { 0x843610CB4BF160CBuLL, 0xCEDF722A585139BAuLL },  // 1e-122, 1e-121
+	{ 0xA54394FE1EEDB8FEuLL, 0xC2974EB4EE658828uLL }, { 0xCE947A3DA6A9273EuLL, 0x733D226229FEEA32uLL },  // 1e-120, 1e-119
+	{ 0x811CCC668829B887uLL, 0x0806357D5A3F525FuLL }, { 0xA163FF802A3426A8uLL, 0xCA07C2DCB0CF26F7uLL },  // 1e-118, 1e-117
+	{ 0xC9BCFF6034C13052uLL, 0xFC89B393DD02F0B5uLL }, { 0xFC2C3F3841F17C67uLL, 0xBBAC2078D443ACE2uLL },  // 1e-116, 1e-115
+	{ 0x9D9BA7832936EDC0uLL, 0xD54B944B84AA4C0DuLL }, { 0xC5029163F384A931uLL, 0x0A9E795E65D4DF11uLL },  // 1e-114, 1e-113
+	{ 0xF64335BCF065D37DuLL, 0x4D4617B5FF4A16D5uLL }, { 0x99EA0196163FA42EuLL, 0x504BCED1BF8E4E45uLL },  // 1e-112, 1e-111
+	{ 0xC06481FB9BCF8D39uLL, 0xE45EC2862F71E1D6uLL }, { 0xF07DA27A82C37088uLL, 0x5D767327BB4E5A4CuLL },  // 1e-110, 1e-109
+	{ 0x964E858C91BA2655uLL, 0x3A6A07F8D510F86FuLL }, { 0xBBE226EFB628AFEAuLL, 0x890489F70A55368BuLL },  // 1e-108, 1e-107
+	{ 0xEADAB0ABA3B2DBE5uLL, 0x2B45AC74CCEA842EuLL }, { 0x92C8AE6B464FC96FuLL, 0x3B0B8BC90012929DuLL },  // 1e-106, 1e-105
+	{ 0xB77ADA0617E3BBCBuLL, 0x09CE6EBB40173744uLL }, { 0xE55990879DDCAABDuLL, 0xCC420A6A101D0515uLL },  // 1e-104, 1e-103
+	{ 0x8F57FA54C2A9EAB6uLL, 0x9FA946824A12232DuLL }, { 0xB32DF8E9F3546564uLL, 0x47939822DC96ABF9uLL },  // 1e-102, 1e-101
+	{ 0xDFF9772470297EBDuLL, 0x59787E2B93BC56F7uLL }, { 0x8BFBEA76C619EF36uLL, 0x57EB4EDB3C55B65AuLL },  // 1e-100, 1e-99
+	{ 0xAEFAE51477A06B03uLL, 0xEDE622920B6B23F1uLL }, { 0xDAB99E59958885C4uLL, 0xE95FAB368E45ECEDuLL },  // 1e-98, 1e-97
+	{ 0x88B402F7FD75539BuLL, 0x11DBCB0218EBB414uLL }, { 0xAAE103B5FCD2A881uLL, 0xD652BDC29F26A119uLL },  // 1e-96, 1e-95
+	{ 0xD59944A37C0752A2uLL, 0x4BE76D3346F0495FuLL }, { 0x857FCAE62D8493A5uLL, 0x6F70A4400C562DDBuLL },  // 1e-94, 1e-93
+	{ 0xA6DFBD9FB8E5B88EuLL, 0xCB4CCD500F6BB952uLL }, { 0xD097AD07A71F26B2uLL, 0x7E2000A41346A7A7uLL },  // 1e-92, 1e-91
+	{ 0x825ECC24C873782FuLL, 0x8ED400668C0C28C8uLL }, { 0xA2F67F2DFA90563BuLL, 0x728900802F0F32FAuLL },  // 1e-90, 1e-89
+	{ 0xCBB41EF979346BCAuLL, 0x4F2B40A03AD2FFB9uLL }, { 0xFEA126B7D78186BCuLL, 0xE2F610C84987BFA8uLL },  // 1e-88, 1e-87
+	{ 0x9F24B832E6B0F436uLL, 0x0DD9CA7D2DF4D7C9uLL }, { 0xC6EDE63FA05D3143uLL, 0x91503D1C79720DBBuLL },  // 1e-86, 1e-85
+	{ 0xF8A95FCF88747D94uLL, 0x75A44C6397CE912AuLL }, { 0x9B69DBE1B548CE7CuLL, 0xC986AFBE3EE11ABAuLL },  // 1e-84, 1e-83
+	{ 0xC24452DA229B021BuLL, 0xFBE85BADCE996168uLL }, { 0xF2D56790AB41C2A2uLL, 0xFAE27299423FB9C3uLL },  // 1e-82, 1e-81
+	{ 0x97C560BA6B0919A5uLL, 0xDCCD879FC967D41AuLL }, { 0xBDB6B8E905CB600FuLL, 0x5400E987BBC1C920uLL },  // 1e-80, 1e-79
+	{ 0xED246723473E3813uLL, 0x290123E9AAB23B68uLL }, { 0x9436C0760C86E30BuLL, 0xF9A0B6720AAF6521uLL },  // 1e-78, 1e-77
+	{ 0xB94470938FA89BCEuLL, 0xF808E40E8D5B3E69uLL }, { 0xE7958CB87392C2C2uLL, 0xB60B1D1230B20E04uLL },  // 1e-76, 1e-75
+	{ 0x90BD77F3483BB9B9uLL, 0xB1C6F22B5E6F48C2uLL }, { 0xB4ECD5F01A4AA828uLL, 0x1E38AEB6360B1AF3uLL },  // 1e-74, 1e-73
+	{ 0xE2280B6C20DD5232uLL, 0x25C6DA63C38DE1B0uLL }, { 0x8D590723948A535FuLL, 0x579C487E5A38AD0EuLL },  // 1e-72, 1e-71
+	{ 0xB0AF48EC79ACE837uLL, 0x2D835A9DF0C6D851uLL }, { 0xDCDB1B2798182244uLL, 0xF8E431456CF88E65uLL },  // 1e-70, 1e-69
+	{ 0x8A08F0F8BF0F156BuLL, 0x1B8E9ECB641B58FFuLL }, { 0xAC8B2D36EED2DAC5uLL, 0xE272467E3D222F3FuLL },  // 1e-68, 1e-67
+	{ 0xD7ADF884AA879177uLL, 0x5B0ED81DCC6ABB0FuLL }, { 0x86CCBB52EA94BAEAuLL, 0x98E947129FC2B4E9uLL },  // 1e-66, 1e-65
+	{ 0xA87FEA27A539E9A5uLL, 0x3F2398D747B36224uLL }, { 0xD29FE4B18E88640EuLL, 0x8EEC7F0D19A03AADuLL },  // 1e-64, 1e-63
+	{ 0x83A3EEEEF9153E89uLL, 0x1953CF68300424ACuLL }, { 0xA48CEAAAB75A8E2BuLL, 0x5FA8C3423C052DD7uLL },  // 1e-62, 1e-61
+	{ 0xCDB02555653131B6uLL, 0x3792F412CB06794DuLL }, { 0x808E17555F3EBF11uLL, 0xE2BBD88BBEE40BD0uLL },  // 1e-60, 1e-59
+	{ 0xA0B19D2AB70E6ED6uLL, 0x5B6ACEAEAE9D0EC4uLL }, { 0xC8DE047564D20A8BuLL, 0xF245825A5A445275uLL },  // 1e-58, 1e-57
+	{ 0xFB158592BE068D2EuLL, 0xEED6E2F0F0D56712uLL }, { 0x9CED737BB6C4183DuLL, 0x55464DD69685606BuLL },  // 1e-56, 1e-55
+	{ 0xC428D05AA4751E4CuLL, 0xAA97E14C3C26B886uLL }, { 0xF53304714D9265DFuLL, 0xD53DD99F4B3066A8uLL },  // 1e-54, 1e-53
+	{ 0x993FE2C6D07B7FABuLL, 0xE546A8038EFE4029uLL }, { 0xBF8FDB78849A5F96uLL, 0xDE98520472BDD033uLL },  // 1e-52, 1e-51
+	{ 0xEF73D256A5C0F77CuLL, 0x963E66858F6D4440uLL }, { 0x95A8637627989AADuLL, 0xDDE7001379A44AA8uLL },  // 1e-50, 1e-49
+	{ 0xBB127C53B17EC159uLL, 0x5560C018580D5D52uLL }, { 0xE9D71B689DDE71AFuLL, 0xAAB8F01E6E10B4A6uLL },  // 1e-48, 1e-47
+	{ 0x9226712162AB070DuLL, 0xCAB3961304CA70E8uLL }, { 0xB6B00D69BB55C8D1uLL, 0x3D607B97C5FD0D22uLL },  // 1e-46, 1e-45
+	{ 0xE45C10C42A2B3B05uLL, 0x8CB89A7DB77C506AuLL }, { 0x8EB98A7A9A5B04E3uLL, 0x77F3608E92ADB242uLL },  // 1e-44, 1e-43
+	{ 0xB267ED1940F1C61CuLL, 0x55F038B237591ED3uLL }, { 0xDF01E85F912E37A3uLL, 0x6B6C46DEC52F6688uLL },  // 1e-42, 1e-41
+	{ 0x8B61313BBABCE2C6uLL, 0x2323AC4B3B3DA015uLL }, { 0xAE397D8AA96C1B77uLL, 0xABEC975E0A0D081AuLL },  // 1e-40, 1e-39
+	{ 0xD9C7DCED53C72255uLL, 0x96E7BD358C904A21uLL }, { 0x881CEA14545C7575uLL, 0x7E50D64177DA2E54uLL },  // 1e-38, 1e-37
+	{ 0xAA242499697392D2uLL, 0xDDE50BD1D5D0B9E9uLL }, { 0xD4AD2DBFC3D07787uLL, 0x955E4EC64B44E864uLL },  // 1e-36, 1e-35
+	{ 0x84EC3C97DA624AB4uLL, 0xBD5AF13BEF0B113EuLL }, { 0xA6274BBDD0FADD61uLL, 0xECB1AD8AEACDD58EuLL },  // 1e-34, 1e-33
+	{ 0xCFB11EAD453994BAuLL, 0x67DE18EDA5814AF2uLL }, { 0x81CEB32C4B43FCF4uLL, 0x80EACF948770CED7uLL },  // 1e-32, 1e-31
+	{ 0xA2425FF75E14FC31uLL, 0xA1258379A94D028DuLL }, { 0xCAD2F7F5359A3B3EuLL, 0x096EE45813A04330uLL },  // 1e-30, 1e-29
+	{ 0xFD87B5F28300CA0DuLL, 0x8BCA9D6E188853FCuLL }, { 0x9E74D1B791E07E48uLL, 0x775EA264CF55347DuLL },  // 1e-28, 1e-27
+	{ 0xC612062576589DDAuLL, 0x95364AFE032A819DuLL }, { 0xF79687AED3EEC551uLL, 0x3A83DDBD83F52204uLL },  // 1e-26, 1e-25
+	{ 0x9ABE14CD44753B52uLL, 0xC4926A9672793542uLL }, { 0xC16D9A0095928A27uLL, 0x75B7053C0F178293uLL },  // 1e-24, 1e-23
+	{ 0xF1C90080BAF72CB1uLL, 0x5324C68B12DD6338uLL }, { 0x971DA05074DA7BEEuLL, 0xD3F6FC16EBCA5E03uLL },  // 1e-22, 1e-21
+	{ 0xBCE5086492111AEAuLL, 0x88F4BB1CA6BCF584uLL }, { 0xEC1E4A7DB69561A5uLL, 0x2B31E9E3D06C32E5uLL },  // 1e-20, 1e-19
+	{ 0x9392EE8E921D5D07uLL, 0x3AFF322E62439FCFuLL }, { 0xB877AA3236A4B449uLL, 0x09BEFEB9FAD487C2uLL },  // 1e-18, 1e-17
+	{ 0xE69594BEC44DE15BuLL, 0x4C2EBE687989A9B3uLL }, { 0x901D7CF73AB0ACD9uLL, 0x0F9D37014BF60A10uLL },  // 1e-16, 1e-15
+	{ 0xB424DC35095CD80FuLL, 0x538484C19EF38C94uLL }, { 0xE12E13424BB40E13uLL, 0x2865A5F206B06FB9uLL },  // 1e-14, 1e-13
+	{ 0x8CBCCC096F5088CBuLL, 0xF93F87B7442E45D3uLL }, { 0xAFEBFF0BCB24AAFEuLL, 0xF78F69A51539D748uLL },  // 1e-12, 1e-11
+	{ 0xDBE6FECEBDEDD5BEuLL, 0xB573440E5A884D1BuLL }, { 0x89705F4136B4A597uLL, 0x31680A88F8953030uLL },  // 1e-10, 1e-9
+	{ 0xABCC77118461CEFCuLL, 0xFDC20D2B36BA7C3DuLL }, { 0xD6BF94D5E57A42BCuLL, 0x3D32907604691B4CuLL },  // 1e-8, 1e-7
+	{ 0x8637BD05AF6C69B5uLL, 0xA63F9A49C2C1B10FuLL }, { 0xA7C5AC471B478423uLL, 0x0FCF80DC33721D53uLL },  // 1e-6, 1e-5
+	{ 0xD1B71758E219652BuLL, 0xD3C36113404EA4A8uLL }, { 0x83126E978D4FDF3BuLL, 0x645A1CAC083126E9uLL },  // 1e-4, 1e-3
+	{ 0xA3D70A3D70A3D70AuLL, 0x3D70A3D70A3D70A3uLL }, { 0xCCCCCCCCCCCCCCCCuLL, 0xCCCCCCCCCCCCCCCCuLL },  // 1e-2, 1e-1
+	{ 0x8000000000000000uLL, 0x0000000000000000uLL }, { 0xA000000000000000uLL, 0x0000000000000000uLL },  // 1e0, 1e1
+	{ 0xC800000000000000uLL, 0x0000000000000000uLL }, { 0xFA00000000000000uLL, 0x0000000000000000uLL },  // 1e2, 1e3
+	{ 0x9C40000000000000uLL, 0x0000000000000000uLL }, { 0xC350000000000000uLL, 0x0000000000000000uLL },  // 1e4, 1e5
+	{ 0xF424000000000000uLL, 0x0000000000000000uLL }, { 0x9896800000000000uLL, 0x0000000000000000uLL },  // 1e6, 1e7
+	{ 0xBEBC200000000000uLL, 0x0000000000000000uLL }, { 0xEE6B280000000000uLL, 0x0000000000000000uLL },  // 1e8, 1e9
+	{ 0x9502F90000000000uLL, 0x0000000000000000uLL }, { 0xBA43B74000000000uLL, 0x0000000000000000uLL },  // 1e10, 1e11
+	{ 0xE8D4A51000000000uLL, 0x0000000000000000uLL }, { 0x9184E72A00000000uLL, 0x0000000000000000uLL },  // 1e12, 1e13
+	{ 0xB5E620F480000000uLL, 0x0000000000000000uLL }, { 0xE35FA931A0000000uLL, 0x0000000000000000uLL },  // 1e14, 1e15
+	{ 0x8E1BC9BF04000000uLL, 0x0000000000000000uLL }, { 0xB1A2BC2EC5000000uLL, 0x0000000000000000uLL },  // 1e16, 1e17
+	{ 0xDE0B6B3A76400000uLL, 0x0000000000000000uLL }, { 0x8AC7230489E80000uLL, 0x0000000000000000uLL },  // 1e18, 1e19
+	{ 0xAD78EBC5AC620000uLL, 0x0000000000000000uLL }, { 0xD8D726B7177A8000uLL, 0x0000000000000000uLL },  // 1e20, 1e21
+	{ 0x878678326EAC9000uLL, 0x0000000000000000uLL }, { 0xA968163F0A57B400uLL, 0x0000000000000000uLL },  // 1e22, 1e23
+	{ 0xD3C21BCECCEDA100uLL, 0x0000000000000000uLL }, { 0x84595161401484A0uLL, 0x0000000000000000uLL },  // 1e24, 1e25
+	{ 0xA56FA5B99019A5C8uLL, 0x0000000000000000uLL }, { 0xCECB8F27F4200F3AuLL, 0x0000000000000000uLL },  // 1e26, 1e27
+	{ 0x813F3978F8940984uLL, 0x4000000000000000uLL }, { 0xA18F07D736B90BE5uLL, 0x5000000000000000uLL },  // 1e28, 1e29
+	{ 0xC9F2C9CD04674EDEuLL, 0xA400000000000000uLL }, { 0xFC6F7C4045812296uLL, 0x4D00000000000000uLL },  // 1e30, 1e31
+	{ 0x9DC5ADA82B70B59DuLL, 0xF020000000000000uLL }, { 0xC5371912364CE305uLL, 0x6C28000000000000uLL },  // 1e32, 1e33
+	{ 0xF684DF56C3E01BC6uLL, 0xC732000000000000uLL }, { 0x9A130B963A6C115CuLL, 0x3C7F400000000000uLL },  // 1e34, 1e35
+	{ 0xC097CE7BC90715B3uLL, 0x4B9F100000000000uLL }, { 0xF0BDC21ABB48DB20uLL, 0x1E86D40000000000uLL },  // 1e36, 1e37
+	{ 0x96769950B50D88F4uLL, 0x1314448000000000uLL }, { 0xBC143FA4E250EB31uLL, 0x17D955A000000000uLL },  // 1e38, 1e39
+	{ 0xEB194F8E1AE525FDuLL, 0x5DCFAB0800000000uLL }, { 0x92EFD1B8D0CF37BEuLL, 0x5AA1CAE500000000uLL },  // 1e40, 1e41
+	{ 0xB7ABC627050305ADuLL, 0xF14A3D9E40000000uLL }, { 0xE596B7B0C643C719uLL, 0x6D9CCD05D0000000uLL },  // 1e42, 1e43
+	{ 0x8F7E32CE7BEA5C6FuLL, 0xE4820023A2000000uLL }, { 0xB35DBF821AE4F38BuLL, 0xDDA2802C8A800000uLL },  // 1e44, 1e45
+	{ 0xE0352F62A19E306EuLL, 0xD50B2037AD200000uLL }, { 0x8C213D9DA502DE45uLL, 0x4526F422CC340000uLL },  // 1e46, 1e47
+	{ 0xAF298D050E4395D6uLL, 0x9670B12B7F410000uLL }, { 0xDAF3F04651D47B4CuLL, 0x3C0CDD765F114000uLL },  // 1e48, 1e49
+	{ 0x88D8762BF324CD0FuLL, 0xA5880A69FB6AC800uLL }, { 0xAB0E93B6EFEE0053uLL, 0x8EEA0D047A457A00uLL },  // 1e50, 1e51
+	{ 0xD5D238A4ABE98068uLL, 0x72A4904598D6D880uLL }, { 0x85A36366EB71F041uLL, 0x47A6DA2B7F864750uLL },  // 1e52, 1e53
+	{ 0xA70C3C40A64E6C51uLL, 0x999090B65F67D924uLL }, { 0xD0CF4B50CFE20765uLL, 0xFFF4B4E3F741CF6DuLL },  // 1e54, 1e55
+	{ 0x82818F1281ED449FuLL, 0xBFF8F10E7A8921A4uLL }, { 0xA321F2D7226895C7uLL, 0xAFF72D52192B6A0DuLL },  // 1e56, 1e57
+	{ 0xCBEA6F8CEB02BB39uLL, 0x9BF4F8A69F764490uLL }, { 0xFEE50B7025C36A08uLL, 0x02F236D04753D5B4uLL },  // 1e58, 1e59
+	{ 0x9F4F2726179A2245uLL, 0x01D762422C946590uLL }, { 0xC722F0EF9D80AAD6uLL, 0x424D3AD2B7B97EF5uLL },  // 1e60, 1e61
+	{ 0xF8EBAD2B84E0D58BuLL, 0xD2E0898765A7DEB2uLL }, { 0x9B934C3B330C8577uLL, 0x63CC55F49F88EB2FuLL },  // 1e62, 1e63
+	{ 0xC2781F49FFCFA6D5uLL, 0x3CBF6B71C76B25FBuLL }, { 0xF316271C7FC3908AuLL, 0x8BEF464E3945EF7AuLL },  // 1e64, 1e65
+	{ 0x97EDD871CFDA3A56uLL, 0x97758BF0E3CBB5ACuLL }, { 0xBDE94E8E43D0C8ECuLL, 0x3D52EEED1CBEA317uLL },  // 1e66, 1e67
+	{ 0xED63A231D4C4FB27uLL, 0x4CA7AAA863EE4BDDuLL }, { 0x945E455F24FB1CF8uLL, 0x8FE8CAA93E74EF6AuLL },  // 1e68, 1e69
+	{ 0xB975D6B6EE39E436uLL, 0xB3E2FD538E122B44uLL }, { 0xE7D34C64A9C85D44uLL, 0x60DBBCA87196B616uLL },  // 1e70, 1e71
+	{ 0x90E40FBEEA1D3A4AuLL, 0xBC8955E946FE31CDuLL }, { 0xB51D13AEA4A488DDuLL, 0x6BABAB6398BDBE41uLL },  // 1e72, 1e73
+	{ 0xE264589A4DCDAB14uLL, 0xC696963C7EED2DD1uLL }, { 0x8D7EB76070A08AECuLL, 0xFC1E1DE5CF543CA2uLL },  // 1e74, 1e75
+	{ 0xB0DE65388CC8ADA8uLL, 0x3B25A55F43294BCBuLL }, { 0xDD15FE86AFFAD912uLL, 0x49EF0EB713F39EBEuLL },  // 1e76, 1e77
+	{ 0x8A2DBF142DFCC7ABuLL, 0x6E3569326C784337uLL }, { 0xACB92ED9397BF996uLL, 0x49C2C37F07965404uLL },  // 1e78, 1e79
+	{ 0xD7E77A8F87DAF7FBuLL, 0xDC33745EC97BE906uLL }, { 0x86F0AC99B4E8DAFDuLL, 0x69A028BB3DED71A3uLL },  // 1e80, 1e81
+	{ 0xA8ACD7C0222311BCuLL, 0xC40832EA0D68CE0CuLL }, { 0xD2D80DB02AABD62BuLL, 0xF50A3FA490C30190uLL },  // 1e82, 1e83
+	{ 0x83C7088E1AAB65DBuLL, 0x792667C6DA79E0FAuLL }, { 0xA4B8CAB1A1563F52uLL, 0x577001B891185938uLL },  // 1e84, 1e85
+	{ 0xCDE6FD5E09ABCF26uLL, 0xED4C0226B55E6F86uLL }, { 0x80B05E5AC60B6178uLL, 0x544F8158315B05B4uLL },  // 1e86, 1e87
+	{ 0xA0DC75F1778E39D6uLL, 0x696361AE3DB1C721uLL }, { 0xC913936DD571C84CuLL, 0x03BC3A19CD1E38E9uLL },  // 1e88, 1e89
+	{ 0xFB5878494ACE3A5FuLL, 0x04AB48A04065C723uLL }, { 0x9D174B2DCEC0E47BuLL, 0x62EB0D64283F9C76uLL },  // 1e90, 1e91
+	{ 0xC45D1DF942711D9AuLL, 0x3BA5D0BD324F8394uLL }, { 0xF5746577930D6500uLL, 0xCA8F44EC7EE36479uLL },  // 1e92, 1e93
+	{ 0x9968BF6ABBE85F20uLL, 0x7E998B13CF4E1ECBuLL }, { 0xBFC2EF456AE276E8uLL, 0x9E3FEDD8C321A67EuLL },  // 1e94, 1e95
+	{ 0xEFB3AB16C59B14A2uLL, 0xC5CFE94EF3EA101EuLL }, { 0x95D04AEE3B80ECE5uLL, 0xBBA1F1D158724A12uLL },  // 1e96, 1e97
+	{ 0xBB445DA9CA61281FuLL, 0x2A8A6E45AE8EDC97uLL }, { 0xEA1575143CF97226uLL, 0xF52D09D71A3293BDuLL },  // 1e98, 1e99
+	{ 0x924D692CA61BE758uLL, 0x593C2626705F9C56uLL }, { 0xB6E0C377CFA2E12EuLL, 0x6F8B2FB00C77836CuLL },  // 1e100, 1e101
+	{ 0xE498F455C38B997AuLL, 0x0B6DFB9C0F956447uLL }, { 0x8EDF98B59A373FECuLL, 0x4724BD4189BD5EACuLL },  // 1e102, 1e103
+	{ 0xB2977EE300C50FE7uLL, 0x58EDEC91EC2CB657uLL }, { 0xDF3D5E9BC0F653E1uLL, 0x2F2967B66737E3EDuLL },  // 1e104, 1e105
+	{ 0x8B865B215899F46CuLL, 0xBD79E0D20082EE74uLL }, { 0xAE67F1E9AEC07187uLL, 0xECD8590680A3AA11uLL },  // 1e106, 1e107
+	{ 0xDA01EE641A708DE9uLL, 0xE80E6F4820CC9495uLL }, { 0x884134FE908658B2uLL, 0x3109058D147FDCDDuLL },  // 1e108, 1e109
+	{ 0xAA51823E34A7EEDEuLL, 0xBD4B46F0599FD415uLL }, { 0xD4E5E2CDC1D1EA96uLL, 0x6C9E18AC7007C91AuLL },  // 1e110, 1e111
+	{ 0x850FADC09923329EuLL, 0x03E2CF6BC604DDB0uLL }, { 0xA6539930BF6BFF45uLL, 0x84DB8346B786151CuLL },  // 1e112, 1e113
+	{ 0xCFE87F7CEF46FF16uLL, 0xE612641865679A63uLL }, { 0x81F14FAE158C5F6EuLL, 0x4FCB7E8F3F60C07EuLL },  // 1e114, 1e115
+	{ 0xA26DA3999AEF7749uLL, 0xE3BE5E330F38F09DuLL }, { 0xCB090C8001AB551CuLL, 0x5CADF5BFD3072CC5uLL },  // 1e116, 1e117
+	{ 0xFDCB4FA002162A63uLL, 0x73D9732FC7C8F7F6uLL }, { 0x9E9F11C4014DDA7EuLL, 0x2867E7FDDCDD9AFAuLL },  // 1e118, 1e119
+	{ 0xC646D63501A1511DuLL, 0xB281E1FD541501B8uLL }, { 0xF7D88BC24209A565uLL, 0x1F225A7CA91A4226uLL },  // 1e120, 1e121
+	{ 0x9AE757596946075FuLL, 0x3375788DE9B06958uLL }, { 0xC1A12D2FC3978937uLL, 0x0052D6B1641C83AEuLL },  // 1e122, 1e123
+	{ 0xF209787BB47D6B84uLL, 0xC0678C5DBD23A49AuLL }, { 0x9745EB4D50CE6332uLL, 0xF840B7BA963646E0uLL },  // 1e124, 1e125
+	{ 0xBD176620A501FBFFuLL, 0xB650E5A93BC3D898uLL }, { 0xEC5D3FA8CE427AFFuLL, 0xA3E51F138AB4CEBEuLL },  // 1e126, 1e127
+	{ 0x93BA47C980E98CDFuLL, 0xC66F336C36B10137uLL }, { 0xB8A8D9BBE123F017uLL, 0xB80B0047445D4184uLL },  // 1e128, 1e129
+	{ 0xE6D3102AD96CEC1DuLL, 0xA60DC059157491E5uLL }, { 0x9043EA1AC7E41392uLL, 0x87C89837AD68DB2FuLL },  // 1e130, 1e131
+	{ 0xB454E4A179DD1877uLL, 0x29BABE4598C311FBuLL }, { 0xE16A1DC9D8545E94uLL, 0xF4296DD6FEF3D67AuLL },  // 1e132, 1e133
+	{ 0x8CE2529E2734BB1DuLL, 0x1899E4A65F58660CuLL }, { 0xB01AE745B101E9E4uLL, 0x5EC05DCFF72E7F8FuLL },  // 1e134, 1e135
+	{ 0xDC21A1171D42645DuLL, 0x76707543F4FA1F73uLL }, { 0x899504AE72497EBAuLL, 0x6A06494A791C53A8uLL },  // 1e136, 1e137
+	{ 0xABFA45DA0EDBDE69uLL, 0x0487DB9D17636892uLL }, { 0xD6F8D7509292D603uLL, 0x45A9D2845D3C42B6uLL },  // 1e138, 1e139
+	{ 0x865B86925B9BC5C2uLL, 0x0B8A2392BA45A9B2uLL }, { 0xA7F26836F282B732uLL, 0x8E6CAC7768D7141EuLL },  // 1e140, 1e141
+	{ 0xD1EF0244AF2364FFuLL, 0x3207D795430CD926uLL }, { 0x8335616AED761F1FuLL, 0x7F44E6BD49E807B8uLL },  // 1e142, 1e143
+	{ 0xA402B9C5A8D3A6E7uLL, 0x5F16206C9C6209A6uLL }, { 0xCD036837130890A1uLL, 0x36DBA887C37A8C0FuLL },  // 1e144, 1e145
+	{ 0x802221226BE55A64uLL, 0xC2494954DA2C9789uLL }, { 0xA02AA96B06DEB0FDuLL, 0xF2DB9BAA10B7BD6CuLL },  // 1e146, 1e147
+	{ 0xC83553C5C8965D3DuLL, 0x6F92829494E5ACC7uLL }, { 0xFA42A8B73ABBF48CuLL, 0xCB772339BA1F17F9uLL },  // 1e148, 1e149
+	{ 0x9C69A97284B578D7uLL, 0xFF2A760414536EFBuLL }, { 0xC38413CF25E2D70DuLL, 0xFEF5138519684ABAuLL },  // 1e150, 1e151
+	{ 0xF46518C2EF5B8CD1uLL, 0x7EB258665FC25D69uLL }, { 0x98BF2F79D5993802uLL, 0xEF2F773FFBD97A61uLL },  // 1e152, 1e153
+	{ 0xBEEEFB584AFF8603uLL, 0xAAFB550FFACFD8FAuLL }, { 0xEEAABA2E5DBF6784uLL, 0x95BA2A53F983CF38uLL },  // 1e154, 1e155
+	{ 0x952AB45CFA97A0B2uLL, 0xDD945A747BF26183uLL }, { 0xBA756174393D88DFuLL, 0x94F971119AEEF9E4uLL },  // 1e156, 1e157
+	{ 0xE912B9D1478CEB17uLL, 0x7A37CD5601AAB85DuLL }, { 0x91ABB422CCB812EEuLL, 0xAC62E055C10AB33AuLL },  // 1e158, 1e159
+	{ 0xB616A12B7FE617AAuLL, 0x577B986B314D6009uLL }, { 0xE39C49765FDF9D94uLL, 0xED5A7E85FDA0B80BuLL },  // 1e160, 1e161
+	{ 0x8E41ADE9FBEBC27DuLL, 0x14588F13BE847307uLL }, { 0xB1D219647AE6B31CuLL, 0x596EB2D8AE258FC8uLL },  // 1e162, 1e163
+	{ 0xDE469FBD99A05FE3uLL, 0x6FCA5F8ED9AEF3BBuLL }, { 0x8AEC23D680043BEEuLL, 0x25DE7BB9480D5854uLL },  // 1e164, 1e165
+	{ 0xADA72CCC20054AE9uLL, 0xAF561AA79A10AE6AuLL }, { 0xD910F7FF28069DA4uLL, 0x1B2BA1518094DA04uLL },  // 1e166, 1e167
+	{ 0x87AA9AFF79042286uLL, 0x90FB44D2F05D0842uLL }, { 0xA99541BF57452B28uLL, 0x353A1607AC744A53uLL },  // 1e168, 1e169
+	{ 0xD3FA922F2D1675F2uLL, 0x42889B8997915CE8uLL }, { 0x847C9B5D7C2E09B7uLL, 0x69956135FEBADA11uLL },  // 1e170, 1e171
+	{ 0xA59BC234DB398C25uLL, 0x43FAB9837E699095uLL }, { 0xCF02B2C21207EF2EuLL, 0x94F967E45E03F4BBuLL },  // 1e172, 1e173
+	{ 0x8161AFB94B44F57DuLL, 0x1D1BE0EEBAC278F5uLL }, { 0xA1BA1BA79E1632DCuLL, 0x6462D92A69731732uLL },  // 1e174, 1e175
+	{ 0xCA28A291859BBF93uLL, 0x7D7B8F7503CFDCFEuLL }, { 0xFCB2CB35E702AF78uLL, 0x5CDA735244C3D43EuLL },  // 1e176, 1e177
+	{ 0x9DEFBF01B061ADABuLL, 0x3A0888136AFA64A7uLL }, { 0xC56BAEC21C7A1916uLL, 0x088AAA1845B8FDD0uLL },  // 1e178, 1e179
+	{ 0xF6C69A72A3989F5BuLL, 0x8AAD549E57273D45uLL }, { 0x9A3C2087A63F6399uLL, 0x36AC54E2F678864BuLL },  // 1e180, 1e181
+	{ 0xC0CB28A98FCF3C7FuLL, 0x84576A1BB416A7DDuLL }, { 0xF0FDF2D3F3C30B9FuLL, 0x656D44A2A11C51D5uLL },  // 1e182, 1e183
+	{ 0x969EB7C47859E743uLL, 0x9F644AE5A4B1B325uLL }, { 0xBC4665B596706114uLL, 0x873D5D9F0DDE1FEEuLL },  // 1e184, 1e185
+	{ 0xEB57FF22FC0C7959uLL, 0xA90CB506D155A7EAuLL }, { 0x9316FF75DD87CBD8uLL, 0x09A7F12442D588F2uLL },  // 1e186, 1e187
+	{ 0xB7DCBF5354E9BECEuLL, 0x0C11ED6D538AEB2FuLL }, { 0xE5D3EF282A242E81uLL, 0x8F1668C8A86DA5FAuLL },  // 1e188, 1e189
+	{ 0x8FA475791A569D10uLL, 0xF96E017D694487BCuLL }, { 0xB38D92D760EC4455uLL, 0x37C981DCC395A9ACuLL },  // 1e190, 1e191
+	{ 0xE070F78D3927556AuLL, 0x85BBE253F47B1417uLL }, { 0x8C469AB843B89562uLL, 0x93956D7478CCEC8EuLL },  // 1e192, 1e193
+	{ 0xAF58416654A6BABBuLL, 0x387AC8D1970027B2uLL }, { 0xDB2E51BFE9D0696AuLL, 0x06997B05FCC0319EuLL },  // 1e194, 1e195
+	{ 0x88FCF317F22241E2uLL, 0x441FECE3BDF81F03uLL }, { 0xAB3C2FDDEEAAD25AuLL, 0xD527E81CAD7626C3uLL },  // 1e196, 1e197
+	{ 0xD60B3BD56A5586F1uLL, 0x8A71E223D8D3B074uLL }, { 0x85C7056562757456uLL, 0xF6872D5667844E49uLL },  // 1e198, 1e199
+	{ 0xA738C6BEBB12D16CuLL, 0xB428F8AC016561DBuLL }, { 0xD106F86E69D785C7uLL, 0xE13336D701BEBA52uLL },  // 1e200, 1e201
+	{ 0x82A45B450226B39CuLL, 0xECC0024661173473uLL }, { 0xA34D721642B06084uLL, 0x27F002D7F95D0190uLL },  // 1e202, 1e203
+	{ 0xCC20CE9BD35C78A5uLL, 0x31EC038DF7B441F4uLL }, { 0xFF290242C83396CEuLL, 0x7E67047175A15271uLL },  // 1e204, 1e205
+	{ 0x9F79A169BD203E41uLL, 0x0F0062C6E984D386uLL }, { 0xC75809C42C684DD1uLL, 0x52C07B78A3E60868uLL },  // 1e206, 1e207
+	{ 0xF92E0C3537826145uLL, 0xA7709A56CCDF8A82uLL }, { 0x9BBCC7A142B17CCBuLL, 0x88A66076400BB691uLL },  // 1e208, 1e209
+	{ 0xC2ABF989935DDBFEuLL, 0x6ACFF893D00EA435uLL }, { 0xF356F7EBF83552FEuLL, 0x0583F6B8C4124D43uLL },  // 1e210, 1e211
+	{ 0x98165AF37B2153DEuLL, 0xC3727A337A8B704AuLL }, { 0xBE1BF1B059E9A8D6uLL, 0x744F18C0592E4C5CuLL },  // 1e212, 1e213
+	{ 0xEDA2EE1C7064130CuLL, 0x1162DEF06F79DF73uLL }, { 0x9485D4D1C63E8BE7uLL, 0x8ADDCB5645AC2BA8uLL },  // 1e214, 1e215
+	{ 0xB9A74A0637CE2EE1uLL, 0x6D953E2BD7173692uLL }, { 0xE8111C87C5C1BA99uLL, 0xC8FA8DB6CCDD0437uLL },  // 1e216, 1e217
+	{ 0x910AB1D4DB9914A0uLL, 0x1D9C9892400A22A2uLL }, { 0xB54D5E4A127F59C8uLL, 0x2503BEB6D00CAB4BuLL },  // 1e218, 1e219
+	{ 0xE2A0B5DC971F303AuLL, 0x2E44AE64840FD61DuLL }, { 0x8DA471A9DE737E24uLL, 0x5CEAECFED289E5D2uLL },  // 1e220, 1e221
+	{ 0xB10D8E1456105DADuLL, 0x7425A83E872C5F47uLL }, { 0xDD50F1996B947518uLL, 0xD12F124E28F77719uLL },  // 1e222, 1e223
+	{ 0x8A5296FFE33CC92FuLL, 0x82BD6B70D99AAA6FuLL }, { 0xACE73CBFDC0BFB7BuLL, 0x636CC64D1001550BuLL },  // 1e224, 1e225
+	{ 0xD8210BEFD30EFA5AuLL, 0x3C47F7E05401AA4EuLL }, { 0x8714A775E3E95C78uLL, 0x65ACFAEC34810A71uLL },  // 1e226, 1e227
+	{ 0xA8D9D1535CE3B396uLL, 0x7F1839A741A14D0DuLL }, { 0xD31045A8341CA07CuLL, 0x1EDE48111209A050uLL },  // 1e228, 1e229
+	{ 0x83EA2B892091E44DuLL, 0x934AED0AAB460432uLL }, { 0xA4E4B66B68B65D60uLL, 0xF81DA84D5617853FuLL },  // 1e230, 1e231
+	{ 0xCE1DE40642E3F4B9uLL, 0x36251260AB9D668EuLL }, { 0x80D2AE83E9CE78F3uLL, 0xC1D72B7C6B426019uLL },  // 1e232, 1e233
+	{ 0xA1075A24E4421730uLL, 0xB24CF65B8612F81FuLL }, { 0xC94930AE1D529CFCuLL, 0xDEE033F26797B627uLL },  // 1e234, 1e235
+	{ 0xFB9B7CD9A4A7443CuLL, 0x169840EF017DA3B1uLL }, { 0x9D412E0806E88AA5uLL, 0x8E1F289560EE864EuLL },  // 1e236, 1e237
+	{ 0xC491798A08A2AD4EuLL, 0xF1A6F2BAB92A27E2uLL }, { 0xF5B5D7EC8ACB58A2uLL, 0xAE10AF696774B1DBuLL },  // 1e238, 1e239
+	{ 0x9991A6F3D6BF1765uLL, 0xACCA6DA1E0A8EF29uLL }, { 0xBFF610B0CC6EDD3FuLL, 0x17FD090A58D32AF3uLL },  // 1e240, 1e241
+	{ 0xEFF394DCFF8A948EuLL, 0xDDFC4B4CEF07F5B0uLL }, { 0x95F83D0A1FB69CD9uLL, 0x4ABDAF101564F98EuLL },  // 1e242, 1e243
+	{ 0xBB764C4CA7A4440FuLL, 0x9D6D1AD41ABE37F1uLL }, { 0xEA53DF5FD18D5513uLL, 0x84C86189216DC5EDuLL },  // 1e244, 1e245
+	{ 0x92746B9BE2F8552CuLL, 0x32FD3CF5B4E49BB4uLL }, { 0xB7118682DBB66A77uLL, 0x3FBC8C33221DC2A1uLL },  // 1e246, 1e247
+	{ 0xE4D5E82392A40515uLL, 0x0FABAF3FEAA5334AuLL }, { 0x8F05B1163BA6832DuLL, 0x29CB4D87F2A7400EuLL },  // 1e248, 1e249
+	{ 0xB2C71D5BCA9023F8uLL, 0x743E20E9EF511012uLL }, { 0xDF78E4B2BD342CF6uLL, 0x914DA9246B255416uLL },  // 1e250, 1e251
+	{ 0x8BAB8EEFB6409C1AuLL, 0x1AD089B6C2F7548EuLL }, { 0xAE9672ABA3D0C320uLL, 0xA184AC2473B529B1uLL },  // 1e252, 1e253
+	{ 0xDA3C0F568CC4F3E8uLL, 0xC9E5D72D90A2741EuLL }, { 0x8865899617FB1871uLL, 0x7E2FA67C7A658892uLL },  // 1e254, 1e255
+	{ 0xAA7EEBFB9DF9DE8DuLL, 0xDDBB901B98FEEAB7uLL }, { 0xD51EA6FA85785631uLL, 0x552A74227F3EA565uLL },  // 1e256, 1e257
+	{ 0x8533285C936B35DEuLL, 0xD53A88958F87275FuLL }, { 0xA67FF273B8460356uLL, 0x8A892ABAF368F137uLL },  // 1e258, 1e259
+	{ 0xD01FEF10A657842CuLL, 0x2D2B7569B0432D85uLL }, { 0x8213F56A67F6B29BuLL, 0x9C3B29620E29FC73uLL },  // 1e260, 1e261
+	{ 0xA298F2C501F45F42uLL, 0x8349F3BA91B47B8FuLL }, { 0xCB3F2F7642717713uLL, 0x241C70A936219A73uLL },  // 1e262, 1e263
+	{ 0xFE0EFB53D30DD4D7uLL, 0xED238CD383AA0110uLL }, { 0x9EC95D1463E8A506uLL, 0xF4363804324A40AAuLL },  // 1e264, 1e265
+	{ 0xC67BB4597CE2CE48uLL, 0xB143C6053EDCD0D5uLL }, { 0xF81AA16FDC1B81DAuLL, 0xDD94B7868E94050AuLL },  // 1e266, 1e267
+	{ 0x9B10A4E5E9913128uLL, 0xCA7CF2B4191C8326uLL }, { 0xC1D4CE1F63F57D72uLL, 0xFD1C2F611F63A3F0uLL },  // 1e268, 1e269
+	{ 0xF24A01A73CF2DCCFuLL, 0xBC633B39673C8CECuLL }, { 0x976E41088617CA01uLL, 0xD5BE0503E085D813uLL },  // 1e270, 1e271
+	{ 0xBD49D14AA79DBC82uLL, 0x4B2D8644D8A74E18uLL }, { 0xEC9C459D51852BA2uLL, 0xDDF8E7D60ED1219EuLL },  // 1e272, 1e273
+	{ 0x93E1AB8252F33B45uLL, 0xCABB90E5C942B503uLL }, { 0xB8DA1662E7B00A17uLL, 0x3D6A751F3B936243uLL },  // 1e274, 1e275
+	{ 0xE7109BFBA19C0C9DuLL, 0x0CC512670A783AD4uLL }, { 0x906A617D450187E2uLL, 0x27FB2B80668B24C5uLL },  // 1e276, 1e277
+	{ 0xB484F9DC9641E9DAuLL, 0xB1F9F660802DEDF6uLL }, { 0xE1A63853BBD26451uLL, 0x5E7873F8A0396973uLL },  // 1e278, 1e279
+	{ 0x8D07E33455637EB2uLL, 0xDB0B487B6423E1E8uLL }, { 0xB049DC016ABC5E5FuLL, 0x91CE1A9A3D2CDA62uLL },  // 1e280, 1e281
+	{ 0xDC5C5301C56B75F7uLL, 0x7641A140CC7810FBuLL }, { 0x89B9B3E11B6329BAuLL, 0xA9E904C87FCB0A9DuLL },  // 1e282, 1e283
+	{ 0xAC2820D9623BF429uLL, 0x546345FA9FBDCD44uLL }, { 0xD732290FBACAF133uLL, 0xA97C177947AD4095uLL },  // 1e284, 1e285
+	{ 0x867F59A9D4BED6C0uLL, 0x49ED8EABCCCC485DuLL }, { 0xA81F301449EE8C70uLL, 0x5C68F256BFFF5A74uLL },  // 1e286, 1e287
+	{ 0xD226FC195C6A2F8CuLL, 0x73832EEC6FFF3111uLL }, { 0x83585D8FD9C25DB7uLL, 0xC831FD53C5FF7EABuLL },  // 1e288, 1e289
+	{ 0xA42E74F3D032F525uLL, 0xBA3E7CA8B77F5E55uLL }, { 0xCD3A1230C43FB26FuLL, 0x28CE1BD2E55F35EBuLL },  // 1e290, 1e291
+	{ 0x80444B5E7AA7CF85uLL, 0x7980D163CF5B81B3uLL }, { 0xA0555E361951C366uLL, 0xD7E105BCC332621FuLL },  // 1e292, 1e293
+	{ 0xC86AB5C39FA63440uLL, 0x8DD9472BF3FEFAA7uLL }, { 0xFA856334878FC150uLL, 0xB14F98F6F0FEB951uLL },  // 1e294, 1e295
+	{ 0x9C935E00D4B9D8D2uLL, 0x6ED1BF9A569F33D3uLL }, { 0xC3B8358109E84F07uLL, 0x0A862F80EC4700C8uLL },  // 1e296, 1e297
+	{ 0xF4A642E14C6262C8uLL, 0xCD27BB612758C0FAuLL }, { 0x98E7E9CCCFBD7DBDuLL, 0x8038D51CB897789CuLL },  // 1e298, 1e299
+	{ 0xBF21E44003ACDD2CuLL, 0xE0470A63E6BD56C3uLL }, { 0xEEEA5D5004981478uLL, 0x1858CCFCE06CAC74uLL },  // 1e300, 1e301
+	{ 0x95527A5202DF0CCBuLL, 0x0F37801E0C43EBC8uLL }, { 0xBAA718E68396CFFDuLL, 0xD30560258F54E6BAuLL },  // 1e302, 1e303
+	{ 0xE950DF20247C83FDuLL, 0x47C6B82EF32A2069uLL }, { 0x91D28B7416CDD27EuLL, 0x4CDC331D57FA5441uLL },  // 1e304, 1e305
+	{ 0xB6472E511C81471DuLL, 0xE0133FE4ADF8E952uLL }, { 0xE3D8F9E563A198E5uLL, 0x58180FDDD97723A6uLL },  // 1e306, 1e307
+	{ 0x8E679C2F5E44FF8FuLL, 0x570F09EAA7EA7648uLL },  // 1e308
+};
+
+// returns the lower 64 bits of a*b and writes the upper 64 bits to *hi
+static uint64_t DG__Mul64x64(uint64_t a, uint64_t b, uint64_t* hi)
+{
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 DG__uint128; // __extension__: no -Wpedantic warning
+	DG__uint128 r = (DG__uint128)a * b;
+	*hi = (uint64_t)(r >> 64);
+	return (uint64_t)r;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(a, b, hi);
+#else
+	const uint64_t M32 = 0xFFFFFFFFu;
+	uint64_t ll = (a & M32) * (b & M32);
+	uint64_t lh = (a & M32) * (b >> 32);
+	uint64_t hl = (a >> 32) * (b & M32);
+	uint64_t hh = (a >> 32) * (b >> 32);
+	uint64_t mid = (ll >> 32) + (lh & M32) + (hl & M32);
+	*hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	return (mid << 32) | (ll & M32);
+#endif
+}
+
+// x must not be 0
+static int DG__CountLeadingZeros64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(x);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long idx;
+	_BitScanReverse64(&idx, x);
+	return 63 - (int)idx;
+#else
+	int n = 0;
+	while((x & 0x8000000000000000uLL) == 0)
+	{
+		x <<= 1;
+		++n;
+	}
+	return n;
+#endif
+}
+
+// converts w * 10^q (w != 0) to a double (mantBits = 52, expBits = 11) or float (23, 8) with
+// the Eisel-Lemire algorithm (see "Number Parsing at a Gigabyte per Second" by Daniel Lemire,
+// https://arxiv.org/abs/2101.11408), like in the strconv package of the Go standard library.
+// writes the bits of the number (without sign) to *bits and returns 1, or returns 0 if it
+// can't decide how to round or the result would be subnormal, inf or 0 (use the fallback then)
+static int DG__EiselLemire(uint64_t w, long long q, int mantBits, int expBits, uint64_t* bits)
+{
+	if(q < DG__POW10_MIN_EXP || q > DG__POW10_MAX_EXP)  return 0;
+
+	int clz = DG__CountLeadingZeros64(w);
+	w <<= clz;
+	// floor(q * log2(10)), without relying on >> of negative numbers
+	int qi = (int)q;
+	int qLog2 = (qi >= 0) ? (217706 * qi) >> 16 : -((-217706 * qi + 65535) >> 16);
+	int maxExp = (1 << expBits) - 1;
+	int exp2 = qLog2 + 64 + (maxExp >> 1) - clz; // (maxExp >> 1) is the exponent bias
+
+	// the upper 64 bits of w * 10^q are enough, unless the lower bits of them are all set
+	// (then adding the rest of the product might change the rounding)
+	const uint64_t* pow10 = DG__pow10x128[qi - DG__POW10_MIN_EXP];
+	int shift = 64 - mantBits - 3;
+	uint64_t mask = ((uint64_t)1 << shift) - 1;
+	uint64_t xHi;
+	uint64_t xLo = DG__Mul64x64(w, pow10[0], &xHi);
+	if((xHi & mask) == mask && xLo + w < w)
+	{
+		uint64_t yHi;
+		uint64_t yLo = DG__Mul64x64(w, pow10[1], &yHi);
+		uint64_t mergedHi = xHi;
+		uint64_t mergedLo = xLo + yHi;
+		if(mergedLo < xLo)  ++mergedHi;
+		if((mergedHi & mask) == mask && mergedLo + 1 == 0 && yLo + w < w)
+			return 0;
+		xHi = mergedHi;
+		xLo = mergedLo;
+	}
+
+	// shift to mantBits + 2 bits
+	int msb = (int)(xHi >> 63);
+	uint64_t mant = xHi >> (msb + shift);
+	exp2 -= 1 ^ msb;
+
+	// exactly halfway between two numbers: can't tell how to round
+	if(xLo == 0 && (xHi & mask) == 0 && (mant & 3) == 1)
+		return 0;
+
+	// round to mantBits + 1 bits (incl. the implicit one)
+	mant += mant & 1;
+	mant >>= 1;
+	if((mant >> (mantBits + 1)) != 0)
+	{
+		mant >>= 1;
+		++exp2;
+	}
+	if(exp2 <= 0 || exp2 >= maxExp)
+		return 0;
+
+	*bits = ((uint64_t)exp2 << mantBits) | (mant & (((uint64_t)1 << mantBits) - 1));
+	return 1;
+}
+
+// a decimal number parsed by DG__ParseDecimal()
+typedef struct {
+	uint64_t w; // the first (up to) 19 significant digits
+	long long exp10; // the number is (about) w * 10^exp10
+	int truncated; // there were more significant digits that didn't fit into w
+	int neg;
+	const char* mantStart; // the digits (and '.') of the number, for DG__ParseFallback()
+	const char* mantEnd;
+	long long explicitExp; // the exponent after the 'e'
+} DG__ParsedDecimal;
+
+// the biggest exponent after the 'e' DG__ParseDecimal() keeps track of,
+// anything bigger is inf or 0 anyway
+#define DG__PARSE_MAX_EXP 100000000
+
+// parses the syntax of a decimal number from [p, end) into d.
+// returns the end of the number, or NULL if there is none
+static const char* DG__ParseDecimal(const char* p, const char* end, DG__ParsedDecimal* d)
+{
+	d->neg = (p < end && *p == '-');
+	p += d->neg;
+	d->mantStart = p;
+
+	uint64_t w = 0;
+	int numSig = 0; // number of significant digits in w
+	long long exp10 = 0;
+	int truncated = 0;
+	int anyDigits = 0;
+	for( ; p < end && (unsigned char)(*p - '0') < 10; ++p)
+	{
+		anyDigits = 1;
+		if(numSig < 19)
+		{
+			w = w*10 + (*p - '0');
+			numSig += (w != 0); // leading zeros aren't significant
+		}
+		else
+		{
+			++exp10;
+			truncated |= (*p != '0');
+		}
+	}
+	if(p < end && *p == '.')
+	{
+		const char* afterPoint = p + 1;
+		for(p = afterPoint; p < end && (unsigned char)(*p - '0') < 10; ++p)
+		{
+			if(numSig < 19)
+			{
+				w = w*10 + (*p - '0');
+				numSig += (w != 0);
+				--exp10;
+			}
+			else
+			{
+				truncated |= (*p != '0');
+			}
+		}
+		anyDigits |= (p != afterPoint);
+	}
+	if(!anyDigits)  return NULL; // also for "." or "-"
+	d->mantEnd = p;
+
+	// the exponent, only if there's at least one digit after the 'e'
+	d->explicitExp = 0;
+	if(p < end && (*p == 'e' || *p == 'E'))
+	{
+		const char* e = p + 1;
+		int expNeg = 0;
+		if(e < end && (*e == '-' || *e == '+'))
+		{
+			expNeg = (*e == '-');
+			++e;
+		}
+		if(e < end && (unsigned char)(*e - '0') < 10)
+		{
+			long long ex = 0;
+			for( ; e < end && (unsigned char)(*e - '0') < 10; ++e)
+			{
+				if(ex < DG__PARSE_MAX_EXP)
+					ex = ex*10 + (*e - '0');
+			}
+			d->explicitExp = expNeg ? -ex : ex;
+			p = e;
+		}
+	}
+	d->w = w;
+	d->exp10 = exp10 + d->explicitExp;
+	d->truncated = truncated;
+	return p;
+}
+
+// the maximum number of significant digits DG__ParseFallback() passes on to strtod(),
+// more are never needed to correctly round a double (if the rest is replaced by
+// a non-zero digit if it isn't all zeros)
+#define DG__PARSE_FALLBACK_DIGITS 800
+
+// slow path for numbers the Eisel-Lemire algorithm can't handle: rebuilds the number in d
+// as "<digits>e<exponent>" without decimal point (so strtod() doesn't depend on the locale)
+// and parses that with strtod(), or strtof() if isFloat. d->w must not be 0
+static double DG__ParseFallback(const DG__ParsedDecimal* d, int isFloat, float* floatResult)
+{
+	char buf[DG__PARSE_FALLBACK_DIGITS + 32];
+	int numDigits = 0;
+	int sticky = 0; // set if non-zero digits were dropped
+	long long numIntDigits = 0; // digits before the '.'
+	long long numDigitsSeen = 0; // up to the last one in buf (incl. leading zeros)
+	int inFraction = 0;
+	for(const char* p = d->mantStart; p < d->mantEnd; ++p)
+	{
+		if(*p == '.')
+		{
+			inFraction = 1;
+			continue;
+		}
+		numIntDigits += !inFraction;
+		if(numDigits == 0 && *p == '0')
+		{
+			++numDigitsSeen; // skip leading zeros
+		}
+		else if(numDigits < DG__PARSE_FALLBACK_DIGITS)
+		{
+			buf[numDigits++] = *p;
+			++numDigitsSeen;
+		}
+		else
+		{
+			sticky |= (*p != '0');
+		}
+	}
+	if(sticky)
+	{
+		buf[numDigits++] = '1';
+		++numDigitsSeen;
+	}
+	// the last digit in buf is at 10^(numIntDigits - numDigitsSeen)
+	long long exp10 = numIntDigits - numDigitsSeen + d->explicitExp;
+	if(exp10 > DG__PARSE_MAX_EXP)  exp10 = DG__PARSE_MAX_EXP;
+	if(exp10 < -DG__PARSE_MAX_EXP)  exp10 = -DG__PARSE_MAX_EXP;
+	DG_snprintf(buf + numDigits, sizeof(buf) - numDigits, "e%d", (int)exp10);
+
+	if(isFloat)
+	{
+		*floatResult = strtof(buf, NULL);
+		return *floatResult;
+	}
+	return strtod(buf, NULL);
+}
+
+// parses "inf", "infinity", "nan" or "nan(...)" (case insensitive, maybe with leading '-')
+// from [p, end), sets *bits to the double (or float, if isFloat) and returns the end,
+// or NULL if it's something else
+static const char* DG__ParseInfNan(const char* p, const char* end, int isFloat, uint64_t* bits)
+{
+	int neg = (p < end && *p == '-');
+	p += neg;
+	int isNan;
+	if(end - p >= 3 && (p[0] | 0x20) == 'i' && (p[1] | 0x20) == 'n' && (p[2] | 0x20) == 'f')
+	{
+		isNan = 0;
+		p += 3;
+		static const char inity[] = "inity";
+		if(end - p >= 5)
+		{
+			int i = 0;
+			while(i < 5 && (p[i] | 0x20) == inity[i])  ++i;
+			if(i == 5)  p += 5;
+		}
+	}
+	else if(end - p >= 3 && (p[0] | 0x20) == 'n' && (p[1] | 0x20) == 'a' && (p[2] | 0x20) == 'n')
+	{
+		isNan = 1;
+		p += 3;
+		// optionally followed by (n-char-sequence)
+		if(p < end && *p == '(')
+		{
+			const char* c = p + 1;
+			while(c < end && (DG__DigitValue((unsigned char)*c) < 36 || *c == '_'))  ++c;
+			if(c < end && *c == ')')  p = c + 1;
+		}
+	}
+	else
+	{
+		return NULL;
+	}
+
+	if(isFloat)
+		*bits = (neg ? 0x80000000u : 0) | (isNan ? 0x7FC00000u : 0x7F800000u);
+	else
+		*bits = (neg ? 0x8000000000000000uLL : 0) | (isNan ? 0x7FF8000000000000uLL : 0x7FF0000000000000uLL);
+	return p;
+}
+
+// if the floating point math isn't done with more precision (like x87 does), small enough
+// numbers can be calculated exactly with a single multiplication or division (Clinger's fast path)
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  #define DG__PARSE_CLINGER
+#endif
+
+DG_MISC_DEF const char* DG_strtod(const char* str, size_t len, double* value, int* error)
+{
+	DG_MISC_ASSERT(value && (str || len == 0), "Don't pass NULL into DG_strtod()!");
+	int dummyError;
+	if(error == NULL)  error = &dummyError;
+	*error = DG_PARSE_INVALID;
+	if(len == 0)  return str;
+
+	const char* end = str + len;
+	uint64_t bits;
+	const char* p = DG__ParseInfNan(str, end, 0, &bits);
+	if(p != NULL)
+	{
+		memcpy(value, &bits, sizeof(bits));
+		*error = DG_PARSE_OK;
+		return p;
+	}
+
+	DG__ParsedDecimal d;
+	p = DG__ParseDecimal(str, end, &d);
+	if(p == NULL)  return str;
+
+	double v;
+	*error = DG_PARSE_OK;
+#ifdef DG__PARSE_CLINGER
+	// doubles can represent all integers up to 2^53 and powers of ten up to 10^22 exactly
+	static const double exactPow10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	if(!d.truncated && d.w <= (1uLL << 53) && d.exp10 >= -22 && d.exp10 <= 22)
+	{
+		v = (double)d.w;
+		v = (d.exp10 < 0) ? v / exactPow10[-d.exp10] : v * exactPow10[d.exp10];
+	}
+	else
+#endif
+	if(d.w == 0)
+	{
+		v = 0.0;
+	}
+	else
+	{
+		uint64_t bits2;
+		// if digits were cut off, the number is between w and w+1 (times 10^exp10),
+		// that's only good enough if both round to the same double
+		if(DG__EiselLemire(d.w, d.exp10, 52, 11, &bits)
+		   && (!d.truncated || (DG__EiselLemire(d.w + 1, d.exp10, 52, 11, &bits2) && bits == bits2)))
+		{
+			memcpy(&v, &bits, sizeof(v));
+		}
+		else
+		{
+			v = DG__ParseFallback(&d, 0, NULL);
+			if(v == 0.0 || v - v != 0.0) // 0 or inf
+				*error = DG_PARSE_RANGE;
+		}
+	}
+	*value = d.neg ? -v : v;
+	return p;
+}
+
+DG_MISC_DEF const char* DG_strtof(const char* str, size_t len, float* value, int* error)
+{
+	DG_MISC_ASSERT(value && (str || len == 0), "Don't pass NULL into DG_strtof()!");
+	int dummyError;
+	if(error == NULL)  error = &dummyError;
+	*error = DG_PARSE_INVALID;
+	if(len == 0)  return str;
+
+	const char* end = str + len;
+	uint64_t bits;
+	const char* p = DG__ParseInfNan(str, end, 1, &bits);
+	if(p != NULL)
+	{
+		uint32_t bits32 = (uint32_t)bits;
+		memcpy(value, &bits32, sizeof(bits32));
+		*error = DG_PARSE_OK;
+		return p;
+	}
+
+	DG__ParsedDecimal d;
+	p = DG__ParseDecimal(str, end, &d);
+	if(p == NULL)  return str;
+
+	float v;
+	*error = DG_PARSE_OK;
+#ifdef DG__PARSE_CLINGER
+	// floats can represent all integers up to 2^24 and powers of ten up to 10^10 exactly
+	static const float exactPow10[] = {
+		1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+	};
+	if(!d.truncated && d.w <= (1u << 24) && d.exp10 >= -10 && d.exp10 <= 10)
+	{
+		v = (float)d.w;
+		v = (d.exp10 < 0) ? v / exactPow10[-d.exp10] : v * exactPow10[d.exp10];
+	}
+	else
+#endif
+	if(d.w == 0)
+	{
+		v = 0.0f;
+	}
+	else
+	{
+		uint64_t bits2;
+		if(DG__EiselLemire(d.w, d.exp10, 23, 8, &bits)
+		   && (!d.truncated || (DG__EiselLemire(d.w + 1, d.exp10, 23, 8, &bits2) && bits == bits2)))
+		{
+			uint32_t bits32 = (uint32_t)bits;
+			memcpy(&v, &bits32, sizeof(v));
+		}
+		else
+		{
+			DG__ParseFallback(&d, 1, &v);
+			if(v == 0.0f || v - v != 0.0f)
+				*error = DG_PARSE_RANGE;
+		}
+	}
+	*value = d.neg ? -v : v;
+	return p;
+}
+
+// *** UTF-8 validation and UTF-8 <-> UTF-16 conversion ***
+
+// returns the length of the UTF-8 sequence at s (with rem >= 1 bytes left) if it's valid,
+// otherwise 0. the valid ranges are from table 3-7 in chapter 3.9 of the Unicode standard
+static size_t DG__Utf8SeqLen(const unsigned char* s, size_t rem)
+{
+	unsigned int c = s[0];
+	if(c < 0x80)  return 1;
+	if(c < 0xC2)  return 0; // continuation byte or overlong 2 byte sequence
+	if(c < 0xE0)  return (rem >= 2 && (s[1] & 0xC0) == 0x80) ? 2 : 0;
+	if(c < 0xF0)
+	{
+		if(rem < 3 || (s[2] & 0xC0) != 0x80)  return 0;
+		unsigned int lo = (c == 0xE0) ? 0xA0 : 0x80; // overlong
+		unsigned int hi = (c == 0xED) ? 0x9F : 0xBF; // surrogates
+		return (s[1] >= lo && s[1] <= hi) ? 3 : 0;
+	}
+	if(c < 0xF5)
+	{
+		if(rem < 4 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80)  return 0;
+		unsigned int lo = (c == 0xF0) ? 0x90 : 0x80; // overlong
+		unsigned int hi = (c == 0xF4) ? 0x8F : 0xBF; // > U+10FFFF
+		return (s[1] >= lo && s[1] <= hi) ? 4 : 0;
+	}
+	return 0;
+}
+
+// decodes the valid UTF-8 sequence of seqLen bytes at s
+static unsigned int DG__Utf8Decode(const unsigned char* s, size_t seqLen)
+{
+	switch(seqLen)
+	{
+		case 1: return s[0];
+		case 2: return ((s[0] & 0x1Fu) << 6) | (s[1] & 0x3Fu);
+		case 3: return ((s[0] & 0x0Fu) << 12) | ((s[1] & 0x3Fu) << 6) | (s[2] & 0x3Fu);
+		default: return ((s[0] & 0x07u) << 18) | ((s[1] & 0x3Fu) << 12) | ((s[2] & 0x3Fu) << 6) | (s[3] & 0x3Fu);
+	}
+}
+
+// the following functions return the number of ASCII chars at the start of s (up to n).
+// the *_to_utf16() and *_to_utf8() variants also copy them to dst (as UTF-16 or UTF-8)
+
+static size_t DG__utf8_ascii_len_swar(const unsigned char* s, size_t n)
+{
+	size_t i = 0;
+	for( ; n - i >= sizeof(uintptr_t); i += sizeof(uintptr_t))
+	{
+		uintptr_t w;
+		memcpy(&w, s + i, sizeof(w));
+		if(w & DG__MISC_MAGIC2)  break;
+	}
+	while(i < n && s[i] < 0x80)  ++i;
+	return i;
+}
+
+static size_t DG__utf8_ascii_to_utf16_swar(unsigned short* dst, const unsigned char* s, size_t n)
+{
+	size_t i = 0;
+	for( ; n - i >= sizeof(uintptr_t); i += sizeof(uintptr_t))
+	{
+		uintptr_t w;
+		memcpy(&w, s + i, sizeof(w));
+		if(w & DG__MISC_MAGIC2)  break;
+		for(size_t j=0; j < sizeof(uintptr_t); ++j)
+			dst[i+j] = s[i+j];
+	}
+	for( ; i < n && s[i] < 0x80; ++i)
+		dst[i] = s[i];
+	return i;
+}
+
+static size_t DG__utf16_ascii_to_utf8_swar(unsigned char* dst, const unsigned short* s, size_t n)
+{
+	size_t i = 0;
+	for( ; n - i >= 4; i += 4)
+	{
+		if((s[i] | s[i+1] | s[i+2] | s[i+3]) >= 0x80)  break;
+		dst[i] = (unsigned char)s[i];
+		dst[i+1] = (unsigned char)s[i+1];
+		dst[i+2] = (unsigned char)s[i+2];
+		dst[i+3] = (unsigned char)s[i+3];
+	}
+	for( ; i < n && s[i] < 0x80; ++i)
+		dst[i] = (unsigned char)s[i];
+	return i;
+}
+
+#ifdef DG__MISC_HAVE_SSE2
+
+static size_t DG__utf8_ascii_len_sse2(const unsigned char* s, size_t n)
+{
+	size_t i = 0;
+	for( ; n - i >= 16; i += 16)
+	{
+		// movemask returns the highest bit of each byte, it's set for non-ASCII chars
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(s + i)));
+		if(mask != 0)  return i + DG__LowestBitIdx(mask);
+	}
+	return i + DG__utf8_ascii_len_swar(s + i, n - i);
+}
+
+static size_t DG__utf8_ascii_to_utf16_sse2(unsigned short* dst, const unsigned char* s, size_t n)
+{
+	const __m128i zero = _mm_setzero_si128();
+	size_t i = 0;
+	for( ; n - i >= 16; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+		if(_mm_movemask_epi8(v) != 0)  break;
+		// interleaving with zeros turns the bytes into 16bit units
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(v, zero));
+		_mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+	}
+	return i + DG__utf8_ascii_to_utf16_swar(dst + i, s + i, n - i);
+}
+
+static size_t DG__utf16_ascii_to_utf8_sse2(unsigned char* dst, const unsigned short* s, size_t n)
+{
+	const __m128i nonAscii = _mm_set1_epi16((short)0xFF80);
+	const __m128i zero = _mm_setzero_si128();
+	size_t i = 0;
+	for( ; n - i >= 16; i += 16)
+	{
+		__m128i v0 = _mm_loadu_si128((const __m128i*)(s + i));
+		__m128i v1 = _mm_loadu_si128((const __m128i*)(s + i + 8));
+		__m128i high = _mm_and_si128(_mm_or_si128(v0, v1), nonAscii);
+		if(_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF)  break;
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(v0, v1));
+	}
+	return i + DG__utf16_ascii_to_utf8_swar(dst + i, s + i, n - i);
+}
+
+#endif // DG__MISC_HAVE_SSE2
+
+#ifdef DG__MISC_HAVE_AVX2
+
+DG__MISC_TARGET_AVX2
+static size_t DG__utf8_ascii_len_avx2(const unsigned char* s, size_t n)
+{
+	size_t i = 0;
+	for( ; n - i >= 32; i += 32)
+	{
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(s + i)));
+		if(mask != 0)  return i + DG__LowestBitIdx(mask);
+	}
+	return i + DG__utf8_ascii_len_sse2(s + i, n - i);
+}
+
+DG__MISC_TARGET_AVX2
+static size_t DG__utf8_ascii_to_utf16_avx2(unsigned short* dst, const unsigned char* s, size_t n)
+{
+	size_t i = 0;
+	for( ; n - i >= 32; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+		if(_mm256_movemask_epi8(v) != 0)  break;
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+		_mm256_storeu_si256((__m256i*)(dst + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+	}
+	return i + DG__utf8_ascii_to_utf16_sse2(dst + i, s + i, n - i);
+}
+
+DG__MISC_TARGET_AVX2
+static size_t DG__utf16_ascii_to_utf8_avx2(unsigned char* dst, const unsigned short* s, size_t n)
+{
+	const __m256i nonAscii = _mm256_set1_epi16((short)0xFF80);
+	size_t i = 0;
+	for( ; n - i >= 32; i += 32)
+	{
+		__m256i v0 = _mm256_loadu_si256((const __m256i*)(s + i));
+		__m256i v1 = _mm256_loadu_si256((const __m256i*)(s + i + 16));
+		if(!_mm256_testz_si256(_mm256_or_si256(v0, v1), nonAscii))  break;
+		// packus works per 128bit lane, so the 64bit blocks must be reordered afterwards
+		__m256i packed = _mm256_packus_epi16(v0, v1);
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_permute4x64_epi64(packed, 0xD8));
+	}
+	return i + DG__utf16_ascii_to_utf8_sse2(dst + i, s + i, n - i);
+}
+
+#endif // DG__MISC_HAVE_AVX2
+
+// these pick the implementation for the given SIMD level (DG__MISC_SIMD_*)
+
+static size_t DG__utf8_ascii_len(const unsigned char* s, size_t n, int simdLevel)
+{
+#ifdef DG__MISC_HAVE_AVX2
+	if(simdLevel >= DG__MISC_SIMD_AVX2)  return DG__utf8_ascii_len_avx2(s, n);
+#endif
+#ifdef DG__MISC_HAVE_SSE2
+	if(simdLevel >= DG__MISC_SIMD_SSE2)  return DG__utf8_ascii_len_sse2(s, n);
+#endif
+	(void)simdLevel;
+	return DG__utf8_ascii_len_swar(s, n);
+}
+
+static size_t DG__utf8_ascii_to_utf16(unsigned short* dst, const unsigned char* s, size_t n, int simdLevel)
+{
+#ifdef DG__MISC_HAVE_AVX2
+	if(simdLevel >= DG__MISC_SIMD_AVX2)  return DG__utf8_ascii_to_utf16_avx2(dst, s, n);
+#endif
+#ifdef DG__MISC_HAVE_SSE2
+	if(simdLevel >= DG__MISC_SIMD_SSE2)  return DG__utf8_ascii_to_utf16_sse2(dst, s, n);
+#endif
+	(void)simdLevel;
+	return DG__utf8_ascii_to_utf16_swar(dst, s, n);
+}
+
+static size_t DG__utf16_ascii_to_utf8(unsigned char* dst, const unsigned short* s, size_t n, int simdLevel)
+{
+#ifdef DG__MISC_HAVE_AVX2
+	if(simdLevel >= DG__MISC_SIMD_AVX2)  return DG__utf16_ascii_to_utf8_avx2(dst, s, n);
+#endif
+#ifdef DG__MISC_HAVE_SSE2
+	if(simdLevel >= DG__MISC_SIMD_SSE2)  return DG__utf16_ascii_to_utf8_sse2(dst, s, n);
+#endif
+	(void)simdLevel;
+	return DG__utf16_ascii_to_utf8_swar(dst, s, n);
+}
+
+// validates UTF-8 by skipping ASCII chars (with SIMD, if simdLevel allows)
+// and checking everything else one sequence at a time
+static size_t DG__utf8_validate_scalar(const unsigned char* s, size_t len, int simdLevel)
+{
+	size_t i = 0;
+	while(i < len)
+	{
+		if(s[i] < 0x80)
+		{
+			i += DG__utf8_ascii_len(s + i, len - i, simdLevel);
+			continue;
+		}
+		size_t seqLen = DG__Utf8SeqLen(s + i, len - i);
+		if(seqLen == 0)  return i;
+		i += seqLen;
+	}
+	return len;
+}
+
+#ifdef DG__MISC_HAVE_AVX2
+
+// for the tables in DG__utf8_validate_avx2(): the same 16 values in both 128bit lanes
+#define DG__UTF8_TABLE(a,b,c,d, e,f,g,h, i,j,k,l, m,n,o,p) _mm256_setr_epi8( \
+	(char)(a),(char)(b),(char)(c),(char)(d), (char)(e),(char)(f),(char)(g),(char)(h), \
+	(char)(i),(char)(j),(char)(k),(char)(l), (char)(m),(char)(n),(char)(o),(char)(p), \
+	(char)(a),(char)(b),(char)(c),(char)(d), (char)(e),(char)(f),(char)(g),(char)(h), \
+	(char)(i),(char)(j),(char)(k),(char)(l), (char)(m),(char)(n),(char)(o),(char)(p))
+
+// the error classes, each bit is a kind of error that's possible for a pair of bytes
+#define DG__UTF8_TOO_SHORT   (1 << 0) // lead byte (or ASCII) followed by lead byte or ASCII
+#define DG__UTF8_TOO_LONG    (1 << 1) // ASCII followed by continuation byte
+#define DG__UTF8_OVERLONG_3  (1 << 2) // 11100000 100_____
+#define DG__UTF8_TOO_LARGE   (1 << 3) // 11110100 1001____ and bigger
+#define DG__UTF8_SURROGATE   (1 << 4) // 11101101 101_____
+#define DG__UTF8_OVERLONG_2  (1 << 5) // 1100000_ 10______
+#define DG__UTF8_TOO_LARGE_1000 (1 << 6) // 11110101 1000____ and bigger
+#define DG__UTF8_OVERLONG_4  (1 << 6) // 11110000 1000____
+#define DG__UTF8_TWO_CONTS   (1 << 7) // two continuation bytes (only valid in 3/4 byte sequences)
+#define DG__UTF8_CARRY  (DG__UTF8_TOO_SHORT | DG__UTF8_TOO_LONG | DG__UTF8_TWO_CONTS)
+
+// validates 32 bytes at once with the "lookup" algorithm from "Validating UTF-8 In Less Than
+// One Instruction Per Byte" by John Keiser and Daniel Lemire (https://arxiv.org/abs/2010.03090):
+// each byte and the one before it are looked up in three tables (by the high nibble of the
+// previous byte, its low nibble and the high nibble of the current byte) that have a bit set
+// for each error class that pair of nibbles could be part of, ANDing the results only leaves
+// the bits of actual errors. Continuation bytes are checked against the lead bytes 2 and 3
+// bytes before them. The exact error position is found with the scalar code.
+DG__MISC_TARGET_AVX2 DG__MISC_MAYBE_UNUSED
+static size_t DG__utf8_validate_avx2(const unsigned char* s, size_t len)
+{
+	const __m256i byte1High = DG__UTF8_TABLE(
+		// 0_______ ________ (ASCII)
+		DG__UTF8_TOO_LONG, DG__UTF8_TOO_LONG, DG__UTF8_TOO_LONG, DG__UTF8_TOO_LONG,
+		DG__UTF8_TOO_LONG, DG__UTF8_TOO_LONG, DG__UTF8_TOO_LONG, DG__UTF8_TOO_LONG,
+		// 10______ ________ (continuation)
+		DG__UTF8_TWO_CONTS, DG__UTF8_TWO_CONTS, DG__UTF8_TWO_CONTS, DG__UTF8_TWO_CONTS,
+		// 1100____ ________ (2 byte lead)
+		DG__UTF8_TOO_SHORT | DG__UTF8_OVERLONG_2,
+		// 1101____ ________ (2 byte lead)
+		DG__UTF8_TOO_SHORT,
+		// 1110____ ________ (3 byte lead)
+		DG__UTF8_TOO_SHORT | DG__UTF8_OVERLONG_3 | DG__UTF8_SURROGATE,
+		// 1111____ ________ (4 byte lead)
+		DG__UTF8_TOO_SHORT | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000 | DG__UTF8_OVERLONG_4);
+	const __m256i byte1Low = DG__UTF8_TABLE(
+		// ____0000 ________
+		DG__UTF8_CARRY | DG__UTF8_OVERLONG_3 | DG__UTF8_OVERLONG_2 | DG__UTF8_OVERLONG_4,
+		// ____0001 ________
+		DG__UTF8_CARRY | DG__UTF8_OVERLONG_2,
+		// ____001_ ________
+		DG__UTF8_CARRY, DG__UTF8_CARRY,
+		// ____0100 ________
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE,
+		// ____0101 ________ to ____1100 ________
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		// ____1101 ________
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000 | DG__UTF8_SURROGATE,
+		// ____111_ ________
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000,
+		DG__UTF8_CARRY | DG__UTF8_TOO_LARGE | DG__UTF8_TOO_LARGE_1000);
+	const __m256i byte2High = DG__UTF8_TABLE(
+		// ________ 0_______ (ASCII)
+		DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT,
+		DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT,
+		// ________ 1000____
+		DG__UTF8_TOO_LONG | DG__UTF8_OVERLONG_2 | DG__UTF8_TWO_CONTS | DG__UTF8_OVERLONG_3
+		  | DG__UTF8_TOO_LARGE_1000 | DG__UTF8_OVERLONG_4,
+		// ________ 1001____
+		DG__UTF8_TOO_LONG | DG__UTF8_OVERLONG_2 | DG__UTF8_TWO_CONTS | DG__UTF8_OVERLONG_3 | DG__UTF8_TOO_LARGE,
+		// ________ 101_____
+		DG__UTF8_TOO_LONG | DG__UTF8_OVERLONG_2 | DG__UTF8_TWO_CONTS | DG__UTF8_SURROGATE | DG__UTF8_TOO_LARGE,
+		DG__UTF8_TOO_LONG | DG__UTF8_OVERLONG_2 | DG__UTF8_TWO_CONTS | DG__UTF8_SURROGATE | DG__UTF8_TOO_LARGE,
+		// ________ 11______ (lead byte)
+		DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT, DG__UTF8_TOO_SHORT);
+	const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+	// the last 3 bytes of a block must not start a sequence that's longer than the rest of the block
+	const __m256i maxLast = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	                                         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	                                         (char)(0xF0-1), (char)(0xE0-1), (char)(0xC0-1));
+
+	__m256i prev = _mm256_setzero_si256();
+	__m256i prevIncomplete = _mm256_setzero_si256();
+	size_t i = 0;
+	for( ; len - i >= 32; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+		__m256i err;
+		if(_mm256_movemask_epi8(v) == 0)
+		{
+			// only ASCII, that's only an error if the last block ended with an incomplete sequence
+			err = prevIncomplete;
+		}
+		else
+		{
+			// v shifted by 1, 2 and 3 bytes, with the last bytes of the previous block shifted in
+			__m256i prevHalf = _mm256_permute2x128_si256(prev, v, 0x21);
+			__m256i prev1 = _mm256_alignr_epi8(v, prevHalf, 15);
+			__m256i prev2 = _mm256_alignr_epi8(v, prevHalf, 14);
+			__m256i prev3 = _mm256_alignr_epi8(v, prevHalf, 13);
+
+			__m256i b1h = _mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble));
+			__m256i b1l = _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, lowNibble));
+			__m256i b2h = _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibble));
+			__m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+
+			// two continuation bytes in a row are only valid if they're the 3rd or 4th byte of a sequence.
+			// the saturating subtraction only leaves the highest bit set for 111_____ and 1111____
+			__m256i isThird = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+			__m256i isFourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+			__m256i must23 = _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8((char)0x80));
+			err = _mm256_xor_si256(must23, special);
+
+			prevIncomplete = _mm256_subs_epu8(v, maxLast);
+		}
+		if(!_mm256_testz_si256(err, err))  break;
+		prev = v;
+	}
+
+	// there's an error in the block at i, or i is in the incomplete last block (or at len).
+	// everything before it is valid, except maybe for a sequence that started in
+	// the last 3 bytes before i: continue with the scalar code at its start
+	size_t start = i;
+	for(size_t k=1; k <= 3 && k <= i; ++k)
+	{
+		unsigned int c = s[i-k];
+		if(c < 0x80)  break;
+		if(c >= 0xC0)
+		{
+			size_t leadLen = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : 2;
+			if(leadLen > k)  start = i - k;
+			break;
+		}
+	}
+	return start + DG__utf8_validate_scalar(s + start, len - start, DG__MISC_SIMD_SSE2);
+}
+
+#undef DG__UTF8_TABLE
+#undef DG__UTF8_TOO_SHORT
+#undef DG__UTF8_TOO_LONG
+#undef DG__UTF8_OVERLONG_3
+#undef DG__UTF8_TOO_LARGE
+#undef DG__UTF8_SURROGATE
+#undef DG__UTF8_OVERLONG_2
+#undef DG__UTF8_TOO_LARGE_1000
+#undef DG__UTF8_OVERLONG_4
+#undef DG__UTF8_TWO_CONTS
+#undef DG__UTF8_CARRY
+
+#endif // DG__MISC_HAVE_AVX2
+
+static size_t DG__utf8_validate_level(const unsigned char* s, size_t len, int simdLevel)
+{
+#ifdef DG__MISC_HAVE_AVX2
+	if(simdLevel >= DG__MISC_SIMD_AVX2)  return DG__utf8_validate_avx2(s, len);
+#endif
+	return DG__utf8_validate_scalar(s, len, simdLevel);
+}
+
+DG_MISC_DEF size_t DG_utf8_validate(const char* str, size_t len)
+{
+	DG_MISC_ASSERT(str != NULL || len == 0, "Don't pass NULL into DG_utf8_validate()!");
+	return DG__utf8_validate_level((const unsigned char*)str, len, DG__MISC_SIMD_LEVEL);
+}
+
+static size_t DG__utf8_to_utf16_level(unsigned short* dst, size_t dstLen, const unsigned char* s,
+                                      size_t srcLen, size_t* errorOffset, int simdLevel)
+{
+	// validating everything first (with SIMD) is faster than checking each sequence
+	// while converting, and then nothing is written for invalid input
+	size_t validLen = DG__utf8_validate_level(s, srcLen, simdLevel);
+	if(validLen != srcLen)
+	{
+		if(errorOffset != NULL)  *errorOffset = validLen;
+		return DG_UTF_INVALID;
+	}
+
+	size_t i = 0;
+	size_t outLen = 0;
+	while(i < srcLen && outLen < dstLen)
+	{
+		unsigned int c = s[i];
+		if(c < 0x80)
+		{
+			size_t n = srcLen - i;
+			if(n > dstLen - outLen)  n = dstLen - outLen;
+			n = DG__utf8_ascii_to_utf16(dst + outLen, s + i, n, simdLevel);
+			i += n;
+			outLen += n;
+		}
+		else if(c < 0xE0)
+		{
+			dst[outLen++] = (unsigned short)(((c & 0x1F) << 6) | (s[i+1] & 0x3F));
+			i += 2;
+		}
+		else if(c < 0xF0)
+		{
+			dst[outLen++] = (unsigned short)(((c & 0x0F) << 12) | ((s[i+1] & 0x3F) << 6) | (s[i+2] & 0x3F));
+			i += 3;
+		}
+		else
+		{
+			// needs a surrogate pair. if that doesn't fit, stop writing
+			if(dstLen - outLen < 2)  break;
+			unsigned int cp = DG__Utf8Decode(s + i, 4) - 0x10000;
+			dst[outLen] = (unsigned short)(0xD800 | (cp >> 10));
+			dst[outLen+1] = (unsigned short)(0xDC00 | (cp & 0x3FF));
+			outLen += 2;
+			i += 4;
+		}
+	}
+
+	// dst is full, count the rest: each sequence has exactly one byte that isn't
+	// a continuation byte, and 4 byte sequences need two UTF-16 units
+	for( ; i < srcLen; ++i)
+		outLen += ((s[i] & 0xC0) != 0x80) + (s[i] >= 0xF0);
+	return outLen;
+}
+
+static size_t DG__utf16_to_utf8_level(unsigned char* d, size_t dstLen, const unsigned short* src,
+                                      size_t srcLen, size_t* errorOffset, int simdLevel)
+{
+	// like in DG__utf8_to_utf16_level(), check for unpaired surrogates first,
+	// so nothing is written for invalid input
+	for(size_t j=0; j < srcLen; ++j)
+	{
+		unsigned int u = (unsigned int)src[j] - 0xD800;
+		if(u >= 0x800)  continue;
+		if(u >= 0x400 || srcLen - j < 2 || (unsigned int)src[j+1] - 0xDC00 >= 0x400)
+		{
+			if(errorOffset != NULL)  *errorOffset = j;
+			return DG_UTF_INVALID;
+		}
+		++j;
+	}
+
+	size_t i = 0;
+	size_t outLen = 0; // also counts the bytes that don't fit into dst anymore
+	while(i < srcLen)
+	{
+		unsigned int u = src[i];
+		if(u < 0x80 && outLen < dstLen)
+		{
+			size_t n = srcLen - i;
+			if(n > dstLen - outLen)  n = dstLen - outLen;
+			n = DG__utf16_ascii_to_utf8(d + outLen, src + i, n, simdLevel);
+			i += n;
+			outLen += n;
+			continue;
+		}
+
+		unsigned int cp = u;
+		size_t seqLen;
+		if(u < 0x80)
+		{
+			seqLen = 1;
+		}
+		else if(u < 0x800)
+		{
+			seqLen = 2;
+		}
+		else if(u - 0xD800 < 0x800) // surrogate pair, already validated above
+		{
+			cp = 0x10000 + ((u - 0xD800) << 10) + (src[i+1] - 0xDC00);
+			seqLen = 4;
+			++i;
+		}
+		else
+		{
+			seqLen = 3;
+		}
+		++i;
+
+		if(outLen < dstLen && dstLen - outLen >= seqLen)
+		{
+			unsigned char* o = d + outLen;
+			switch(seqLen)
+			{
+				case 1:
+					o[0] = (unsigned char)cp;
+					break;
+				case 2:
+					o[0] = (unsigned char)(0xC0 | (cp >> 6));
+					o[1] = (unsigned char)(0x80 | (cp & 0x3F));
+					break;
+				case 3:
+					o[0] = (unsigned char)(0xE0 | (cp >> 12));
+					o[1] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+					o[2] = (unsigned char)(0x80 | (cp & 0x3F));
+					break;
+				default:
+					o[0] = (unsigned char)(0xF0 | (cp >> 18));
+					o[1] = (unsigned char)(0x80 | ((cp >> 12) & 0x3F));
+					o[2] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+					o[3] = (unsigned char)(0x80 | (cp & 0x3F));
+			}
+		}
+		else if(outLen < dstLen)
+		{
+			dstLen = outLen; // doesn't fit, don't write anything anymore
+		}
+		outLen += seqLen;
+	}
+	return outLen;
+}
+
+DG_MISC_DEF size_t DG_utf8_to_utf16(unsigned short* dst, size_t dstLen,
+                                    const char* src, size_t srcLen, size_t* errorOffset)
+{
+	DG_MISC_ASSERT((src != NULL || srcLen == 0) && (dst != NULL || dstLen == 0),
+	               "Don't pass NULL into DG_utf8_to_utf16() (except for dst with dstLen 0)!");
+	return DG__utf8_to_utf16_level(dst, dstLen, (const unsigned char*)src, srcLen,
+	                               errorOffset, DG__MISC_SIMD_LEVEL);
+}
+
+DG_MISC_DEF size_t DG_utf16_to_utf8(char* dst, size_t dstLen,
+                                    const unsigned short* src, size_t srcLen, size_t* errorOffset)
+{
+	DG_MISC_ASSERT((src != NULL || srcLen == 0) && (dst != NULL || dstLen == 0),
+	               "Don't pass NULL into DG_utf16_to_utf8() (except for dst with dstLen 0)!");
+	return DG__utf16_to_utf8_level((unsigned char*)dst, dstLen, src, srcLen,
+	                               errorOffset, DG__MISC_SIMD_LEVEL);
+}
+
+// *** DG_hash64() (XXH3) and DG_crc32c() ***
+
+#define DG__XXH_PRIME32_1  0x9E3779B1u
+#define DG__XXH_PRIME32_2  0x85EBCA77u
+#define DG__XXH_PRIME32_3  0xC2B2AE3Du
+#define DG__XXH_PRIME64_1  0x9E3779B185EBCA87uLL
+#define DG__XXH_PRIME64_2  0xC2B2AE3D27D4EB4FuLL
+#define DG__XXH_PRIME64_3  0x165667B19E3779F9uLL
+#define DG__XXH_PRIME64_4  0x85EBCA77C2B2AE63uLL
+#define DG__XXH_PRIME64_5  0x27D4EB2F165667C5uLL
+
+// inputs up to this length are hashed without the accumulators
+#define DG__XXH3_MIDSIZE_MAX  240
+// the accumulators process the input in stripes of 64 bytes, each with the secret shifted
+// by another 8 bytes; after a block of 16 stripes they're scrambled
+#define DG__XXH3_STRIPE_LEN   64
+#define DG__XXH3_SECRET_SIZE  192
+#define DG__XXH3_BLOCK_STRIPES  ((DG__XXH3_SECRET_SIZE - DG__XXH3_STRIPE_LEN) / 8)
+#define DG__XXH3_BLOCK_LEN      (DG__XXH3_BLOCK_STRIPES * DG__XXH3_STRIPE_LEN)
+
+// the default secret of XXH3, with a seed its 64-bit words are modified
+static const unsigned char DG__xxh3Secret[DG__XXH3_SECRET_SIZE] = {
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// XXH3 is defined on little endian values, so these swap the bytes on big endian CPUs
+static unsigned long long DG__HashRead64(const unsigned char* p)
+{
+	unsigned long long v;
+	memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+static unsigned int DG__HashRead32(const unsigned char* p)
+{
+	unsigned int v;
+	memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	return v;
+}
+
+static unsigned long long DG__HashSwap64(unsigned long long v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_bswap64(v);
+#elif defined(_MSC_VER)
+	return _byteswap_uint64(v);
+#else
+	v = ((v & 0x00FF00FF00FF00FFuLL) << 8) | ((v >> 8) & 0x00FF00FF00FF00FFuLL);
+	v = ((v & 0x0000FFFF0000FFFFuLL) << 16) | ((v >> 16) & 0x0000FFFF0000FFFFuLL);
+	return (v << 32) | (v >> 32);
+#endif
+}
+
+static unsigned long long DG__HashRotl64(unsigned long long v, int r)
+{
+	return (v << r) | (v >> (64 - r));
+}
+
+// the 128-bit product of a and b, with its upper and lower 64 bits XORed
+static unsigned long long DG__HashMulFold64(unsigned long long a, unsigned long long b)
+{
+	uint64_t hi;
+	uint64_t lo = DG__Mul64x64(a, b, &hi);
+	return lo ^ hi;
+}
+
+static unsigned long long DG__XXH64Avalanche(unsigned long long h)
+{
+	h ^= h >> 33;
+	h *= DG__XXH_PRIME64_2;
+	h ^= h >> 29;
+	h *= DG__XXH_PRIME64_3;
+	h ^= h >> 32;
+	return h;
+}
+
+static unsigned long long DG__XXH3Avalanche(unsigned long long h)
+{
+	h ^= h >> 37;
+	h *= 0x165667919E3779F9uLL;
+	h ^= h >> 32;
+	return h;
+}
+
+static unsigned long long DG__XXH3Len0To16(const unsigned char* p, size_t len, unsigned long long seed)
+{
+	const unsigned char* secret = DG__xxh3Secret;
+	if(len > 8)
+	{
+		unsigned long long bitflip1 = (DG__HashRead64(secret + 24) ^ DG__HashRead64(secret + 32)) + seed;
+		unsigned long long bitflip2 = (DG__HashRead64(secret + 40) ^ DG__HashRead64(secret + 48)) - seed;
+		unsigned long long lo = DG__HashRead64(p) ^ bitflip1;
+		unsigned long long hi = DG__HashRead64(p + len - 8) ^ bitflip2;
+		unsigned long long acc = len + DG__HashSwap64(lo) + hi + DG__HashMulFold64(lo, hi);
+		return DG__XXH3Avalanche(acc);
+	}
+	if(len >= 4)
+	{
+		unsigned int seedLo = (unsigned int)seed;
+		seedLo = (seedLo >> 24) | ((seedLo >> 8) & 0xFF00u) | ((seedLo << 8) & 0xFF0000u) | (seedLo << 24);
+		seed ^= (unsigned long long)seedLo << 32;
+		unsigned long long bitflip = (DG__HashRead64(secret + 8) ^ DG__HashRead64(secret + 16)) - seed;
+		unsigned long long in64 = DG__HashRead32(p + len - 4) + ((unsigned long long)DG__HashRead32(p) << 32);
+		unsigned long long h = in64 ^ bitflip;
+		// "rrmxmx"
+		h ^= DG__HashRotl64(h, 49) ^ DG__HashRotl64(h, 24);
+		h *= 0x9FB21C651E98DF25uLL;
+		h ^= (h >> 35) + len;
+		h *= 0x9FB21C651E98DF25uLL;
+		return h ^ (h >> 28);
+	}
+	if(len > 0)
+	{
+		unsigned int combined = ((unsigned int)p[0] << 16) | ((unsigned int)p[len >> 1] << 24)
+		                        | (unsigned int)p[len - 1] | ((unsigned int)len << 8);
+		unsigned long long bitflip = (DG__HashRead32(secret) ^ DG__HashRead32(secret + 4)) + seed;
+		return DG__XXH64Avalanche(combined ^ bitflip);
+	}
+	return DG__XXH64Avalanche(seed ^ DG__HashRead64(secret + 56) ^ DG__HashRead64(secret + 64));
+}
+
+static unsigned long long DG__XXH3Mix16(const unsigned char* p, const unsigned char* secret,
+                                        unsigned long long seed)
+{
+	return DG__HashMulFold64(DG__HashRead64(p) ^ (DG__HashRead64(secret) + seed),
+	                         DG__HashRead64(p + 8) ^ (DG__HashRead64(secret + 8) - seed));
+}
+
+static unsigned long long DG__XXH3Len17To128(const unsigned char* p, size_t len, unsigned long long seed)
+{
+	const unsigned char* secret = DG__xxh3Secret;
+	unsigned long long acc = len * DG__XXH_PRIME64_1;
+	// pairs of 16 byte blocks from the start and the end, meeting in the middle
+	if(len > 32)
+	{
+		if(len > 64)
+		{
+			if(len > 96)
+			{
+				acc += DG__XXH3Mix16(p + 48, secret + 96, seed);
+				acc += DG__XXH3Mix16(p + len - 64, secret + 112, seed);
+			}
+			acc += DG__XXH3Mix16(p + 32, secret + 64, seed);
+			acc += DG__XXH3Mix16(p + len - 48, secret + 80, seed);
+		}
+		acc += DG__XXH3Mix16(p + 16, secret + 32, seed);
+		acc += DG__XXH3Mix16(p + len - 32, secret + 48, seed);
+	}
+	acc += DG__XXH3Mix16(p, secret, seed);
+	acc += DG__XXH3Mix16(p + len - 16, secret + 16, seed);
+	return DG__XXH3Avalanche(acc);
+}
+
+static unsigned long long DG__XXH3Len129To240(const unsigned char* p, size_t len, unsigned long long seed)
+{
+	const unsigned char* secret = DG__xxh3Secret;
+	unsigned long long acc = len * DG__XXH_PRIME64_1;
+	size_t numBlocks = len / 16;
+	size_t i;
+	for(i = 0; i < 8; ++i)
+		acc += DG__XXH3Mix16(p + 16*i, secret + 16*i, seed);
+	acc = DG__XXH3Avalanche(acc);
+	for(i = 8; i < numBlocks; ++i)
+		acc += DG__XXH3Mix16(p + 16*i, secret + 16*(i - 8) + 3, seed);
+	acc += DG__XXH3Mix16(p + len - 16, secret + 136 - 17, seed);
+	return DG__XXH3Avalanche(acc);
+}
+
+// for inputs longer than DG__XXH3_MIDSIZE_MAX: the secret is derived from the seed
+static void DG__XXH3InitSecret(unsigned char* secret, unsigned long long seed)
+{
+	int i;
+	for(i = 0; i < DG__XXH3_SECRET_SIZE; i += 16)
+	{
+		unsigned long long lo = DG__HashRead64(DG__xxh3Secret + i) + seed;
+		unsigned long long hi = DG__HashRead64(DG__xxh3Secret + i + 8) - seed;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		lo = __builtin_bswap64(lo);
+		hi = __builtin_bswap64(hi);
+#endif
+		memcpy(secret + i, &lo, 8);
+		memcpy(secret + i + 8, &hi, 8);
+	}
+}
+
+static void DG__XXH3InitAcc(unsigned long long* acc)
+{
+	acc[0] = DG__XXH_PRIME32_3;
+	acc[1] = DG__XXH_PRIME64_1;
+	acc[2] = DG__XXH_PRIME64_2;
+	acc[3] = DG__XXH_PRIME64_3;
+	acc[4] = DG__XXH_PRIME64_4;
+	acc[5] = DG__XXH_PRIME32_2;
+	acc[6] = DG__XXH_PRIME64_5;
+	acc[7] = DG__XXH_PRIME32_1;
+}
+
+// processes numStripes stripes of 64 bytes at p: each 64-bit word of a stripe is XORed with
+// the secret, the product of the lower and upper 32 bits of that is added to its accumulator
+// and the word itself to the neighbouring accumulator. the secret moves by 8 bytes per stripe
+static void DG__XXH3Accumulate_scalar(unsigned long long* acc, const unsigned char* p,
+                                      const unsigned char* secret, size_t numStripes)
+{
+	size_t s;
+	int i;
+	for(s = 0; s < numStripes; ++s, p += DG__XXH3_STRIPE_LEN, secret += 8)
+	{
+		for(i = 0; i < 8; ++i)
+		{
+			unsigned long long v = DG__HashRead64(p + 8*i);
+			unsigned long long vk = v ^ DG__HashRead64(secret + 8*i);
+			acc[i ^ 1] += v;
+			acc[i] += (vk & 0xFFFFFFFFu) * (vk >> 32);
+		}
+	}
+}
+
+// at the end of each block, so the accumulators don't just sum up the data
+static void DG__XXH3Scramble_scalar(unsigned long long* acc, const unsigned char* secret)
+{
+	int i;
+	for(i = 0; i < 8; ++i)
+	{
+		unsigned long long a = acc[i];
+		a ^= a >> 47;
+		a ^= DG__HashRead64(secret + 8*i);
+		acc[i] = a * DG__XXH_PRIME32_1;
+	}
+}
+
+#ifdef DG__MISC_HAVE_SSE2
+
+DG__MISC_MAYBE_UNUSED
+static void DG__XXH3Accumulate_sse2(unsigned long long* acc, const unsigned char* p,
+                                    const unsigned char* secret, size_t numStripes)
+{
+	__m128i a[4];
+	size_t s;
+	int i;
+	for(i = 0; i < 4; ++i)
+		a[i] = _mm_loadu_si128((const __m128i*)(acc + 2*i));
+	for(s = 0; s < numStripes; ++s, p += DG__XXH3_STRIPE_LEN, secret += 8)
+	{
+		for(i = 0; i < 4; ++i)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i*)(p + 16*i));
+			__m128i vk = _mm_xor_si128(v, _mm_loadu_si128((const __m128i*)(secret + 16*i)));
+			// _mm_mul_epu32() multiplies the lower 32 bits of each 64-bit lane
+			__m128i prod = _mm_mul_epu32(vk, _mm_shuffle_epi32(vk, _MM_SHUFFLE(0, 3, 0, 1)));
+			__m128i swapped = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+			a[i] = _mm_add_epi64(a[i], _mm_add_epi64(prod, swapped));
+		}
+	}
+	for(i = 0; i < 4; ++i)
+		_mm_storeu_si128((__m128i*)(acc + 2*i), a[i]);
+}
+
+DG__MISC_MAYBE_UNUSED
+static void DG__XXH3Scramble_sse2(unsigned long long* acc, const unsigned char* secret)
+{
+	const __m128i prime = _mm_set1_epi32((int)DG__XXH_PRIME32_1);
+	int i;
+	for(i = 0; i < 4; ++i)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i*)(acc + 2*i));
+		a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+		a = _mm_xor_si128(a, _mm_loadu_si128((const __m128i*)(secret + 16*i)));
+		// 64bit * 32bit multiplication: lo*prime + ((hi*prime) << 32)
+		__m128i prodLo = _mm_mul_epu32(a, prime);
+		__m128i prodHi = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+		a = _mm_add_epi64(prodLo, _mm_slli_epi64(prodHi, 32));
+		_mm_storeu_si128((__m128i*)(acc + 2*i), a);
+	}
+}
 
-/* Value of __STDC_VERSION__ macro for different C versions
- * (https://en.cppreference.com/w/c/preprocessor/replace#Predefined_macros)
- *
- * C23: 202311L
- * C17: 201710L
- * C11: 201112L
- * C99: 199901L
- * C95: 199409L
- * (C89 presumably doesn't have this defined)
- */
+#endif // DG__MISC_HAVE_SSE2
 
-/* Value of __cplusplus macro for different C++ versions
- * (https://en.cppreference.com/w/cpp/preprocessor/replace#Predefined_macros)
- * ! VisualC++ needs _MSVC_LANG instead, unless the /Zc:__cplusplus compiler option is set:
- * ! https://learn.microsoft.com/en-us/cpp/build/reference/zc-cplusplus
- *
- * C++23:    202302L
- * C++20:    202002L
- * C++17:    201703L
- * C++14:    201402L
- * C++11:    201103L
- * C++98/03: 199711L
- */
+#ifdef DG__MISC_HAVE_AVX2
 
-#ifndef DG_strlen // if it's not just a #define for regular strlen
+// like the SSE2 versions, with 256bit vectors
+DG__MISC_TARGET_AVX2 DG__MISC_MAYBE_UNUSED
+static void DG__XXH3Accumulate_avx2(unsigned long long* acc, const unsigned char* p,
+                                    const unsigned char* secret, size_t numStripes)
+{
+	__m256i a0 = _mm256_loadu_si256((const __m256i*)acc);
+	__m256i a1 = _mm256_loadu_si256((const __m256i*)(acc + 4));
+	size_t s;
+	for(s = 0; s < numStripes; ++s, p += DG__XXH3_STRIPE_LEN, secret += 8)
+	{
+		__m256i v0 = _mm256_loadu_si256((const __m256i*)p);
+		__m256i v1 = _mm256_loadu_si256((const __m256i*)(p + 32));
+		__m256i vk0 = _mm256_xor_si256(v0, _mm256_loadu_si256((const __m256i*)secret));
+		__m256i vk1 = _mm256_xor_si256(v1, _mm256_loadu_si256((const __m256i*)(secret + 32)));
+		__m256i prod0 = _mm256_mul_epu32(vk0, _mm256_shuffle_epi32(vk0, _MM_SHUFFLE(0, 3, 0, 1)));
+		__m256i prod1 = _mm256_mul_epu32(vk1, _mm256_shuffle_epi32(vk1, _MM_SHUFFLE(0, 3, 0, 1)));
+		a0 = _mm256_add_epi64(a0, _mm256_add_epi64(prod0, _mm256_shuffle_epi32(v0, _MM_SHUFFLE(1, 0, 3, 2))));
+		a1 = _mm256_add_epi64(a1, _mm256_add_epi64(prod1, _mm256_shuffle_epi32(v1, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+	_mm256_storeu_si256((__m256i*)acc, a0);
+	_mm256_storeu_si256((__m256i*)(acc + 4), a1);
+}
 
-DG_MISC_DEF size_t DG_strlen(const char* s)
+DG__MISC_TARGET_AVX2 DG__MISC_MAYBE_UNUSED
+static void DG__XXH3Scramble_avx2(unsigned long long* acc, const unsigned char* secret)
 {
-#ifdef DG_MISC_STRLEN_OVERREAD
-	// glibc's strlen() is *fucking* fast (with custom ASM), Apple also has custom ASM,
-	// freebsd uses the same trick as DG_strnlen() and is slightly faster...
-	// but Microsoft's strlen() (in some version I tested years ago)
-	// was slower than DG_strnlen(), so use this for Windows before VS2015..
-	// I don't feel like duplicating all that strnlen() code, so let's just pass
-	// the max. possible length, until almost the highest address a pointer can store.
-	// Only "almost" to avoid ugly integer wrapping when DG_strnlen() does something
-	// like for(const char* cur=s; cur<s+n; cur += sizeof(uintptr_t))
+	const __m256i prime = _mm256_set1_epi32((int)DG__XXH_PRIME32_1);
+	int i;
+	for(i = 0; i < 2; ++i)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i*)(acc + 4*i));
+		a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+		a = _mm256_xor_si256(a, _mm256_loadu_si256((const __m256i*)(secret + 32*i)));
+		__m256i prodLo = _mm256_mul_epu32(a, prime);
+		__m256i prodHi = _mm256_mul_epu32(_mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+		a = _mm256_add_epi64(prodLo, _mm256_slli_epi64(prodHi, 32));
+		_mm256_storeu_si256((__m256i*)(acc + 4*i), a);
+	}
+}
 
-	// the following might read up to sizeof(uintptr_t)-1 bytes past the end of the buffer
-	// (to read a full aligned uintptr_t). that *should* not hurt usually, but ASan hates it
-	static const uintptr_t maxaddr = ~((uintptr_t)0);
-	return DG_strnlen(s, maxaddr - (uintptr_t)s - sizeof(uintptr_t));
-#else
-	// if we're not allowed to read past the end of the buffer,
-	// there's no hope for optimizations - do the naive loop.
-	const char* cur = s;
-	while(*cur != '\0')
-		++cur;
-	return cur - s;
+#endif // DG__MISC_HAVE_AVX2
+
+static void DG__XXH3Accumulate(unsigned long long* acc, const unsigned char* p,
+                               const unsigned char* secret, size_t numStripes, int simdLevel)
+{
+#ifdef DG__MISC_HAVE_AVX2
+	if(simdLevel >= DG__MISC_SIMD_AVX2)  { DG__XXH3Accumulate_avx2(acc, p, secret, numStripes); return; }
 #endif
+#ifdef DG__MISC_HAVE_SSE2
+	if(simdLevel >= DG__MISC_SIMD_SSE2)  { DG__XXH3Accumulate_sse2(acc, p, secret, numStripes); return; }
+#endif
+	(void)simdLevel;
+	DG__XXH3Accumulate_scalar(acc, p, secret, numStripes);
 }
 
-#endif // DG_strlen
+static void DG__XXH3Scramble(unsigned long long* acc, const unsigned char* secret, int simdLevel)
+{
+#ifdef DG__MISC_HAVE_AVX2
+	if(simdLevel >= DG__MISC_SIMD_AVX2)  { DG__XXH3Scramble_avx2(acc, secret); return; }
+#endif
+#ifdef DG__MISC_HAVE_SSE2
+	if(simdLevel >= DG__MISC_SIMD_SSE2)  { DG__XXH3Scramble_sse2(acc, secret); return; }
+#endif
+	(void)simdLevel;
+	DG__XXH3Scramble_scalar(acc, secret);
+}
 
-#ifndef DG_vsnprintf // if it's not just a #define for regular vsnprintf
+// processes numStripes stripes at p, starting at stripe *stripesInBlock of the current
+// block, and scrambles at the end of each block
+static void DG__XXH3ConsumeStripes(unsigned long long* acc, unsigned int* stripesInBlock,
+                                   const unsigned char* p, size_t numStripes,
+                                   const unsigned char* secret, int simdLevel)
+{
+	size_t n = DG__XXH3_BLOCK_STRIPES - *stripesInBlock;
+	const unsigned char* blockSecret = secret + *stripesInBlock * 8;
+	while(numStripes >= n)
+	{
+		DG__XXH3Accumulate(acc, p, blockSecret, n, simdLevel);
+		DG__XXH3Scramble(acc, secret + DG__XXH3_SECRET_SIZE - DG__XXH3_STRIPE_LEN, simdLevel);
+		p += n * DG__XXH3_STRIPE_LEN;
+		numStripes -= n;
+		n = DG__XXH3_BLOCK_STRIPES;
+		blockSecret = secret;
+		*stripesInBlock = 0;
+	}
+	DG__XXH3Accumulate(acc, p, blockSecret, numStripes, simdLevel);
+	*stripesInBlock += (unsigned int)numStripes;
+}
 
-DG_MISC_DEF int DG_vsnprintf(char *dst, size_t size, const char *format, va_list ap)
+// processes the last stripe of the input (which may overlap with the previous one)
+// and merges the accumulators into the final hash
+static unsigned long long DG__XXH3Finish(unsigned long long* acc, const unsigned char* lastStripe,
+                                         const unsigned char* secret, unsigned long long totalLen,
+                                         int simdLevel)
 {
-	DG_MISC_ASSERT(format, "Don't pass a NULL format into DG_vsnprintf()!");
-	// TODO: assert(size <= INT_MAX && "Don't pass a size > INT_MAX to DG_vsnprintf()!"); ??
-	//       after all, we're supposed to return the number of bytes written.. as an int.
+	unsigned long long ret = totalLen * DG__XXH_PRIME64_1;
+	int i;
+	DG__XXH3Accumulate(acc, lastStripe, secret + DG__XXH3_SECRET_SIZE - DG__XXH3_STRIPE_LEN - 7, 1, simdLevel);
+	for(i = 0; i < 4; ++i)
+	{
+		ret += DG__HashMulFold64(acc[2*i] ^ DG__HashRead64(secret + 11 + 16*i),
+		                         acc[2*i + 1] ^ DG__HashRead64(secret + 11 + 16*i + 8));
+	}
+	return DG__XXH3Avalanche(ret);
+}
 
-	int ret = -1;
-	if(dst != NULL && size > 0)
+static unsigned long long DG__hash64_level(const unsigned char* p, size_t len,
+                                           unsigned long long seed, int simdLevel)
+{
+	if(len <= 16)  return DG__XXH3Len0To16(p, len, seed);
+	if(len <= 128)  return DG__XXH3Len17To128(p, len, seed);
+	if(len <= DG__XXH3_MIDSIZE_MAX)  return DG__XXH3Len129To240(p, len, seed);
 	{
-#if defined(_MSC_VER) && _MSC_VER >= 1400
-		// I think MSVC2005 introduced _vsnprintf_s().
-		// this shuts up _vsnprintf() security/deprecation warnings.
-		ret = _vsnprintf_s(dst, size, _TRUNCATE, format, ap);
-#else
-		ret = _vsnprintf(dst, size, format, ap);
-		dst[size-1] = '\0'; // ensure '\0'-termination
-#endif
+		unsigned long long acc[8];
+		unsigned char seededSecret[DG__XXH3_SECRET_SIZE];
+		const unsigned char* secret = DG__xxh3Secret;
+		unsigned int stripesInBlock = 0;
+		if(seed != 0)
+		{
+			DG__XXH3InitSecret(seededSecret, seed);
+			secret = seededSecret;
+		}
+		DG__XXH3InitAcc(acc);
+		// all stripes but the last one (which is processed by DG__XXH3Finish()), and
+		// if len is a multiple of the stripe length, the last block isn't scrambled
+		DG__XXH3ConsumeStripes(acc, &stripesInBlock, p, (len - 1) / DG__XXH3_STRIPE_LEN, secret, simdLevel);
+		return DG__XXH3Finish(acc, p + len - DG__XXH3_STRIPE_LEN, secret, len, simdLevel);
 	}
+}
 
-	if(ret == -1)
+DG_MISC_DEF unsigned long long DG_hash64(const void* data, size_t len, unsigned long long seed)
+{
+	DG_MISC_ASSERT(data != NULL || len == 0, "Don't pass NULL into DG_hash64()!");
+	return DG__hash64_level((const unsigned char*)data, len, seed, DG__MISC_SIMD_LEVEL);
+}
+
+DG_MISC_DEF void DG_Hash64_Init(DG_Hash64State* st, unsigned long long seed)
+{
+	DG_MISC_ASSERT(st != NULL, "Don't pass NULL into DG_Hash64_Init()!");
+	DG__XXH3InitAcc(st->acc);
+	DG__XXH3InitSecret(st->secret, seed);
+	st->totalLen = 0;
+	st->seed = seed;
+	st->bufferedSize = 0;
+	st->stripesInBlock = 0;
+}
+
+// the buffer always keeps at least one byte, and once more than DG__XXH3_MIDSIZE_MAX bytes
+// have been added, the last stripe is always in the buffer (at its end, if bufferedSize is
+// smaller than a stripe), because DG_Hash64_Final() has to process that one differently
+DG_MISC_DEF void DG_Hash64_Update(DG_Hash64State* st, const void* data, size_t len)
+{
+	const unsigned char* p = (const unsigned char*)data;
+	int simdLevel = DG__MISC_SIMD_LEVEL;
+	DG_MISC_ASSERT(st != NULL && (data != NULL || len == 0), "Don't pass NULL into DG_Hash64_Update()!");
+
+	st->totalLen += len;
+	if(len <= sizeof(st->buffer) - st->bufferedSize)
 	{
-		// _vsnprintf() returns -1 if the output is truncated
-		// it's also -1 if dst or size were NULL/0, so the user didn't want to write
-		// we want to return the number of characters that would've been
-		// needed, though.. fortunately _vscprintf() calculates that.
-		ret = _vscprintf(format, ap);
+		memcpy(st->buffer + st->bufferedSize, p, len);
+		st->bufferedSize += (unsigned int)len;
+		return;
+	}
+	if(st->bufferedSize > 0)
+	{
+		// fill up the buffer and process it
+		size_t n = sizeof(st->buffer) - st->bufferedSize;
+		memcpy(st->buffer + st->bufferedSize, p, n);
+		p += n;
+		len -= n;
+		DG__XXH3ConsumeStripes(st->acc, &st->stripesInBlock, st->buffer,
+		                       sizeof(st->buffer) / DG__XXH3_STRIPE_LEN, st->secret, simdLevel);
+		st->bufferedSize = 0;
+	}
+	if(len > sizeof(st->buffer))
+	{
+		// process the data directly, except for the last (maybe partial) stripe
+		size_t numStripes = (len - 1) / DG__XXH3_STRIPE_LEN;
+		DG__XXH3ConsumeStripes(st->acc, &st->stripesInBlock, p, numStripes, st->secret, simdLevel);
+		p += numStripes * DG__XXH3_STRIPE_LEN;
+		len -= numStripes * DG__XXH3_STRIPE_LEN;
+		memcpy(st->buffer + sizeof(st->buffer) - DG__XXH3_STRIPE_LEN, p - DG__XXH3_STRIPE_LEN, DG__XXH3_STRIPE_LEN);
+	}
+	memcpy(st->buffer, p, len);
+	st->bufferedSize = (unsigned int)len;
+}
 
-		// NOTE: on ancient MSVC versions you may get an error because
-		//  _vscprintf() is not supported.. I don't know when it started being
-		//  supported and I don't want to silently make this function incorrect
-		//  anyway.. feel free to comment out that line yourself, -1 will be
-		//  returned in case of a too short buffer then.
-		//  At least it'll still be '\0'-terminated.
+DG_MISC_DEF unsigned long long DG_Hash64_Final(const DG_Hash64State* st)
+{
+	unsigned long long acc[8];
+	unsigned char lastStripe[DG__XXH3_STRIPE_LEN];
+	const unsigned char* last = lastStripe;
+	unsigned int stripesInBlock;
+	int simdLevel = DG__MISC_SIMD_LEVEL;
+	DG_MISC_ASSERT(st != NULL, "Don't pass NULL into DG_Hash64_Final()!");
+
+	if(st->totalLen <= DG__XXH3_MIDSIZE_MAX) // then all the data is still in the buffer
+		return DG__hash64_level(st->buffer, (size_t)st->totalLen, st->seed, simdLevel);
+
+	memcpy(acc, st->acc, sizeof(acc));
+	stripesInBlock = st->stripesInBlock;
+	if(st->bufferedSize >= DG__XXH3_STRIPE_LEN)
+	{
+		DG__XXH3ConsumeStripes(acc, &stripesInBlock, st->buffer, (st->bufferedSize - 1) / DG__XXH3_STRIPE_LEN,
+		                       st->secret, simdLevel);
+		last = st->buffer + st->bufferedSize - DG__XXH3_STRIPE_LEN;
+	}
+	else
+	{
+		// the start of the last stripe is the end of previously processed data
+		size_t n = DG__XXH3_STRIPE_LEN - st->bufferedSize;
+		memcpy(lastStripe, st->buffer + sizeof(st->buffer) - n, n);
+		memcpy(lastStripe + n, st->buffer, st->bufferedSize);
+	}
+	return DG__XXH3Finish(acc, last, st->secret, st->totalLen, simdLevel);
+}
+
+// for the table-based CRC-32C: DG__crc32cTable[k][b] is the CRC of the byte b followed by k
+// zero bytes, so 8 bytes can be processed at once ("slicing-by-8").
+// Generated with (reversed polynomial 0x82F63B78):
+//   for(n=0; n<256; ++n) { c = n; for(i=0; i<8; ++i) c = (c & 1) ? (c >> 1) ^ 0x82F63B78 : c >> 1;
+//                          t[0][n] = c; }
+//   for(k=1; k<8; ++k) for(n=0; n<256; ++n) t[k][n] = (t[k-1][n] >> 8) ^ t[0][t[k-1][n] & 0xFF];
+static const unsigned int DG__crc32cTable[8][256] = {
+	{
+		0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C, 0x26A1E7E8, 0xD4CA64EB,
+		0x8AD958CF, 0x78B2DBCC, 0x6BE22838, 0x9989AB3B, 0x4D43CFD0, 0xBF284CD3, 0xAC78BF27, 0x5E133C24,
+		0x105EC76F, 0xE235446C, 0xF165B798, 0x030E349B, 0xD7C45070, 0x25AFD373, 0x36FF2087, 0xC494A384,
+		0x9A879FA0, 0x68EC1CA3, 0x7BBCEF57, 0x89D76C54, 0x5D1D08BF, 0xAF768BBC, 0xBC267848, 0x4E4DFB4B,
+		0x20BD8EDE, 0xD2D60DDD, 0xC186FE29, 0x33ED7D2A, 0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35,
+		0xAA64D611, 0x580F5512, 0x4B5FA6E6, 0xB93425E5, 0x6DFE410E, 0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA,
+		0x30E349B1, 0xC288CAB2, 0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD, 0x1642AE59, 0xE4292D5A,
+		0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A, 0x7DA08661, 0x8FCB0562, 0x9C9BF696, 0x6EF07595,
+		0x417B1DBC, 0xB3109EBF, 0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0, 0x67DAFA54, 0x95B17957,
+		0xCBA24573, 0x39C9C670, 0x2A993584, 0xD8F2B687, 0x0C38D26C, 0xFE53516F, 0xED03A29B, 0x1F682198,
+		0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927, 0x96BF4DCC, 0x64D4CECF, 0x77843D3B, 0x85EFBE38,
+		0xDBFC821C, 0x2997011F, 0x3AC7F2EB, 0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4, 0x0F36E6F7,
+		0x61C69362, 0x93AD1061, 0x80FDE395, 0x72966096, 0xA65C047D, 0x5437877E, 0x4767748A, 0xB50CF789,
+		0xEB1FCBAD, 0x197448AE, 0x0A24BB5A, 0xF84F3859, 0x2C855CB2, 0xDEEEDFB1, 0xCDBE2C45, 0x3FD5AF46,
+		0x7198540D, 0x83F3D70E, 0x90A324FA, 0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5, 0xA55230E6,
+		0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD, 0xCEB018DE, 0xDDE0EB2A, 0x2F8B6829,
+		0x82F63B78, 0x709DB87B, 0x63CD4B8F, 0x91A6C88C, 0x456CAC67, 0xB7072F64, 0xA457DC90, 0x563C5F93,
+		0x082F63B7, 0xFA44E0B4, 0xE9141340, 0x1B7F9043, 0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C,
+		0x92A8FC17, 0x60C37F14, 0x73938CE0, 0x81F80FE3, 0x55326B08, 0xA759E80B, 0xB4091BFF, 0x466298FC,
+		0x1871A4D8, 0xEA1A27DB, 0xF94AD42F, 0x0B21572C, 0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033,
+		0xA24BB5A6, 0x502036A5, 0x4370C551, 0xB11B4652, 0x65D122B9, 0x97BAA1BA, 0x84EA524E, 0x7681D14D,
+		0x2892ED69, 0xDAF96E6A, 0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975, 0x0E330A81, 0xFC588982,
+		0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D, 0x758FE5D6, 0x87E466D5, 0x94B49521, 0x66DF1622,
+		0x38CC2A06, 0xCAA7A905, 0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19, 0x0D3D3E1A, 0x1E6DCDEE, 0xEC064EED,
+		0xC38D26C4, 0x31E6A5C7, 0x22B65633, 0xD0DDD530, 0x0417B1DB, 0xF67C32D8, 0xE52CC12C, 0x1747422F,
+		0x49547E0B, 0xBB3FFD08, 0xA86F0EFC, 0x5A048DFF, 0x8ECEE914, 0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0,
+		0xD3D3E1AB, 0x21B862A8, 0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643, 0x07198540,
+		0x590AB964, 0xAB613A67, 0xB831C993, 0x4A5A4A90, 0x9E902E7B, 0x6CFBAD78, 0x7FAB5E8C, 0x8DC0DD8F,
+		0xE330A81A, 0x115B2B19, 0x020BD8ED, 0xF0605BEE, 0x24AA3F05, 0xD6C1BC06, 0xC5914FF2, 0x37FACCF1,
+		0x69E9F0D5, 0x9B8273D6, 0x88D28022, 0x7AB90321, 0xAE7367CA, 0x5C18E4C9, 0x4F48173D, 0xBD23943E,
+		0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A, 0xC69F7B69, 0xD5CF889D, 0x27A40B9E,
+		0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E, 0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351,
+	},
+	{
+		0x00000000, 0x13A29877, 0x274530EE, 0x34E7A899, 0x4E8A61DC, 0x5D28F9AB, 0x69CF5132, 0x7A6DC945,
+		0x9D14C3B8, 0x8EB65BCF, 0xBA51F356, 0xA9F36B21, 0xD39EA264, 0xC03C3A13, 0xF4DB928A, 0xE7790AFD,
+		0x3FC5F181, 0x2C6769F6, 0x1880C16F, 0x0B225918, 0x714F905D, 0x62ED082A, 0x560AA0B3, 0x45A838C4,
+		0xA2D13239, 0xB173AA4E, 0x859402D7, 0x96369AA0, 0xEC5B53E5, 0xFFF9CB92, 0xCB1E630B, 0xD8BCFB7C,
+		0x7F8BE302, 0x6C297B75, 0x58CED3EC, 0x4B6C4B9B, 0x310182DE, 0x22A31AA9, 0x1644B230, 0x05E62A47,
+		0xE29F20BA, 0xF13DB8CD, 0xC5DA1054, 0xD6788823, 0xAC154166, 0xBFB7D911, 0x8B507188, 0x98F2E9FF,
+		0x404E1283, 0x53EC8AF4, 0x670B226D, 0x74A9BA1A, 0x0EC4735F, 0x1D66EB28, 0x298143B1, 0x3A23DBC6,
+		0xDD5AD13B, 0xCEF8494C, 0xFA1FE1D5, 0xE9BD79A2, 0x93D0B0E7, 0x80722890, 0xB4958009, 0xA737187E,
+		0xFF17C604, 0xECB55E73, 0xD852F6EA, 0xCBF06E9D, 0xB19DA7D8, 0xA23F3FAF, 0x96D89736, 0x857A0F41,
+		0x620305BC, 0x71A19DCB, 0x45463552, 0x56E4AD25, 0x2C896460, 0x3F2BFC17, 0x0BCC548E, 0x186ECCF9,
+		0xC0D23785, 0xD370AFF2, 0xE797076B, 0xF4359F1C, 0x8E585659, 0x9DFACE2E, 0xA91D66B7, 0xBABFFEC0,
+		0x5DC6F43D, 0x4E646C4A, 0x7A83C4D3, 0x69215CA4, 0x134C95E1, 0x00EE0D96, 0x3409A50F, 0x27AB3D78,
+		0x809C2506, 0x933EBD71, 0xA7D915E8, 0xB47B8D9F, 0xCE1644DA, 0xDDB4DCAD, 0xE9537434, 0xFAF1EC43,
+		0x1D88E6BE, 0x0E2A7EC9, 0x3ACDD650, 0x296F4E27, 0x53028762, 0x40A01F15, 0x7447B78C, 0x67E52FFB,
+		0xBF59D487, 0xACFB4CF0, 0x981CE469, 0x8BBE7C1E, 0xF1D3B55B, 0xE2712D2C, 0xD69685B5, 0xC5341DC2,
+		0x224D173F, 0x31EF8F48, 0x050827D1, 0x16AABFA6, 0x6CC776E3, 0x7F65EE94, 0x4B82460D, 0x5820DE7A,
+		0xFBC3FAF9, 0xE861628E, 0xDC86CA17, 0xCF245260, 0xB5499B25, 0xA6EB0352, 0x920CABCB, 0x81AE33BC,
+		0x66D73941, 0x7575A136, 0x419209AF, 0x523091D8, 0x285D589D, 0x3BFFC0EA, 0x0F186873, 0x1CBAF004,
+		0xC4060B78, 0xD7A4930F, 0xE3433B96, 0xF0E1A3E1, 0x8A8C6AA4, 0x992EF2D3, 0xADC95A4A, 0xBE6BC23D,
+		0x5912C8C0, 0x4AB050B7, 0x7E57F82E, 0x6DF56059, 0x1798A91C, 0x043A316B, 0x30DD99F2, 0x237F0185,
+		0x844819FB, 0x97EA818C, 0xA30D2915, 0xB0AFB162, 0xCAC27827, 0xD960E050, 0xED8748C9, 0xFE25D0BE,
+		0x195CDA43, 0x0AFE4234, 0x3E19EAAD, 0x2DBB72DA, 0x57D6BB9F, 0x447423E8, 0x70938B71, 0x63311306,
+		0xBB8DE87A, 0xA82F700D, 0x9CC8D894, 0x8F6A40E3, 0xF50789A6, 0xE6A511D1, 0xD242B948, 0xC1E0213F,
+		0x26992BC2, 0x353BB3B5, 0x01DC1B2C, 0x127E835B, 0x68134A1E, 0x7BB1D269, 0x4F567AF0, 0x5CF4E287,
+		0x04D43CFD, 0x1776A48A, 0x23910C13, 0x30339464, 0x4A5E5D21, 0x59FCC556, 0x6D1B6DCF, 0x7EB9F5B8,
+		0x99C0FF45, 0x8A626732, 0xBE85CFAB, 0xAD2757DC, 0xD74A9E99, 0xC4E806EE, 0xF00FAE77, 0xE3AD3600,
+		0x3B11CD7C, 0x28B3550B, 0x1C54FD92, 0x0FF665E5, 0x759BACA0, 0x663934D7, 0x52DE9C4E, 0x417C0439,
+		0xA6050EC4, 0xB5A796B3, 0x81403E2A, 0x92E2A65D, 0xE88F6F18, 0xFB2DF76F, 0xCFCA5FF6, 0xDC68C781,
+		0x7B5FDFFF, 0x68FD4788, 0x5C1AEF11, 0x4FB87766, 0x35D5BE23, 0x26772654, 0x12908ECD, 0x013216BA,
+		0xE64B1C47, 0xF5E98430, 0xC10E2CA9, 0xD2ACB4DE, 0xA8C17D9B, 0xBB63E5EC, 0x8F844D75, 0x9C26D502,
+		0x449A2E7E, 0x5738B609, 0x63DF1E90, 0x707D86E7, 0x0A104FA2, 0x19B2D7D5, 0x2D557F4C, 0x3EF7E73B,
+		0xD98EEDC6, 0xCA2C75B1, 0xFECBDD28, 0xED69455F, 0x97048C1A, 0x84A6146D, 0xB041BCF4, 0xA3E32483,
+	},
+	{
+		0x00000000, 0xA541927E, 0x4F6F520D, 0xEA2EC073, 0x9EDEA41A, 0x3B9F3664, 0xD1B1F617, 0x74F06469,
+		0x38513EC5, 0x9D10ACBB, 0x773E6CC8, 0xD27FFEB6, 0xA68F9ADF, 0x03CE08A1, 0xE9E0C8D2, 0x4CA15AAC,
+		0x70A27D8A, 0xD5E3EFF4, 0x3FCD2F87, 0x9A8CBDF9, 0xEE7CD990, 0x4B3D4BEE, 0xA1138B9D, 0x045219E3,
+		0x48F3434F, 0xEDB2D131, 0x079C1142, 0xA2DD833C, 0xD62DE755, 0x736C752B, 0x9942B558, 0x3C032726,
+		0xE144FB14, 0x4405696A, 0xAE2BA919, 0x0B6A3B67, 0x7F9A5F0E, 0xDADBCD70, 0x30F50D03, 0x95B49F7D,
+		0xD915C5D1, 0x7C5457AF, 0x967A97DC, 0x333B05A2, 0x47CB61CB, 0xE28AF3B5, 0x08A433C6, 0xADE5A1B8,
+		0x91E6869E, 0x34A714E0, 0xDE89D493, 0x7BC846ED, 0x0F382284, 0xAA79B0FA, 0x40577089, 0xE516E2F7,
+		0xA9B7B85B, 0x0CF62A25, 0xE6D8EA56, 0x43997828, 0x37691C41, 0x92288E3F, 0x78064E4C, 0xDD47DC32,
+		0xC76580D9, 0x622412A7, 0x880AD2D4, 0x2D4B40AA, 0x59BB24C3, 0xFCFAB6BD, 0x16D476CE, 0xB395E4B0,
+		0xFF34BE1C, 0x5A752C62, 0xB05BEC11, 0x151A7E6F, 0x61EA1A06, 0xC4AB8878, 0x2E85480B, 0x8BC4DA75,
+		0xB7C7FD53, 0x12866F2D, 0xF8A8AF5E, 0x5DE93D20, 0x29195949, 0x8C58CB37, 0x66760B44, 0xC337993A,
+		0x8F96C396, 0x2AD751E8, 0xC0F9919B, 0x65B803E5, 0x1148678C, 0xB409F5F2, 0x5E273581, 0xFB66A7FF,
+		0x26217BCD, 0x8360E9B3, 0x694E29C0, 0xCC0FBBBE, 0xB8FFDFD7, 0x1DBE4DA9, 0xF7908DDA, 0x52D11FA4,
+		0x1E704508, 0xBB31D776, 0x511F1705, 0xF45E857B, 0x80AEE112, 0x25EF736C, 0xCFC1B31F, 0x6A802161,
+		0x56830647, 0xF3C29439, 0x19EC544A, 0xBCADC634, 0xC85DA25D, 0x6D1C3023, 0x8732F050, 0x2273622E,
+		0x6ED23882, 0xCB93AAFC, 0x21BD6A8F, 0x84FCF8F1, 0xF00C9C98, 0x554D0EE6, 0xBF63CE95, 0x1A225CEB,
+		0x8B277743, 0x2E66E53D, 0xC448254E, 0x6109B730, 0x15F9D359, 0xB0B84127, 0x5A968154, 0xFFD7132A,
+		0xB3764986, 0x1637DBF8, 0xFC191B8B, 0x595889F5, 0x2DA8ED9C, 0x88E97FE2, 0x62C7BF91, 0xC7862DEF,
+		0xFB850AC9, 0x5EC498B7, 0xB4EA58C4, 0x11ABCABA, 0x655BAED3, 0xC01A3CAD, 0x2A34FCDE, 0x8F756EA0,
+		0xC3D4340C, 0x6695A672, 0x8CBB6601, 0x29FAF47F, 0x5D0A9016, 0xF84B0268, 0x1265C21B, 0xB7245065,
+		0x6A638C57, 0xCF221E29, 0x250CDE5A, 0x804D4C24, 0xF4BD284D, 0x51FCBA33, 0xBBD27A40, 0x1E93E83E,
+		0x5232B292, 0xF77320EC, 0x1D5DE09F, 0xB81C72E1, 0xCCEC1688, 0x69AD84F6, 0x83834485, 0x26C2D6FB,
+		0x1AC1F1DD, 0xBF8063A3, 0x55AEA3D0, 0xF0EF31AE, 0x841F55C7, 0x215EC7B9, 0xCB7007CA, 0x6E3195B4,
+		0x2290CF18, 0x87D15D66, 0x6DFF9D15, 0xC8BE0F6B, 0xBC4E6B02, 0x190FF97C, 0xF321390F, 0x5660AB71,
+		0x4C42F79A, 0xE90365E4, 0x032DA597, 0xA66C37E9, 0xD29C5380, 0x77DDC1FE, 0x9DF3018D, 0x38B293F3,
+		0x7413C95F, 0xD1525B21, 0x3B7C9B52, 0x9E3D092C, 0xEACD6D45, 0x4F8CFF3B, 0xA5A23F48, 0x00E3AD36,
+		0x3CE08A10, 0x99A1186E, 0x738FD81D, 0xD6CE4A63, 0xA23E2E0A, 0x077FBC74, 0xED517C07, 0x4810EE79,
+		0x04B1B4D5, 0xA1F026AB, 0x4BDEE6D8, 0xEE9F74A6, 0x9A6F10CF, 0x3F2E82B1, 0xD50042C2, 0x7041D0BC,
+		0xAD060C8E, 0x08479EF0, 0xE2695E83, 0x4728CCFD, 0x33D8A894, 0x96993AEA, 0x7CB7FA99, 0xD9F668E7,
+		0x9557324B, 0x3016A035, 0xDA386046, 0x7F79F238, 0x0B899651, 0xAEC8042F, 0x44E6C45C, 0xE1A75622,
+		0xDDA47104, 0x78E5E37A, 0x92CB2309, 0x378AB177, 0x437AD51E, 0xE63B4760, 0x0C158713, 0xA954156D,
+		0xE5F54FC1, 0x40B4DDBF, 0xAA9A1DCC, 0x0FDB8FB2, 0x7B2BEBDB, 0xDE6A79A5, 0x3444B9D6, 0x91052BA8,
+	},
+	{
+		0x00000000, 0xDD45AAB8, 0xBF672381, 0x62228939, 0x7B2231F3, 0xA6679B4B, 0xC4451272, 0x1900B8CA,
+		0xF64463E6, 0x2B01C95E, 0x49234067, 0x9466EADF, 0x8D665215, 0x5023F8AD, 0x32017194, 0xEF44DB2C,
+		0xE964B13D, 0x34211B85, 0x560392BC, 0x8B463804, 0x924680CE, 0x4F032A76, 0x2D21A34F, 0xF06409F7,
+		0x1F20D2DB, 0xC2657863, 0xA047F15A, 0x7D025BE2, 0x6402E328, 0xB9474990, 0xDB65C0A9, 0x06206A11,
+		0xD725148B, 0x0A60BE33, 0x6842370A, 0xB5079DB2, 0xAC072578, 0x71428FC0, 0x136006F9, 0xCE25AC41,
+		0x2161776D, 0xFC24DDD5, 0x9E0654EC, 0x4343FE54, 0x5A43469E, 0x8706EC26, 0xE524651F, 0x3861CFA7,
+		0x3E41A5B6, 0xE3040F0E, 0x81268637, 0x5C632C8F, 0x45639445, 0x98263EFD, 0xFA04B7C4, 0x27411D7C,
+		0xC805C650, 0x15406CE8, 0x7762E5D1, 0xAA274F69, 0xB327F7A3, 0x6E625D1B, 0x0C40D422, 0xD1057E9A,
+		0xABA65FE7, 0x76E3F55F, 0x14C17C66, 0xC984D6DE, 0xD0846E14, 0x0DC1C4AC, 0x6FE34D95, 0xB2A6E72D,
+		0x5DE23C01, 0x80A796B9, 0xE2851F80, 0x3FC0B538, 0x26C00DF2, 0xFB85A74A, 0x99A72E73, 0x44E284CB,
+		0x42C2EEDA, 0x9F874462, 0xFDA5CD5B, 0x20E067E3, 0x39E0DF29, 0xE4A57591, 0x8687FCA8, 0x5BC25610,
+		0xB4868D3C, 0x69C32784, 0x0BE1AEBD, 0xD6A40405, 0xCFA4BCCF, 0x12E11677, 0x70C39F4E, 0xAD8635F6,
+		0x7C834B6C, 0xA1C6E1D4, 0xC3E468ED, 0x1EA1C255, 0x07A17A9F, 0xDAE4D027, 0xB8C6591E, 0x6583F3A6,
+		0x8AC7288A, 0x57828232, 0x35A00B0B, 0xE8E5A1B3, 0xF1E51979, 0x2CA0B3C1, 0x4E823AF8, 0x93C79040,
+		0x95E7FA51, 0x48A250E9, 0x2A80D9D0, 0xF7C57368, 0xEEC5CBA2, 0x3380611A, 0x51A2E823, 0x8CE7429B,
+		0x63A399B7, 0xBEE6330F, 0xDCC4BA36, 0x0181108E, 0x1881A844, 0xC5C402FC, 0xA7E68BC5, 0x7AA3217D,
+		0x52A0C93F, 0x8FE56387, 0xEDC7EABE, 0x30824006, 0x2982F8CC, 0xF4C75274, 0x96E5DB4D, 0x4BA071F5,
+		0xA4E4AAD9, 0x79A10061, 0x1B838958, 0xC6C623E0, 0xDFC69B2A, 0x02833192, 0x60A1B8AB, 0xBDE41213,
+		0xBBC47802, 0x6681D2BA, 0x04A35B83, 0xD9E6F13B, 0xC0E649F1, 0x1DA3E349, 0x7F816A70, 0xA2C4C0C8,
+		0x4D801BE4, 0x90C5B15C, 0xF2E73865, 0x2FA292DD, 0x36A22A17, 0xEBE780AF, 0x89C50996, 0x5480A32E,
+		0x8585DDB4, 0x58C0770C, 0x3AE2FE35, 0xE7A7548D, 0xFEA7EC47, 0x23E246FF, 0x41C0CFC6, 0x9C85657E,
+		0x73C1BE52, 0xAE8414EA, 0xCCA69DD3, 0x11E3376B, 0x08E38FA1, 0xD5A62519, 0xB784AC20, 0x6AC10698,
+		0x6CE16C89, 0xB1A4C631, 0xD3864F08, 0x0EC3E5B0, 0x17C35D7A, 0xCA86F7C2, 0xA8A47EFB, 0x75E1D443,
+		0x9AA50F6F, 0x47E0A5D7, 0x25C22CEE, 0xF8878656, 0xE1873E9C, 0x3CC29424, 0x5EE01D1D, 0x83A5B7A5,
+		0xF90696D8, 0x24433C60, 0x4661B559, 0x9B241FE1, 0x8224A72B, 0x5F610D93, 0x3D4384AA, 0xE0062E12,
+		0x0F42F53E, 0xD2075F86, 0xB025D6BF, 0x6D607C07, 0x7460C4CD, 0xA9256E75, 0xCB07E74C, 0x16424DF4,
+		0x106227E5, 0xCD278D5D, 0xAF050464, 0x7240AEDC, 0x6B401616, 0xB605BCAE, 0xD4273597, 0x09629F2F,
+		0xE6264403, 0x3B63EEBB, 0x59416782, 0x8404CD3A, 0x9D0475F0, 0x4041DF48, 0x22635671, 0xFF26FCC9,
+		0x2E238253, 0xF36628EB, 0x9144A1D2, 0x4C010B6A, 0x5501B3A0, 0x88441918, 0xEA669021, 0x37233A99,
+		0xD867E1B5, 0x05224B0D, 0x6700C234, 0xBA45688C, 0xA345D046, 0x7E007AFE, 0x1C22F3C7, 0xC167597F,
+		0xC747336E, 0x1A0299D6, 0x782010EF, 0xA565BA57, 0xBC65029D, 0x6120A825, 0x0302211C, 0xDE478BA4,
+		0x31035088, 0xEC46FA30, 0x8E647309, 0x5321D9B1, 0x4A21617B, 0x9764CBC3, 0xF54642FA, 0x2803E842,
+	},
+	{
+		0x00000000, 0x38116FAC, 0x7022DF58, 0x4833B0F4, 0xE045BEB0, 0xD854D11C, 0x906761E8, 0xA8760E44,
+		0xC5670B91, 0xFD76643D, 0xB545D4C9, 0x8D54BB65, 0x2522B521, 0x1D33DA8D, 0x55006A79, 0x6D1105D5,
+		0x8F2261D3, 0xB7330E7F, 0xFF00BE8B, 0xC711D127, 0x6F67DF63, 0x5776B0CF, 0x1F45003B, 0x27546F97,
+		0x4A456A42, 0x725405EE, 0x3A67B51A, 0x0276DAB6, 0xAA00D4F2, 0x9211BB5E, 0xDA220BAA, 0xE2336406,
+		0x1BA8B557, 0x23B9DAFB, 0x6B8A6A0F, 0x539B05A3, 0xFBED0BE7, 0xC3FC644B, 0x8BCFD4BF, 0xB3DEBB13,
+		0xDECFBEC6, 0xE6DED16A, 0xAEED619E, 0x96FC0E32, 0x3E8A0076, 0x069B6FDA, 0x4EA8DF2E, 0x76B9B082,
+		0x948AD484, 0xAC9BBB28, 0xE4A80BDC, 0xDCB96470, 0x74CF6A34, 0x4CDE0598, 0x04EDB56C, 0x3CFCDAC0,
+		0x51EDDF15, 0x69FCB0B9, 0x21CF004D, 0x19DE6FE1, 0xB1A861A5, 0x89B90E09, 0xC18ABEFD, 0xF99BD151,
+		0x37516AAE, 0x0F400502, 0x4773B5F6, 0x7F62DA5A, 0xD714D41E, 0xEF05BBB2, 0xA7360B46, 0x9F2764EA,
+		0xF236613F, 0xCA270E93, 0x8214BE67, 0xBA05D1CB, 0x1273DF8F, 0x2A62B023, 0x625100D7, 0x5A406F7B,
+		0xB8730B7D, 0x806264D1, 0xC851D425, 0xF040BB89, 0x5836B5CD, 0x6027DA61, 0x28146A95, 0x10050539,
+		0x7D1400EC, 0x45056F40, 0x0D36DFB4, 0x3527B018, 0x9D51BE5C, 0xA540D1F0, 0xED736104, 0xD5620EA8,
+		0x2CF9DFF9, 0x14E8B055, 0x5CDB00A1, 0x64CA6F0D, 0xCCBC6149, 0xF4AD0EE5, 0xBC9EBE11, 0x848FD1BD,
+		0xE99ED468, 0xD18FBBC4, 0x99BC0B30, 0xA1AD649C, 0x09DB6AD8, 0x31CA0574, 0x79F9B580, 0x41E8DA2C,
+		0xA3DBBE2A, 0x9BCAD186, 0xD3F96172, 0xEBE80EDE, 0x439E009A, 0x7B8F6F36, 0x33BCDFC2, 0x0BADB06E,
+		0x66BCB5BB, 0x5EADDA17, 0x169E6AE3, 0x2E8F054F, 0x86F90B0B, 0xBEE864A7, 0xF6DBD453, 0xCECABBFF,
+		0x6EA2D55C, 0x56B3BAF0, 0x1E800A04, 0x269165A8, 0x8EE76BEC, 0xB6F60440, 0xFEC5B4B4, 0xC6D4DB18,
+		0xABC5DECD, 0x93D4B161, 0xDBE70195, 0xE3F66E39, 0x4B80607D, 0x73910FD1, 0x3BA2BF25, 0x03B3D089,
+		0xE180B48F, 0xD991DB23, 0x91A26BD7, 0xA9B3047B, 0x01C50A3F, 0x39D46593, 0x71E7D567, 0x49F6BACB,
+		0x24E7BF1E, 0x1CF6D0B2, 0x54C56046, 0x6CD40FEA, 0xC4A201AE, 0xFCB36E02, 0xB480DEF6, 0x8C91B15A,
+		0x750A600B, 0x4D1B0FA7, 0x0528BF53, 0x3D39D0FF, 0x954FDEBB, 0xAD5EB117, 0xE56D01E3, 0xDD7C6E4F,
+		0xB06D6B9A, 0x887C0436, 0xC04FB4C2, 0xF85EDB6E, 0x5028D52A, 0x6839BA86, 0x200A0A72, 0x181B65DE,
+		0xFA2801D8, 0xC2396E74, 0x8A0ADE80, 0xB21BB12C, 0x1A6DBF68, 0x227CD0C4, 0x6A4F6030, 0x525E0F9C,
+		0x3F4F0A49, 0x075E65E5, 0x4F6DD511, 0x777CBABD, 0xDF0AB4F9, 0xE71BDB55, 0xAF286BA1, 0x9739040D,
+		0x59F3BFF2, 0x61E2D05E, 0x29D160AA, 0x11C00F06, 0xB9B60142, 0x81A76EEE, 0xC994DE1A, 0xF185B1B6,
+		0x9C94B463, 0xA485DBCF, 0xECB66B3B, 0xD4A70497, 0x7CD10AD3, 0x44C0657F, 0x0CF3D58B, 0x34E2BA27,
+		0xD6D1DE21, 0xEEC0B18D, 0xA6F30179, 0x9EE26ED5, 0x36946091, 0x0E850F3D, 0x46B6BFC9, 0x7EA7D065,
+		0x13B6D5B0, 0x2BA7BA1C, 0x63940AE8, 0x5B856544, 0xF3F36B00, 0xCBE204AC, 0x83D1B458, 0xBBC0DBF4,
+		0x425B0AA5, 0x7A4A6509, 0x3279D5FD, 0x0A68BA51, 0xA21EB415, 0x9A0FDBB9, 0xD23C6B4D, 0xEA2D04E1,
+		0x873C0134, 0xBF2D6E98, 0xF71EDE6C, 0xCF0FB1C0, 0x6779BF84, 0x5F68D028, 0x175B60DC, 0x2F4A0F70,
+		0xCD796B76, 0xF56804DA, 0xBD5BB42E, 0x854ADB82, 0x2D3CD5C6, 0x152DBA6A, 0x5D1E0A9E, 0x650F6532,
+		0x081E60E7, 0x300F0F4B, 0x783CBFBF, 0x402DD013, 0xE85BDE57, 0xD04AB1FB, 0x9879010F, 0xA0686EA3,
+	},
+	{
+		0x00000000, 0xEF306B19, 0xDB8CA0C3, 0x34BCCBDA, 0xB2F53777, 0x5DC55C6E, 0x697997B4, 0x8649FCAD,
+		0x6006181F, 0x8F367306, 0xBB8AB8DC, 0x54BAD3C5, 0xD2F32F68, 0x3DC34471, 0x097F8FAB, 0xE64FE4B2,
+		0xC00C303E, 0x2F3C5B27, 0x1B8090FD, 0xF4B0FBE4, 0x72F90749, 0x9DC96C50, 0xA975A78A, 0x4645CC93,
+		0xA00A2821, 0x4F3A4338, 0x7B8688E2, 0x94B6E3FB, 0x12FF1F56, 0xFDCF744F, 0xC973BF95, 0x2643D48C,
+		0x85F4168D, 0x6AC47D94, 0x5E78B64E, 0xB148DD57, 0x370121FA, 0xD8314AE3, 0xEC8D8139, 0x03BDEA20,
+		0xE5F20E92, 0x0AC2658B, 0x3E7EAE51, 0xD14EC548, 0x570739E5, 0xB83752FC, 0x8C8B9926, 0x63BBF23F,
+		0x45F826B3, 0xAAC84DAA, 0x9E748670, 0x7144ED69, 0xF70D11C4, 0x183D7ADD, 0x2C81B107, 0xC3B1DA1E,
+		0x25FE3EAC, 0xCACE55B5, 0xFE729E6F, 0x1142F576, 0x970B09DB, 0x783B62C2, 0x4C87A918, 0xA3B7C201,
+		0x0E045BEB, 0xE13430F2, 0xD588FB28, 0x3AB89031, 0xBCF16C9C, 0x53C10785, 0x677DCC5F, 0x884DA746,
+		0x6E0243F4, 0x813228ED, 0xB58EE337, 0x5ABE882E, 0xDCF77483, 0x33C71F9A, 0x077BD440, 0xE84BBF59,
+		0xCE086BD5, 0x213800CC, 0x1584CB16, 0xFAB4A00F, 0x7CFD5CA2, 0x93CD37BB, 0xA771FC61, 0x48419778,
+		0xAE0E73CA, 0x413E18D3, 0x7582D309, 0x9AB2B810, 0x1CFB44BD, 0xF3CB2FA4, 0xC777E47E, 0x28478F67,
+		0x8BF04D66, 0x64C0267F, 0x507CEDA5, 0xBF4C86BC, 0x39057A11, 0xD6351108, 0xE289DAD2, 0x0DB9B1CB,
+		0xEBF65579, 0x04C63E60, 0x307AF5BA, 0xDF4A9EA3, 0x5903620E, 0xB6330917, 0x828FC2CD, 0x6DBFA9D4,
+		0x4BFC7D58, 0xA4CC1641, 0x9070DD9B, 0x7F40B682, 0xF9094A2F, 0x16392136, 0x2285EAEC, 0xCDB581F5,
+		0x2BFA6547, 0xC4CA0E5E, 0xF076C584, 0x1F46AE9D, 0x990F5230, 0x763F3929, 0x4283F2F3, 0xADB399EA,
+		0x1C08B7D6, 0xF338DCCF, 0xC7841715, 0x28B47C0C, 0xAEFD80A1, 0x41CDEBB8, 0x75712062, 0x9A414B7B,
+		0x7C0EAFC9, 0x933EC4D0, 0xA7820F0A, 0x48B26413, 0xCEFB98BE, 0x21CBF3A7, 0x1577387D, 0xFA475364,
+		0xDC0487E8, 0x3334ECF1, 0x0788272B, 0xE8B84C32, 0x6EF1B09F, 0x81C1DB86, 0xB57D105C, 0x5A4D7B45,
+		0xBC029FF7, 0x5332F4EE, 0x678E3F34, 0x88BE542D, 0x0EF7A880, 0xE1C7C399, 0xD57B0843, 0x3A4B635A,
+		0x99FCA15B, 0x76CCCA42, 0x42700198, 0xAD406A81, 0x2B09962C, 0xC439FD35, 0xF08536EF, 0x1FB55DF6,
+		0xF9FAB944, 0x16CAD25D, 0x22761987, 0xCD46729E, 0x4B0F8E33, 0xA43FE52A, 0x90832EF0, 0x7FB345E9,
+		0x59F09165, 0xB6C0FA7C, 0x827C31A6, 0x6D4C5ABF, 0xEB05A612, 0x0435CD0B, 0x308906D1, 0xDFB96DC8,
+		0x39F6897A, 0xD6C6E263, 0xE27A29B9, 0x0D4A42A0, 0x8B03BE0D, 0x6433D514, 0x508F1ECE, 0xBFBF75D7,
+		0x120CEC3D, 0xFD3C8724, 0xC9804CFE, 0x26B027E7, 0xA0F9DB4A, 0x4FC9B053, 0x7B757B89, 0x94451090,
+		0x720AF422, 0x9D3A9F3B, 0xA98654E1, 0x46B63FF8, 0xC0FFC355, 0x2FCFA84C, 0x1B736396, 0xF443088F,
+		0xD200DC03, 0x3D30B71A, 0x098C7CC0, 0xE6BC17D9, 0x60F5EB74, 0x8FC5806D, 0xBB794BB7, 0x544920AE,
+		0xB206C41C, 0x5D36AF05, 0x698A64DF, 0x86BA0FC6, 0x00F3F36B, 0xEFC39872, 0xDB7F53A8, 0x344F38B1,
+		0x97F8FAB0, 0x78C891A9, 0x4C745A73, 0xA344316A, 0x250DCDC7, 0xCA3DA6DE, 0xFE816D04, 0x11B1061D,
+		0xF7FEE2AF, 0x18CE89B6, 0x2C72426C, 0xC3422975, 0x450BD5D8, 0xAA3BBEC1, 0x9E87751B, 0x71B71E02,
+		0x57F4CA8E, 0xB8C4A197, 0x8C786A4D, 0x63480154, 0xE501FDF9, 0x0A3196E0, 0x3E8D5D3A, 0xD1BD3623,
+		0x37F2D291, 0xD8C2B988, 0xEC7E7252, 0x034E194B, 0x8507E5E6, 0x6A378EFF, 0x5E8B4525, 0xB1BB2E3C,
+	},
+	{
+		0x00000000, 0x68032CC8, 0xD0065990, 0xB8057558, 0xA5E0C5D1, 0xCDE3E919, 0x75E69C41, 0x1DE5B089,
+		0x4E2DFD53, 0x262ED19B, 0x9E2BA4C3, 0xF628880B, 0xEBCD3882, 0x83CE144A, 0x3BCB6112, 0x53C84DDA,
+		0x9C5BFAA6, 0xF458D66E, 0x4C5DA336, 0x245E8FFE, 0x39BB3F77, 0x51B813BF, 0xE9BD66E7, 0x81BE4A2F,
+		0xD27607F5, 0xBA752B3D, 0x02705E65, 0x6A7372AD, 0x7796C224, 0x1F95EEEC, 0xA7909BB4, 0xCF93B77C,
+		0x3D5B83BD, 0x5558AF75, 0xED5DDA2D, 0x855EF6E5, 0x98BB466C, 0xF0B86AA4, 0x48BD1FFC, 0x20BE3334,
+		0x73767EEE, 0x1B755226, 0xA370277E, 0xCB730BB6, 0xD696BB3F, 0xBE9597F7, 0x0690E2AF, 0x6E93CE67,
+		0xA100791B, 0xC90355D3, 0x7106208B, 0x19050C43, 0x04E0BCCA, 0x6CE39002, 0xD4E6E55A, 0xBCE5C992,
+		0xEF2D8448, 0x872EA880, 0x3F2BDDD8, 0x5728F110, 0x4ACD4199, 0x22CE6D51, 0x9ACB1809, 0xF2C834C1,
+		0x7AB7077A, 0x12B42BB2, 0xAAB15EEA, 0xC2B27222, 0xDF57C2AB, 0xB754EE63, 0x0F519B3B, 0x6752B7F3,
+		0x349AFA29, 0x5C99D6E1, 0xE49CA3B9, 0x8C9F8F71, 0x917A3FF8, 0xF9791330, 0x417C6668, 0x297F4AA0,
+		0xE6ECFDDC, 0x8EEFD114, 0x36EAA44C, 0x5EE98884, 0x430C380D, 0x2B0F14C5, 0x930A619D, 0xFB094D55,
+		0xA8C1008F, 0xC0C22C47, 0x78C7591F, 0x10C475D7, 0x0D21C55E, 0x6522E996, 0xDD279CCE, 0xB524B006,
+		0x47EC84C7, 0x2FEFA80F, 0x97EADD57, 0xFFE9F19F, 0xE20C4116, 0x8A0F6DDE, 0x320A1886, 0x5A09344E,
+		0x09C17994, 0x61C2555C, 0xD9C72004, 0xB1C40CCC, 0xAC21BC45, 0xC422908D, 0x7C27E5D5, 0x1424C91D,
+		0xDBB77E61, 0xB3B452A9, 0x0BB127F1, 0x63B20B39, 0x7E57BBB0, 0x16549778, 0xAE51E220, 0xC652CEE8,
+		0x959A8332, 0xFD99AFFA, 0x459CDAA2, 0x2D9FF66A, 0x307A46E3, 0x58796A2B, 0xE07C1F73, 0x887F33BB,
+		0xF56E0EF4, 0x9D6D223C, 0x25685764, 0x4D6B7BAC, 0x508ECB25, 0x388DE7ED, 0x808892B5, 0xE88BBE7D,
+		0xBB43F3A7, 0xD340DF6F, 0x6B45AA37, 0x034686FF, 0x1EA33676, 0x76A01ABE, 0xCEA56FE6, 0xA6A6432E,
+		0x6935F452, 0x0136D89A, 0xB933ADC2, 0xD130810A, 0xCCD53183, 0xA4D61D4B, 0x1CD36813, 0x74D044DB,
+		0x27180901, 0x4F1B25C9, 0xF71E5091, 0x9F1D7C59, 0x82F8CCD0, 0xEAFBE018, 0x52FE9540, 0x3AFDB988,
+		0xC8358D49, 0xA036A181, 0x1833D4D9, 0x7030F811, 0x6DD54898, 0x05D66450, 0xBDD31108, 0xD5D03DC0,
+		0x8618701A, 0xEE1B5CD2, 0x561E298A, 0x3E1D0542, 0x23F8B5CB, 0x4BFB9903, 0xF3FEEC5B, 0x9BFDC093,
+		0x546E77EF, 0x3C6D5B27, 0x84682E7F, 0xEC6B02B7, 0xF18EB23E, 0x998D9EF6, 0x2188EBAE, 0x498BC766,
+		0x1A438ABC, 0x7240A674, 0xCA45D32C, 0xA246FFE4, 0xBFA34F6D, 0xD7A063A5, 0x6FA516FD, 0x07A63A35,
+		0x8FD9098E, 0xE7DA2546, 0x5FDF501E, 0x37DC7CD6, 0x2A39CC5F, 0x423AE097, 0xFA3F95CF, 0x923CB907,
+		0xC1F4F4DD, 0xA9F7D815, 0x11F2AD4D, 0x79F18185, 0x6414310C, 0x0C171DC4, 0xB412689C, 0xDC114454,
+		0x1382F328, 0x7B81DFE0, 0xC384AAB8, 0xAB878670, 0xB66236F9, 0xDE611A31, 0x66646F69, 0x0E6743A1,
+		0x5DAF0E7B, 0x35AC22B3, 0x8DA957EB, 0xE5AA7B23, 0xF84FCBAA, 0x904CE762, 0x2849923A, 0x404ABEF2,
+		0xB2828A33, 0xDA81A6FB, 0x6284D3A3, 0x0A87FF6B, 0x17624FE2, 0x7F61632A, 0xC7641672, 0xAF673ABA,
+		0xFCAF7760, 0x94AC5BA8, 0x2CA92EF0, 0x44AA0238, 0x594FB2B1, 0x314C9E79, 0x8949EB21, 0xE14AC7E9,
+		0x2ED97095, 0x46DA5C5D, 0xFEDF2905, 0x96DC05CD, 0x8B39B544, 0xE33A998C, 0x5B3FECD4, 0x333CC01C,
+		0x60F48DC6, 0x08F7A10E, 0xB0F2D456, 0xD8F1F89E, 0xC5144817, 0xAD1764DF, 0x15121187, 0x7D113D4F,
+	},
+	{
+		0x00000000, 0x493C7D27, 0x9278FA4E, 0xDB448769, 0x211D826D, 0x6821FF4A, 0xB3657823, 0xFA590504,
+		0x423B04DA, 0x0B0779FD, 0xD043FE94, 0x997F83B3, 0x632686B7, 0x2A1AFB90, 0xF15E7CF9, 0xB86201DE,
+		0x847609B4, 0xCD4A7493, 0x160EF3FA, 0x5F328EDD, 0xA56B8BD9, 0xEC57F6FE, 0x37137197, 0x7E2F0CB0,
+		0xC64D0D6E, 0x8F717049, 0x5435F720, 0x1D098A07, 0xE7508F03, 0xAE6CF224, 0x7528754D, 0x3C14086A,
+		0x0D006599, 0x443C18BE, 0x9F789FD7, 0xD644E2F0, 0x2C1DE7F4, 0x65219AD3, 0xBE651DBA, 0xF759609D,
+		0x4F3B6143, 0x06071C64, 0xDD439B0D, 0x947FE62A, 0x6E26E32E, 0x271A9E09, 0xFC5E1960, 0xB5626447,
+		0x89766C2D, 0xC04A110A, 0x1B0E9663, 0x5232EB44, 0xA86BEE40, 0xE1579367, 0x3A13140E, 0x732F6929,
+		0xCB4D68F7, 0x827115D0, 0x593592B9, 0x1009EF9E, 0xEA50EA9A, 0xA36C97BD, 0x782810D4, 0x31146DF3,
+		0x1A00CB32, 0x533CB615, 0x8878317C, 0xC1444C5B, 0x3B1D495F, 0x72213478, 0xA965B311, 0xE059CE36,
+		0x583BCFE8, 0x1107B2CF, 0xCA4335A6, 0x837F4881, 0x79264D85, 0x301A30A2, 0xEB5EB7CB, 0xA262CAEC,
+		0x9E76C286, 0xD74ABFA1, 0x0C0E38C8, 0x453245EF, 0xBF6B40EB, 0xF6573DCC, 0x2D13BAA5, 0x642FC782,
+		0xDC4DC65C, 0x9571BB7B, 0x4E353C12, 0x07094135, 0xFD504431, 0xB46C3916, 0x6F28BE7F, 0x2614C358,
+		0x1700AEAB, 0x5E3CD38C, 0x857854E5, 0xCC4429C2, 0x361D2CC6, 0x7F2151E1, 0xA465D688, 0xED59ABAF,
+		0x553BAA71, 0x1C07D756, 0xC743503F, 0x8E7F2D18, 0x7426281C, 0x3D1A553B, 0xE65ED252, 0xAF62AF75,
+		0x9376A71F, 0xDA4ADA38, 0x010E5D51, 0x48322076, 0xB26B2572, 0xFB575855, 0x2013DF3C, 0x692FA21B,
+		0xD14DA3C5, 0x9871DEE2, 0x4335598B, 0x0A0924AC, 0xF05021A8, 0xB96C5C8F, 0x6228DBE6, 0x2B14A6C1,
+		0x34019664, 0x7D3DEB43, 0xA6796C2A, 0xEF45110D, 0x151C1409, 0x5C20692E, 0x8764EE47, 0xCE589360,
+		0x763A92BE, 0x3F06EF99, 0xE44268F0, 0xAD7E15D7, 0x572710D3, 0x1E1B6DF4, 0xC55FEA9D, 0x8C6397BA,
+		0xB0779FD0, 0xF94BE2F7, 0x220F659E, 0x6B3318B9, 0x916A1DBD, 0xD856609A, 0x0312E7F3, 0x4A2E9AD4,
+		0xF24C9B0A, 0xBB70E62D, 0x60346144, 0x29081C63, 0xD3511967, 0x9A6D6440, 0x4129E329, 0x08159E0E,
+		0x3901F3FD, 0x703D8EDA, 0xAB7909B3, 0xE2457494, 0x181C7190, 0x51200CB7, 0x8A648BDE, 0xC358F6F9,
+		0x7B3AF727, 0x32068A00, 0xE9420D69, 0xA07E704E, 0x5A27754A, 0x131B086D, 0xC85F8F04, 0x8163F223,
+		0xBD77FA49, 0xF44B876E, 0x2F0F0007, 0x66337D20, 0x9C6A7824, 0xD5560503, 0x0E12826A, 0x472EFF4D,
+		0xFF4CFE93, 0xB67083B4, 0x6D3404DD, 0x240879FA, 0xDE517CFE, 0x976D01D9, 0x4C2986B0, 0x0515FB97,
+		0x2E015D56, 0x673D2071, 0xBC79A718, 0xF545DA3F, 0x0F1CDF3B, 0x4620A21C, 0x9D642575, 0xD4585852,
+		0x6C3A598C, 0x250624AB, 0xFE42A3C2, 0xB77EDEE5, 0x4D27DBE1, 0x041BA6C6, 0xDF5F21AF, 0x96635C88,
+		0xAA7754E2, 0xE34B29C5, 0x380FAEAC, 0x7133D38B, 0x8B6AD68F, 0xC256ABA8, 0x19122CC1, 0x502E51E6,
+		0xE84C5038, 0xA1702D1F, 0x7A34AA76, 0x3308D751, 0xC951D255, 0x806DAF72, 0x5B29281B, 0x1215553C,
+		0x230138CF, 0x6A3D45E8, 0xB179C281, 0xF845BFA6, 0x021CBAA2, 0x4B20C785, 0x906440EC, 0xD9583DCB,
+		0x613A3C15, 0x28064132, 0xF342C65B, 0xBA7EBB7C, 0x4027BE78, 0x091BC35F, 0xD25F4436, 0x9B633911,
+		0xA777317B, 0xEE4B4C5C, 0x350FCB35, 0x7C33B612, 0x866AB316, 0xCF56CE31, 0x14124958, 0x5D2E347F,
+		0xE54C35A1, 0xAC704886, 0x7734CFEF, 0x3E08B2C8, 0xC451B7CC, 0x8D6DCAEB, 0x56294D82, 0x1F1530A5,
+	},
+};
+
+static unsigned int DG__crc32c_table(unsigned int crc, const unsigned char* p, size_t len)
+{
+	crc = ~crc;
+	while(len >= 8)
+	{
+		unsigned int lo = DG__HashRead32(p) ^ crc;
+		unsigned int hi = DG__HashRead32(p + 4);
+		crc = DG__crc32cTable[7][lo & 0xFF] ^ DG__crc32cTable[6][(lo >> 8) & 0xFF]
+		      ^ DG__crc32cTable[5][(lo >> 16) & 0xFF] ^ DG__crc32cTable[4][lo >> 24]
+		      ^ DG__crc32cTable[3][hi & 0xFF] ^ DG__crc32cTable[2][(hi >> 8) & 0xFF]
+		      ^ DG__crc32cTable[1][(hi >> 16) & 0xFF] ^ DG__crc32cTable[0][hi >> 24];
+		p += 8;
+		len -= 8;
 	}
+	while(len-- > 0)
+		crc = DG__crc32cTable[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
 
-	return ret;
+#ifdef DG__MISC_HAVE_CRC32C
+
+// the crc32 instruction has a latency of 3 cycles but a throughput of 1 per cycle, so 3 blocks
+// are processed in an interleaved way and then their CRCs are combined: CRC(A|B) is
+// CRC(A) "shifted" by len(B) zero bytes, XORed with CRC(B) (without the inversions).
+// The shift is a multiplication with x^(8*len(B)) modulo the CRC polynomial, done with
+// PCLMULQDQ (with x^(8*len(B) - 32), as the crc32 instruction multiplies with x^32 again)
+#define DG__CRC32C_LONG   4096
+#define DG__CRC32C_SHORT  256
+#define DG__CRC32C_LONG_SHIFT   0xC38A7543u // x^(8*4096 - 32) mod P, bit-reflected
+#define DG__CRC32C_SHORT_SHIFT  0x5CF015C3u // x^(8*256 - 32) mod P, bit-reflected
+
+DG__MISC_TARGET_CRC32C DG__MISC_MAYBE_UNUSED
+static unsigned long long DG__Crc32cShift(unsigned long long crc, unsigned int shift)
+{
+	__m128i prod = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int)crc), _mm_cvtsi32_si128((int)shift), 0);
+	// the product of the bit-reflected values is shifted by one bit
+	return _mm_crc32_u64(0, (unsigned long long)_mm_cvtsi128_si64(prod) << 1);
 }
-#endif // DG_vsnprintf
 
-#ifndef DG_snprintf // if it's not just a #define to regular snprintf()
+DG__MISC_TARGET_CRC32C DG__MISC_MAYBE_UNUSED
+static unsigned int DG__crc32c_sse42(unsigned int crc, const unsigned char* p, size_t len)
+{
+	unsigned long long c0 = ~crc;
+	size_t blockLen = DG__CRC32C_LONG;
+	unsigned int shift = DG__CRC32C_LONG_SHIFT;
+	for(;;)
+	{
+		while(len >= 3 * blockLen)
+		{
+			const unsigned char* end = p + blockLen;
+			unsigned long long c1 = 0, c2 = 0, w0, w1, w2;
+			do {
+				memcpy(&w0, p, 8);
+				memcpy(&w1, p + blockLen, 8);
+				memcpy(&w2, p + 2 * blockLen, 8);
+				c0 = _mm_crc32_u64(c0, w0);
+				c1 = _mm_crc32_u64(c1, w1);
+				c2 = _mm_crc32_u64(c2, w2);
+				p += 8;
+			} while(p < end);
+			c0 = DG__Crc32cShift(c0, shift) ^ c1;
+			c0 = DG__Crc32cShift(c0, shift) ^ c2;
+			p += 2 * blockLen;
+			len -= 3 * blockLen;
+		}
+		if(blockLen == DG__CRC32C_SHORT)  break;
+		blockLen = DG__CRC32C_SHORT;
+		shift = DG__CRC32C_SHORT_SHIFT;
+	}
+	while(len >= 8)
+	{
+		unsigned long long w;
+		memcpy(&w, p, 8);
+		c0 = _mm_crc32_u64(c0, w);
+		p += 8;
+		len -= 8;
+	}
+	while(len-- > 0)
+		c0 = _mm_crc32_u8((unsigned int)c0, *p++);
+	return ~(unsigned int)c0;
+}
 
-DG_MISC_DEF int DG_snprintf(char *dst, size_t size, const char *format, ...)
+#ifndef DG__MISC_ALWAYS_CRC32C
+// returns 1 if the CPU supports both SSE4.2 and PCLMULQDQ, so DG__crc32c_sse42() can be used
+DG__MISC_MAYBE_UNUSED
+static int DG__MiscHaveCrc32c(void)
 {
-	DG_MISC_ASSERT(format, "Don't pass a NULL format into DG_snprintf()!");
+	// 0: not checked yet, 1: not supported, 2: supported. like in DG__MiscGetKernels(),
+	// it doesn't matter if several threads check this at the same time
+	static volatile size_t state = 0;
+	size_t ret = DG__AtomicLoad(&state);
+	if(ret == 0)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_cpu_init();
+		ret = (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("pclmul")) ? 2 : 1;
+#elif defined(_MSC_VER)
+		int regs[4]; // eax, ebx, ecx, edx
+		__cpuid(regs, 1);
+		// SSE4.2 is bit 20 and PCLMULQDQ is bit 1 of ecx
+		ret = ((regs[2] & ((1 << 20) | (1 << 1))) == ((1 << 20) | (1 << 1))) ? 2 : 1;
+#else
+		ret = 1;
+#endif
+		DG__AtomicStore(&state, ret);
+	}
+	return ret == 2;
+}
+#endif // DG__MISC_ALWAYS_CRC32C
 
-	int ret = 0;
+#endif // DG__MISC_HAVE_CRC32C
 
-	va_list argptr;
-	va_start( argptr, format );
+static unsigned int DG__crc32c_level(unsigned int crc, const unsigned char* p, size_t len, int simdLevel)
+{
+#if defined(DG__MISC_ALWAYS_CRC32C)
+	if(simdLevel > DG__MISC_SIMD_NONE)  return DG__crc32c_sse42(crc, p, len);
+#elif defined(DG__MISC_HAVE_CRC32C) // compiled for AVX2 or with DG__MISC_DISPATCH
+	if(simdLevel > DG__MISC_SIMD_NONE && DG__MiscHaveCrc32c())  return DG__crc32c_sse42(crc, p, len);
+#endif
+	(void)simdLevel;
+	return DG__crc32c_table(crc, p, len);
+}
 
-	ret = DG_vsnprintf(dst, size, format, argptr);
+DG_MISC_DEF unsigned int DG_crc32c(unsigned int crc, const void* data, size_t len)
+{
+	DG_MISC_ASSERT(data != NULL || len == 0, "Don't pass NULL into DG_crc32c()!");
+	return DG__crc32c_level(crc, (const unsigned char*)data, len, DG__MISC_SIMD_LEVEL);
+}
 
-	va_end( argptr );
+#ifdef DG__MISC_DISPATCH
+
+#ifndef DG_strlen
+  #define DG__MISC_STRLEN_KERNEL(fn)  fn,
+#else // DG_strlen is just strlen, DG__MiscKernels has no strlen member
+  #define DG__MISC_STRLEN_KERNEL(fn)
+#endif
+
+// the SIMD versions of DG_strnlen() and DG_strlen() are opt-in
+#ifdef DG_MISC_STRLEN_SIMD
+  #define DG__MISC_STRLEN_KERNELS(level) \
+	DG__strnlen_ ## level, DG__MISC_STRLEN_KERNEL(DG__strlen_ ## level)
+#else
+  #define DG__MISC_STRLEN_KERNELS(level) \
+	DG__strnlen_swar, DG__MISC_STRLEN_KERNEL(DG__strlen_c)
+#endif
+
+// the implementations for each SIMD level, in the order of DG__MiscKernels members:
+// strnlen, strlen, memmem, memrmem, memrchr, simdLevel
+static const DG__MiscKernels DG__miscKernelsC = {
+	DG__strnlen_swar, DG__MISC_STRLEN_KERNEL(DG__strlen_c)
+	DG__memmem_c, DG__memrmem_c, DG__memrchr_swar, DG__MISC_SIMD_NONE
+};
+static const DG__MiscKernels DG__miscKernelsSSE2 = {
+	DG__MISC_STRLEN_KERNELS(sse2)
+	DG__memmem_sse2, DG__memrmem_sse2, DG__memrchr_sse2, DG__MISC_SIMD_SSE2
+};
+static const DG__MiscKernels DG__miscKernelsAVX2 = {
+	DG__MISC_STRLEN_KERNELS(avx2)
+	DG__memmem_avx2, DG__memrmem_avx2, DG__memrchr_avx2, DG__MISC_SIMD_AVX2
+};
+
+#undef DG__MISC_STRLEN_KERNEL
+#undef DG__MISC_STRLEN_KERNELS
+
+// returns the best DG__MISC_SIMD_* level supported by the CPU (and OS)
+static int DG__MiscDetectSIMD(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	// this also checks if the OS saves the AVX registers on context switch
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2"))
+		return DG__MISC_SIMD_AVX2;
+#elif defined(_MSC_VER)
+	int regs[4]; // eax, ebx, ecx, edx
+	__cpuid(regs, 0);
+	if(regs[0] >= 7)
+	{
+		__cpuid(regs, 1);
+		// OSXSAVE (bit 27) and AVX (bit 28) must be set in ecx
+		if((regs[2] & (3 << 27)) == (3 << 27)
+		   && (_xgetbv(0) & 6) == 6) // OS saves XMM and YMM registers
+		{
+			__cpuidex(regs, 7, 0);
+			if(regs[1] & (1 << 5)) // AVX2 bit in ebx
+				return DG__MISC_SIMD_AVX2;
+		}
+	}
+#endif
+	// DG__MISC_DISPATCH is only #defined if SSE2 can be used unconditionally
+	return DG__MISC_SIMD_SSE2;
+}
 
+static const DG__MiscKernels* DG__MiscGetKernels(void)
+{
+	// if several threads call this at the same time, they all store the same
+	// pointer, so it doesn't matter who wins - but it must be stored atomically
+	static volatile size_t kernels = 0; // const DG__MiscKernels*
+	const DG__MiscKernels* ret = (const DG__MiscKernels*)DG__AtomicLoad(&kernels);
+	if(ret == NULL)
+	{
+		switch(DG__MiscDetectSIMD())
+		{
+			case DG__MISC_SIMD_AVX2: ret = &DG__miscKernelsAVX2; break;
+			case DG__MISC_SIMD_SSE2: ret = &DG__miscKernelsSSE2; break;
+			default:                 ret = &DG__miscKernelsC;
+		}
+		DG__AtomicStore(&kernels, (size_t)ret);
+	}
 	return ret;
 }
-#endif // DG_snprintf is defined
 
-#endif // _WIN32
+#endif // DG__MISC_DISPATCH
 
 #ifdef _DG__DEFINED_PATH_MAX
 #undef PATH_MAX
@@ -0,0 +1,1296 @@
+/*
+ * Benchmarks for some of the DG_misc.h functions, compared to the libc versions
+ * (if the libc has them) and to the different implementations in DG_misc.h
+ *
+ * Build with optimizations, for example:
+ *   gcc -O2 -o benchmisc benchmisc.c
+ * Run it with the name of a function (like "memmem") as argument to only benchmark that,
+ * or without arguments to benchmark everything.
+ *
+ * Each implementation is run for a while to warm up caches (and make the CPU leave
+ * its power saving states), then timed a few times and the fastest run is reported.
+ * The process is pinned to one CPU, so the scheduler doesn't move it around.
+ *
+ * License:
+ *  This software is in the public domain. Where that dedication is not
+ *  recognized, you are granted a perpetual, irrevocable license to copy
+ *  and modify this file however you want.
+ *  No warranty implied; use at your own risk.
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+  #define _GNU_SOURCE // for memmem(), memrchr() and sched_setaffinity() (if available)
+#endif
+#include <stdarg.h>
+
+#define DG_MISC_IMPLEMENTATION
+#define DG_MISC_NO_GNU_SOURCE // benchmark our own implementations, not glibc's
+#define DG_MISC_STRLEN_SIMD
+#define DG_MISC_RUNTIME_DISPATCH // so the AVX2 versions are available (if the CPU supports it)
+#include "../DG_misc.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <time.h>
+  #ifdef __linux
+    #include <sched.h>
+  #endif
+#endif
+
+// how long to warm up before measuring, how long each timed run should take
+// and how many timed runs there are (the fastest one is used)
+#define WARMUP_NS   20e6
+#define RUN_NS      20e6
+#define NUM_RUNS    3
+
+// returns a timestamp in nanoseconds
+static double getTimeNS(void)
+{
+#ifdef _WIN32
+	static LARGE_INTEGER freq = {0};
+	LARGE_INTEGER now;
+	if(freq.QuadPart == 0)  QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (double)now.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
+
+static void pinToCPU(void)
+{
+#ifdef _WIN32
+	SetThreadAffinityMask(GetCurrentThread(), 1);
+#elif defined(__linux) && defined(CPU_SET)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(0, &set);
+	if(sched_setaffinity(0, sizeof(set), &set) != 0)
+		printf("NOTE: Couldn't pin process to a CPU, results may be noisy\n");
+#else
+	printf("NOTE: Don't know how to pin the process to a CPU here, results may be noisy\n");
+#endif
+}
+
+static int haveAVX2(void)
+{
+#if defined(DG__MISC_ALWAYS_AVX2)
+	return 1;
+#elif defined(DG__MISC_DISPATCH)
+	return DG__MiscDetectSIMD() >= DG__MISC_SIMD_AVX2;
+#else
+	return 0;
+#endif
+}
+
+// the data for one benchmark case. call number i uses input i % numInputs,
+// so the benchmarks can use several different inputs (like strings of different lengths)
+#define MAX_INPUTS 1024
+typedef struct {
+	const char* inputs[MAX_INPUTS];
+	size_t inputLens[MAX_INPUTS];
+	size_t numInputs;
+	size_t bytesPerCall; // average number of bytes processed per call, for ns/byte
+	const char* needle;
+	size_t needleLen;
+	unsigned char c; // for memrchr()
+	char* dst;       // for strlcpy() and strlcat()
+	size_t dstSize;
+	const unsigned long long* ints; // for the number formatting functions
+	const double* doubles;
+	const char* others[MAX_INPUTS]; // for strncasecmp(): what inputs[i] is compared with
+} BenchData;
+
+// one implementation of the function that's being benchmarked, returns some value
+// derived from the result so the call can't be optimized away
+typedef size_t (*BenchFn)(const BenchData* d, size_t i);
+
+typedef struct {
+	const char* name;
+	BenchFn fn;
+} BenchImpl;
+
+// the results are summed up into this, so the compiler can't optimize the calls away
+static volatile size_t sink;
+
+static double timeRun(BenchFn fn, const BenchData* d, size_t iterations)
+{
+	size_t sum = 0;
+	double start = getTimeNS();
+	for(size_t i=0; i < iterations; ++i)
+		sum += fn(d, i);
+	double ret = getTimeNS() - start;
+	sink += sum;
+	return ret;
+}
+
+// times each implementation with d and prints a line with the results
+static void runBench(const char* caseName, const BenchImpl* impls, int numImpls, const BenchData* d)
+{
+	printf("  %-28s", caseName);
+	for(int i=0; i<numImpls; ++i)
+	{
+		BenchFn fn = impls[i].fn;
+
+		// warm up, while figuring out how many iterations take about RUN_NS
+		size_t iterations = 1;
+		double t, warmupStart = getTimeNS();
+		for(;;)
+		{
+			t = timeRun(fn, d, iterations);
+			if(t >= RUN_NS / 4 && getTimeNS() - warmupStart >= WARMUP_NS)  break;
+			if(t < RUN_NS / 4)  iterations *= 2;
+		}
+		iterations = (size_t)(iterations * (RUN_NS / t)) + 1;
+
+		double best = 1e300;
+		for(int r=0; r < NUM_RUNS; ++r)
+		{
+			t = timeRun(fn, d, iterations) / iterations;
+			if(t < best)  best = t;
+		}
+		double nsPerByte = best / (d->bytesPerCall ? d->bytesPerCall : 1);
+		// bytes per nanosecond is the same as GB per second
+		printf(" | %-6s %8.2fns %6.3fns/B %6.2fGB/s", impls[i].name, best, nsPerByte, 1.0 / nsPerByte);
+	}
+	printf("\n");
+}
+
+static void addImpl(BenchImpl* impls, int* numImpls, const char* name, BenchFn fn)
+{
+	impls[*numImpls].name = name;
+	impls[*numImpls].fn = fn;
+	++*numImpls;
+}
+
+// a buffer with some slack at the start (for different alignments) and end
+static char* allocBuffer(size_t size)
+{
+	char* ret = (char*)malloc(size + 128);
+	if(ret == NULL)
+	{
+		printf("Couldn't allocate %d bytes!\n", (int)size);
+		exit(1);
+	}
+	return ret;
+}
+
+// fills buf with random bytes from "abcdefghijklmnop" (that are never '\0')
+static void fillRandom(char* buf, size_t size)
+{
+	for(size_t i=0; i<size; ++i)
+		buf[i] = 'a' + rand() % 16;
+}
+
+// *** DG_GetExecutable*() ***
+
+static DG__ExePaths benchExePaths;
+
+#ifdef __linux
+// the old way of getting the path and its parts: formatting the PID into the /proc/ path,
+// and then copying and splitting the path in DG_GetExecutableDir() and DG_GetExecutableFilename()
+static size_t exePathOld(const BenchData* d, size_t i)
+{
+	char link[64];
+	char* path = benchExePaths.path;
+	char* dir = benchExePaths.dir;
+	(void)d; (void)i;
+	snprintf(link, sizeof(link), "/proc/%d/exe", getpid());
+	ssize_t len = readlink(link, path, PATH_MAX-1);
+	if(len <= 0)  return 0;
+	path[len] = '\0';
+	DG_strlcpy(dir, path, PATH_MAX);
+	char* lastSlash = strrchr(dir, '/');
+	if(lastSlash != NULL)  lastSlash[1] = '\0';
+	const char* filename = strrchr(path, '/');
+	return (size_t)len + (filename ? strlen(filename) : 0);
+}
+#endif
+
+// what happens at the first call of any DG_GetExecutable*() function
+static size_t exePathInit(const BenchData* d, size_t i)
+{
+	(void)d; (void)i;
+	DG__InitExePaths(&benchExePaths);
+	return benchExePaths.pathLen;
+}
+
+// all later calls
+static size_t exePathCached(const BenchData* d, size_t i)
+{
+	DG_ExecutableInfo info;
+	(void)d; (void)i;
+	DG_GetExecutableInfo(&info);
+	return info.pathLen + info.filenameLen;
+}
+
+static size_t exePathCachedGetters(const BenchData* d, size_t i)
+{
+	(void)d; (void)i;
+	return (size_t)DG_GetExecutablePath() + (size_t)DG_GetExecutableDir() + (size_t)DG_GetExecutableFilename();
+}
+
+static void benchExePath(void)
+{
+	BenchImpl impls[4];
+	int numImpls = 0;
+	BenchData d;
+
+	memset(&d, 0, sizeof(d));
+	d.numInputs = 1;
+	printf("\nDG_GetExecutable*() (old is the previous implementation, init is the first call,\n");
+	printf("info a later DG_GetExecutableInfo() call, getters later calls of the 3 functions):\n");
+#ifdef __linux
+	addImpl(impls, &numImpls, "old", exePathOld);
+#endif
+	addImpl(impls, &numImpls, "init", exePathInit);
+	addImpl(impls, &numImpls, "info", exePathCached);
+	addImpl(impls, &numImpls, "getters", exePathCachedGetters);
+	runBench("path, dir and filename", impls, numImpls, &d);
+}
+
+// *** DG_strnlen() and DG_strlen() ***
+
+#define STRNLEN_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		size_t k = i % d->numInputs; \
+		const char* s = d->inputs[k]; \
+		size_t n = d->inputLens[k] + 16; \
+		(void)n; \
+		return call; \
+	}
+
+STRNLEN_WRAPPER(strnlen_libc, strnlen(s, n))
+STRNLEN_WRAPPER(strnlen_swar, DG__strnlen_swar(s, n))
+STRNLEN_WRAPPER(strnlen_sse2, DG__strnlen_sse2(s, n))
+STRNLEN_WRAPPER(strnlen_avx2, DG__strnlen_avx2(s, n))
+STRNLEN_WRAPPER(strnlen_DG,   DG_strnlen(s, n))
+
+STRNLEN_WRAPPER(strlen_libc, strlen(s))
+STRNLEN_WRAPPER(strlen_DG,   DG_strlen(s))
+STRNLEN_WRAPPER(strlen_swar, DG__strnlen_swar(s, (size_t)-1 - (uintptr_t)s - sizeof(uintptr_t)))
+STRNLEN_WRAPPER(strlen_sse2, DG__strnlen_sse2(s, (size_t)-1))
+STRNLEN_WRAPPER(strlen_avx2, DG__strnlen_avx2(s, (size_t)-1))
+
+// sets up d with strings of the given length at the given alignment,
+// or (if len is 0) with strings of random lengths between 0 and maxRandLen
+static void setupStrings(BenchData* d, char* buf, size_t len, size_t align, size_t maxRandLen)
+{
+	memset(d, 0, sizeof(*d));
+	if(len != 0)
+	{
+		char* s = buf + align;
+		fillRandom(s, len);
+		s[len] = '\0';
+		d->inputs[0] = s;
+		d->inputLens[0] = len;
+		d->numInputs = 1;
+		d->bytesPerCall = len;
+		return;
+	}
+
+	// many strings (so the branch predictor can't learn the lengths),
+	// each in its own 64 byte aligned slot
+	size_t slot = (maxRandLen + 64 + 63) & ~(size_t)63;
+	size_t sum = 0;
+	for(size_t i=0; i<MAX_INPUTS; ++i)
+	{
+		char* s = buf + i*slot + align;
+		size_t l = rand() % (maxRandLen + 1);
+		fillRandom(s, l);
+		s[l] = '\0';
+		d->inputs[i] = s;
+		d->inputLens[i] = l;
+		sum += l;
+	}
+	d->numInputs = MAX_INPUTS;
+	d->bytesPerCall = sum / MAX_INPUTS;
+}
+
+static void benchStrlen(int strnlenToo)
+{
+	static const size_t lengths[] = { 7, 16, 64, 256, 1000, 4096, 65536, 1 << 20 };
+	static const size_t aligns[] = { 0, 1, 13 };
+	static const size_t randMaxLens[] = { 16, 64, 256 };
+	char* buf = allocBuffer(MAX_INPUTS * (256 + 128) + (1 << 20));
+	BenchImpl impls[6];
+	BenchData d;
+	char caseName[64];
+
+	for(int variant = strnlenToo ? 0 : 1; variant < 2; ++variant)
+	{
+		int numImpls = 0;
+		if(variant == 0)
+		{
+			printf("\nDG_strnlen():\n");
+			addImpl(impls, &numImpls, "libc", strnlen_libc);
+			addImpl(impls, &numImpls, "DG", strnlen_DG);
+			addImpl(impls, &numImpls, "swar", strnlen_swar);
+	#ifdef DG__MISC_HAVE_SSE2
+			addImpl(impls, &numImpls, "sse2", strnlen_sse2);
+	#endif
+	#ifdef DG__MISC_HAVE_AVX2
+			if(haveAVX2())  addImpl(impls, &numImpls, "avx2", strnlen_avx2);
+	#endif
+		}
+		else
+		{
+			printf("\nDG_strlen():\n");
+			addImpl(impls, &numImpls, "libc", strlen_libc);
+			addImpl(impls, &numImpls, "DG", strlen_DG);
+			addImpl(impls, &numImpls, "swar", strlen_swar);
+	#ifdef DG__MISC_HAVE_SSE2
+			addImpl(impls, &numImpls, "sse2", strlen_sse2);
+	#endif
+	#ifdef DG__MISC_HAVE_AVX2
+			if(haveAVX2())  addImpl(impls, &numImpls, "avx2", strlen_avx2);
+	#endif
+		}
+
+		for(size_t a=0; a < sizeof(aligns)/sizeof(aligns[0]); ++a)
+		{
+			for(size_t l=0; l < sizeof(lengths)/sizeof(lengths[0]); ++l)
+			{
+				setupStrings(&d, buf, lengths[l], aligns[a], 0);
+				sprintf(caseName, "len %d, align %d", (int)lengths[l], (int)aligns[a]);
+				runBench(caseName, impls, numImpls, &d);
+			}
+		}
+		for(size_t r=0; r < sizeof(randMaxLens)/sizeof(randMaxLens[0]); ++r)
+		{
+			setupStrings(&d, buf, 0, 0, randMaxLens[r]);
+			sprintf(caseName, "random len 0..%d", (int)randMaxLens[r]);
+			runBench(caseName, impls, numImpls, &d);
+		}
+	}
+	free(buf);
+}
+
+// *** DG_memmem() and DG_memrmem() ***
+
+#define MEMMEM_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		(void)i; \
+		const unsigned char* h = (const unsigned char*)d->inputs[0]; \
+		size_t hl = d->inputLens[0]; \
+		const unsigned char* n = (const unsigned char*)d->needle; \
+		size_t nl = d->needleLen; \
+		(void)hl; (void)nl; \
+		const unsigned char* res = (const unsigned char*)(call); \
+		return res ? (size_t)(res - h) : 0; \
+	}
+
+#ifdef __GLIBC__
+MEMMEM_WRAPPER(memmem_libc, memmem(h, hl, n, nl))
+#endif
+MEMMEM_WRAPPER(memmem_DG,   DG_memmem(h, hl, n, nl))
+MEMMEM_WRAPPER(memmem_c,    DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_NONE, 0))
+MEMMEM_WRAPPER(memmem_sse2, DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_SSE2, 0))
+MEMMEM_WRAPPER(memmem_avx2, DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_AVX2, 0))
+
+MEMMEM_WRAPPER(memrmem_DG,   DG_memrmem(h, hl, n, nl))
+MEMMEM_WRAPPER(memrmem_c,    DG__memrmem_level(h, hl, n, nl, DG__MISC_SIMD_NONE, 0))
+MEMMEM_WRAPPER(memrmem_sse2, DG__memrmem_level(h, hl, n, nl, DG__MISC_SIMD_SSE2, 0))
+MEMMEM_WRAPPER(memrmem_avx2, DG__memrmem_level(h, hl, n, nl, DG__MISC_SIMD_AVX2, 0))
+
+static void benchMemmem(int backwards)
+{
+	static const size_t hayLens[] = { 1000, 1 << 20 };
+	static const size_t needleLens[] = { 2, 4, 12, 32, 200, 1000 };
+	// the position of the match, in percent of the haystack length (-1 means no match)
+	static const int matchPos[] = { 50, -1 };
+	size_t maxHayLen = 1 << 20;
+	char* buf = allocBuffer(maxHayLen);
+	char* needleBuf = allocBuffer(1000);
+	BenchImpl impls[6];
+	int numImpls = 0;
+	BenchData d;
+	char caseName[64];
+
+	printf(backwards ? "\nDG_memrmem():\n" : "\nDG_memmem():\n");
+	if(backwards)
+	{
+		addImpl(impls, &numImpls, "DG", memrmem_DG);
+		addImpl(impls, &numImpls, "c", memrmem_c);
+	#ifdef DG__MISC_HAVE_SSE2
+		addImpl(impls, &numImpls, "sse2", memrmem_sse2);
+	#endif
+	#ifdef DG__MISC_HAVE_AVX2
+		if(haveAVX2())  addImpl(impls, &numImpls, "avx2", memrmem_avx2);
+	#endif
+	}
+	else
+	{
+	#ifdef __GLIBC__
+		addImpl(impls, &numImpls, "libc", memmem_libc);
+	#endif
+		addImpl(impls, &numImpls, "DG", memmem_DG);
+		addImpl(impls, &numImpls, "c", memmem_c);
+	#ifdef DG__MISC_HAVE_SSE2
+		addImpl(impls, &numImpls, "sse2", memmem_sse2);
+	#endif
+	#ifdef DG__MISC_HAVE_AVX2
+		if(haveAVX2())  addImpl(impls, &numImpls, "avx2", memmem_avx2);
+	#endif
+	}
+
+	for(size_t h=0; h < sizeof(hayLens)/sizeof(hayLens[0]); ++h)
+	{
+		size_t hl = hayLens[h];
+		for(size_t n=0; n < sizeof(needleLens)/sizeof(needleLens[0]); ++n)
+		{
+			size_t nl = needleLens[n];
+			if(nl > hl/4)  continue;
+			for(size_t m=0; m < sizeof(matchPos)/sizeof(matchPos[0]); ++m)
+			{
+				// random text with a needle made from random text as well, so there
+				// are lots of partial matches. the '#' makes sure it only matches once
+				memset(&d, 0, sizeof(d));
+				char* hay = buf + 1; // unaligned
+				fillRandom(hay, hl);
+				fillRandom(needleBuf, nl);
+				needleBuf[nl/2] = '#';
+				if(matchPos[m] >= 0)
+					memcpy(hay + (hl - nl) * matchPos[m] / 100, needleBuf, nl);
+
+				d.inputs[0] = hay;
+				d.inputLens[0] = hl;
+				d.numInputs = 1;
+				d.needle = needleBuf;
+				d.needleLen = nl;
+				// the whole haystack is searched if there's no match, else half of it
+				d.bytesPerCall = (matchPos[m] >= 0) ? hl / 2 : hl;
+				if(matchPos[m] >= 0)
+					sprintf(caseName, "hay %d, needle %d, match", (int)hl, (int)nl);
+				else
+					sprintf(caseName, "hay %d, needle %d, none", (int)hl, (int)nl);
+				runBench(caseName, impls, numImpls, &d);
+			}
+		}
+	}
+	free(needleBuf);
+	free(buf);
+
+	if(backwards)
+	{
+		// inputs that take O(haystackLen*needleLen) time with naive backwards searches:
+		// "aaaa...aaab" in "ab" followed by lots of 'a's, so the only match is at the start
+		static const size_t pathNeedleLens[] = { 2, 16, 17, 256, 257, 10000 };
+		size_t hl = 16 << 20;
+		char* hay = allocBuffer(hl);
+		needleBuf = allocBuffer(10000);
+		memset(hay, 'a', hl);
+		memset(needleBuf, 'a', 10000);
+		for(size_t n=0; n < sizeof(pathNeedleLens)/sizeof(pathNeedleLens[0]); ++n)
+		{
+			size_t nl = pathNeedleLens[n];
+			hay[nl-1] = 'b';
+			needleBuf[nl-1] = 'b';
+
+			memset(&d, 0, sizeof(d));
+			d.inputs[0] = hay;
+			d.inputLens[0] = hl;
+			d.numInputs = 1;
+			d.needle = needleBuf;
+			d.needleLen = nl;
+			d.bytesPerCall = hl;
+			sprintf(caseName, "%d MB a..ab, needle %d", (int)(hl >> 20), (int)nl);
+			runBench(caseName, impls, numImpls, &d);
+
+			hay[nl-1] = 'a';
+			needleBuf[nl-1] = 'a';
+		}
+		free(needleBuf);
+		free(hay);
+	}
+}
+
+// *** DG_memrchr() ***
+
+#define MEMRCHR_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		(void)i; \
+		const unsigned char* b = (const unsigned char*)d->inputs[0]; \
+		size_t len = d->inputLens[0]; \
+		unsigned char c = d->c; \
+		const unsigned char* res = (const unsigned char*)(call); \
+		return res ? (size_t)(res - b) : 0; \
+	}
+
+#ifdef __GLIBC__
+MEMRCHR_WRAPPER(memrchr_libc, memrchr(b, c, len))
+#endif
+MEMRCHR_WRAPPER(memrchr_DG,   DG_memrchr(b, c, len))
+MEMRCHR_WRAPPER(memrchr_swar, DG__memrchr_swar(b, c, len))
+#ifdef DG__MISC_HAVE_SSE2
+MEMRCHR_WRAPPER(memrchr_sse2, DG__memrchr_sse2(b, c, len))
+#endif
+#ifdef DG__MISC_HAVE_AVX2
+MEMRCHR_WRAPPER(memrchr_avx2, DG__memrchr_avx2(b, c, len))
+#endif
+
+static void benchMemrchr(void)
+{
+	static const size_t lengths[] = { 16, 100, 1000, 65536, 1 << 20 };
+	static const size_t aligns[] = { 0, 7 };
+	char* buf = allocBuffer(1 << 20);
+	BenchImpl impls[6];
+	int numImpls = 0;
+	BenchData d;
+	char caseName[64];
+
+	printf("\nDG_memrchr():\n");
+#ifdef __GLIBC__
+	addImpl(impls, &numImpls, "libc", memrchr_libc);
+#endif
+	addImpl(impls, &numImpls, "DG", memrchr_DG);
+	addImpl(impls, &numImpls, "swar", memrchr_swar);
+#ifdef DG__MISC_HAVE_SSE2
+	addImpl(impls, &numImpls, "sse2", memrchr_sse2);
+#endif
+#ifdef DG__MISC_HAVE_AVX2
+	if(haveAVX2())  addImpl(impls, &numImpls, "avx2", memrchr_avx2);
+#endif
+
+	for(size_t a=0; a < sizeof(aligns)/sizeof(aligns[0]); ++a)
+	{
+		for(size_t l=0; l < sizeof(lengths)/sizeof(lengths[0]); ++l)
+		{
+			// the byte is only at the very start, so the whole buffer is searched
+			size_t len = lengths[l];
+			char* b = buf + aligns[a];
+			fillRandom(b, len);
+			b[0] = '#';
+			memset(&d, 0, sizeof(d));
+			d.inputs[0] = b;
+			d.inputLens[0] = len;
+			d.numInputs = 1;
+			d.c = '#';
+			d.bytesPerCall = len;
+			sprintf(caseName, "len %d, align %d", (int)len, (int)aligns[a]);
+			runBench(caseName, impls, numImpls, &d);
+		}
+	}
+	free(buf);
+}
+
+// *** DG_strlcpy() and DG_strlcat() ***
+
+// the libc only has strlcpy() on the BSDs, macOS and with glibc 2.38 and newer
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) \
+    || (defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38)))
+  #define HAVE_LIBC_STRLCPY
+#endif
+
+#define STRLCPY_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		size_t k = i % d->numInputs; \
+		const char* src = d->inputs[k]; \
+		char* dst = d->dst; \
+		size_t dstSize = d->dstSize; \
+		(void)dstSize; \
+		return call; \
+	}
+
+#ifdef HAVE_LIBC_STRLCPY
+STRLCPY_WRAPPER(strlcpy_libc, strlcpy(dst, src, dstSize))
+#endif
+STRLCPY_WRAPPER(strlcpy_DG, DG_strlcpy(dst, src, dstSize))
+STRLCPY_WRAPPER(strlcpy_swar, DG__strlcpy_level(dst, src, dstSize, DG__MISC_SIMD_NONE))
+STRLCPY_WRAPPER(strlcpy_sse2, DG__strlcpy_level(dst, src, dstSize, DG__MISC_SIMD_SSE2))
+STRLCPY_WRAPPER(strlcpy_avx2, DG__strlcpy_level(dst, src, dstSize, DG__MISC_SIMD_AVX2))
+// for comparison: what the old two-pass strlen() + memcpy() costs
+static size_t strlcpy_2pass(const BenchData* d, size_t i)
+{
+	const char* src = d->inputs[i % d->numInputs];
+	size_t srclen = strlen(src);
+	size_t numchars = (srclen < d->dstSize - 1) ? srclen : d->dstSize - 1;
+	memcpy(d->dst, src, numchars);
+	d->dst[numchars] = '\0';
+	return srclen;
+}
+// and what strlen() alone costs
+STRLCPY_WRAPPER(strlcpy_ref, (dst[0] = src[0], strlen(src)))
+
+// strlcat() appends to a string of constant length, so reset its length first
+#ifdef HAVE_LIBC_STRLCPY
+STRLCPY_WRAPPER(strlcat_libc, (dst[16] = '\0', strlcat(dst, src, dstSize)))
+#endif
+STRLCPY_WRAPPER(strlcat_DG, (dst[16] = '\0', DG_strlcat(dst, src, dstSize)))
+
+static void benchStrlcpy(void)
+{
+	static const size_t lengths[] = { 8, 64, 1000, 65536 };
+	static const size_t randMaxLens[] = { 16, 64, 256 };
+	char* buf = allocBuffer(MAX_INPUTS * (256 + 128) + 65536);
+	char* dst = allocBuffer(65536 + 64);
+	BenchImpl impls[8];
+	BenchData d;
+	char caseName[64];
+
+	for(int cat = 0; cat < 2; ++cat)
+	{
+		int numImpls = 0;
+		if(cat == 0)
+		{
+			printf("\nDG_strlcpy() (with a big enough dst, \"2pass\" is strlen() + memcpy(), \"ref\" is strlen() only):\n");
+	#ifdef HAVE_LIBC_STRLCPY
+			addImpl(impls, &numImpls, "libc", strlcpy_libc);
+	#endif
+			addImpl(impls, &numImpls, "DG", strlcpy_DG);
+			addImpl(impls, &numImpls, "swar", strlcpy_swar);
+	#ifdef DG__MISC_HAVE_SSE2
+			addImpl(impls, &numImpls, "sse2", strlcpy_sse2);
+	#endif
+	#ifdef DG__MISC_HAVE_AVX2
+			if(haveAVX2())  addImpl(impls, &numImpls, "avx2", strlcpy_avx2);
+	#endif
+			addImpl(impls, &numImpls, "2pass", strlcpy_2pass);
+			addImpl(impls, &numImpls, "ref", strlcpy_ref);
+		}
+		else
+		{
+			printf("\nDG_strlcat() (appending to a string of 16 chars):\n");
+	#ifdef HAVE_LIBC_STRLCPY
+			addImpl(impls, &numImpls, "libc", strlcat_libc);
+	#endif
+			addImpl(impls, &numImpls, "DG", strlcat_DG);
+		}
+		memset(dst, 'x', 16);
+
+		for(size_t l=0; l < sizeof(lengths)/sizeof(lengths[0]) + sizeof(randMaxLens)/sizeof(randMaxLens[0]); ++l)
+		{
+			if(l < sizeof(lengths)/sizeof(lengths[0]))
+			{
+				setupStrings(&d, buf, lengths[l], 0, 0);
+				sprintf(caseName, "len %d", (int)lengths[l]);
+			}
+			else
+			{
+				size_t maxLen = randMaxLens[l - sizeof(lengths)/sizeof(lengths[0])];
+				setupStrings(&d, buf, 0, 0, maxLen);
+				sprintf(caseName, "random len 0..%d", (int)maxLen);
+			}
+			d.dst = dst;
+			d.dstSize = 65536 + 64;
+			runBench(caseName, impls, numImpls, &d);
+		}
+	}
+	free(dst);
+	free(buf);
+}
+
+// *** DG_StrPool ***
+
+static DG_StrPool benchPool;
+
+#define STRPOOL_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		size_t k = i % d->numInputs; \
+		const char* s = d->inputs[k]; \
+		size_t len = d->inputLens[k]; \
+		return (size_t)(call); \
+	}
+
+// what interning replaces: a copy per use of the string
+static size_t strndupAndFree(const char* s, size_t len)
+{
+	char* p = DG_strndup(s, len);
+	size_t ret = (unsigned char)p[0];
+	free(p);
+	return ret;
+}
+
+STRPOOL_WRAPPER(intern_DG,   (uintptr_t)DG_StrPool_InternN(&benchPool, s, len))
+STRPOOL_WRAPPER(find_DG,     DG_StrPool_Find(&benchPool, s, len))
+STRPOOL_WRAPPER(strndup_ref, strndupAndFree(s, len))
+
+static void benchStrPool(void)
+{
+	static const size_t randMaxLens[] = { 8, 16, 64 };
+	char* buf = allocBuffer(MAX_INPUTS * (64 + 128));
+	BenchImpl impls[3];
+	int numImpls = 0;
+	BenchData d;
+	char caseName[64];
+
+	printf("\nDG_StrPool_InternN() of strings that are already interned, and DG_StrPool_Find(),\n"
+	       "compared to DG_strndup() + free() (\"ref\"):\n");
+	addImpl(impls, &numImpls, "intern", intern_DG);
+	addImpl(impls, &numImpls, "find", find_DG);
+	addImpl(impls, &numImpls, "ref", strndup_ref);
+
+	for(size_t l=0; l < sizeof(randMaxLens)/sizeof(randMaxLens[0]); ++l)
+	{
+		setupStrings(&d, buf, 0, 0, randMaxLens[l]);
+		DG_StrPool_Init(&benchPool);
+		for(size_t i=0; i < d.numInputs; ++i)
+			DG_StrPool_InternN(&benchPool, d.inputs[i], d.inputLens[i]);
+		sprintf(caseName, "random len 0..%d", (int)randMaxLens[l]);
+		runBench(caseName, impls, numImpls, &d);
+		DG_StrPool_Free(&benchPool);
+	}
+	free(buf);
+}
+
+// *** DG_u64toa(), DG_i64toa(), DG_dtoa() and DG_ftoa() ***
+
+#define TOA_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		size_t k = i % d->numInputs; \
+		unsigned long long u = d->ints[k]; \
+		double v = d->doubles[k]; \
+		char buf[64]; \
+		(void)u; (void)v; \
+		return (size_t)(call) + (unsigned char)buf[0]; \
+	}
+
+TOA_WRAPPER(u64toa_libc, snprintf(buf, sizeof(buf), "%llu", u))
+TOA_WRAPPER(u64toa_DG,   DG_u64toa(buf, u))
+TOA_WRAPPER(i64toa_libc, snprintf(buf, sizeof(buf), "%lld", (long long)u))
+TOA_WRAPPER(i64toa_DG,   DG_i64toa(buf, (long long)u))
+TOA_WRAPPER(dtoa_libc,   snprintf(buf, sizeof(buf), "%.17g", v))
+TOA_WRAPPER(dtoa_DG,     DG_dtoa(buf, v))
+TOA_WRAPPER(ftoa_libc,   snprintf(buf, sizeof(buf), "%.9g", (float)v))
+TOA_WRAPPER(ftoa_DG,     DG_ftoa(buf, (float)v))
+
+static void benchToA(void)
+{
+	static unsigned long long ints[MAX_INPUTS];
+	static double doubles[MAX_INPUTS];
+	BenchImpl impls[2];
+	BenchData d;
+	char buf[64];
+
+	// the results are printed as time per output char
+	static const char* cases[] = {
+		"u64toa, small (0..999)", "u64toa, random 64bit", "i64toa, random +/-32bit",
+		"dtoa, random 0..1", "dtoa, random bits", "dtoa, short (x.yz)", "ftoa, random 0..1", "ftoa, short (x.yz)"
+	};
+	printf("\nNumber formatting (libc is snprintf(), time per output char):\n");
+	for(size_t c=0; c < sizeof(cases)/sizeof(cases[0]); ++c)
+	{
+		memset(&d, 0, sizeof(d));
+		size_t totalLen = 0;
+		for(size_t i=0; i<MAX_INPUTS; ++i)
+		{
+			unsigned long long r = ((unsigned long long)rand() << 42) ^ ((unsigned long long)rand() << 21) ^ (unsigned long long)rand();
+			switch(c)
+			{
+				case 0: ints[i] = r % 1000; break;
+				case 1: ints[i] = r ^ ((unsigned long long)rand() << 60); break;
+				case 2: ints[i] = (unsigned long long)(long long)(int)(r & 0xFFFFFFFFu); break;
+				case 3: case 6: doubles[i] = (double)rand() / RAND_MAX; break;
+				case 4:
+					do {
+						memcpy(&doubles[i], &r, sizeof(r));
+						r = ((unsigned long long)rand() << 42) ^ ((unsigned long long)rand() << 21) ^ (unsigned long long)rand();
+					} while(doubles[i] != doubles[i] || doubles[i] - doubles[i] != 0.0); // no nan or inf
+					break;
+				case 5: case 7: doubles[i] = (double)(rand() % 1000) / 100.0; break;
+			}
+			if(c < 3)       totalLen += (c == 2) ? DG_i64toa(buf, (long long)ints[i]) : DG_u64toa(buf, ints[i]);
+			else if(c < 6)  totalLen += DG_dtoa(buf, doubles[i]);
+			else            totalLen += DG_ftoa(buf, (float)doubles[i]);
+		}
+		d.ints = ints;
+		d.doubles = doubles;
+		d.numInputs = MAX_INPUTS;
+		d.bytesPerCall = totalLen / MAX_INPUTS;
+
+		int numImpls = 0;
+		if(c < 2)       { addImpl(impls, &numImpls, "libc", u64toa_libc); addImpl(impls, &numImpls, "DG", u64toa_DG); }
+		else if(c == 2) { addImpl(impls, &numImpls, "libc", i64toa_libc); addImpl(impls, &numImpls, "DG", i64toa_DG); }
+		else if(c < 6)  { addImpl(impls, &numImpls, "libc", dtoa_libc);   addImpl(impls, &numImpls, "DG", dtoa_DG); }
+		else            { addImpl(impls, &numImpls, "libc", ftoa_libc);   addImpl(impls, &numImpls, "DG", ftoa_DG); }
+		runBench(cases[c], impls, numImpls, &d);
+	}
+}
+
+// *** DG_strtou64(), DG_strtoi64(), DG_strtod() and DG_strtof() ***
+
+#define PARSE_WRAPPER(name, type, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		size_t k = i % d->numInputs; \
+		const char* s = d->inputs[k]; \
+		size_t len = d->inputLens[k]; \
+		char* end = NULL; \
+		type v = 0; \
+		(void)len; (void)end; \
+		const char* e = (call); \
+		return (size_t)(e - s) + (size_t)v; \
+	}
+
+PARSE_WRAPPER(strtou64_libc, unsigned long long, (v = strtoull(s, &end, 10), end))
+PARSE_WRAPPER(strtou64_DG,   unsigned long long, DG_strtou64(s, len, &v, 10, NULL))
+PARSE_WRAPPER(strtoi64_libc, long long,          (v = strtoll(s, &end, 10), end))
+PARSE_WRAPPER(strtoi64_DG,   long long,          DG_strtoi64(s, len, &v, 10, NULL))
+PARSE_WRAPPER(strtod_libc,   double,             (v = strtod(s, &end), end))
+PARSE_WRAPPER(strtod_DG,     double,             DG_strtod(s, len, &v, NULL))
+PARSE_WRAPPER(strtof_libc,   float,              (v = strtof(s, &end), end))
+PARSE_WRAPPER(strtof_DG,     float,              DG_strtof(s, len, &v, NULL))
+
+static void benchParse(void)
+{
+	static char strs[MAX_INPUTS][64];
+	BenchImpl impls[2];
+	BenchData d;
+
+	// the results are printed as time per input char
+	static const char* cases[] = {
+		"strtou64, small (0..999)", "strtou64, random 64bit", "strtoi64, random +/-32bit",
+		"strtod, shortest (DG_dtoa)", "strtod, %.17g", "strtod, short (x.yz)", "strtod, 30 digits",
+		"strtof, shortest (DG_ftoa)"
+	};
+	printf("\nNumber parsing (libc is strtoull() etc, time per input char):\n");
+	for(size_t c=0; c < sizeof(cases)/sizeof(cases[0]); ++c)
+	{
+		memset(&d, 0, sizeof(d));
+		size_t totalLen = 0;
+		for(size_t i=0; i<MAX_INPUTS; ++i)
+		{
+			unsigned long long r = ((unsigned long long)rand() << 42) ^ ((unsigned long long)rand() << 21) ^ (unsigned long long)rand();
+			double v;
+			do {
+				memcpy(&v, &r, sizeof(r));
+				r = ((unsigned long long)rand() << 42) ^ ((unsigned long long)rand() << 21) ^ (unsigned long long)rand();
+			} while(v != v || v - v != 0.0); // no nan or inf
+			char* s = strs[i];
+			switch(c)
+			{
+				case 0: DG_u64toa(s, r % 1000); break;
+				case 1: DG_u64toa(s, r ^ ((unsigned long long)rand() << 60)); break;
+				case 2: DG_i64toa(s, (long long)(int)(r & 0xFFFFFFFFu)); break;
+				case 3: DG_dtoa(s, v); break;
+				case 4: snprintf(s, 64, "%.17g", v); break;
+				case 5: snprintf(s, 64, "%.2f", (double)(rand() % 1000) / 100.0); break;
+				case 6: snprintf(s, 64, "%.29e", v); break;
+				case 7: DG_ftoa(s, (float)((double)rand() / RAND_MAX)); break;
+			}
+			d.inputs[i] = s;
+			d.inputLens[i] = strlen(s);
+			totalLen += d.inputLens[i];
+		}
+		d.numInputs = MAX_INPUTS;
+		d.bytesPerCall = totalLen / MAX_INPUTS;
+
+		int numImpls = 0;
+		if(c < 2)       { addImpl(impls, &numImpls, "libc", strtou64_libc); addImpl(impls, &numImpls, "DG", strtou64_DG); }
+		else if(c == 2) { addImpl(impls, &numImpls, "libc", strtoi64_libc); addImpl(impls, &numImpls, "DG", strtoi64_DG); }
+		else if(c < 7)  { addImpl(impls, &numImpls, "libc", strtod_libc);   addImpl(impls, &numImpls, "DG", strtod_DG); }
+		else            { addImpl(impls, &numImpls, "libc", strtof_libc);   addImpl(impls, &numImpls, "DG", strtof_DG); }
+		runBench(cases[c], impls, numImpls, &d);
+	}
+}
+
+// *** DG_utf8_validate(), DG_utf8_to_utf16() and DG_utf16_to_utf8() ***
+
+// for comparison: checking one sequence after another, without skipping ASCII chars in blocks
+static size_t utf8ValidateBytewise(const unsigned char* s, size_t len)
+{
+	size_t i = 0;
+	while(i < len)
+	{
+		size_t seqLen = DG__Utf8SeqLen(s + i, len - i);
+		if(seqLen == 0)  return i;
+		i += seqLen;
+	}
+	return len;
+}
+
+#define UTF_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		size_t k = i % d->numInputs; \
+		const unsigned char* s = (const unsigned char*)d->inputs[k]; \
+		size_t len = d->inputLens[k]; \
+		(void)s; (void)len; \
+		return call; \
+	}
+
+UTF_WRAPPER(utf8_validate_ref,  utf8ValidateBytewise(s, len))
+UTF_WRAPPER(utf8_validate_DG,   DG_utf8_validate((const char*)s, len))
+UTF_WRAPPER(utf8_validate_swar, DG__utf8_validate_level(s, len, DG__MISC_SIMD_NONE))
+UTF_WRAPPER(utf8_validate_sse2, DG__utf8_validate_level(s, len, DG__MISC_SIMD_SSE2))
+UTF_WRAPPER(utf8_validate_avx2, DG__utf8_validate_level(s, len, DG__MISC_SIMD_AVX2))
+
+#define UTF8TO16_(level) DG__utf8_to_utf16_level((unsigned short*)d->dst, d->dstSize / 2, s, len, NULL, level)
+UTF_WRAPPER(utf8_to_utf16_DG,   DG_utf8_to_utf16((unsigned short*)d->dst, d->dstSize / 2, (const char*)s, len, NULL))
+UTF_WRAPPER(utf8_to_utf16_swar, UTF8TO16_(DG__MISC_SIMD_NONE))
+UTF_WRAPPER(utf8_to_utf16_sse2, UTF8TO16_(DG__MISC_SIMD_SSE2))
+UTF_WRAPPER(utf8_to_utf16_avx2, UTF8TO16_(DG__MISC_SIMD_AVX2))
+
+// the input of these is UTF-16, len is in units (d->bytesPerCall is still the UTF-8 length)
+#define UTF16TO8_(level) DG__utf16_to_utf8_level((unsigned char*)d->dst, d->dstSize, (const unsigned short*)s, len, NULL, level)
+UTF_WRAPPER(utf16_to_utf8_DG,   DG_utf16_to_utf8(d->dst, d->dstSize, (const unsigned short*)s, len, NULL))
+UTF_WRAPPER(utf16_to_utf8_swar, UTF16TO8_(DG__MISC_SIMD_NONE))
+UTF_WRAPPER(utf16_to_utf8_sse2, UTF16TO8_(DG__MISC_SIMD_SSE2))
+UTF_WRAPPER(utf16_to_utf8_avx2, UTF16TO8_(DG__MISC_SIMD_AVX2))
+
+static void benchUtf(void)
+{
+	static const size_t lengths[] = { 100, 4096, 1 << 20 };
+	// the texts: which code points are used, in how many percent of the chars
+	static const struct { const char* name; int percent; unsigned int first, num; } texts[] = {
+		{ "ASCII", 0, 0, 0 },
+		{ "latin (5% 2 bytes)", 5, 0xC0, 0x40 },
+		{ "cyrillic (2 bytes)", 90, 0x410, 0x40 },
+		{ "CJK (3 bytes)", 90, 0x4E00, 0x5000 },
+		{ "emoji (10% 4 bytes)", 10, 0x1F600, 0x50 },
+	};
+	size_t maxLen = lengths[sizeof(lengths)/sizeof(lengths[0]) - 1];
+	unsigned char* utf8 = (unsigned char*)allocBuffer(maxLen);
+	unsigned short* utf16 = (unsigned short*)allocBuffer(maxLen * 2);
+	char* dst = allocBuffer(maxLen * 2);
+	BenchImpl impls[3][6];
+	int numImpls[3] = { 0, 0, 0 };
+	BenchData d;
+	char caseName[64];
+
+	addImpl(impls[0], &numImpls[0], "bytes", utf8_validate_ref);
+	addImpl(impls[0], &numImpls[0], "DG", utf8_validate_DG);
+	addImpl(impls[0], &numImpls[0], "swar", utf8_validate_swar);
+	addImpl(impls[1], &numImpls[1], "DG", utf8_to_utf16_DG);
+	addImpl(impls[1], &numImpls[1], "swar", utf8_to_utf16_swar);
+	addImpl(impls[2], &numImpls[2], "DG", utf16_to_utf8_DG);
+	addImpl(impls[2], &numImpls[2], "swar", utf16_to_utf8_swar);
+#ifdef DG__MISC_HAVE_SSE2
+	addImpl(impls[0], &numImpls[0], "sse2", utf8_validate_sse2);
+	addImpl(impls[1], &numImpls[1], "sse2", utf8_to_utf16_sse2);
+	addImpl(impls[2], &numImpls[2], "sse2", utf16_to_utf8_sse2);
+#endif
+#ifdef DG__MISC_HAVE_AVX2
+	if(haveAVX2())
+	{
+		addImpl(impls[0], &numImpls[0], "avx2", utf8_validate_avx2);
+		addImpl(impls[1], &numImpls[1], "avx2", utf8_to_utf16_avx2);
+		addImpl(impls[2], &numImpls[2], "avx2", utf16_to_utf8_avx2);
+	}
+#endif
+
+	static const char* funcNames[3] = { "DG_utf8_validate()", "DG_utf8_to_utf16()", "DG_utf16_to_utf8()" };
+	for(int f=0; f<3; ++f)
+	{
+		printf("\n%s (\"bytes\" checks one sequence after the other, time per UTF-8 byte):\n", funcNames[f]);
+		for(size_t t=0; t < sizeof(texts)/sizeof(texts[0]); ++t)
+		{
+			for(size_t l=0; l < sizeof(lengths)/sizeof(lengths[0]); ++l)
+			{
+				// random text of (about) the given length, with a few spaces
+				srand(42);
+				size_t len = 0;
+				while(len + 4 <= lengths[l])
+				{
+					unsigned int cp = (rand() % 100 < texts[t].percent) ? texts[t].first + rand() % texts[t].num
+					                : (rand() % 8 == 0) ? ' ' : 'a' + (unsigned int)rand() % 26;
+					unsigned short u[2];
+					size_t ulen = 1;
+					if(cp >= 0x10000)
+					{
+						u[0] = (unsigned short)(0xD800 | ((cp - 0x10000) >> 10));
+						u[1] = (unsigned short)(0xDC00 | ((cp - 0x10000) & 0x3FF));
+						ulen = 2;
+					}
+					else
+					{
+						u[0] = (unsigned short)cp;
+					}
+					len += DG_utf16_to_utf8((char*)utf8 + len, 4, u, ulen, NULL);
+				}
+				size_t len16 = DG_utf8_to_utf16(utf16, maxLen, (const char*)utf8, len, NULL);
+
+				memset(&d, 0, sizeof(d));
+				d.inputs[0] = (f == 2) ? (const char*)utf16 : (const char*)utf8;
+				d.inputLens[0] = (f == 2) ? len16 : len;
+				d.numInputs = 1;
+				d.bytesPerCall = len;
+				d.dst = dst;
+				d.dstSize = maxLen * 2;
+				sprintf(caseName, "%s, len %d", texts[t].name, (int)len);
+				runBench(caseName, impls[f], numImpls[f], &d);
+			}
+		}
+	}
+	free(dst);
+	free(utf16);
+	free(utf8);
+}
+
+// *** DG_memimem(), DG_strcasestr() and DG_strncasecmp() ***
+
+#ifdef _WIN32
+  #define strncasecmp _strnicmp
+#else
+  #include <strings.h> // strncasecmp()
+#endif
+
+#ifdef __GLIBC__
+MEMMEM_WRAPPER(strcasestr_libc, strcasestr((const char*)h, (const char*)n))
+#endif
+MEMMEM_WRAPPER(memimem_DG,    DG_memimem(h, hl, n, nl))
+MEMMEM_WRAPPER(memimem_c,     DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_NONE, 1))
+MEMMEM_WRAPPER(memimem_sse2,  DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_SSE2, 1))
+MEMMEM_WRAPPER(memimem_avx2,  DG__memmem_level(h, hl, n, nl, DG__MISC_SIMD_AVX2, 1))
+
+#define STRCASECMP_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		size_t k = i % d->numInputs; \
+		const char* s1 = d->inputs[k]; \
+		const char* s2 = d->others[k]; \
+		size_t n = d->inputLens[k] + 1; \
+		return (size_t)(call); \
+	}
+
+STRCASECMP_WRAPPER(strncasecmp_libc, strncasecmp(s1, s2, n))
+STRCASECMP_WRAPPER(strncasecmp_DG,   DG_strncasecmp(s1, s2, n))
+STRCASECMP_WRAPPER(strncasecmp_c,    DG__strncasecmp_c((const unsigned char*)s1, (const unsigned char*)s2, n))
+STRCASECMP_WRAPPER(strncasecmp_sse2, DG__strncasecmp_sse2((const unsigned char*)s1, (const unsigned char*)s2, n))
+STRCASECMP_WRAPPER(strncasecmp_avx2, DG__strncasecmp_avx2((const unsigned char*)s1, (const unsigned char*)s2, n))
+
+// makes the ASCII letters in buf randomly uppercase or lowercase
+static void randomizeCase(char* buf, size_t size)
+{
+	for(size_t i=0; i<size; ++i)
+	{
+		if(buf[i] >= 'a' && buf[i] <= 'z' && (rand() & 1))  buf[i] -= 'a' - 'A';
+	}
+}
+
+static void benchIcase(void)
+{
+	static const size_t hayLens[] = { 1000, 1 << 20 };
+	static const size_t needleLens[] = { 4, 12, 32, 200, 1000 };
+	static const size_t cmpLengths[] = { 8, 64, 1000 };
+	size_t maxHayLen = 1 << 20;
+	char* buf = allocBuffer(MAX_INPUTS * (1000 + 64) + maxHayLen);
+	char* buf2 = allocBuffer(MAX_INPUTS * (1000 + 64));
+	char* needleBuf = allocBuffer(1000);
+	BenchImpl impls[6];
+	int numImpls = 0;
+	BenchData d;
+	char caseName[64];
+
+	printf("\nDG_memimem() (libc is strcasestr()):\n");
+#ifdef __GLIBC__
+	addImpl(impls, &numImpls, "libc", strcasestr_libc);
+#endif
+	addImpl(impls, &numImpls, "DG", memimem_DG);
+	addImpl(impls, &numImpls, "c", memimem_c);
+#ifdef DG__MISC_HAVE_SSE2
+	addImpl(impls, &numImpls, "sse2", memimem_sse2);
+#endif
+#ifdef DG__MISC_HAVE_AVX2
+	if(haveAVX2())  addImpl(impls, &numImpls, "avx2", memimem_avx2);
+#endif
+
+	for(size_t h=0; h < sizeof(hayLens)/sizeof(hayLens[0]); ++h)
+	{
+		size_t hl = hayLens[h];
+		for(size_t n=0; n < sizeof(needleLens)/sizeof(needleLens[0]); ++n)
+		{
+			size_t nl = needleLens[n];
+			if(nl > hl/4)  continue;
+			for(int match=1; match >= 0; --match)
+			{
+				// like in benchMemmem(), but the haystack has mixed case
+				// and the needle is lowercase
+				memset(&d, 0, sizeof(d));
+				char* hay = buf + 1; // unaligned
+				fillRandom(hay, hl);
+				fillRandom(needleBuf, nl);
+				needleBuf[nl/2] = '#';
+				needleBuf[nl] = '\0';
+				if(match)  memcpy(hay + (hl - nl) / 2, needleBuf, nl);
+				randomizeCase(hay, hl);
+				hay[hl] = '\0';
+
+				d.inputs[0] = hay;
+				d.inputLens[0] = hl;
+				d.numInputs = 1;
+				d.needle = needleBuf;
+				d.needleLen = nl;
+				d.bytesPerCall = match ? hl / 2 : hl;
+				sprintf(caseName, "hay %d, needle %d, %s", (int)hl, (int)nl, match ? "match" : "none");
+				runBench(caseName, impls, numImpls, &d);
+			}
+		}
+	}
+
+	printf("\nDG_strncasecmp() (equal strings with different case):\n");
+	numImpls = 0;
+	addImpl(impls, &numImpls, "libc", strncasecmp_libc);
+	addImpl(impls, &numImpls, "DG", strncasecmp_DG);
+	addImpl(impls, &numImpls, "c", strncasecmp_c);
+#ifdef DG__MISC_HAVE_SSE2
+	addImpl(impls, &numImpls, "sse2", strncasecmp_sse2);
+#endif
+#ifdef DG__MISC_HAVE_AVX2
+	if(haveAVX2())  addImpl(impls, &numImpls, "avx2", strncasecmp_avx2);
+#endif
+
+	for(size_t l=0; l <= sizeof(cmpLengths)/sizeof(cmpLengths[0]); ++l)
+	{
+		if(l < sizeof(cmpLengths)/sizeof(cmpLengths[0]))
+		{
+			setupStrings(&d, buf, cmpLengths[l], 0, 0);
+			sprintf(caseName, "len %d", (int)cmpLengths[l]);
+		}
+		else
+		{
+			setupStrings(&d, buf, 0, 0, 64);
+			sprintf(caseName, "random len 0..64");
+		}
+		// the other strings are copies with randomized case, at the same offsets in buf2
+		for(size_t i=0; i < d.numInputs; ++i)
+		{
+			char* other = buf2 + (d.inputs[i] - buf);
+			memcpy(other, d.inputs[i], d.inputLens[i] + 1);
+			randomizeCase(other, d.inputLens[i]);
+			d.others[i] = other;
+		}
+		runBench(caseName, impls, numImpls, &d);
+	}
+
+	free(needleBuf);
+	free(buf2);
+	free(buf);
+}
+
+// *** DG_hash64() and DG_crc32c() ***
+
+// for comparison: the 64-bit FNV-1a hash, a common "simple and fast enough" choice
+static unsigned long long fnv1a64(const unsigned char* p, size_t len)
+{
+	unsigned long long h = 0xCBF29CE484222325uLL;
+	for(size_t i=0; i<len; ++i)
+		h = (h ^ p[i]) * 0x100000001B3uLL;
+	return h;
+}
+
+// hashes the data in chunks of 1000 bytes, with the streaming API
+static unsigned long long hash64Streaming(const unsigned char* p, size_t len)
+{
+	DG_Hash64State st;
+	DG_Hash64_Init(&st, 0);
+	while(len > 1000)
+	{
+		DG_Hash64_Update(&st, p, 1000);
+		p += 1000;
+		len -= 1000;
+	}
+	DG_Hash64_Update(&st, p, len);
+	return DG_Hash64_Final(&st);
+}
+
+#define HASH_WRAPPER(name, call) \
+	static size_t name(const BenchData* d, size_t i) { \
+		size_t k = i % d->numInputs; \
+		const unsigned char* p = (const unsigned char*)d->inputs[k]; \
+		size_t len = d->inputLens[k]; \
+		return (size_t)(call); \
+	}
+
+HASH_WRAPPER(hash_fnv1a,  fnv1a64(p, len))
+HASH_WRAPPER(hash_DG,     DG_hash64(p, len, 0))
+HASH_WRAPPER(hash_stream, hash64Streaming(p, len))
+HASH_WRAPPER(hash_c,      DG__hash64_level(p, len, 0, DG__MISC_SIMD_NONE))
+HASH_WRAPPER(hash_sse2,   DG__hash64_level(p, len, 0, DG__MISC_SIMD_SSE2))
+HASH_WRAPPER(hash_avx2,   DG__hash64_level(p, len, 0, DG__MISC_SIMD_AVX2))
+
+HASH_WRAPPER(crc32c_DG,    DG_crc32c(0, p, len))
+HASH_WRAPPER(crc32c_table, DG__crc32c_table(0, p, len))
+#ifdef DG__MISC_HAVE_CRC32C
+HASH_WRAPPER(crc32c_sse42, DG__crc32c_sse42(0, p, len))
+#endif
+
+static void benchHash(void)
+{
+	static const size_t lengths[] = { 8, 32, 200, 4096, 1 << 20 };
+	size_t maxLen = 1 << 20;
+	// several inputs for the short lengths, so it's not always the same address
+	char* buf = allocBuffer(maxLen + MAX_INPUTS * 64);
+	BenchImpl impls[2][6];
+	int numImpls[2] = { 0, 0 };
+	BenchData d;
+	char caseName[64];
+
+	for(size_t i=0; i < maxLen + MAX_INPUTS * 64; ++i)
+		buf[i] = (char)rand();
+
+	addImpl(impls[0], &numImpls[0], "fnv1a", hash_fnv1a);
+	addImpl(impls[0], &numImpls[0], "DG", hash_DG);
+	addImpl(impls[0], &numImpls[0], "stream", hash_stream);
+	addImpl(impls[0], &numImpls[0], "c", hash_c);
+#ifdef DG__MISC_HAVE_SSE2
+	addImpl(impls[0], &numImpls[0], "sse2", hash_sse2);
+#endif
+#ifdef DG__MISC_HAVE_AVX2
+	if(haveAVX2())  addImpl(impls[0], &numImpls[0], "avx2", hash_avx2);
+#endif
+	addImpl(impls[1], &numImpls[1], "DG", crc32c_DG);
+	addImpl(impls[1], &numImpls[1], "table", crc32c_table);
+#ifdef DG__MISC_HAVE_CRC32C
+  #ifndef DG__MISC_ALWAYS_CRC32C
+	if(DG__MiscHaveCrc32c())
+  #endif
+		addImpl(impls[1], &numImpls[1], "sse4.2", crc32c_sse42);
+#endif
+
+	static const char* funcNames[2] = {
+		"DG_hash64() (fnv1a is a bytewise FNV-1a loop, stream uses DG_Hash64_Update() with 1000 byte chunks)",
+		"DG_crc32c() (table is the slicing-by-8 version, sse4.2 uses the crc32 instruction)"
+	};
+	for(int f=0; f<2; ++f)
+	{
+		printf("\n%s:\n", funcNames[f]);
+		for(size_t l=0; l < sizeof(lengths)/sizeof(lengths[0]); ++l)
+		{
+			size_t len = lengths[l];
+			memset(&d, 0, sizeof(d));
+			d.numInputs = (len < 4096) ? MAX_INPUTS : 1;
+			for(size_t i=0; i < d.numInputs; ++i)
+			{
+				d.inputs[i] = buf + i * 64 + i % 8;
+				d.inputLens[i] = len;
+			}
+			d.bytesPerCall = len;
+			sprintf(caseName, "len %d", (int)len);
+			runBench(caseName, impls[f], numImpls[f], &d);
+		}
+	}
+	free(buf);
+}
+
+int main(int argc, char** argv)
+{
+	const char* only = (argc > 1) ? argv[1] : NULL;
+#define RUN_IF_SELECTED(name, call) \
+	if(only == NULL || strcmp(only, name) == 0)  call
+
+	pinToCPU();
+	srand(42);
+	printf("Implementations: libc, DG (the public DG_* function), and the specific ones\n");
+	printf("in DG_misc.h (plain C/SWAR, SSE2, AVX2 if the CPU supports it)\n");
+
+	RUN_IF_SELECTED("exepath", benchExePath());
+	RUN_IF_SELECTED("strnlen", benchStrlen(1));
+	else RUN_IF_SELECTED("strlen", benchStrlen(0));
+	RUN_IF_SELECTED("memmem", benchMemmem(0));
+	RUN_IF_SELECTED("memrmem", benchMemmem(1));
+	RUN_IF_SELECTED("memrchr", benchMemrchr());
+	RUN_IF_SELECTED("strlcpy", benchStrlcpy());
+	RUN_IF_SELECTED("strpool", benchStrPool());
+	RUN_IF_SELECTED("toa", benchToA());
+	RUN_IF_SELECTED("parse", benchParse());
+	RUN_IF_SELECTED("utf", benchUtf());
+	RUN_IF_SELECTED("icase", benchIcase());
+	RUN_IF_SELECTED("hash", benchHash());
+
+	return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * Benchmark for DG_dynarr.h arrays bound to a custom allocator (a per-frame arena)
+ * compared to arrays using the default allocator (malloc(), realloc(), free())
+ *
+ * Build with optimizations, for example:
+ *   gcc -O2 -o dynarr_bench dynarr_bench.c
+ *
+ * Each "frame" fills a few arrays with a random number of elements (like the lists of
+ * visible objects or of render commands of a game frame) and throws them away at the end.
+ * Each variant is run for a while to warm up, then timed a few times and the fastest
+ * run is reported.
+ * Furthermore, growing one huge array with the default allocator is compared to
+ * growing it with da_init_vm() (and to reserving the whole size up front).
+ *
+ * License:
+ *  This software is in the public domain. Where that dedication is not
+ *  recognized, you are granted a perpetual, irrevocable license to copy
+ *  and modify this file however you want.
+ *  No warranty implied; use at your own risk.
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+  #define _GNU_SOURCE // for mremap() in dg_dynarr_vm_allocator()
+#endif
+
+#define DG_DYNARR_IMPLEMENTATION
+#define DG_DYNARR_INDEX_CHECK_LEVEL 0
+#include "../DG_dynarr.h"
+
+#include <stdio.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <time.h>
+#endif
+
+#define WARMUP_NS   100e6
+#define RUN_NS      200e6
+#define NUM_RUNS    3
+
+#define ARRAYS_PER_FRAME  64
+
+DA_TYPEDEF(int, IntArray);
+
+typedef struct { unsigned char* mem; size_t used, size; } FrameArena;
+
+// returns a timestamp in nanoseconds
+static double getTimeNS(void)
+{
+#ifdef _WIN32
+	static LARGE_INTEGER freq = {0};
+	LARGE_INTEGER now;
+	if(freq.QuadPart == 0)  QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (double)now.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
+
+static void* arenaAlloc(void* ctx, size_t numBytes)
+{
+	FrameArena* arena = (FrameArena*)ctx;
+	size_t start = (arena->used + 15) & ~(size_t)15;
+	if(numBytes > arena->size - start)  return NULL;
+	arena->used = start + numBytes;
+	return arena->mem + start;
+}
+
+static void* arenaRealloc(void* ctx, void* ptr, size_t oldNumBytes, size_t newNumBytes)
+{
+	FrameArena* arena = (FrameArena*)ctx;
+	unsigned char* p = (unsigned char*)ptr;
+	if(p + oldNumBytes == arena->mem + arena->used && newNumBytes <= arena->size - (size_t)(p - arena->mem))
+	{
+		arena->used = (size_t)(p - arena->mem) + newNumBytes;
+		return ptr;
+	}
+	void* ret = arenaAlloc(ctx, newNumBytes);
+	if(ret != NULL)  memcpy(ret, ptr, (oldNumBytes < newNumBytes) ? oldNumBytes : newNumBytes);
+	return ret;
+}
+
+static void arenaFree(void* ctx, void* ptr, size_t numBytes)
+{
+	(void)ctx; (void)ptr; (void)numBytes; // everything is freed at the end of the frame
+}
+
+static unsigned int randState = 1;
+
+// the results of the frames end up here, so the compiler can't optimize the work away
+static volatile size_t sink;
+
+// simple LCG, so both variants get the same sequence of array sizes
+static unsigned int nextRand(void)
+{
+	randState = randState * 1103515245u + 12345u;
+	return randState >> 8;
+}
+
+// one frame, returns the number of elements in all its arrays
+static size_t runFrame(const dg_dynarr_allocator* alloc)
+{
+	IntArray arrays[ARRAYS_PER_FRAME];
+	size_t ret = 0;
+	int i, j;
+	for(i=0; i<ARRAYS_PER_FRAME; ++i)
+	{
+		int n = (int)(nextRand() % 2000);
+		if(alloc != NULL)  da_init_allocator(arrays[i], alloc);
+		else  da_init(arrays[i]);
+		for(j=0; j<n; ++j)  da_push(arrays[i], j);
+	}
+	for(i=0; i<ARRAYS_PER_FRAME; ++i)
+	{
+		ret += da_count(arrays[i]);
+		da_free(arrays[i]); // a no-op for the arena
+	}
+	if(alloc != NULL)  ((FrameArena*)alloc->ctx)->used = 0; // end of frame
+	return ret;
+}
+
+static void bench(const char* name, const dg_dynarr_allocator* alloc)
+{
+	double best = 1e300;
+	int r;
+	double start = getTimeNS();
+	while(getTimeNS() - start < WARMUP_NS)  sink += runFrame(alloc);
+
+	for(r=0; r<NUM_RUNS; ++r)
+	{
+		size_t numFrames = 0;
+		randState = 1;
+		start = getTimeNS();
+		double now;
+		do {
+			sink += runFrame(alloc);
+			++numFrames;
+			now = getTimeNS();
+		} while(now - start < RUN_NS);
+		double perFrame = (now - start) / (double)numFrames;
+		if(perFrame < best)  best = perFrame;
+	}
+	printf("  %-8s %10.2f us/frame\n", name, best / 1000.0);
+}
+
+#define HUGE_COUNT  (64*1024*1024) // 256MB of ints
+
+// pushes HUGE_COUNT ints to an array, initialized according to mode
+// (0: default allocator, 1: da_init_vm(), 2: default allocator with da_reserve())
+static void benchHuge(const char* name, int mode)
+{
+	double best = 1e300;
+	int r, i;
+	for(r=0; r<NUM_RUNS; ++r)
+	{
+		IntArray arr;
+		double start = getTimeNS();
+		if(mode == 1)  da_init_vm(arr);
+		else  da_init(arr);
+		if(mode == 2)  da_reserve(arr, HUGE_COUNT);
+		for(i=0; i<HUGE_COUNT; ++i)  da_push(arr, i);
+		sink += da_count(arr) + (size_t)arr.p[HUGE_COUNT/2];
+		da_free(arr);
+		double t = getTimeNS() - start;
+		if(t < best)  best = t;
+	}
+	printf("  %-8s %10.2f ms\n", name, best / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+	FrameArena arena;
+	dg_dynarr_allocator arenaAllocator = { arenaAlloc, arenaRealloc, arenaFree, NULL, NULL };
+	(void)argc; (void)argv;
+
+	// the arrays of one frame need at most ARRAYS_PER_FRAME * 2000 ints, plus some
+	// slack because arrays that aren't the last allocation have to move when growing
+	arena.size = (size_t)ARRAYS_PER_FRAME * 2048 * sizeof(int) * 4;
+	arena.mem = (unsigned char*)malloc(arena.size);
+	arena.used = 0;
+	arenaAllocator.ctx = &arena;
+	if(arena.mem == NULL)
+	{
+		printf("Couldn't allocate the arena!\n");
+		return 1;
+	}
+
+	printf("Filling %d arrays with 0..2000 ints per frame:\n", ARRAYS_PER_FRAME);
+	bench("malloc", NULL);
+	bench("arena", &arenaAllocator);
+
+	printf("\nPushing %d ints to one array:\n", HUGE_COUNT);
+	benchHuge("malloc", 0);
+	benchHuge("vm", 1);
+	benchHuge("reserved", 2);
+
+	free(arena.mem);
+	return 0;
+}
@@ -1,5 +1,14 @@
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+  #define _GNU_SOURCE // for mremap() in dg_dynarr_vm_allocator(), so testvm() covers it on Linux
+#endif
+
 #define DG_DYNARR_IMPLEMENTATION
 #define DG_DYNARR_INDEX_CHECK_LEVEL 3
+// small, so the tests also cover moving to a new reservation (where mremap() isn't available)
+#define DG_DYNARR_VM_RESERVE_BYTES (1024*1024)
+// count OOMs instead of asserting, testoom() provokes them
+static int numOutOfMemory = 0;
+#define DG_DYNARR_OUT_OF_MEMORY  ++numOutOfMemory;
 #include "../DG_dynarr.h"
 
 #include <stdio.h>
@@ -291,10 +300,315 @@ static void testfoo()
 	da_free(fa2);
 }
 
+static void testgrowth()
+{
+	MyIntArrType arr = {0};
+	size_t lastcap = 0;
+	for(int i=0; i<100000; ++i)
+	{
+		da_push(arr, i);
+		if(da_capacity(arr) != lastcap)
+		{
+			// grows at least by the growth factor or by DG_DYNARR_LINEAR_GROWTH_BYTES
+			size_t linear = lastcap + DG_DYNARR_LINEAR_GROWTH_BYTES/sizeof(int);
+			size_t factor = lastcap + lastcap*(DG_DYNARR_GROWTH_NUM-DG_DYNARR_GROWTH_DEN)/DG_DYNARR_GROWTH_DEN;
+			assert(da_capacity(arr) >= factor || (linear > lastcap && da_capacity(arr) >= linear));
+			lastcap = da_capacity(arr);
+		}
+		assert(da_capacity(arr) >= da_count(arr));
+	}
+	assert(da_count(arr) == 100000 && arr.p[99999] == 99999);
+	assert(da_capacity(arr) >= DG_DYNARR_MIN_CAPACITY);
+
+	da_free(arr);
+	da_reserve(arr, 3);
+#ifdef DG_DYNARR_ROUND_TO_SIZE_CLASSES
+	// the capacity includes the bytes the allocator rounds up to
+	assert(da_capacity(arr) >= DG_DYNARR_MIN_CAPACITY);
+	assert(da_capacity(arr)*sizeof(int) <= DG_DYNARR_GOOD_SIZE(da_capacity(arr)*sizeof(int)));
+	da_reserve(arr, 1001);
+	assert(da_capacity(arr) >= 1001 && da_capacity(arr) <= DG_DYNARR_GOOD_SIZE(1001*sizeof(int))/sizeof(int));
+
+	// big arrays are rounded up to huge pages
+	size_t bigcap = 16*DG_DYNARR_HUGEPAGE_SIZE/sizeof(int) + 1;
+	da_reserve(arr, bigcap);
+	assert(da_capacity(arr) >= bigcap && (da_capacity(arr)*sizeof(int)) % DG_DYNARR_HUGEPAGE_SIZE == 0);
+#else
+	// without DG_DYNARR_ROUND_TO_SIZE_CLASSES the capacity is exactly what the growth policy says
+	assert(da_capacity(arr) == DG_DYNARR_MIN_CAPACITY);
+	da_reserve(arr, 1001);
+	assert(da_capacity(arr) == 1001);
+	da_setcount(arr, 1001);
+	da_push(arr, 42);
+	assert(da_capacity(arr) == 1001 + 1001*(DG_DYNARR_GROWTH_NUM-DG_DYNARR_GROWTH_DEN)/DG_DYNARR_GROWTH_DEN);
+#endif
+	da_free(arr);
+}
+
+// counts the allocated bytes, to check that the array uses its allocator with the right sizes
+typedef struct { size_t numAllocs, numFrees, bytesInUse; } AllocStats;
+
+static void* countingAlloc(void* ctx, size_t numBytes)
+{
+	AllocStats* stats = (AllocStats*)ctx;
+	stats->numAllocs++;
+	stats->bytesInUse += numBytes;
+	return malloc(numBytes);
+}
+
+static void* countingRealloc(void* ctx, void* ptr, size_t oldNumBytes, size_t newNumBytes)
+{
+	AllocStats* stats = (AllocStats*)ctx;
+	void* ret = realloc(ptr, newNumBytes);
+	if(ret != NULL)  stats->bytesInUse += newNumBytes - oldNumBytes;
+	return ret;
+}
+
+static void countingFree(void* ctx, void* ptr, size_t numBytes)
+{
+	AllocStats* stats = (AllocStats*)ctx;
+	stats->numFrees++;
+	stats->bytesInUse -= numBytes;
+	free(ptr);
+}
+
+// pretend the allocator has 64 byte size classes
+static size_t countingGoodSize(void* ctx, size_t numBytes)
+{
+	(void)ctx;
+	return (numBytes + 63) & ~(size_t)63;
+}
+
+static void testallocator()
+{
+	AllocStats stats = {0};
+	dg_dynarr_allocator alloc = { countingAlloc, countingRealloc, countingFree, NULL, &stats };
+	FooArray fa;
+	da_init_allocator(fa, &alloc);
+	assert(da_count(fa) == 0 && da_capacity(fa) == 0 && fa.p == NULL);
+
+	for(int i=0; i<100; ++i)
+	{
+		Foo f = {i, i*0.5};
+		da_push(fa, f);
+		assert(stats.bytesInUse == da_capacity(fa)*sizeof(Foo));
+	}
+	assert(stats.numAllocs == 1 && fa.p[99].i == 99 && dblEq(fa.p[42].d, 21.0));
+	// without good_size(), the capacity isn't rounded
+	assert(da_capacity(fa) == 128);
+
+	// with custom allocators, shrinking uses their realloc()
+	da_setcount(fa, 10);
+	da_shrink_to_fit(fa);
+	assert(da_capacity(fa) == 10 && stats.bytesInUse == 10*sizeof(Foo) && stats.numFrees == 0);
+	assert(fa.p[9].i == 9);
+
+	// after da_free() the array still uses the allocator
+	da_free(fa);
+	assert(stats.bytesInUse == 0 && stats.numFrees == 1);
+	(void)da_addn_zeroed(fa, 5);
+	assert(stats.numAllocs == 2 && stats.bytesInUse == da_capacity(fa)*sizeof(Foo));
+	da_free(fa);
+
+	alloc.good_size = countingGoodSize;
+	MyIntArrType ia;
+	da_init_allocator(ia, &alloc);
+	da_reserve(ia, 5); // 8 ints (DG_DYNARR_MIN_CAPACITY) => 32 bytes => rounded to 64
+	assert(da_capacity(ia) == 64/sizeof(int) && stats.bytesInUse == 64);
+	da_reserve(ia, 41); // 41 ints => 164 bytes => 192
+	assert(da_capacity(ia) == 192/sizeof(int) && stats.bytesInUse == 192);
+	da_free(ia);
+	assert(stats.bytesInUse == 0 && stats.numAllocs == stats.numFrees);
+
+	// an external buffer is copied to memory from the allocator when it's full
+	Foo buf[2];
+	da_init_external_allocator(fa, buf, 2, &alloc);
+	Foo f = {7, 8.0};
+	da_push(fa, f); da_push(fa, f);
+	assert(fa.p == buf && stats.bytesInUse == 0);
+	da_push(fa, f);
+	assert(fa.p != buf && da_count(fa) == 3 && stats.bytesInUse == da_capacity(fa)*sizeof(Foo));
+	da_free(fa);
+	assert(stats.bytesInUse == 0);
+
+	// da_init() makes it use the default allocator again
+	size_t numAllocs = stats.numAllocs;
+	da_init(fa);
+	da_push(fa, f);
+	assert(stats.bytesInUse == 0 && stats.numAllocs == numAllocs);
+	da_free(fa);
+}
+
+// an allocator that fails once more than maxBytes would be in use
+typedef struct { size_t maxBytes, bytesInUse; } LimitedAlloc;
+
+static void* limitedAlloc(void* ctx, size_t numBytes)
+{
+	LimitedAlloc* la = (LimitedAlloc*)ctx;
+	if(numBytes > la->maxBytes - la->bytesInUse)  return NULL;
+	la->bytesInUse += numBytes;
+	return malloc(numBytes);
+}
+
+static void* limitedRealloc(void* ctx, void* ptr, size_t oldNumBytes, size_t newNumBytes)
+{
+	LimitedAlloc* la = (LimitedAlloc*)ctx;
+	if(newNumBytes > oldNumBytes && newNumBytes - oldNumBytes > la->maxBytes - la->bytesInUse)  return NULL;
+	void* ret = realloc(ptr, newNumBytes);
+	if(ret != NULL)  la->bytesInUse += newNumBytes - oldNumBytes;
+	return ret;
+}
+
+static void limitedFree(void* ctx, void* ptr, size_t numBytes)
+{
+	LimitedAlloc* la = (LimitedAlloc*)ctx;
+	la->bytesInUse -= numBytes;
+	free(ptr);
+}
+
+static void testoom()
+{
+	LimitedAlloc la = { 64*sizeof(int), 0 };
+	dg_dynarr_allocator alloc = { limitedAlloc, limitedRealloc, limitedFree, NULL, &la };
+	MyIntArrType arr;
+	da_init_allocator(arr, &alloc);
+	numOutOfMemory = 0;
+
+	int i;
+	for(i=0; i<100; ++i)  da_push(arr, i);
+	// growing to 64 worked, growing to 128 didn't => the first 64 elements are still there
+	assert(da_oom(arr) && numOutOfMemory == 36);
+	assert(da_count(arr) == 64 && da_capacity(arr) == 64);
+	for(i=0; i<64; ++i)  assert(arr.p[i] == i);
+
+	// all the other ways to grow fail as well and leave the array alone
+	int x = 0;
+	da_insert(arr, 3, x++);
+	assert(x == 0 && da_count(arr) == 64 && arr.p[3] == 3);
+	assert(da_addn_uninit(arr, 1) == NULL && da_insertn_zeroed(arr, 0, 10) == NULL);
+	da_addn(arr, arr.p, 3);
+	da_setcount(arr, 65);
+	da_reserve(arr, 1000);
+	assert(da_count(arr) == 64 && da_capacity(arr) == 64 && arr.p[0] == 0 && arr.p[63] == 63);
+
+	// the flag is sticky: operations that work don't reset it
+	da_pop(arr);
+	da_push(arr, 63);
+	assert(da_oom(arr) && da_count(arr) == 64);
+
+	// after making more memory available, clear the flag and retry
+	la.maxBytes = 1000*sizeof(int);
+	da_oom_clear(arr);
+	assert(!da_oom(arr));
+	for(i=64; i<100; ++i)  da_push(arr, i);
+	assert(!da_oom(arr) && da_count(arr) == 100);
+	for(i=0; i<100; ++i)  assert(arr.p[i] == i);
+	da_free(arr);
+	assert(la.bytesInUse == 0);
+
+	// an external buffer is kept as well if the first allocation fails
+	int buf[4];
+	int vals[5] = {1, 2, 3, 4, 5};
+	la.maxBytes = 0;
+	da_init_external_allocator(arr, buf, 4, &alloc);
+	da_addn(arr, vals, 4);
+	assert(!da_oom(arr) && arr.p == buf && da_count(arr) == 4);
+	da_push(arr, 5);
+	assert(da_oom(arr) && arr.p == buf && da_count(arr) == 4 && da_capacity(arr) == 4 && buf[3] == 4);
+	da_free(arr);
+	assert(!da_oom(arr)); // da_free() resets the flag (the external buffer is still used)
+	numOutOfMemory = 0;
+}
+
+static void testvm()
+{
+	MyIntArrType arr;
+	da_init_vm(arr);
+	assert(da_count(arr) == 0 && da_capacity(arr) == 0 && arr.p == NULL);
+
+	const int n = 5*1000*1000;
+	for(int i=0; i<n; ++i)  da_push(arr, i);
+	assert(da_count(arr) == (size_t)n && da_capacity(arr) >= (size_t)n);
+	for(int i=0; i<n; ++i)  assert(arr.p[i] == i);
+
+	// shrinking (and growing again) keeps the elements
+	da_setcount(arr, 1000);
+	da_shrink_to_fit(arr);
+	assert(da_capacity(arr) == 1000 && arr.p[999] == 999);
+	int* added = da_addn_zeroed(arr, 100000);
+	assert(added != NULL && da_count(arr) == 101000 && arr.p[0] == 0 && arr.p[999] == 999 && arr.p[100999] == 0);
+	da_free(arr);
+	assert(da_count(arr) == 0 && da_capacity(arr) == 0 && arr.p == NULL);
+
+	// small arrays work too (but use at least a page)
+	da_push(arr, 42);
+	assert(da_count(arr) == 1 && arr.p[0] == 42 && da_capacity(arr) >= 8);
+	da_free(arr);
+}
+
+static void testappendreserve()
+{
+	DA_TYPEDEF(char, CharArray);
+	CharArray buf;
+	da_init(buf);
+
+	// write some data to a temporary file and read it back in chunks, straight into the array
+	FILE* f = tmpfile();
+	assert(f != NULL);
+	const int n = 100000;
+	for(int i=0; i<n; ++i)  fputc('a' + i%26, f);
+	rewind(f);
+	for(;;)
+	{
+		char* dst = da_append_reserve(buf, 1000);
+		assert(dst == buf.p + da_count(buf) && da_capacity(buf) - da_count(buf) >= 1000);
+		size_t numRead = fread(dst, 1, da_capacity(buf) - da_count(buf), f);
+		if(numRead == 0)  break;
+		da_commit(buf, numRead);
+	}
+	fclose(f);
+	assert(da_count(buf) == (size_t)n);
+	for(int i=0; i<n; ++i)  assert(buf.p[i] == 'a' + i%26);
+
+	// reserving doesn't add anything and doesn't grow if there's enough space
+	size_t cap = da_capacity(buf);
+	da_setcount(buf, 10);
+	assert(da_append_reserve(buf, 100) == buf.p + 10 && da_count(buf) == 10 && da_capacity(buf) == cap);
+	da_commit(buf, 0);
+	assert(da_count(buf) == 10);
+	da_free(buf);
+
+	// k = 0 on an empty array still returns a valid pointer (it's treated like 1)
+	char* dst0 = da_append_reserve(buf, 0);
+	assert(dst0 != NULL && dst0 == buf.p && da_count(buf) == 0 && da_capacity(buf) >= 1 && !da_oom(buf));
+	da_free(buf);
+
+	// if it can't grow, it returns NULL and the array is unchanged
+	LimitedAlloc la = { 64*sizeof(int), 0 };
+	dg_dynarr_allocator alloc = { limitedAlloc, limitedRealloc, limitedFree, NULL, &la };
+	MyIntArrType arr;
+	da_init_allocator(arr, &alloc);
+	numOutOfMemory = 0;
+	int* dst = da_append_reserve(arr, 64);
+	assert(dst != NULL && da_count(arr) == 0);
+	for(int i=0; i<64; ++i)  dst[i] = i;
+	da_commit(arr, 64);
+	assert(da_append_reserve(arr, 1) == NULL && numOutOfMemory == 1 && da_oom(arr));
+	assert(da_count(arr) == 64 && arr.p[63] == 63);
+	da_free(arr);
+	assert(la.bytesInUse == 0);
+	numOutOfMemory = 0;
+}
+
 int main(int argc, char** argv)
 {
 	testint();
 	testfoo();
+	testgrowth();
+	testallocator();
+	testvm();
+	testoom();
+	testappendreserve();
 
 	// if we got this far w/o assertion, things are good.
 	printf("success!\n");
@@ -1,5 +1,5 @@
 /*
- * Tests for DG_memrmem() and DG_strrstr()
+ * Tests for DG_memrmem() and DG_strrstr() (and the other DG_memmem*() variants)
  * (C) 2016 Daniel Gibson
  *
  * License:
@@ -116,6 +116,27 @@ static void teststrrstr(const char* haystack, const char* needle,
 #define TEST_STRRSTR(haystack, needle, resultIdx) \
 	teststrrstr(haystack, needle, resultIdx, __LINE__, __FUNCTION__)
 
+// resultIdx < 0 means "expect NULL"
+static void testmemmem(const char* haystack, size_t haystackLen, const char* needle, size_t needleLen,
+                       int resultIdx, int line, const char* func)
+{
+	const char* res = (const char*)DG_memmem(haystack, haystackLen, needle, needleLen);
+	const char* expected = (resultIdx < 0) ? NULL : haystack + resultIdx;
+	if(res != expected)
+	{
+		fail(func, line, "DG_memmem( \"%.*s\", %d, \"%.*s\", %d )\n\tdid not return %d but %d",
+		                  (int)haystackLen, haystack, (int)haystackLen,
+		                  (int)needleLen, needle, (int)needleLen, resultIdx,
+		                  (res != NULL) ? (int)(res-haystack) : -1);
+	}
+}
+
+#define TEST_MEMMEM(haystack, haystackLen, needle, needleLen, resultIdx) \
+	testmemmem(haystack, haystackLen, needle, needleLen, resultIdx, __LINE__, __FUNCTION__)
+
+#define TEST_MEMMEM_STR(haystack, needle, resultIdx) \
+	testmemmem(haystack, strlen(haystack), needle, strlen(needle), resultIdx, __LINE__, __FUNCTION__)
+
 static void testWithNullterminatedStrings()
 {
 	//                         111111111122
@@ -218,15 +239,458 @@ static void testDG_strrstr()
 	TEST_STRRSTR("haystack", "needle", -1); // SEE?! it's impossible to find needle in haystack.
 }
 
+static void testDG_memmem()
+{
+	// DG_memmem() uses different algorithms depending on the needle length,
+	// these tests try to cover all of them
+
+	//                         111111111122
+	//               0123456789012345678901
+	const char* s = "#asdfasdfasd2fasdfasd";
+	TEST_MEMMEM_STR(s, s, 0);
+	TEST_MEMMEM_STR(s, "#a", 0);
+	TEST_MEMMEM_STR(s, "asd", 1);
+	TEST_MEMMEM_STR(s, "d2f", 11);
+	TEST_MEMMEM_STR(s, "fasd", 4);
+	TEST_MEMMEM_STR(s, "sd2fasdfasd", 10);
+	TEST_MEMMEM_STR(s, "2a", -1);
+	TEST_MEMMEM_STR(s, "#asdfasdfasd2fasdfasdP", -1);
+	TEST_MEMMEM(s, strlen(s), "", 0, 0); // empty needle => return haystack
+	TEST_MEMMEM(s, strlen(s)+1, "d\0", 2, 20);
+
+	// long haystack of '\0's with the needle at the very end,
+	// for short, medium and long needles
+	static char buf[100000];
+	static char needle[1000];
+	size_t needleLens[] = { 2, 3, 15, 16, 17, 100, 255, 256, 257, 999 };
+	for(size_t i=0; i < sizeof(needleLens)/sizeof(needleLens[0]); ++i)
+	{
+		size_t nl = needleLens[i];
+		memset(buf, 0, sizeof(buf));
+		memset(needle, 0, nl);
+		needle[nl-2] = 'x'; // "\0\0 ... \0x\0"
+
+		TEST_MEMMEM(buf, sizeof(buf), needle, nl, -1);
+		buf[sizeof(buf)-2] = 'x';
+		TEST_MEMMEM(buf, sizeof(buf), needle, nl, (int)(sizeof(buf)-nl));
+		TEST_MEMMEM(buf, sizeof(buf)-1, needle, nl, -1);
+
+		// and the same with a periodic needle
+		memset(buf, 'a', sizeof(buf));
+		memset(needle, 'a', nl);
+		needle[nl-1] = 'b';
+		TEST_MEMMEM(buf, sizeof(buf), needle, nl, -1);
+		buf[sizeof(buf)-1] = 'b';
+		TEST_MEMMEM(buf, sizeof(buf), needle, nl, (int)(sizeof(buf)-nl));
+		buf[5000] = 'b';
+		TEST_MEMMEM(buf, sizeof(buf), needle, nl, (nl <= 5001) ? (int)(5001-nl) : (int)(sizeof(buf)-nl));
+	}
+}
+
+// simple (and slow) reference implementation to compare DG_memrmem() to
+static const char* naiveMemrmem(const char* h, size_t hl, const char* n, size_t nl)
+{
+	if(nl == 0)  return h + hl;
+	if(hl < nl)  return NULL;
+	size_t i = hl - nl + 1;
+	while(i-- > 0)
+	{
+		if(memcmp(h+i, n, nl) == 0)  return h+i;
+	}
+	return NULL;
+}
+
+static void testRandomized()
+{
+	// compare with naiveMemrmem() on random data with few different bytes,
+	// so there are lots of partial matches (and periodic needles)
+	static char h[3000];
+	static char n[600];
+	srand(42);
+	for(int iter=0; iter < 100000; ++iter)
+	{
+		int numChars = 1 + rand() % 4;
+		size_t hl = rand() % ((iter & 1) ? 3000 : 100);
+		size_t nl = rand() % ((iter & 2) ? 600 : 20);
+		for(size_t i=0; i<hl; ++i)  h[i] = 'a' + rand() % numChars;
+		for(size_t i=0; i<nl; ++i)  n[i] = 'a' + rand() % numChars;
+		if(nl > 0 && hl > nl && (iter & 4))
+		{
+			// make sure there's at least one match
+			memcpy(h + rand() % (hl - nl), n, nl);
+		}
+
+		const char* expected = naiveMemrmem(h, hl, n, nl);
+		TEST_MEMRMEM(h, hl, n, nl, (expected != NULL) ? (int)(expected - h) : -1);
+	}
+}
+
+// for DG_memmem_multi_all(): checks that the matches are reported in the
+// documented order and counts them per needle
+typedef struct {
+	size_t lastEnd;
+	size_t lastLen;
+	const size_t* needleLens;
+	size_t counts[8];
+} MultiAllState;
+
+static int countMultiMatch(void* userData, size_t needleID, size_t offset)
+{
+	MultiAllState* st = (MultiAllState*)userData;
+	size_t end = offset + st->needleLens[needleID];
+	if(end < st->lastEnd || (end == st->lastEnd && st->needleLens[needleID] > st->lastLen))
+		fail(__func__, __LINE__, "DG_memmem_multi_all() reported needle %d at %d out of order!", (int)needleID, (int)offset);
+	st->lastEnd = end;
+	st->lastLen = st->needleLens[needleID];
+	st->counts[needleID]++;
+	return 1;
+}
+
+static void testMultiNeedle()
+{
+	{
+		//                         11111111112
+		//               012345678901234567890
+		const char* h = "xxabcdxxbcdexxcdxabxx";
+		const char* needles[] = { "bcde", "abcd", "cd", "ab", "cd" };
+		size_t lens[] = { 4, 4, 2, 2, 2 };
+		DG_MultiNeedle* mn = DG_MultiNeedle_Create(needles, lens, 5);
+		if(mn == NULL)  fail(__func__, __LINE__, "DG_MultiNeedle_Create() failed!");
+
+		size_t id = 42;
+		const char* res = (const char*)DG_memmem_multi(h, strlen(h), mn, &id);
+		// "cd" ends first, but "abcd" and "ab" start before it, and "abcd" has the lower ID
+		if(res != h+2 || id != 1)
+			fail(__func__, __LINE__, "DG_memmem_multi() returned %d (needle %d) instead of 2 (needle 1)!",
+			     res ? (int)(res-h) : -1, (int)id);
+		res = (const char*)DG_memmem_multi(h+3, strlen(h)-3, mn, &id);
+		if(res != h+4 || id != 2)
+			fail(__func__, __LINE__, "DG_memmem_multi() returned %d (needle %d) instead of 4 (needle 2)!",
+			     res ? (int)(res-h) : -1, (int)id);
+		res = (const char*)DG_memmem_multi(h, 5, mn, &id); // "xxabc"
+		if(res != h+2 || id != 3)
+			fail(__func__, __LINE__, "DG_memmem_multi() returned %d (needle %d) instead of 2 (needle 3)!",
+			     res ? (int)(res-h) : -1, (int)id);
+		res = (const char*)DG_memmem_multi("xxbcxdxa", 8, mn, NULL);
+		if(res != NULL)
+			fail(__func__, __LINE__, "DG_memmem_multi() found something that isn't there!");
+
+		MultiAllState st = { 0, 0, lens, {0} };
+		size_t num = DG_memmem_multi_all(h, strlen(h), mn, countMultiMatch, &st);
+		if(num != 10 || st.counts[0] != 1 || st.counts[1] != 1 || st.counts[2] != 3
+		   || st.counts[3] != 2 || st.counts[4] != 3)
+			fail(__func__, __LINE__, "DG_memmem_multi_all() reported the wrong matches!");
+
+		DG_MultiNeedle_Free(mn);
+	}
+	{
+		// without any needles, nothing is found (and nothing is read outside the haystack)
+		DG_MultiNeedle* mn = DG_MultiNeedle_Create(NULL, NULL, 0);
+		if(mn == NULL)  fail(__func__, __LINE__, "DG_MultiNeedle_Create() failed for 0 needles!");
+		const char* h = "xxabcdxxbcdexxcdxabxxxxabcdxxbcdexxcdxabxx";
+		if(DG_memmem_multi(h, strlen(h), mn, NULL) != NULL || DG_memmem_multi_all(h, strlen(h), mn, countMultiMatch, NULL) != 0)
+			fail(__func__, __LINE__, "DG_memmem_multi*() found something without needles!");
+		DG_MultiNeedle_Free(mn);
+	}
+
+	// compare with calling DG_memmem() for each needle, on random data with few
+	// different bytes. the number of needles and their first bytes varies,
+	// so the automaton (and sometimes the SIMD skipping) is used in different ways
+	static char h[2000];
+	static char needleBuf[8][40];
+	const char* needles[8];
+	size_t lens[8];
+	srand(23);
+	for(int iter=0; iter < 20000; ++iter)
+	{
+		int numChars = 2 + rand() % 3;
+		char firstChar = (iter & 1) ? 'a' : 'c';
+		size_t hl = rand() % ((iter & 2) ? 2000 : 50);
+		size_t numNeedles = 1 + rand() % 8;
+		for(size_t i=0; i<hl; ++i)  h[i] = (char)(firstChar + rand() % (numChars + 20));
+		for(size_t n=0; n<numNeedles; ++n)
+		{
+			lens[n] = 1 + rand() % ((iter & 4) ? 39 : 4);
+			for(size_t i=0; i<lens[n]; ++i)  needleBuf[n][i] = (char)(firstChar + rand() % numChars);
+			needles[n] = needleBuf[n];
+			if(hl > lens[n] && (rand() & 1))
+				memcpy(h + rand() % (hl - lens[n]), needles[n], lens[n]);
+		}
+
+		DG_MultiNeedle* mn = DG_MultiNeedle_Create(needles, lens, numNeedles);
+		if(mn == NULL)  fail(__func__, __LINE__, "DG_MultiNeedle_Create() failed!");
+
+		const char* expected = NULL;
+		size_t expectedID = 0;
+		size_t expectedCount[8] = {0};
+		for(size_t n=0; n<numNeedles; ++n)
+		{
+			const char* res = (const char*)DG_memmem(h, hl, needles[n], lens[n]);
+			if(res != NULL && (expected == NULL || res < expected))
+			{
+				expected = res;
+				expectedID = n;
+			}
+			while(res != NULL)
+			{
+				++expectedCount[n];
+				res = (const char*)DG_memmem(res+1, hl - (res+1-h), needles[n], lens[n]);
+			}
+		}
+
+		size_t id = 42;
+		const char* res = (const char*)DG_memmem_multi(h, hl, mn, &id);
+		if(res != expected || (res != NULL && id != expectedID))
+			fail(__func__, __LINE__, "DG_memmem_multi() returned %d (needle %d) instead of %d (needle %d)!",
+			     res ? (int)(res-h) : -1, (int)id, expected ? (int)(expected-h) : -1, (int)expectedID);
+
+		MultiAllState st = { 0, 0, lens, {0} };
+		DG_memmem_multi_all(h, hl, mn, countMultiMatch, &st);
+		for(size_t n=0; n<numNeedles; ++n)
+		{
+			if(st.counts[n] != expectedCount[n])
+				fail(__func__, __LINE__, "DG_memmem_multi_all() found needle %d %d times instead of %d times!",
+				     (int)n, (int)st.counts[n], (int)expectedCount[n]);
+		}
+
+		DG_MultiNeedle_Free(mn);
+	}
+}
+
+// for DG_MemmemStream_Feed(): collects the reported offsets
+typedef struct {
+	unsigned long long offsets[5000];
+	size_t num;
+	size_t stopAfter;
+} StreamMatches;
+
+static int collectStreamMatch(void* userData, unsigned long long offset)
+{
+	StreamMatches* sm = (StreamMatches*)userData;
+	if(sm->num < sizeof(sm->offsets)/sizeof(sm->offsets[0]))
+		sm->offsets[sm->num] = offset;
+	++sm->num;
+	return sm->num != sm->stopAfter;
+}
+
+static void testMemmemStream()
+{
+	// feed random data in random chunks (from 0 bytes to bigger than the needle)
+	// and compare with all matches found by (naively) using memcmp() at every offset
+	static char h[4000];
+	static char n[100];
+	static StreamMatches sm;
+	srand(1337);
+	for(int iter=0; iter < 10000; ++iter)
+	{
+		int numChars = 1 + rand() % 3;
+		size_t hl = rand() % ((iter & 1) ? 4000 : 200);
+		size_t nl = 1 + rand() % ((iter & 2) ? 99 : 20);
+		for(size_t i=0; i<hl; ++i)  h[i] = 'a' + rand() % numChars;
+		for(size_t i=0; i<nl; ++i)  n[i] = 'a' + rand() % numChars;
+
+		DG_MemmemStream* ms = DG_MemmemStream_Create(n, nl);
+		if(ms == NULL)  fail(__func__, __LINE__, "DG_MemmemStream_Create() failed!");
+
+		sm.num = 0;
+		sm.stopAfter = (iter & 4) ? (size_t)(1 + rand() % 10) : 0;
+		size_t pos = 0;
+		size_t numReported = 0;
+		while(pos < hl)
+		{
+			size_t maxChunk = (iter & 8) ? 2*nl : 300;
+			size_t chunkLen = rand() % (maxChunk + 1);
+			if(chunkLen > hl - pos)  chunkLen = hl - pos;
+			numReported += DG_MemmemStream_Feed(ms, h + pos, chunkLen, collectStreamMatch, &sm);
+			pos += chunkLen;
+		}
+		DG_MemmemStream_Free(ms);
+
+		if(numReported != sm.num)
+			fail(__func__, __LINE__, "DG_MemmemStream_Feed() returned %d matches, but reported %d!",
+			     (int)numReported, (int)sm.num);
+
+		size_t numExpected = 0;
+		for(size_t i=0; i+nl <= hl; ++i)
+		{
+			if(memcmp(h+i, n, nl) != 0)  continue;
+			if(sm.stopAfter != 0 && numExpected == sm.stopAfter)
+				fail(__func__, __LINE__, "DG_MemmemStream_Feed() didn't stop searching!");
+			if(numExpected >= sm.num || sm.offsets[numExpected] != i)
+				fail(__func__, __LINE__, "DG_MemmemStream_Feed() match %d should be at %d, not %d!",
+				     (int)numExpected, (int)i, (numExpected < sm.num) ? (int)sm.offsets[numExpected] : -1);
+			++numExpected;
+			if(numExpected == sm.stopAfter)  break;
+		}
+		if(numExpected != sm.num)
+			fail(__func__, __LINE__, "DG_MemmemStream_Feed() found %d matches instead of %d!",
+			     (int)sm.num, (int)numExpected);
+	}
+}
+
+static void testFileFind()
+{
+	// a file of a few MB, so DG_FileFindLast() needs several windows
+	static char buf[5*1024*1024 + 123];
+	const char* path = "testmemrmem_filefind.tmp";
+	size_t size = sizeof(buf);
+	for(size_t i=0; i<size; ++i)  buf[i] = 'a' + (i*7 + i/13) % 23;
+	// one match at the start, one in the middle, one spanning the boundary
+	// between the first two windows of DG_FileFindLast() and one at the end
+	size_t positions[] = { 100, 2000000, size - 1024*1024 - 5, size - 18 };
+	const char* needle = "#needle!ELDEEN#";
+	size_t nl = strlen(needle);
+	for(size_t i=0; i<4; ++i)  memcpy(buf + positions[i], needle, nl);
+
+	FILE* f = fopen(path, "wb");
+	if(f == NULL || fwrite(buf, 1, size, f) != size)
+		fail(__func__, __LINE__, "Couldn't write %s!", path);
+	fclose(f);
+
+	unsigned long long offset = 0;
+	int res = DG_FileFind(path, needle, nl, &offset);
+	if(res != 1 || offset != positions[0])
+		fail(__func__, __LINE__, "DG_FileFind() returned %d, offset %d instead of 1, %d!", res, (int)offset, (int)positions[0]);
+	res = DG_FileFindLast(path, needle, nl, &offset);
+	if(res != 1 || offset != positions[3])
+		fail(__func__, __LINE__, "DG_FileFindLast() returned %d, offset %d instead of 1, %d!", res, (int)offset, (int)positions[3]);
+
+	// search for needles (and parts of them) that only occur once or twice
+	for(size_t i=0; i<4; ++i)
+	{
+		const char* n = buf + positions[i] - 3;
+		size_t len = nl + 6;
+		const char* expected = (const char*)DG_memmem(buf, size, n, len);
+		res = DG_FileFind(path, n, len, &offset);
+		if(res != 1 || offset != (unsigned long long)(expected - buf))
+			fail(__func__, __LINE__, "DG_FileFind() returned %d, offset %d instead of 1, %d!", res, (int)offset, (int)(expected - buf));
+		expected = (const char*)DG_memrmem(buf, size, n, len);
+		res = DG_FileFindLast(path, n, len, &offset);
+		if(res != 1 || offset != (unsigned long long)(expected - buf))
+			fail(__func__, __LINE__, "DG_FileFindLast() returned %d, offset %d instead of 1, %d!", res, (int)offset, (int)(expected - buf));
+	}
+
+	res = DG_FileFind(path, "#needle!x", 9, &offset);
+	if(res != 0)  fail(__func__, __LINE__, "DG_FileFind() returned %d instead of 0!", res);
+	res = DG_FileFindLast(path, "#needle!x", 9, &offset);
+	if(res != 0)  fail(__func__, __LINE__, "DG_FileFindLast() returned %d instead of 0!", res);
+
+	remove(path);
+	res = DG_FileFind(path, needle, nl, &offset);
+	if(res != -1)  fail(__func__, __LINE__, "DG_FileFind() returned %d for a missing file instead of -1!", res);
+}
+
+// runs the jobs one after another, like a thread pool with only one thread would
+static void runJobsSequentially(void* userData, DG_MemmemJobFn job, void* jobData, int numJobs)
+{
+	int* numCalls = (int*)userData;
+	for(int i=0; i<numJobs; ++i)
+	{
+		job(jobData);
+		++*numCalls;
+	}
+}
+
+static void testMemmemParallel()
+{
+	// big enough for several segments of DG_memmem_parallel_jobs()
+	size_t size = 21*1024*1024;
+	char* buf = (char*)malloc(size);
+	if(buf == NULL)  fail(__func__, __LINE__, "Couldn't allocate buffer!");
+	memset(buf, 'a', size);
+	const char* needle = "aaaaaaaaaaaaaaaaaaaaaaab";
+	size_t nl = strlen(needle);
+	// (some of) those span the boundary between two segments
+	size_t positions[] = { size - nl, 20*1024*1024 - 3, 8*1024*1024 - 1, 4*1024*1024 - nl + 1, 12345, 0 };
+	for(size_t i=0; i < sizeof(positions)/sizeof(positions[0]); ++i)
+	{
+		memcpy(buf + positions[i], needle, nl);
+		int numCalls = 0;
+		const char* res = (const char*)DG_memmem_parallel_jobs(buf, size, needle, nl, runJobsSequentially, &numCalls, 4);
+		if(res != buf + positions[i] || numCalls != 4)
+			fail(__func__, __LINE__, "DG_memmem_parallel_jobs() returned %d instead of %d!",
+			     res ? (int)(res - buf) : -1, (int)positions[i]);
+	}
+	int numCalls = 0;
+	if(DG_memmem_parallel_jobs(buf, size, "b", 1, runJobsSequentially, &numCalls, 8) != buf + nl - 1)
+		fail(__func__, __LINE__, "DG_memmem_parallel_jobs() didn't find the first 'b'!");
+	if(DG_memmem_parallel_jobs(buf, size, "ba", 2, runJobsSequentially, &numCalls, 8) != buf + nl - 1)
+		fail(__func__, __LINE__, "DG_memmem_parallel_jobs() didn't find the first \"ba\"!");
+	if(DG_memmem_parallel_jobs(buf, size, "c", 1, runJobsSequentially, &numCalls, 8) != NULL)
+		fail(__func__, __LINE__, "DG_memmem_parallel_jobs() found something that isn't there!");
+	free(buf);
+}
+
+static void testPathological()
+{
+	// inputs that made the old memrchr()+memcmp() based implementation
+	// (and similar naive searches) take O(haystackLen*needleLen) time:
+	// "aaaa...aaab" in "ab" followed by lots of 'a's
+	// (only checks the results - benchmisc.c's memrmem benchmark times these)
+	static const size_t hl = 1024*1024;
+	char* h = (char*)malloc(hl+1);
+	char* n = (char*)malloc(10001);
+	if(h == NULL || n == NULL)
+	{
+		fail(__FUNCTION__, __LINE__, "couldn't allocate memory");
+	}
+
+	size_t needleLens[] = { 2, 4, 16, 17, 100, 256, 257, 1000, 10000 };
+	for(size_t i=0; i < sizeof(needleLens)/sizeof(needleLens[0]); ++i)
+	{
+		size_t nl = needleLens[i];
+		memset(n, 'a', nl-1);
+		n[nl-1] = 'b';
+		n[nl] = '\0';
+
+		memset(h, 'a', hl);
+		h[hl] = '\0';
+		h[nl-1] = 'b'; // so the only match is at the start of the haystack
+
+		TEST_MEMRMEM(h, hl, n, nl, 0);
+		TEST_STRRSTR(h, n, 0);
+		// and the same with the last 'a' removed from the needle
+		// (so it's not periodic anymore)
+		TEST_MEMRMEM(h, hl, n+1, nl-1, 1);
+	}
+
+	// lots of '\0' bytes with a needle that starts and ends with '\0'
+	memset(h, 0, hl);
+	memset(n, 0, 64);
+	n[1] = 'x';
+	h[1] = 'x';
+	for(size_t nl = 3; nl <= 64; nl *= 2)
+	{
+		TEST_MEMRMEM(h, hl, n, nl, 0);
+	}
+
+	free(h);
+	free(n);
+}
+
 int main()
 {
+	testDG_memmem();
+
 	testWithNullterminatedStrings();
 
 	testWithoutNullTermination();
 
 	testDG_strrstr();
 
-	printf("Success! All DG_memrmem() and DG_strrstr() tests passed.\n");
+	testRandomized();
+
+	testMultiNeedle();
+
+	testMemmemStream();
+
+	testFileFind();
+
+	testMemmemParallel();
+
+	testPathological();
+
+	printf("Success! All DG_memmem(), DG_memrmem(), DG_memmem_multi(), DG_MemmemStream, DG_FileFind(), DG_memmem_parallel*() and DG_strrstr() tests passed.\n");
 
 	return 0;
 }
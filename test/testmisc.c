@@ -0,0 +1,1271 @@
+/*
+ * Tests for some of the functions in DG_misc.h that don't have their own test
+ * (see testmemrmem.c and teststrnlen.c for the others)
+ *
+ * License:
+ *  This software is in the public domain. Where that dedication is not
+ *  recognized, you are granted a perpetual, irrevocable license to copy
+ *  and modify this file however you want.
+ *  No warranty implied; use at your own risk.
+ */
+
+#include <stdarg.h>
+
+#define DG_MISC_IMPLEMENTATION
+#define DG_MISC_RUNTIME_DISPATCH // so the AVX2 versions can be tested (if the CPU supports it)
+#include "../DG_misc.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+static void fail(const char* fromfunc, int line, const char* failmsgfmt, ...)
+{
+	printf("!!! %s() line %d:\n\t", fromfunc, line);
+
+	va_list argptr;
+	va_start( argptr, failmsgfmt );
+
+	vprintf( failmsgfmt, argptr );
+
+	va_end( argptr );
+
+	printf(" !!!\n");
+	exit(1);
+}
+
+static void testExecutablePath(void)
+{
+	DG_ExecutableInfo info;
+	if(!DG_GetExecutableInfo(&info))
+		fail(__func__, __LINE__, "DG_GetExecutableInfo() failed!");
+	if(info.path != DG_GetExecutablePath() || info.dir != DG_GetExecutableDir()
+	   || info.filename != DG_GetExecutableFilename())
+		fail(__func__, __LINE__, "DG_GetExecutableInfo() returned different strings than the other functions!");
+	if(strlen(info.path) != info.pathLen || strlen(info.dir) != info.dirLen
+	   || strlen(info.filename) != info.filenameLen || info.dirLen + info.filenameLen != info.pathLen)
+		fail(__func__, __LINE__, "DG_GetExecutableInfo() returned wrong lengths!");
+	if(info.dirLen == 0 || info.filenameLen == 0 || (info.dir[info.dirLen-1] != '/' && info.dir[info.dirLen-1] != '\\')
+	   || memcmp(info.path, info.dir, info.dirLen) != 0 || strcmp(info.path + info.dirLen, info.filename) != 0)
+		fail(__func__, __LINE__, "\"%s\" is not \"%s\" + \"%s\"!", info.path, info.dir, info.filename);
+
+	FILE* f = fopen(info.path, "rb");
+	if(f == NULL)
+		fail(__func__, __LINE__, "Couldn't open the executable at \"%s\"!", info.path);
+	fclose(f);
+}
+
+// naive splitter to compare DG_StrSplitIter against: writes the start offsets and lengths
+// of the tokens into starts and lens, returns the number of tokens
+static int naiveSplit(const char* str, size_t len, const char* delims, int keepEmpty,
+                      size_t* starts, size_t* lens)
+{
+	int num = 0;
+	size_t tokStart = 0;
+	for(size_t i=0; i <= len; ++i)
+	{
+		if(i == len || (str[i] != '\0' && strchr(delims, str[i]) != NULL))
+		{
+			if(keepEmpty || i > tokStart)
+			{
+				starts[num] = tokStart;
+				lens[num] = i - tokStart;
+				++num;
+			}
+			tokStart = i+1;
+		}
+	}
+	return num;
+}
+
+static void testStrSplitIter()
+{
+	// the simple cases
+	{
+		static const char* expected[] = { "foo", "bar", "baz" };
+		const char* str = "  foo bar\t\tbaz\n";
+		DG_StrSplitIter it;
+		const char* tok;
+		size_t tokLen;
+		int i = 0;
+		DG_StrSplitIter_Init(&it, str, strlen(str), " \t\n", 0);
+		while(DG_StrSplitIter_Next(&it, &tok, &tokLen))
+		{
+			if(i >= 3 || tokLen != strlen(expected[i]) || memcmp(tok, expected[i], tokLen) != 0)
+				fail(__func__, __LINE__, "Unexpected token %d: \"%.*s\"", i, (int)tokLen, tok);
+			++i;
+		}
+		if(i != 3)
+			fail(__func__, __LINE__, "Expected 3 tokens, got %d", i);
+		if(DG_StrSplitIter_Next(&it, &tok, &tokLen))
+			fail(__func__, __LINE__, "DG_StrSplitIter_Next() returned another token after the end!");
+	}
+	{
+		// empty tokens, like in CSV
+		static const char* expected[] = { "", "a", "", "b", "" };
+		const char* str = ",a,,b,";
+		DG_StrSplitIter it;
+		const char* tok;
+		size_t tokLen;
+		int i = 0;
+		DG_StrSplitIter_Init(&it, str, strlen(str), ",", DG_STRSPLIT_KEEP_EMPTY);
+		while(DG_StrSplitIter_Next(&it, &tok, &tokLen))
+		{
+			if(i >= 5 || tokLen != strlen(expected[i]) || memcmp(tok, expected[i], tokLen) != 0)
+				fail(__func__, __LINE__, "Unexpected token %d: \"%.*s\"", i, (int)tokLen, tok);
+			++i;
+		}
+		if(i != 5)
+			fail(__func__, __LINE__, "Expected 5 tokens, got %d", i);
+	}
+	{
+		// the string isn't '\0'-terminated and can contain '\0', only len matters
+		const char str[] = { 'a', '\0', 'b', ';', 'c', 'd', ';', 'x' };
+		DG_StrSplitIter it;
+		const char* tok;
+		size_t tokLen;
+		DG_StrSplitIter_Init(&it, str, 6, ";", 0);
+		if(!DG_StrSplitIter_Next(&it, &tok, &tokLen) || tok != str || tokLen != 3)
+			fail(__func__, __LINE__, "Wrong first token!");
+		if(!DG_StrSplitIter_Next(&it, &tok, &tokLen) || tok != str+4 || tokLen != 2)
+			fail(__func__, __LINE__, "Wrong second token!");
+		if(DG_StrSplitIter_Next(&it, &tok, &tokLen))
+			fail(__func__, __LINE__, "Got token after end of string!");
+	}
+
+	// random strings with different sets of delimiters (using memchr, SIMD and the plain C loop)
+	static const char* delimSets[] = { "", ",", " \t", ";:,", " \t\r\n,;.", " \t\r\n,;.!?", "abcdefghijklmnop" };
+	static char buf[600];
+	static size_t expStarts[600], expLens[600];
+	srand(42);
+	for(int iter=0; iter < 50000; ++iter)
+	{
+		const char* delims = delimSets[iter % (sizeof(delimSets)/sizeof(delimSets[0]))];
+		int keepEmpty = (iter / 7) & 1;
+		size_t len = rand() % ((iter & 16) ? 500 : 40);
+		// mostly non-delimiters, so there are tokens of different lengths
+		int delimChance = 1 + rand() % 30;
+		size_t numDelims = strlen(delims);
+		for(size_t i=0; i<len; ++i)
+		{
+			if(numDelims > 0 && rand() % delimChance == 0)
+				buf[i] = delims[rand() % numDelims];
+			else
+				buf[i] = 'A' + rand() % 26;
+		}
+		const char* str = buf + (rand() % 64);
+		if(str + len > buf + sizeof(buf))  str = buf;
+		memmove((char*)str, buf, len);
+
+		int numExp = naiveSplit(str, len, delims, keepEmpty, expStarts, expLens);
+
+		DG_StrSplitIter it;
+		const char* tok;
+		size_t tokLen;
+		int num = 0;
+		DG_StrSplitIter_Init(&it, str, len, delims, keepEmpty ? DG_STRSPLIT_KEEP_EMPTY : 0);
+		while(DG_StrSplitIter_Next(&it, &tok, &tokLen))
+		{
+			if(num >= numExp)
+				fail(__func__, __LINE__, "Got more than the expected %d tokens (iter %d)!", numExp, iter);
+			if(tok != str + expStarts[num] || tokLen != expLens[num])
+				fail(__func__, __LINE__, "Token %d is at %d with length %d instead of %d, %d (iter %d)!", num,
+				     (int)(tok - str), (int)tokLen, (int)expStarts[num], (int)expLens[num], iter);
+			++num;
+		}
+		if(num != numExp)
+			fail(__func__, __LINE__, "Got %d instead of %d tokens (iter %d)!", num, numExp, iter);
+	}
+}
+
+static void testStrBuf()
+{
+	DG_StrBuf sb;
+	DG_StrBuf_Init(&sb);
+	if(sb.len != 0)
+		fail(__func__, __LINE__, "DG_StrBuf should be empty after DG_StrBuf_Init()!");
+
+	// build a long string from many small appends and compare with what snprintf() produces
+	static char expected[200000];
+	size_t expLen = 0;
+	for(int i=0; i<10000; ++i)
+	{
+		switch(i % 4)
+		{
+			case 0:
+				DG_StrBuf_Append(&sb, "foo ");
+				expLen += sprintf(expected + expLen, "foo ");
+				break;
+			case 1:
+				DG_StrBuf_AppendN(&sb, "barbaz", 3);
+				expLen += sprintf(expected + expLen, "bar");
+				break;
+			case 2:
+				DG_StrBuf_AppendChar(&sb, 'x');
+				expected[expLen++] = 'x';
+				expected[expLen] = '\0';
+				break;
+			case 3:
+				DG_StrBuf_AppendF(&sb, "%d:%s;", i, (i & 8) ? "a" : "");
+				expLen += sprintf(expected + expLen, "%d:%s;", i, (i & 8) ? "a" : "");
+				break;
+		}
+		if(sb.len != expLen || sb.str[sb.len] != '\0' || sb.cap <= sb.len)
+			fail(__func__, __LINE__, "Wrong len %d (expected %d) or cap %d!", (int)sb.len, (int)expLen, (int)sb.cap);
+	}
+	if(memcmp(sb.str, expected, expLen+1) != 0)
+		fail(__func__, __LINE__, "DG_StrBuf has wrong content!");
+
+	// a formatted string that's much longer than the free space
+	DG_StrBuf_Clear(&sb);
+	DG_StrBuf_Free(&sb);
+	DG_StrBuf_AppendF(&sb, "%s|%5000d|", "start", 42);
+	if(sb.len != 5000+7 || memcmp(sb.str, "start|   ", 9) != 0 || strcmp(sb.str + sb.len - 3, "42|") != 0)
+		fail(__func__, __LINE__, "DG_StrBuf_AppendF() with long output failed!");
+
+	size_t len = 0;
+	char* str = DG_StrBuf_Detach(&sb, &len);
+	if(str == NULL || len != 5007 || strlen(str) != 5007 || sb.str != NULL || sb.len != 0)
+		fail(__func__, __LINE__, "DG_StrBuf_Detach() failed!");
+	free(str);
+
+	// with an external buffer: it's used until it's too small, and never freed
+	char stackBuf[16];
+	DG_StrBuf_InitExternal(&sb, stackBuf, sizeof(stackBuf));
+	DG_StrBuf_AppendF(&sb, "%d", 12345);
+	DG_StrBuf_Append(&sb, "6789");
+	if(sb.str != stackBuf || strcmp(stackBuf, "123456789") != 0)
+		fail(__func__, __LINE__, "External buffer wasn't used!");
+	// detaching copies the external buffer and keeps using it
+	str = DG_StrBuf_Detach(&sb, NULL);
+	if(str == NULL || str == stackBuf || strcmp(str, "123456789") != 0 || sb.str != stackBuf || sb.len != 0)
+		fail(__func__, __LINE__, "DG_StrBuf_Detach() with external buffer failed!");
+	free(str);
+	// exactly 15 chars still fit
+	DG_StrBuf_AppendF(&sb, "%s", "abcdefghijklmno");
+	if(sb.str != stackBuf || sb.len != 15)
+		fail(__func__, __LINE__, "External buffer wasn't used for 15 chars!");
+	DG_StrBuf_AppendF(&sb, "%s", "pq");
+	if(sb.str == stackBuf || strcmp(sb.str, "abcdefghijklmnopq") != 0 || strcmp(stackBuf, "abcdefghijklmno") != 0)
+		fail(__func__, __LINE__, "Growing from external buffer failed!");
+	DG_StrBuf_Free(&sb);
+
+	// detaching an empty DG_StrBuf gives an empty string
+	str = DG_StrBuf_Detach(&sb, &len);
+	if(str == NULL || str[0] != '\0' || len != 0)
+		fail(__func__, __LINE__, "DG_StrBuf_Detach() of empty DG_StrBuf failed!");
+	free(str);
+}
+
+static void testStrPool()
+{
+	DG_StrPool pool;
+	DG_StrPool_Init(&pool);
+
+	const char* a = DG_StrPool_Intern(&pool, "foo");
+	const char* b = DG_StrPool_InternN(&pool, "foobar", 3);
+	const char* c = DG_StrPool_Intern(&pool, "bar");
+	const char* e = DG_StrPool_InternN(&pool, NULL, 0);
+	if(a == NULL || a != b || a == c || strcmp(a, "foo") != 0 || strcmp(c, "bar") != 0 || e == NULL || e[0] != '\0')
+		fail(__func__, __LINE__, "DG_StrPool_Intern*() is broken!");
+	if(DG_StrPool_GetID(&pool, a) != 0 || DG_StrPool_GetID(&pool, c) != 1 || DG_StrPool_GetID(&pool, e) != 2
+	   || DG_StrPool_Get(&pool, 1) != c || DG_StrPool_Len(&pool, 1) != 3 || DG_StrPool_Len(&pool, 2) != 0
+	   || pool.numStrings != 3)
+		fail(__func__, __LINE__, "DG_StrPool IDs are broken!");
+	if(DG_StrPool_Find(&pool, "bar", 3) != 1 || DG_StrPool_Find(&pool, "ba", 2) != DG_STRPOOL_INVALID_ID
+	   || DG_StrPool_InternID(&pool, "", 0) != 2 || pool.numStrings != 3)
+		fail(__func__, __LINE__, "DG_StrPool_Find() or DG_StrPool_InternID() is broken!");
+
+	// strings containing '\0' are different from their prefix
+	const char* z = DG_StrPool_InternN(&pool, "foo\0x", 5);
+	if(z == a || memcmp(z, "foo\0x", 6) != 0 || DG_StrPool_Len(&pool, DG_StrPool_GetID(&pool, z)) != 5)
+		fail(__func__, __LINE__, "DG_StrPool_InternN() with '\\0' in the string is broken!");
+
+	// lots of strings (some of them longer than a block), interned several times;
+	// the pointers from the first time must remain valid and be returned again
+	enum { NUM = 20000 };
+	static const char* ptrs[NUM];
+	static char buf[40000];
+	for(int round=0; round<2; ++round)
+	{
+		for(int i=0; i<NUM; ++i)
+		{
+			size_t len = (size_t)sprintf(buf, "str%d_", i);
+			if(i % 997 == 0)
+			{
+				// sometimes a big one
+				memset(buf + len, 'x', 20000 + i);
+				len += 20000 + i;
+				buf[len] = '\0';
+			}
+			const char* p = DG_StrPool_InternN(&pool, buf, len);
+			if(p == NULL || strcmp(p, buf) != 0)
+				fail(__func__, __LINE__, "DG_StrPool_InternN() returned a wrong string for %d!", i);
+			if(round == 0)
+				ptrs[i] = p;
+			else if(p != ptrs[i])
+				fail(__func__, __LINE__, "DG_StrPool_InternN() returned a different pointer for %d!", i);
+			unsigned int id = DG_StrPool_GetID(&pool, p);
+			if(DG_StrPool_Get(&pool, id) != p || DG_StrPool_Len(&pool, id) != len || DG_StrPool_Find(&pool, buf, len) != id)
+				fail(__func__, __LINE__, "DG_StrPool IDs are broken for %d!", i);
+		}
+	}
+	if(pool.numStrings != 4 + NUM || DG_StrPool_Intern(&pool, "foo") != a)
+		fail(__func__, __LINE__, "DG_StrPool contains %d strings instead of %d!", (int)pool.numStrings, 4 + NUM);
+
+	DG_StrPool_Free(&pool);
+	if(pool.numStrings != 0 || DG_StrPool_Find(&pool, "foo", 3) != DG_STRPOOL_INVALID_ID)
+		fail(__func__, __LINE__, "DG_StrPool_Free() didn't make the pool empty!");
+	DG_StrPool_Free(&pool); // freeing an empty pool is ok
+}
+
+static void testIntToA()
+{
+	static const unsigned long long uvals[] = { 0, 1, 9, 10, 99, 100, 12345, 4294967295uLL, 4294967296uLL,
+		99999999, 100000000, 1234567890123456789uLL, 18446744073709551615uLL };
+	static const long long ivals[] = { 0, -1, 1, -10, 9223372036854775807LL, -9223372036854775807LL - 1 };
+	char buf[DG_I64TOA_BUFSIZE];
+	char expected[32];
+
+	for(size_t i=0; i < sizeof(uvals)/sizeof(uvals[0]); ++i)
+	{
+		size_t len = DG_u64toa(buf, uvals[i]);
+		sprintf(expected, "%llu", uvals[i]);
+		if(len != strlen(expected) || strcmp(buf, expected) != 0)
+			fail(__func__, __LINE__, "DG_u64toa() wrote \"%s\" instead of \"%s\"!", buf, expected);
+	}
+	for(size_t i=0; i < sizeof(ivals)/sizeof(ivals[0]); ++i)
+	{
+		size_t len = DG_i64toa(buf, ivals[i]);
+		sprintf(expected, "%lld", ivals[i]);
+		if(len != strlen(expected) || strcmp(buf, expected) != 0)
+			fail(__func__, __LINE__, "DG_i64toa() wrote \"%s\" instead of \"%s\"!", buf, expected);
+	}
+
+	// random numbers of all magnitudes
+	srand(42);
+	for(int i=0; i<200000; ++i)
+	{
+		unsigned long long v = ((unsigned long long)rand() << 42) ^ ((unsigned long long)rand() << 21) ^ (unsigned long long)rand();
+		v >>= rand() % 64;
+		long long sv = (i & 1) ? -(long long)(v >> 1) : (long long)(v >> 1);
+		DG_u64toa(buf, v);
+		sprintf(expected, "%llu", v);
+		if(strcmp(buf, expected) != 0)
+			fail(__func__, __LINE__, "DG_u64toa() wrote \"%s\" instead of \"%s\"!", buf, expected);
+		DG_i64toa(buf, sv);
+		sprintf(expected, "%lld", sv);
+		if(strcmp(buf, expected) != 0)
+			fail(__func__, __LINE__, "DG_i64toa() wrote \"%s\" instead of \"%s\"!", buf, expected);
+	}
+}
+
+// returns the number of significant digits in a string written by DG_dtoa()
+static int countDigits(const char* str)
+{
+	int num = 0;
+	int leading = 1;
+	int trailingZeros = 0;
+	for(const char* p = str; *p != '\0' && *p != 'e'; ++p)
+	{
+		if(*p < '0' || *p > '9')  continue;
+		if(*p == '0' && leading)  continue;
+		leading = 0;
+		++num;
+		trailingZeros = (*p == '0') ? trailingZeros+1 : 0;
+	}
+	return num - trailingZeros;
+}
+
+static void testDtoA()
+{
+	static const struct { double v; const char* str; } dtests[] = {
+		{ 0.0, "0" }, { -0.0, "-0" }, { 1.0, "1" }, { -1.5, "-1.5" }, { 0.1, "0.1" }, { 0.3, "0.3" },
+		{ 0.1+0.2, "0.30000000000000004" }, { 123456.0, "123456" }, { 1e20, "100000000000000000000" },
+		{ 1e21, "1e+21" }, { 1.5e300, "1.5e+300" }, { 0.000001, "0.000001" }, { 1.5e-7, "1.5e-7" },
+		{ 5e-324, "5e-324" }, { 2.2250738585072014e-308, "2.2250738585072014e-308" },
+		{ 1.7976931348623157e308, "1.7976931348623157e+308" }, { 9007199254740993.0, "9007199254740992" },
+		{ 1.0/0.0, "inf" }, { -1.0/0.0, "-inf" }, { 0.0/0.0, "nan" },
+	};
+	static const struct { float v; const char* str; } ftests[] = {
+		{ 0.1f, "0.1" }, { 1.0f/3.0f, "0.33333334" }, { 16777216.0f, "16777216" }, { 3.4028235e38f, "3.4028235e+38" },
+		{ 1e-45f, "1e-45" }, { 1.17549435e-38f, "1.1754944e-38" }, { -2.5f, "-2.5" },
+	};
+	char buf[DG_DTOA_BUFSIZE];
+	for(size_t i=0; i < sizeof(dtests)/sizeof(dtests[0]); ++i)
+	{
+		size_t len = DG_dtoa(buf, dtests[i].v);
+		if(len != strlen(buf) || strcmp(buf, dtests[i].str) != 0)
+			fail(__func__, __LINE__, "DG_dtoa() wrote \"%s\" instead of \"%s\"!", buf, dtests[i].str);
+	}
+	for(size_t i=0; i < sizeof(ftests)/sizeof(ftests[0]); ++i)
+	{
+		size_t len = DG_ftoa(buf, ftests[i].v);
+		if(len != strlen(buf) || strcmp(buf, ftests[i].str) != 0)
+			fail(__func__, __LINE__, "DG_ftoa() wrote \"%s\" instead of \"%s\"!", buf, ftests[i].str);
+	}
+
+	// random bit patterns must read back as the same number, and there must not be a shorter
+	// representation that reads back correctly (which is found by trying printf() precisions)
+	char expected[64];
+	srand(42);
+	for(int i=0; i<300000; ++i)
+	{
+		unsigned long long bits = ((unsigned long long)rand() << 42) ^ ((unsigned long long)rand() << 21) ^ (unsigned long long)rand();
+		bits ^= (unsigned long long)rand() << 60;
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		if(d != d || d - d != 0.0)  continue; // nan or inf
+
+		size_t len = DG_dtoa(buf, d);
+		if(len >= DG_DTOA_BUFSIZE || strtod(buf, NULL) != d)
+			fail(__func__, __LINE__, "DG_dtoa() wrote \"%s\" which doesn't read back as %.17g!", buf, d);
+		int prec = 1;
+		for( ; prec < 17; ++prec)
+		{
+			sprintf(expected, "%.*e", prec-1, d);
+			if(strtod(expected, NULL) == d)  break;
+		}
+		if(countDigits(buf) != prec)
+			fail(__func__, __LINE__, "DG_dtoa() wrote \"%s\" for %.17g, but %s is shorter!", buf, d, expected);
+
+		unsigned int fbits = (unsigned int)bits;
+		float f;
+		memcpy(&f, &fbits, sizeof(f));
+		if(f != f || f - f != 0.0f)  continue;
+		DG_ftoa(buf, f);
+		if(strtof(buf, NULL) != f)
+			fail(__func__, __LINE__, "DG_ftoa() wrote \"%s\" which doesn't read back as %.9g!", buf, f);
+		for(prec = 1; prec < 9; ++prec)
+		{
+			sprintf(expected, "%.*e", prec-1, f);
+			if(strtof(expected, NULL) == f)  break;
+		}
+		if(countDigits(buf) != prec)
+			fail(__func__, __LINE__, "DG_ftoa() wrote \"%s\" for %.9g, but %s is shorter!", buf, f, expected);
+	}
+}
+
+static void testIntParse()
+{
+	static const struct { const char* str; int base; unsigned long long v; int err; int endOfs; } utests[] = {
+		{ "0", 10, 0, DG_PARSE_OK, 1 }, { "123abc", 10, 123, DG_PARSE_OK, 3 },
+		{ "18446744073709551615", 10, 18446744073709551615uLL, DG_PARSE_OK, 20 },
+		{ "18446744073709551616", 10, 0, DG_PARSE_RANGE, 20 }, { "99999999999999999999999 ", 10, 0, DG_PARSE_RANGE, 23 },
+		{ "00000000000000000000000000042", 10, 42, DG_PARSE_OK, 29 }, { "ffFF", 16, 0xffff, DG_PARSE_OK, 4 },
+		{ "ffffffffffffffff", 16, 0xffffffffffffffffuLL, DG_PARSE_OK, 16 }, { "10000000000000000", 16, 0, DG_PARSE_RANGE, 17 },
+		{ "1012", 2, 5, DG_PARSE_OK, 3 }, { "zZ", 36, 35*36+35, DG_PARSE_OK, 2 },
+		{ "", 10, 0, DG_PARSE_INVALID, 0 }, { "-1", 10, 0, DG_PARSE_INVALID, 0 }, { "+1", 10, 0, DG_PARSE_INVALID, 0 },
+		{ " 1", 10, 0, DG_PARSE_INVALID, 0 }, { "0x10", 16, 0, DG_PARSE_OK, 1 },
+	};
+	for(size_t i=0; i < sizeof(utests)/sizeof(utests[0]); ++i)
+	{
+		const char* str = utests[i].str;
+		unsigned long long v = 0;
+		int err = -1;
+		const char* end = DG_strtou64(str, strlen(str), &v, utests[i].base, &err);
+		if(err != utests[i].err || end - str != utests[i].endOfs || v != utests[i].v)
+			fail(__func__, __LINE__, "DG_strtou64(\"%s\") returned %llu, error %d, end %d!", str, v, err, (int)(end - str));
+	}
+
+	static const struct { const char* str; int base; long long v; int err; int endOfs; } itests[] = {
+		{ "-0", 10, 0, DG_PARSE_OK, 2 }, { "-123", 10, -123, DG_PARSE_OK, 4 },
+		{ "9223372036854775807", 10, 9223372036854775807LL, DG_PARSE_OK, 19 },
+		{ "9223372036854775808", 10, 0, DG_PARSE_RANGE, 19 },
+		{ "-9223372036854775808", 10, -9223372036854775807LL - 1, DG_PARSE_OK, 20 },
+		{ "-9223372036854775809", 10, 0, DG_PARSE_RANGE, 20 }, { "-7f", 16, -127, DG_PARSE_OK, 3 },
+		{ "-", 10, 0, DG_PARSE_INVALID, 0 }, { "--1", 10, 0, DG_PARSE_INVALID, 0 }, { "-x", 10, 0, DG_PARSE_INVALID, 0 },
+	};
+	for(size_t i=0; i < sizeof(itests)/sizeof(itests[0]); ++i)
+	{
+		const char* str = itests[i].str;
+		long long v = 0;
+		int err = -1;
+		const char* end = DG_strtoi64(str, strlen(str), &v, itests[i].base, &err);
+		if(err != itests[i].err || end - str != itests[i].endOfs || v != itests[i].v)
+			fail(__func__, __LINE__, "DG_strtoi64(\"%s\") returned %lld, error %d, end %d!", str, v, err, (int)(end - str));
+	}
+
+	// the length must be respected, even if more digits follow
+	unsigned long long v = 0;
+	const char* str = "12345";
+	if(DG_strtou64(str, 3, &v, 10, NULL) != str + 3 || v != 123)
+		fail(__func__, __LINE__, "DG_strtou64() didn't stop at len!");
+
+	// round trips through DG_i64toa()
+	char buf[DG_I64TOA_BUFSIZE];
+	srand(42);
+	for(int i=0; i<100000; ++i)
+	{
+		long long n = (long long)(((unsigned long long)rand() << 42) ^ ((unsigned long long)rand() << 21) ^ (unsigned long long)rand());
+		n >>= rand() % 64;
+		if(rand() & 1)  n = -n;
+		size_t len = DG_i64toa(buf, n);
+		long long res = 0;
+		int err = -1;
+		if(DG_strtoi64(buf, len, &res, 10, &err) != buf + len || err != DG_PARSE_OK || res != n)
+			fail(__func__, __LINE__, "DG_strtoi64(\"%s\") returned %lld, error %d!", buf, res, err);
+	}
+}
+
+// checks that DG_strtod() and DG_strtof() parse str like strtod() and strtof() (which are
+// correctly rounded in glibc and recent MSVC), in the C locale
+static void checkFloatParse(const char* str, int line)
+{
+	size_t len = strlen(str);
+	char* expEnd;
+	double expected = strtod(str, &expEnd);
+	double res = 0.0;
+	int err = -1;
+	const char* end = DG_strtod(str, len, &res, &err);
+	if(end != expEnd || memcmp(&res, &expected, sizeof(res)) != 0)
+		fail(__func__, line, "DG_strtod(\"%s\") returned %.17g (end %d) instead of %.17g (end %d)!",
+		     str, res, (int)(end - str), expected, (int)(expEnd - str));
+	// out of range: inf that wasn't written as "inf", or 0 from non-zero digits
+	const char* mantEnd = strpbrk(str, "eE");
+	if(mantEnd == NULL || mantEnd > expEnd)  mantEnd = expEnd;
+	const char* nonZero = strpbrk(str, "123456789");
+	int isRange = (expected - expected != 0.0 && strpbrk(str, "iInN") == NULL)
+	              || (expected == 0.0 && nonZero != NULL && nonZero < mantEnd);
+	int expectedErr = (expEnd == str) ? DG_PARSE_INVALID : isRange ? DG_PARSE_RANGE : DG_PARSE_OK;
+	if(err != expectedErr)
+		fail(__func__, line, "DG_strtod(\"%s\") set error %d!", str, err);
+
+	float expectedF = strtof(str, &expEnd);
+	float resF = 0.0f;
+	end = DG_strtof(str, len, &resF, &err);
+	if(end != expEnd || memcmp(&resF, &expectedF, sizeof(resF)) != 0)
+		fail(__func__, line, "DG_strtof(\"%s\") returned %.9g (end %d) instead of %.9g (end %d)!",
+		     str, resF, (int)(end - str), expectedF, (int)(expEnd - str));
+}
+
+static void testFloatParse()
+{
+	static const char* strs[] = {
+		"0", "-0", "0.0", "1", "-1", "1.5", "0.1", "0.3", "1.", "-1.e5", ".5", "-.5", "1e", "1e+", "1e-x", "1e5",
+		"1E-5", "1.25e+2xyz", "007", "123456789012345678901234567890", "0.000000000000000000000000000001234",
+		"9007199254740993", "9007199254740993.0000000000000000000000001", "9007199254740992.9999999999999999999999",
+		"2.2250738585072011e-308", "2.2250738585072014e-308", "4.9406564584124654e-324", "2.4703282292062327e-324",
+		"2.4703282292062328e-324", "1e-400", "-1e-400", "1.7976931348623157e308", "1.7976931348623158e308",
+		"1.7976931348623159e308", "1e309", "-1e400", "1e99999999999999999999", "1e-99999999999999999999",
+		"0e99999999999", "3.4028235e38", "3.4028236e38", "1.4e-45", "7e-46", "1.17549435e-38",
+		"inf", "-inf", "INFINITY", "-Infinity", "infinit", "nan", "-NaN", "nan(123abc_)", "nan(", "nan(x y)", "in",
+		"", "-", ".", "-.", "e5",
+		// lots of digits, needs the fallback
+		"2.47032822920623272088284396434110686182529901307162382212792841250337753635104375932649918180817996189"
+		"89828154530446187536212963937037574945164419127591286520474549627516937097036233651219453883456497829"
+		"8437583962434082575829716883389706802937823163016578963700e-324",
+		"1.00000000000000011102230246251565404236316680908203125",
+		"1.00000000000000011102230246251565404236316680908203124",
+		"1.00000000000000011102230246251565404236316680908203126",
+	};
+	for(size_t i=0; i < sizeof(strs)/sizeof(strs[0]); ++i)
+		checkFloatParse(strs[i], __LINE__);
+
+	// unlike strtod(), no leading whitespace, '+' or hex numbers
+	static const struct { const char* str; int endOfs; } partial[] = {
+		{ " 1", 0 }, { "+1", 0 }, { "0x10", 1 }, { "-0x1p3", 2 }
+	};
+	for(size_t i=0; i < sizeof(partial)/sizeof(partial[0]); ++i)
+	{
+		const char* str = partial[i].str;
+		double d = 42.0;
+		int err = -1;
+		const char* end = DG_strtod(str, strlen(str), &d, &err);
+		int expectedErr = (partial[i].endOfs == 0) ? DG_PARSE_INVALID : DG_PARSE_OK;
+		if(end - str != partial[i].endOfs || err != expectedErr || d != (expectedErr ? 42.0 : 0.0))
+			fail(__func__, __LINE__, "DG_strtod(\"%s\") returned %g, error %d, end %d!", str, d, err, (int)(end - str));
+	}
+	// the length must be respected, even if more digits follow
+	double d = 0.0;
+	const char* str = "1.2345e10";
+	if(DG_strtod(str, 4, &d, NULL) != str + 4 || d != 1.23)
+		fail(__func__, __LINE__, "DG_strtod() didn't stop at len!");
+	if(DG_strtod(str, 8, &d, NULL) != str + 8 || d != 1.2345e1)
+		fail(__func__, __LINE__, "DG_strtod() didn't stop at len!");
+
+	// random doubles and floats, formatted in different ways, and random digit strings
+	char buf[128];
+	srand(42);
+	for(int i=0; i<300000; ++i)
+	{
+		unsigned long long bits = ((unsigned long long)rand() << 42) ^ ((unsigned long long)rand() << 21) ^ (unsigned long long)rand();
+		bits ^= (unsigned long long)rand() << 60;
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		float f;
+		unsigned int fbits = (unsigned int)bits;
+		memcpy(&f, &fbits, sizeof(f));
+		switch(i % 6)
+		{
+			case 0: sprintf(buf, "%.17g", d); break;
+			case 1: DG_dtoa(buf, d); break;
+			case 2: DG_ftoa(buf, f); break;
+			case 3: sprintf(buf, "%.*e", rand() % 30, d); break;
+			case 4: sprintf(buf, "%.*f", rand() % 30, (double)f); break;
+			default:
+			{
+				// random digits (often close to halfway between two numbers), random exponent
+				int len = 1 + rand() % 40;
+				char* p = buf;
+				for(int j=0; j<len; ++j)
+				{
+					if(j == len/2 && (rand() & 1))  *p++ = '.';
+					*p++ = (rand() & 3) ? "05"[rand() & 1] : (char)('0' + rand() % 10);
+				}
+				sprintf(p, "e%d", rand() % 700 - 350);
+			}
+		}
+		checkFloatParse(buf, __LINE__);
+	}
+}
+
+// SIMD levels of the DG__*_level() functions that can be tested on this CPU
+static int simdLevels[3];
+static int numSimdLevels = 0;
+
+static void initSimdLevels(void)
+{
+	simdLevels[numSimdLevels++] = DG__MISC_SIMD_NONE;
+#ifdef DG__MISC_HAVE_SSE2
+	simdLevels[numSimdLevels++] = DG__MISC_SIMD_SSE2;
+#endif
+#if defined(DG__MISC_ALWAYS_AVX2)
+	simdLevels[numSimdLevels++] = DG__MISC_SIMD_AVX2;
+#elif defined(DG__MISC_DISPATCH)
+	if(DG__MiscDetectSIMD() >= DG__MISC_SIMD_AVX2)
+		simdLevels[numSimdLevels++] = DG__MISC_SIMD_AVX2;
+#endif
+}
+
+// straightforward UTF-8 validation to compare against
+static size_t naiveUtf8Validate(const unsigned char* s, size_t len)
+{
+	size_t i = 0;
+	while(i < len)
+	{
+		unsigned int c = s[i];
+		size_t n;
+		unsigned int cp, minCp;
+		if(c < 0x80)                { ++i; continue; }
+		else if((c & 0xE0) == 0xC0) { n = 2; cp = c & 0x1F; minCp = 0x80; }
+		else if((c & 0xF0) == 0xE0) { n = 3; cp = c & 0x0F; minCp = 0x800; }
+		else if((c & 0xF8) == 0xF0) { n = 4; cp = c & 0x07; minCp = 0x10000; }
+		else  return i;
+		if(len - i < n)  return i;
+		for(size_t k=1; k<n; ++k)
+		{
+			if((s[i+k] & 0xC0) != 0x80)  return i;
+			cp = (cp << 6) | (s[i+k] & 0x3F);
+		}
+		if(cp < minCp || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))  return i;
+		i += n;
+	}
+	return len;
+}
+
+static size_t encodeUtf8(unsigned char* dst, unsigned int cp)
+{
+	if(cp < 0x80)     { dst[0] = (unsigned char)cp; return 1; }
+	if(cp < 0x800)    { dst[0] = (unsigned char)(0xC0 | (cp >> 6)); dst[1] = (unsigned char)(0x80 | (cp & 0x3F)); return 2; }
+	if(cp < 0x10000)
+	{
+		dst[0] = (unsigned char)(0xE0 | (cp >> 12)); dst[1] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+		dst[2] = (unsigned char)(0x80 | (cp & 0x3F));
+		return 3;
+	}
+	dst[0] = (unsigned char)(0xF0 | (cp >> 18)); dst[1] = (unsigned char)(0x80 | ((cp >> 12) & 0x3F));
+	dst[2] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F)); dst[3] = (unsigned char)(0x80 | (cp & 0x3F));
+	return 4;
+}
+
+static unsigned int randomCodePoint(void)
+{
+	switch(rand() % 8)
+	{
+		case 0: return 0x80 + rand() % (0x800 - 0x80);
+		case 1: { unsigned int cp = 0x800 + rand() % (0x10000 - 0x800); return (cp >= 0xD800 && cp <= 0xDFFF) ? 0xFFFD : cp; }
+		case 2: return 0x10000 + (((unsigned int)rand() << 8) ^ (unsigned int)rand()) % (0x110000 - 0x10000);
+		default: return 1 + rand() % 0x7F; // mostly ASCII
+	}
+}
+
+static void checkUtf8(const unsigned char* s, size_t len, const unsigned int* cps, size_t numCps, int line)
+{
+	static unsigned short u16[4096];
+	static unsigned char u8[4096 * 3];
+	size_t expected = naiveUtf8Validate(s, len);
+	// the expected UTF-16 length (if valid)
+	size_t expectedU16Len = 0;
+	for(size_t i=0; cps != NULL && numCps != (size_t)-1 && i<numCps; ++i)
+		expectedU16Len += (cps[i] >= 0x10000) ? 2 : 1;
+
+	for(int l=0; l<numSimdLevels; ++l)
+	{
+		int level = simdLevels[l];
+		size_t res = DG__utf8_validate_level(s, len, level);
+		if(res != expected)
+			fail(__func__, line, "DG__utf8_validate_level(len %d, level %d) returned %d instead of %d!",
+			     (int)len, level, (int)res, (int)expected);
+
+		size_t errOfs = 12345;
+		size_t u16Len = DG__utf8_to_utf16_level(u16, 4096, s, len, &errOfs, level);
+		if(expected != len)
+		{
+			if(u16Len != DG_UTF_INVALID || errOfs != expected)
+				fail(__func__, line, "DG__utf8_to_utf16_level(level %d) returned %d with error offset %d for invalid input, expected offset %d!",
+				     level, (int)u16Len, (int)errOfs, (int)expected);
+			continue;
+		}
+		if(cps != NULL && numCps != (size_t)-1 && u16Len != expectedU16Len)
+			fail(__func__, line, "DG__utf8_to_utf16_level(level %d) returned %d instead of %d!", level, (int)u16Len, (int)expectedU16Len);
+		// only counting must return the same
+		size_t countLen = DG__utf8_to_utf16_level(NULL, 0, s, len, NULL, level);
+		if(countLen != u16Len)
+			fail(__func__, line, "DG__utf8_to_utf16_level(NULL, 0, level %d) returned %d instead of %d!", level, (int)countLen, (int)u16Len);
+
+		// and back to UTF-8 must give the same string
+		size_t u8Len = DG__utf16_to_utf8_level(u8, sizeof(u8), u16, u16Len, &errOfs, level);
+		if(u8Len != len || memcmp(u8, s, len) != 0)
+			fail(__func__, line, "DG__utf16_to_utf8_level(level %d) didn't return the original string (len %d instead of %d)!",
+			     level, (int)u8Len, (int)len);
+		countLen = DG__utf16_to_utf8_level(NULL, 0, u16, u16Len, NULL, level);
+		if(countLen != len)
+			fail(__func__, line, "DG__utf16_to_utf8_level(NULL, 0, level %d) returned %d instead of %d!", level, (int)countLen, (int)len);
+
+		// with a too small dst, the output must be cut off between two code points
+		size_t dstLen = (size_t)rand() % (u16Len + 1);
+		unsigned short shortU16[4096];
+		shortU16[dstLen] = 0x4242; // guard
+		res = DG__utf8_to_utf16_level(shortU16, dstLen, s, len, NULL, level);
+		size_t written = dstLen;
+		if(written > 0 && written < u16Len && (u16[written] & 0xFC00) == 0xDC00)  --written; // would split a pair
+		if(res != u16Len || memcmp(shortU16, u16, written * 2) != 0 || shortU16[dstLen] != 0x4242)
+			fail(__func__, line, "DG__utf8_to_utf16_level(level %d) with dstLen %d is broken!", level, (int)dstLen);
+
+		dstLen = (size_t)rand() % (len + 1);
+		unsigned char shortU8[4096 * 3];
+		shortU8[dstLen] = 0x42;
+		res = DG__utf16_to_utf8_level(shortU8, dstLen, u16, u16Len, NULL, level);
+		written = dstLen;
+		while(written > 0 && written < len && (s[written] & 0xC0) == 0x80)  --written;
+		if(res != len || memcmp(shortU8, s, written) != 0 || shortU8[dstLen] != 0x42)
+			fail(__func__, line, "DG__utf16_to_utf8_level(level %d) with dstLen %d is broken!", level, (int)dstLen);
+	}
+}
+
+static void testUtf(void)
+{
+	static const struct { const char* str; int validLen; } tests[] = {
+		{ "", 0 }, { "abc", 3 }, { "\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80", 9 }, // U+00E4, U+20AC, U+1F600
+		{ "\x80", 0 }, { "a\xBF", 1 }, { "\xC0\x80", 0 }, { "\xC1\xBF", 0 }, { "\xC2\x80", 2 }, { "ab\xC2", 2 },
+		{ "\xE0\x9F\xBF", 0 }, { "\xE0\xA0\x80", 3 }, { "\xED\x9F\xBF", 3 }, { "\xED\xA0\x80", 0 }, { "\xED\xBF\xBF", 0 },
+		{ "\xEF\xBF\xBF", 3 }, { "\xE2\x82", 0 }, { "\xE2\x82x", 0 }, { "\xF0\x8F\xBF\xBF", 0 }, { "\xF0\x90\x80\x80", 4 },
+		{ "\xF4\x8F\xBF\xBF", 4 }, { "\xF4\x90\x80\x80", 0 }, { "\xF5\x80\x80\x80", 0 }, { "\xFF", 0 }, { "\xF0\x9F\x98", 0 },
+		{ "a\xC3\xA4\x80", 3 }, { "\xF0\x9F\x98\x80\x80", 4 },
+	};
+	for(size_t i=0; i < sizeof(tests)/sizeof(tests[0]); ++i)
+	{
+		size_t len = strlen(tests[i].str);
+		size_t res = DG_utf8_validate(tests[i].str, len);
+		if(res != (size_t)tests[i].validLen)
+			fail(__func__, __LINE__, "DG_utf8_validate() returned %d for test %d instead of %d!", (int)res, (int)i, tests[i].validLen);
+		checkUtf8((const unsigned char*)tests[i].str, len, NULL, (size_t)-1, __LINE__);
+	}
+
+	// unpaired surrogates in UTF-16
+	static const unsigned short badU16[][3] = {
+		{ 'a', 0xD800, 'b' }, { 'a', 0xDC00, 'b' }, { 'a', 'b', 0xD83D }, { 0xD83D, 0xD83D, 0xDE00 }
+	};
+	static const int badU16Ofs[] = { 1, 1, 2, 0 };
+	for(int i=0; i<4; ++i)
+	{
+		size_t errOfs = 12345;
+		char buf[16];
+		memset(buf, 'x', sizeof(buf));
+		size_t res = DG_utf16_to_utf8(buf, sizeof(buf), badU16[i], 3, &errOfs);
+		if(res != DG_UTF_INVALID || errOfs != (size_t)badU16Ofs[i])
+			fail(__func__, __LINE__, "DG_utf16_to_utf8() returned %d with error offset %d for test %d!", (int)res, (int)errOfs, i);
+		if(buf[0] != 'x')
+			fail(__func__, __LINE__, "DG_utf16_to_utf8() wrote to dst for invalid test %d!", i);
+	}
+
+	// random strings (valid or with a random byte changed), at different alignments
+	static unsigned int cps[1024];
+	static unsigned char buf[4096 + 64];
+	srand(42);
+	for(int iter=0; iter<30000; ++iter)
+	{
+		size_t numCps = (size_t)rand() % ((iter & 1) ? 1024 : 40);
+		size_t offset = (size_t)rand() % 64;
+		unsigned char* s = buf + offset;
+		size_t len = 0;
+		int asciiOnly = (rand() % 4 == 0);
+		for(size_t i=0; i<numCps; ++i)
+		{
+			cps[i] = asciiOnly ? (unsigned int)(1 + rand() % 0x7F) : randomCodePoint();
+			len += encodeUtf8(s + len, cps[i]);
+		}
+		if(len > 0 && (iter % 3) == 0)
+		{
+			s[rand() % len] = (unsigned char)rand();
+			numCps = (size_t)-1; // unknown now
+		}
+		else if(len > 0 && (iter % 7) == 0)
+		{
+			len -= 1 + rand() % 3; // maybe cuts off the last sequence
+			if(len > 4096)  len = 0;
+			numCps = (size_t)-1;
+		}
+		checkUtf8(s, len, cps, numCps, __LINE__);
+	}
+}
+
+static unsigned char naiveFold(unsigned char c)
+{
+	return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+static int naiveEqualIcase(const char* a, const char* b, size_t len)
+{
+	for(size_t i=0; i<len; ++i)
+	{
+		if(naiveFold((unsigned char)a[i]) != naiveFold((unsigned char)b[i]))  return 0;
+	}
+	return 1;
+}
+
+// finds the first (or last, if backwards != 0) case-insensitive match of n in h
+static const char* naiveMemimem(const char* h, size_t hl, const char* n, size_t nl, int backwards)
+{
+	if(nl > hl)  return NULL;
+	for(size_t i=0; i <= hl-nl; ++i)
+	{
+		size_t pos = backwards ? hl-nl-i : i;
+		if(naiveEqualIcase(h+pos, n, nl))  return h+pos;
+	}
+	return NULL;
+}
+
+static int naiveStrncasecmp(const char* a, const char* b, size_t n)
+{
+	for(size_t i=0; i<n; ++i)
+	{
+		int ca = naiveFold((unsigned char)a[i]);
+		int cb = naiveFold((unsigned char)b[i]);
+		if(ca != cb || ca == 0)  return ca - cb;
+	}
+	return 0;
+}
+
+static int sign(int x)
+{
+	return (x > 0) - (x < 0);
+}
+
+// returns a buffer of size bytes that is directly followed by a page that can't be accessed
+static char* allocGuarded(size_t size)
+{
+#ifdef _WIN32
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	size_t pageSize = sysInfo.dwPageSize;
+	size_t allocSize = (size + pageSize - 1) / pageSize * pageSize;
+	char* ret = (char*)VirtualAlloc(NULL, allocSize + pageSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	DWORD oldProt;
+	if(ret == NULL || !VirtualProtect(ret + allocSize, pageSize, PAGE_NOACCESS, &oldProt))
+		fail(__func__, __LINE__, "Couldn't allocate guarded buffer!");
+#else
+	size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	size_t allocSize = (size + pageSize - 1) / pageSize * pageSize;
+	char* ret = (char*)mmap(NULL, allocSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(ret == (char*)MAP_FAILED || mprotect(ret + allocSize, pageSize, PROT_NONE) != 0)
+		fail(__func__, __LINE__, "Couldn't allocate guarded buffer!");
+#endif
+	return ret + allocSize - size;
+}
+
+static void checkStrncasecmp(const char* a, const char* b, size_t n, int line)
+{
+	int expected = sign(naiveStrncasecmp(a, b, n));
+	for(int l=0; l<numSimdLevels; ++l)
+	{
+		int res = sign(DG__strncasecmp_level((const unsigned char*)a, (const unsigned char*)b, n, simdLevels[l]));
+		if(res != expected)
+			fail(__func__, line, "DG__strncasecmp_level(\"%.40s\", \"%.40s\", %d, level %d) returned %d instead of %d!",
+			     a, b, (int)n, simdLevels[l], res, expected);
+	}
+	if(sign(DG_strncasecmp(a, b, n)) != expected)
+		fail(__func__, line, "DG_strncasecmp(\"%.40s\", \"%.40s\", %d) is broken!", a, b, (int)n);
+}
+
+static void checkMemimem(const char* h, size_t hl, const char* n, size_t nl, int line)
+{
+	for(int backwards=0; backwards<2; ++backwards)
+	{
+		const char* expected = naiveMemimem(h, hl, n, nl, backwards);
+		if(nl == 0)  expected = backwards ? h+hl : h;
+		for(int l=0; l<numSimdLevels; ++l)
+		{
+			const char* res = backwards
+				? (const char*)DG__memrmem_level((const unsigned char*)h, hl, (const unsigned char*)n, nl, simdLevels[l], 1)
+				: (const char*)DG__memmem_level((const unsigned char*)h, hl, (const unsigned char*)n, nl, simdLevels[l], 1);
+			if(res != expected)
+				fail(__func__, line, "DG__mem%smem_level(\"%.*s\", %d, \"%.*s\", %d, level %d, icase) returned %d instead of %d!",
+				     backwards ? "r" : "", (int)hl, h, (int)hl, (int)nl, n, (int)nl, simdLevels[l],
+				     res ? (int)(res-h) : -1, expected ? (int)(expected-h) : -1);
+		}
+		const char* res = backwards ? (const char*)DG_memrimem(h, hl, n, nl) : (const char*)DG_memimem(h, hl, n, nl);
+		if(res != expected)
+			fail(__func__, line, "DG_mem%simem() returned %d instead of %d!", backwards ? "r" : "",
+			     res ? (int)(res-h) : -1, expected ? (int)(expected-h) : -1);
+	}
+}
+
+static void testIcase(void)
+{
+	//                           1111111111
+	//                 01234567890123456789
+	const char* str = "Hello World, HELLO wORLD";
+	if(DG_strcasestr(str, "world") != str+6 || DG_strcasestr(str, "WORLD,") != str+6
+	   || DG_strcasestr(str, "") != str || DG_strcasestr(str, "worlds") != NULL)
+		fail(__func__, __LINE__, "DG_strcasestr() is broken!");
+	if(DG_strrcasestr(str, "world") != str+19 || DG_strrcasestr(str, "hello") != str+13
+	   || DG_strrcasestr(str, "O") != str+20 || DG_strrcasestr(str, "o w") != str+17)
+		fail(__func__, __LINE__, "DG_strrcasestr() is broken!");
+
+	// only ASCII letters are folded: '[' and '{', '@' and '`' or 0xC4 and 0xE4 also differ
+	// by 32, but must not match
+	static const struct { const char* h; const char* n; } noMatch[] = {
+		{ "a[b", "a{b" }, { "A{B", "a[b" }, { "x@y", "x`y" }, { "\xC4", "\xE4" }, { "\xE4\xC4x", "\xC4\xE4X" },
+		{ "[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[", "{{" }, { "[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[", "{" },
+	};
+	for(size_t i=0; i < sizeof(noMatch)/sizeof(noMatch[0]); ++i)
+	{
+		checkMemimem(noMatch[i].h, strlen(noMatch[i].h), noMatch[i].n, strlen(noMatch[i].n), __LINE__);
+		if(DG_strcasestr(noMatch[i].h, noMatch[i].n) != NULL || DG_strrcasestr(noMatch[i].h, noMatch[i].n) != NULL)
+			fail(__func__, __LINE__, "DG_str(r)casestr(\"%s\", \"%s\") found a match!", noMatch[i].h, noMatch[i].n);
+	}
+
+	// long uniform needles (longer than the SSE2 and BMH cutoffs) have no maximal suffix
+	// with a mismatch, so the Two-Way periodicity check must not read past the needle
+	{
+		// the needle is allocated with its exact size so ASan can catch reads past its end
+		static char uh[2001];
+		static char us[301];
+		char* un = (char*)malloc(300);
+		memset(uh, 'A', 2000);
+		memset(un, 'a', 300);
+		memset(us, 'a', 300);
+		checkMemimem(uh, 2000, un, 300, __LINE__);
+		if(DG_strcasestr(uh, us) != uh || DG_strrcasestr(uh, us) != uh+1700)
+			fail(__func__, __LINE__, "DG_str(r)casestr() with a uniform needle is broken!");
+		for(int i=0; i<2000; i += 150)  uh[i] = 'b';
+		checkMemimem(uh, 2000, un, 300, __LINE__);
+		free(un);
+		if(DG_strcasestr(uh, us) != NULL || DG_strrcasestr(uh, us) != NULL)
+			fail(__func__, __LINE__, "DG_str(r)casestr() with a uniform needle found a match!");
+	}
+
+	checkStrncasecmp("abc", "ABD", 3, __LINE__);
+	checkStrncasecmp("abc", "ABD", 2, __LINE__);
+	checkStrncasecmp("a", "A", 5, __LINE__);
+	checkStrncasecmp("abc", "ab", 5, __LINE__);
+	checkStrncasecmp("[", "{", 1, __LINE__);
+	checkStrncasecmp("Z", "a", 1, __LINE__);
+	checkStrncasecmp("\xC4", "\xE4", 1, __LINE__);
+	checkStrncasecmp("", "", 1, __LINE__);
+	checkStrncasecmp("x", "y", 0, __LINE__);
+	if(DG_strncasecmp("Hello World", "hELLO wORLD", (size_t)-1) != 0 || DG_strncasecmp("Hello", "help", 5) >= 0)
+		fail(__func__, __LINE__, "DG_strncasecmp() is broken!");
+
+	// random haystacks and needles with few different letters (in both cases) and
+	// some non-letters, so there are lots of partial and periodic matches
+	static const char alphabet[] = "aAbB[{@`";
+	static char h[3000];
+	static char n[600];
+	srand(1337);
+	for(int iter=0; iter<40000; ++iter)
+	{
+		int numChars = 2 + rand() % 7;
+		size_t hl = (size_t)rand() % ((iter & 1) ? 3000 : 100);
+		size_t nl = (size_t)rand() % ((iter & 2) ? 600 : 20);
+		for(size_t i=0; i<hl; ++i)  h[i] = alphabet[rand() % numChars];
+		for(size_t i=0; i<nl; ++i)  n[i] = alphabet[rand() % numChars];
+		if(nl > 0 && hl > nl && (iter & 4))
+		{
+			// make sure there's at least one match (with different case)
+			size_t pos = (size_t)rand() % (hl - nl);
+			for(size_t i=0; i<nl; ++i)
+				h[pos+i] = (n[i] >= 'a' && n[i] <= 'z' && (rand() & 1)) ? (char)(n[i] - 32) : n[i];
+		}
+		checkMemimem(h, hl, n, nl, __LINE__);
+	}
+
+	// random strings that are equal except for case, with a random difference (or not),
+	// at all kinds of alignments
+	static char bufA[600 + 64];
+	static char bufB[600 + 64];
+	for(int iter=0; iter<100000; ++iter)
+	{
+		size_t len = (size_t)rand() % ((iter & 1) ? 600 : 70);
+		char* a = bufA + rand() % 64;
+		char* b = bufB + rand() % 64;
+		for(size_t i=0; i<len; ++i)
+		{
+			a[i] = (char)(1 + rand() % 255);
+			b[i] = (naiveFold((unsigned char)a[i]) != (unsigned char)a[i] || (rand() & 1) == 0)
+			       ? a[i] : (char)naiveFold((unsigned char)a[i]);
+			if(a[i] >= 'a' && a[i] <= 'z' && (rand() & 1))  b[i] = (char)(a[i] - 32);
+		}
+		a[len] = b[len] = '\0';
+		if(len > 0 && (iter % 3) == 0)  b[rand() % len] = (char)(rand() % 256);
+		if(len > 0 && (iter % 5) == 0)  a[rand() % len] = '\0';
+		size_t n = (iter & 2) ? (size_t)-1 : (size_t)rand() % (len + 40);
+		checkStrncasecmp(a, b, n, __LINE__);
+	}
+
+	// strings that end right before an inaccessible page
+	size_t size = 200;
+	char* ga = allocGuarded(size);
+	char* gb = allocGuarded(size);
+	for(size_t start=0; start < size; ++start)
+	{
+		size_t len = size - start;
+		memset(ga + start, 'a', len);
+		memset(gb, 'A', size);
+		ga[size-1] = gb[size-1] = '\0';
+		// a ends at the page boundary, b is up to 6 chars shorter
+		char* b = gb + size - len + ((start % 7 < len) ? start % 7 : 0);
+		checkStrncasecmp(ga + start, b, len + 100, __LINE__);
+		checkStrncasecmp(b, ga + start, len + 100, __LINE__);
+		// n stops before the end of the buffers, which aren't terminated
+		ga[size-1] = 'a';
+		gb[size-1] = 'a';
+		checkStrncasecmp(ga + start, gb + start, len, __LINE__);
+	}
+}
+
+// simple bytewise CRC-32C to compare DG_crc32c() against
+static unsigned int naiveCrc32c(unsigned int crc, const unsigned char* p, size_t len)
+{
+	crc = ~crc;
+	for(size_t i=0; i<len; ++i)
+	{
+		crc ^= p[i];
+		for(int b=0; b<8; ++b)
+			crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+	}
+	return ~crc;
+}
+
+static void testHash(void)
+{
+	// reference values from xxHash's XXH3_64bits_withSeed() with seeds 0 and 0x0123456789ABCDEF
+	static const struct { size_t len; unsigned long long hash, seededHash; } known[] = {
+		{ 0, 0x2D06800538D394C2uLL, 0xCC1CA35A1B089C5CuLL },
+		{ 1, 0xC44BDFF4074EECDBuLL, 0xD5DD68911C7F195DuLL },
+		{ 3, 0x3698B80191E625F9uLL, 0x0FA9784A27C8EBBBuLL },
+		{ 4, 0x2E4AC2F1C52157FCuLL, 0xB237A2E813D3DB2BuLL },
+		{ 8, 0x60E1BAA91347A1F2uLL, 0x618706A051ABD078uLL },
+		{ 9, 0x9C88FC32C37B56CBuLL, 0xCE43BC550BD61083uLL },
+		{ 16, 0xF9FBD0260BA978DFuLL, 0x06BC6C42003C4F19uLL },
+		{ 17, 0xC56F339D36CC73D7uLL, 0x8217FFF1DB9EB07DuLL },
+		{ 128, 0x31CCF8DEC850D035uLL, 0xB9BE1917946BEC42uLL },
+		{ 129, 0xC72AF4C6AC4DEA94uLL, 0x541B74AF44360656uLL },
+		{ 240, 0xE315D53D5129EEDEuLL, 0x61BFB247E409654CuLL },
+		{ 241, 0x18773C512B008A63uLL, 0x89FFF3D6CDE6684BuLL },
+		{ 1024, 0x5A1893EDFFA2577CuLL, 0x2CF7913F34CAD7D8uLL },
+		{ 1025, 0x550ABE5D45DD663BuLL, 0x63D5CF7E2B7BB2D5uLL },
+		{ 4096, 0xBE855965EAE8486BuLL, 0x197272E3556D44ABuLL },
+	};
+	static unsigned char buf[40000];
+	for(size_t i=0; i < sizeof(buf); ++i)
+		buf[i] = (unsigned char)(i * 31 + (i >> 8));
+
+	for(size_t i=0; i < sizeof(known)/sizeof(known[0]); ++i)
+	{
+		for(int l=0; l<numSimdLevels; ++l)
+		{
+			unsigned long long h = DG__hash64_level(buf, known[i].len, 0, simdLevels[l]);
+			unsigned long long sh = DG__hash64_level(buf, known[i].len, 0x0123456789ABCDEFuLL, simdLevels[l]);
+			if(h != known[i].hash || sh != known[i].seededHash)
+				fail(__func__, __LINE__, "hash of len %d with SIMD level %d is 0x%llx (seeded: 0x%llx) instead of 0x%llx (0x%llx)!",
+				     (int)known[i].len, simdLevels[l], h, sh, known[i].hash, known[i].seededHash);
+		}
+	}
+
+	// the SIMD versions must match the scalar version, streaming must match one-shot
+	srand(42);
+	for(int iter=0; iter<3000; ++iter)
+	{
+		size_t len = (size_t)rand() % ((iter & 1) ? 600 : 20000);
+		size_t offset = (size_t)rand() % 64;
+		unsigned long long seed = (iter % 3 == 0) ? 0 : ((unsigned long long)rand() << 32) ^ (unsigned long long)rand();
+		const unsigned char* p = buf + offset + (size_t)rand() % 8;
+		unsigned long long expected = DG__hash64_level(p, len, seed, DG__MISC_SIMD_NONE);
+		for(int l=1; l<numSimdLevels; ++l)
+		{
+			unsigned long long h = DG__hash64_level(p, len, seed, simdLevels[l]);
+			if(h != expected)
+				fail(__func__, __LINE__, "hash of len %d with SIMD level %d is 0x%llx instead of 0x%llx!",
+				     (int)len, simdLevels[l], h, expected);
+		}
+		if(DG_hash64(p, len, seed) != expected)
+			fail(__func__, __LINE__, "DG_hash64() of len %d is wrong!", (int)len);
+
+		DG_Hash64State st;
+		DG_Hash64_Init(&st, seed);
+		size_t pos = 0;
+		while(pos < len)
+		{
+			// mostly small chunks, sometimes big ones
+			size_t chunk = (size_t)rand() % ((rand() % 4 == 0) ? 3000 : 100);
+			if(chunk > len - pos)  chunk = len - pos;
+			DG_Hash64_Update(&st, p + pos, chunk);
+			pos += chunk;
+			if(rand() % 8 == 0 && DG_Hash64_Final(&st) != DG__hash64_level(p, pos, seed, DG__MISC_SIMD_NONE))
+				fail(__func__, __LINE__, "DG_Hash64_Final() after %d of %d bytes is wrong!", (int)pos, (int)len);
+		}
+		if(DG_Hash64_Final(&st) != expected)
+			fail(__func__, __LINE__, "DG_Hash64_Final() of len %d is wrong!", (int)len);
+	}
+
+	if(DG_crc32c(0, "123456789", 9) != 0xE3069283u || DG_crc32c(0, NULL, 0) != 0)
+		fail(__func__, __LINE__, "DG_crc32c() is broken!");
+	for(int iter=0; iter<2000; ++iter)
+	{
+		// long enough to use the interleaved blocks of the SSE4.2 version
+		size_t len = (size_t)rand() % ((iter & 1) ? 1000 : 30000);
+		const unsigned char* p = buf + (size_t)rand() % 64;
+		unsigned int start = (iter % 3 == 0) ? 0 : (unsigned int)rand();
+		unsigned int expected = naiveCrc32c(start, p, len);
+		for(int l=0; l<numSimdLevels; ++l)
+		{
+			unsigned int crc = DG__crc32c_level(start, p, len, simdLevels[l]);
+			if(crc != expected)
+				fail(__func__, __LINE__, "CRC of len %d with SIMD level %d is 0x%x instead of 0x%x!",
+				     (int)len, simdLevels[l], crc, expected);
+		}
+		size_t split = len ? (size_t)rand() % len : 0;
+		if(DG_crc32c(DG_crc32c(start, p, split), p + split, len - split) != expected)
+			fail(__func__, __LINE__, "DG_crc32c() of len %d split at %d is wrong!", (int)len, (int)split);
+	}
+}
+
+// checks DG__strlcpy_level() for all SIMD levels, including that it doesn't write
+// behind the '\0' it puts into dst (dstBuf must have dstsize + 64 bytes)
+static void checkStrlcpy(char* dstBuf, const char* src, size_t dstsize, int line)
+{
+	size_t srclen = strlen(src);
+	size_t copyLen = (dstsize == 0) ? 0 : ((srclen < dstsize-1) ? srclen : dstsize-1);
+	for(int l=0; l<numSimdLevels; ++l)
+	{
+		memset(dstBuf, '#', dstsize + 64);
+		size_t res = DG__strlcpy_level(dstBuf, src, dstsize, simdLevels[l]);
+		if(res != srclen)
+			fail(__func__, line, "DG__strlcpy_level(\"%.40s\", %d, level %d) returned %d instead of %d!",
+			     src, (int)dstsize, simdLevels[l], (int)res, (int)srclen);
+		if(memcmp(dstBuf, src, copyLen) != 0 || (dstsize != 0 && dstBuf[copyLen] != '\0'))
+			fail(__func__, line, "DG__strlcpy_level(\"%.40s\", %d, level %d) copied the wrong data!",
+			     src, (int)dstsize, simdLevels[l]);
+		size_t end = (dstsize == 0) ? 0 : copyLen + 1;
+		for(size_t i=end; i < dstsize + 64; ++i)
+		{
+			if(dstBuf[i] != '#')
+				fail(__func__, line, "DG__strlcpy_level(\"%.40s\", %d, level %d) wrote to dst[%d]!",
+				     src, (int)dstsize, simdLevels[l], (int)i);
+		}
+	}
+}
+
+static void testStrlcpy(void)
+{
+	char src[400];
+	char dst[400 + 64];
+
+	// all lengths and offsets (relative to the alignment) up to a few SIMD blocks
+	for(size_t off=0; off < 33; ++off)
+	{
+		for(size_t len=0; len < 100; ++len)
+		{
+			for(size_t i=0; i<len; ++i)  src[off+i] = (char)('a' + (i+off) % 26);
+			src[off+len] = '\0';
+			for(size_t dstsize=0; dstsize < len + 35; ++dstsize)
+				checkStrlcpy(dst, src + off, dstsize, __LINE__);
+		}
+	}
+	// random lengths with random bytes
+	for(int iter=0; iter < 20000; ++iter)
+	{
+		size_t off = (size_t)rand() % 64;
+		size_t len = (size_t)rand() % 300;
+		for(size_t i=0; i<len; ++i)  src[off+i] = (char)(1 + rand() % 255);
+		src[off+len] = '\0';
+		checkStrlcpy(dst, src + off, (size_t)rand() % 340, __LINE__);
+	}
+
+	// src ends right before an inaccessible page
+	size_t size = 200;
+	char* g = allocGuarded(size);
+	memset(g, 'x', size);
+	g[size-1] = '\0';
+	for(size_t start=0; start < size; ++start)
+	{
+		checkStrlcpy(dst, g + start, 400, __LINE__);
+		checkStrlcpy(dst, g + start, size - start, __LINE__);
+		checkStrlcpy(dst, g + start, (start * 7) % 250, __LINE__);
+	}
+
+	// DG_strlcat() appends with the same kernels
+	char cat[16];
+	strcpy(cat, "abc");
+	if(DG_strlcat(cat, "defghij", sizeof(cat)) != 10 || strcmp(cat, "abcdefghij") != 0)
+		fail(__func__, __LINE__, "DG_strlcat() failed!");
+	if(DG_strlcat(cat, "klmnopqrstuvwxyz", sizeof(cat)) != 26 || strcmp(cat, "abcdefghijklmno") != 0)
+		fail(__func__, __LINE__, "DG_strlcat() didn't truncate correctly!");
+	if(DG_strlcat(cat, "xyz", sizeof(cat)) != 18 || strcmp(cat, "abcdefghijklmno") != 0)
+		fail(__func__, __LINE__, "DG_strlcat() into a full buffer failed!");
+	if(DG_strlcpy(cat, "hello", 0) != 5 || DG_strlcpy(cat, "hello", sizeof(cat)) != 5 || strcmp(cat, "hello") != 0)
+		fail(__func__, __LINE__, "DG_strlcpy() failed!");
+}
+
+int main()
+{
+	initSimdLevels();
+
+	testExecutablePath();
+
+	testStrSplitIter();
+
+	testStrBuf();
+
+	testStrPool();
+
+	testIntToA();
+
+	testDtoA();
+
+	testIntParse();
+
+	testFloatParse();
+
+	testUtf();
+
+	testIcase();
+
+	testHash();
+
+	testStrlcpy();
+
+	printf("Success! All DG_GetExecutable*(), DG_StrSplitIter, DG_StrBuf, DG_StrPool, DG_*toa(), DG_strto*(), DG_utf*(), case-insensitive search/compare, hash and DG_strl*() tests passed.\n");
+
+	return 0;
+}
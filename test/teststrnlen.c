@@ -0,0 +1,177 @@
+/*
+ * Tests for the different implementations of DG_strnlen() (and DG_strlen())
+ *
+ * License:
+ *  This software is in the public domain. Where that dedication is not
+ *  recognized, you are granted a perpetual, irrevocable license to copy
+ *  and modify this file however you want.
+ *  No warranty implied; use at your own risk.
+ */
+
+#include <stdarg.h>
+
+#define DG_MISC_IMPLEMENTATION
+#define DG_MISC_NO_GNU_SOURCE
+#define DG_MISC_STRLEN_SIMD
+#define DG_MISC_RUNTIME_DISPATCH // so the AVX2 version is available (if the CPU supports it)
+#include "../DG_misc.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+static void fail(const char* fromfunc, int line, const char* failmsgfmt, ...)
+{
+	printf("!!! %s() line %d:\n\t", fromfunc, line);
+
+	va_list argptr;
+	va_start( argptr, failmsgfmt );
+
+	vprintf( failmsgfmt, argptr );
+
+	va_end( argptr );
+
+	printf(" !!!\n");
+	exit(1);
+}
+
+typedef size_t (*StrnlenFn)(const char* s, size_t n);
+
+typedef struct {
+	const char* name;
+	StrnlenFn fn;
+} StrnlenImpl;
+
+static StrnlenImpl impls[4];
+static int numImpls = 0;
+
+static void initImpls(void)
+{
+	impls[numImpls].name = "DG_strnlen";
+	impls[numImpls++].fn = DG_strnlen;
+	impls[numImpls].name = "swar";
+	impls[numImpls++].fn = DG__strnlen_swar;
+#ifdef DG__MISC_HAVE_SSE2
+	impls[numImpls].name = "sse2";
+	impls[numImpls++].fn = DG__strnlen_sse2;
+#endif
+#if defined(DG__MISC_ALWAYS_AVX2)
+	impls[numImpls].name = "avx2";
+	impls[numImpls++].fn = DG__strnlen_avx2;
+#elif defined(DG__MISC_DISPATCH)
+	if(DG__MiscDetectSIMD() >= DG__MISC_SIMD_AVX2)
+	{
+		impls[numImpls].name = "avx2";
+		impls[numImpls++].fn = DG__strnlen_avx2;
+	}
+#endif
+}
+
+static size_t naiveStrnlen(const char* s, size_t n)
+{
+	size_t i = 0;
+	while(i < n && s[i] != '\0')  ++i;
+	return i;
+}
+
+// returns a buffer of size bytes that is directly followed by a page that can't be accessed
+static char* allocGuarded(size_t size)
+{
+#ifdef _WIN32
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	size_t pageSize = sysInfo.dwPageSize;
+	size_t allocSize = (size + pageSize - 1) / pageSize * pageSize;
+	char* ret = (char*)VirtualAlloc(NULL, allocSize + pageSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	DWORD oldProt;
+	if(ret == NULL || !VirtualProtect(ret + allocSize, pageSize, PAGE_NOACCESS, &oldProt))
+		fail(__func__, __LINE__, "Couldn't allocate guarded buffer!");
+#else
+	size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	size_t allocSize = (size + pageSize - 1) / pageSize * pageSize;
+	char* ret = (char*)mmap(NULL, allocSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(ret == (char*)MAP_FAILED || mprotect(ret + allocSize, pageSize, PROT_NONE) != 0)
+		fail(__func__, __LINE__, "Couldn't allocate guarded buffer!");
+#endif
+	return ret + allocSize - size;
+}
+
+static void testAgainstNaive()
+{
+	// random strings of random lengths at all kinds of alignments
+	static char buf[4096 + 64];
+	srand(42);
+	for(int iter=0; iter < 200000; ++iter)
+	{
+		size_t offset = rand() % 64;
+		size_t len = rand() % ((iter & 1) ? 4096 : 200);
+		char* s = buf + offset;
+		for(size_t i=0; i<len; ++i)  s[i] = (char)(1 + rand() % 255);
+		s[len] = '\0';
+		size_t n = (iter & 2) ? (size_t)-1 : (size_t)(rand() % (len + 100));
+
+		size_t expected = naiveStrnlen(s, n);
+		for(int i=0; i<numImpls; ++i)
+		{
+			size_t res = impls[i].fn(s, n);
+			if(res != expected)
+				fail(__func__, __LINE__, "%s(s, %d) returned %d instead of %d (len %d, offset %d)!",
+				     impls[i].name, (int)n, (int)res, (int)expected, (int)len, (int)offset);
+		}
+	}
+}
+
+static void testPageBoundary()
+{
+	// strings (and buffers without '\0') that end right before an inaccessible page,
+	// reading past that would crash
+	size_t size = 1024;
+	char* buf = allocGuarded(size);
+	for(size_t start=0; start < size; ++start)
+	{
+		char* s = buf + start;
+		size_t len = size - start;
+		memset(s, 'a', len);
+		for(int i=0; i<numImpls; ++i)
+		{
+			// without terminating '\0', but limited by n
+			size_t res = impls[i].fn(s, len);
+			if(res != len)
+				fail(__func__, __LINE__, "%s(s, %d) returned %d!", impls[i].name, (int)len, (int)res);
+
+			// with '\0' at the very end, but n is (too) big
+			s[len-1] = '\0';
+			res = impls[i].fn(s, len + 1000);
+			if(res != len-1)
+				fail(__func__, __LINE__, "%s(s, %d) returned %d instead of %d!", impls[i].name, (int)(len+1000), (int)res, (int)(len-1));
+			s[len-1] = 'a';
+		}
+	}
+	buf[size-1] = '\0';
+	if(DG_strlen(buf) != size-1)
+		fail(__func__, __LINE__, "DG_strlen() returned %d instead of %d!", (int)DG_strlen(buf), (int)(size-1));
+}
+
+int main()
+{
+	initImpls();
+
+	printf("Testing implementations:");
+	for(int i=0; i<numImpls; ++i)  printf(" %s", impls[i].name);
+	printf("\n");
+
+	testAgainstNaive();
+
+	testPageBoundary();
+
+	printf("Success! All DG_strnlen() tests passed.\n");
+
+	return 0;
+}